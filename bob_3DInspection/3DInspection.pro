@@ -3,41 +3,94 @@ CONFIG += console c++11
 CONFIG -= app_bundle
 QT += core
 QT += sql
-QT += xml
 
 SOURCES += \
     sdk/customexception.cpp \
     app/appsetting.cpp \
     app/capturesetting.cpp \
     sdk/rectangle.cpp \
+    sdk/rectanglekernel.cpp \
+    sdk/affinetransform.cpp \
     job/measuredobj.cpp \
     job/board.cpp \
+    job/componenttable.cpp \
+    job/spatialindex.cpp \
+    job/changetracker.cpp \
+    job/fovplan.cpp \
+    job/fovplanner.cpp \
+    job/inspectionplan.cpp \
+    job/boardalignment.cpp \
+    job/jobsnapshot.cpp \
+    job/jobstore.cpp \
+    job/binaryjob.cpp \
+    job/resultstore.cpp \
+    job/jobmigrator.cpp \
+    job/jobcatalog.cpp \
+    job/lazyjob.cpp \
+    job/jobcache.cpp \
     job/inspectiondata.cpp \
     main.cpp \
     sdk/formatconvertion.cpp \
     app/datageneration.cpp \
     sdk/DB/blob.cpp \
     sdk/DB/sqlitedb.cpp \
+    sdk/DB/statement.cpp \
+    sdk/DB/sqliteconnectionpool.cpp \
     app/mainwindow.cpp \
     app/config.cpp \
-    sdk/numrandom.cpp
+    sdk/numrandom.cpp \
+    sdk/hash.cpp \
+    sdk/xmlstreamwriter.cpp \
+    sdk/chunkedwriter.cpp \
+    sdk/xmlstreamreader.cpp \
+    job/xmljobimporter.cpp
 
 HEADERS += \
     sdk/customexception.hpp \
     app/appsetting.hpp \
     app/capturesetting.hpp \
     sdk/rectangle.hpp \
+    sdk/rectanglekernel.hpp \
+    sdk/rectanglekernelimpl.hpp \
+    sdk/affinetransform.hpp \
     job/measuredobj.hpp \
     job/measuredobjlist.hpp \
+    job/measuredobjpool.hpp \
     job/board.hpp \
+    job/componenttable.hpp \
+    job/spatialindex.hpp \
+    job/changetracker.hpp \
+    job/fovplan.hpp \
+    job/fovplanner.hpp \
+    job/inspectionplan.hpp \
+    job/boardalignment.hpp \
+    job/jobsnapshot.hpp \
+    job/jobstore.hpp \
+    job/binaryjob.hpp \
+    job/resultstore.hpp \
+    job/jobmigrator.hpp \
+    job/jobcatalog.hpp \
+    job/lazyjob.hpp \
+    job/jobcache.hpp \
     job/inspectiondata.hpp \
     sdk/formatconvertion.hpp \
     app/datageneration.hpp \
     sdk/DB/blob.hpp \
     sdk/DB/sqlitedb.hpp \
+    sdk/DB/statement.hpp \
+    sdk/DB/sqliteconnectionpool.hpp \
+    sdk/DB/rowreader.hpp \
     app/mainwindow.hpp \
     app/config.hpp \
-    sdk/numrandom.hpp
+    sdk/numrandom.hpp \
+    sdk/hash.hpp \
+    sdk/xmlstreamwriter.hpp \
+    sdk/chunkedwriter.hpp \
+    sdk/xmlstreamreader.hpp \
+    job/xmljobimporter.hpp
+
+#按指令集单独编译的源文件(rectanglekernel_avx2.cpp)
+include(sdk/simd.pri)
 
 INCLUDEPATH += $$PWD/include/sqlits
 INCLUDEPATH += $$PWD/include
@@ -46,3 +99,8 @@ unix::LIBS += -L$$PWD/lib/ -lsqlite3
 
 unix:LIBS += -L/usr/lib/x86_64-linux-gnu\
 -ldl
+
+#Parquet导出(SSDK::Archive::Parquet),需要SSDK,parquet-cpp及arrow库: qmake CONFIG+=parquet
+parquet {
+    include(job/parquet.pri)
+}
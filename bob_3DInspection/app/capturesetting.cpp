@@ -8,6 +8,9 @@ CaptureSetting::CaptureSetting()
 {
     this->m_imgWidth = 0;                //定义图片的宽度为4096
     this->m_imgHeight = 0;               //定义图片的高度为3072
+    this->m_imgBit = IMGBIT::BIT8;
+    this->m_pixelSize = 15;              //默认像素尺寸为15um
+    this->m_fovOverlap = 1;              //默认相邻FOV重叠1mm
 }
 
 CaptureSetting::~CaptureSetting()
@@ -78,6 +81,37 @@ void CaptureSetting::readCaptureSetting(const QString &path)
                 THROW_EXCEPTION("读取文件数据Image/ImgBit失败!");
             }
             //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //step2.4
+            //读取文件Image/PixelSize数据(单位:um),没有该项时使用默认值,数据不大于0时抛出异常
+            if(configFile.contains("Image/PixelSize"))
+            {
+                this->m_pixelSize = configFile.value("Image/PixelSize").toDouble();
+
+                if( this->m_pixelSize <= 0 )
+                {
+                    THROW_EXCEPTION("读取文件数据Image/PixelSize失败!");
+                }
+            }
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //step2.5
+            //读取文件Fov/Overlap数据(单位:mm),没有该项时使用默认值
+            //重叠量必须大于等于0,且小于FOV的宽和高,否则抛出异常
+            if(configFile.contains("Fov/Overlap"))
+            {
+                this->m_fovOverlap = configFile.value("Fov/Overlap").toDouble();
+            }
+
+            if( this->m_fovOverlap < 0 ||
+                this->m_fovOverlap >= this->fovWidth() ||
+                this->m_fovOverlap >= this->fovHeight())
+            {
+                THROW_EXCEPTION("读取文件数据Fov/Overlap失败!");
+            }
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         }
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     }
@@ -106,6 +140,10 @@ void CaptureSetting::writeCaptureSetting(const QString &path)
         configFile.setValue("Image/Height",3072);
         //将Image/Height的数据写为系统默认值,默认为"8"
         configFile.setValue("Image/ImgBit","BIT8");
+        //将Image/PixelSize的数据写为系统默认值,默认为"15"(um)
+        configFile.setValue("Image/PixelSize",15);
+        //将Fov/Overlap的数据写为系统默认值,默认为"1"(mm)
+        configFile.setValue("Fov/Overlap",1);
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     }
     catch(const exception &ex)
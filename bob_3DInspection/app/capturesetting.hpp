@@ -61,6 +61,25 @@ namespace App
 
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //访存函数
+        //获取图片的宽度,高度(单位:像素)及图像的位数
+        int imgWidth() const {return this->m_imgWidth;}
+        int imgHeight() const {return this->m_imgHeight;}
+        IMGBIT imgBit() const {return this->m_imgBit;}
+
+        //获取像素尺寸(单位:um)
+        double pixelSize() const {return this->m_pixelSize;}
+
+        //获取相邻FOV之间的重叠量(单位:mm)
+        double fovOverlap() const {return this->m_fovOverlap;}
+
+        //获取一个FOV在基板上的宽度和高度(单位:mm)
+        double fovWidth() const {return this->m_imgWidth * this->m_pixelSize / 1000.0;}
+        double fovHeight() const {return this->m_imgHeight * this->m_pixelSize / 1000.0;}
+
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
     private:
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         //定义图片的宽度,高度及图像的位数(相机为12M相机,图像位数分别为8位和16位)
@@ -68,6 +87,11 @@ namespace App
         int m_imgWidth;
         int m_imgHeight;
         IMGBIT m_imgBit;
+
+        //像素尺寸(单位:um)及相邻FOV的重叠量(单位:mm),用于规划FOV
+        //配置文件中没有这两项时使用默认值,有但数据不正确时抛出异常
+        double m_pixelSize;
+        double m_fovOverlap;
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     };
 } //End of namespace App
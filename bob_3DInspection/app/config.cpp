@@ -43,13 +43,11 @@ void Config::readConfigFiles()
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         //step2
         //读取appsetting.ini和capturesetting.ini配置文件的路径
-        //将AppSetting类实例化,调用读取文件(app.ini)的成员函数
-        AppSetting appSetting;
-        appSetting.readAppSetting(this->m_appSettingPath);
+        //调用读取文件(app.ini)的成员函数
+        this->m_appSetting.readAppSetting(this->m_appSettingPath);
 
-        //将CaptureSetting类实例化,调用读取文件(capture.ini)的成员函数
-        CaptureSetting captureSetting;
-        captureSetting.readCaptureSetting(this->m_captureSettingPath);
+        //调用读取文件(capture.ini)的成员函数
+        this->m_captureSetting.readCaptureSetting(this->m_captureSettingPath);
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     }
     catch(const exception &ex)
@@ -75,8 +73,7 @@ void Config::readAppSetting()
     //读取文件Theme内容,将读取appsetting.ini配置文件的路径
     this->m_appSettingPath = configFile.value("AppSettingPath").toString();
 
-    AppSetting appSetting;
-    appSetting.readAppSetting(this->m_appSettingPath);
+    this->m_appSetting.readAppSetting(this->m_appSettingPath);
 }
 
 void Config::readCaptureSetting()
@@ -94,8 +91,7 @@ void Config::readCaptureSetting()
     }
     //读取文件Theme内容,将读取 capturesetting.ini配置文件的路径
     this->m_captureSettingPath = configFile.value("CaptureSettingPath").toString();
-    CaptureSetting captureSetting;
-    captureSetting.readCaptureSetting(this->m_captureSettingPath);
+    this->m_captureSetting.readCaptureSetting(this->m_captureSettingPath);
 }
 //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -50,6 +50,13 @@ namespace App
         */
         void readCaptureSetting();
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //访存函数
+        //获取读取后的AppSetting及CaptureSetting数据
+        AppSetting & appSetting(){return this->m_appSetting;}
+        CaptureSetting & captureSetting(){return this->m_captureSetting;}
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     private:
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         //成员变量,设置配置文件的路径
@@ -57,6 +64,9 @@ namespace App
         QString m_captureSettingPath;
         //存放配置文件路径的文件
         QString m_appConfig{"./AppConfig"};
+        //读取后的配置数据
+        AppSetting m_appSetting;
+        CaptureSetting m_captureSetting;
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     };
 }  //End of namespace App
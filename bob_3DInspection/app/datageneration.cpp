@@ -1,4 +1,5 @@
 #include "datageneration.hpp"
+#include "../job/jobmigrator.hpp"
 
 using namespace std;
 using namespace App;
@@ -17,8 +18,7 @@ DataGeneration::~DataGeneration()
 }
 
 void DataGeneration::generateInspectionData(int size,
-                                            InspectionData * pInspectionData,
-                                            MeasuredObj measuredObjArr[])
+                                            InspectionData * pInspectionData)
 {
     try
     {
@@ -32,6 +32,9 @@ void DataGeneration::generateInspectionData(int size,
 
         NumRandom randomNum;
 
+        //从board的内存池中一次性分配所有的检测对象
+        MeasuredObj * measuredObjArr = pInspectionData->pBoard()->measuredObjPool().allocate(size);
+
         //根据传入参数,生成指定大小的链表
         for (int i = 0; i < size; ++i)
         {
@@ -72,10 +75,11 @@ void DataGeneration::generateInspectionData(int size,
             }
             measuredObjArr[i].setRectangle(&rect); //将当前对象的rectangle变量赋值
             measuredObjArr[i].setName(name);       //设置已检测对象的名称
-            //将当前检测对象添加至链表中
-            pInspectionData->pBoard()->pMeasuredObjList()->pushTail(&measuredObjArr[i]);
             //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         }
+        //将生成的检测对象一次性添加至链表中
+        pInspectionData->pBoard()->pMeasuredObjList()->append(measuredObjArr,
+                                                             measuredObjArr + size);
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -94,18 +98,12 @@ void DataGeneration::generateInspectionData(int size,
         //step3
         //生成inspectionData数据(检测程式的版本信息,检测程式上次保存时间)
         //2017.12.02 bob    将自动生成检测程式的版本号设置为V2
-        string versionName = "V2";
+        //2026.10.17 bob    设置为JobMigrator的当前版本,生成的检测程式不需要升级
+        string versionName = JobMigrator().currentVersion();
         pInspectionData->setVersion(versionName);
 
-        time_t currentTime = time(NULL);
-        tm * pTime = localtime(&currentTime);       //获取当前系统时间的地址
-        //获取时间,格式为 ( xx年/xx月/xx日  x时:x分:x秒)
-        string lastEditingTime = FormatConvertion::intToString(pTime->tm_year+1900) +
-              "/" + FormatConvertion::intToString(pTime->tm_mon+1) +
-              "/" + FormatConvertion::intToString(pTime->tm_mday) +
-              " " + FormatConvertion::intToString(pTime->tm_hour) +
-              ":" + FormatConvertion::intToString(pTime->tm_min) +
-              ":" + FormatConvertion::intToString(pTime->tm_sec);
+        //获取当前系统时间,格式为 ( xx年/xx月/xx日  x时:x分:x秒)
+        string lastEditingTime = FormatConvertion::timeToString(time(NULL));
         pInspectionData->setLastEditingTime(lastEditingTime);
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     }
@@ -40,14 +40,13 @@ namespace App
         *           检测程式的版本
         *           检测程式对应基板的名称,原点x ,y坐标,及长和宽
         *           基板中所有元件的名称,x,y轴坐标,及长和宽
+        *           检测对象从board的内存池中分配
         *  @param   size:检测对象的数量
         *           inspectionData:存放inspectionData数据的头指针
-        *           measuredObjArr:存放measuredObj对象的数组
         *  @return  N/A
         */
         void generateInspectionData(int size,
-                                    InspectionData *pInspectionData,
-                                    MeasuredObj measuredObjArr[]);
+                                    InspectionData *pInspectionData);
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     };
 }//End of namespace App
@@ -1,4 +1,5 @@
 #include "mainwindow.hpp"
+#include "../sdk/hash.hpp"
 
 using namespace std;
 using namespace Job;
@@ -8,7 +9,12 @@ using namespace SSDK::DB;
 
 MainWindow::MainWindow()
 {
-
+    //将board的成员变量(指向检测对象列表的指针)指向检测对象列表
+    this->m_board.setMeasurdObjList(&this->m_measuredObjList);
+    //将inspectionData的成员变量(指向board信息的指针)指向board
+    this->m_inspectionData.setBoard(&this->m_board);
+    //board的编辑函数通过m_jobStore发布编辑后的快照(只复制被编辑的块)
+    this->m_board.setJobStore(&this->m_jobStore);
 }
 
 MainWindow::~MainWindow()
@@ -22,15 +28,13 @@ void MainWindow::loadJob(QString path)
 {
     //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     // step1
-    //实例化类对象(InspectionData,Board,MeasuredObjList三个类对象)
-    InspectionData inspectionData;          //将 InspectionData 类实例化
-    Board board;                            //将 board 类实例化
-    MeasuredObjList<MeasuredObj> measuredObjList;        //将检测对象列表实例化
-
-    //将board的成员变量(指向检测对象列表的指针)指向实例化的检测对象列表
-    board.setMeasurdObjList(&measuredObjList);
-    //将inspectionData的成员变量(指向board信息的指针)指向实例化的board
-    inspectionData.setBoard(&board);
+    //检测程式数据(InspectionData,Board,MeasuredObjList)由MainWindow持有
+    //重新加载前先保存上一个程式未保存的修改,再释放其检测对象
+    InspectionData & inspectionData = this->m_inspectionData;
+    saveJob();
+    inspectionData.pBoard()->clearMeasuredObjs();
+    this->m_jobPath.clear();
+    this->m_jobContentHash = 0;
     //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
     //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -47,15 +51,18 @@ void MainWindow::loadJob(QString path)
 
     //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     //step3
-    //过滤目录下所有的xml文件
-    QStringList filters;            //创建过滤器列表，过滤xml为后缀的文件
-    filters << "*[^xml]";           //"*[^x|^t][^m|^x][^l|^t]";
-    dir.setNameFilters(filters);    //过滤目录下的xml文件
-
-    //扫描目录下的文件
-    dir.setFilter(QDir::Files);
-    //获取文件目录下排除.xml文件后的文件列表
-    QFileInfoList list = dir.entryInfoList();
+    //从目录的索引中列出检测程式,只重新读取新增及变化的文件(比较大小及修改时间)
+    //导出的xml文件及生成的plan,bin文件不是检测程式,不在索引中
+    //二进制检测程式缓存在该目录下的.jobcache目录中
+    if(!this->m_jobCatalog.isOpened() || this->m_jobCatalog.folderPath() != path.toStdString())
+    {
+        //有QCoreApplication(Qt事件循环)时监视目录,目录没有变化时不再扫描;
+        //控制台程序(main.cpp没有创建QCoreApplication)不监视,每次加载都比较文件的大小及修改时间
+        this->m_jobCatalog.open(path.toStdString(), true);
+        this->m_jobCache.setDiskFolder(this->m_jobCatalog.folderPath() + ".jobcache");
+    }
+    this->m_jobCatalog.refreshIfChanged();
+    vector<JobCatalogEntry> list = this->m_jobCatalog.entries();
     //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
     //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -66,27 +73,38 @@ void MainWindow::loadJob(QString path)
     //将检测程式数据写入到xml文件中
     //将检测程式数据显示在终端上
     //step4.1
+    //如果目录下没有检测程式,但有之前导出的xml文件(V2.xml),则从xml导入检测程式(V2)
+    if ( 0 == list.size() && dir.exists("V2.xml") )
+    {
+        importJobFromXml((path + "V2.xml").toStdString(), path.toStdString() + "V2");
+        inspectionData.pBoard()->pMeasuredObjList()->print();
+    }
     //如果目录下没有检测程式
-    if ( 0 == list.size() )
+    else if ( 0 == list.size() )
     {
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         // step4.1.1 随机生成一笔检测程式数据
         DataGeneration generator;           //实例化一个生成随机检测程式对象
-        MeasuredObj objArr[OBJ_CNT];        //创建一个存放检测对象数据的数组
         //随机一笔检测程式数据生成数据
         generator.generateInspectionData(OBJ_CNT,
-                                         &inspectionData,
-                                         objArr);
+                                         &inspectionData);
+        //根据生成的检测对象生成列式存储的元件表
+        inspectionData.pBoard()->buildComponentTable();
+        //发布检测程式的快照,供检测线程读取
+        this->m_jobStore.publish(JobSnapshot::create(&inspectionData));
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         //step4.1.2 将检测程式数据写入到检测程式文件中(sqlite数据库)
         //2017.12.02 bob
         //将生成检测程式的名称改成V2
         writeInspectionDataToJob(path.toStdString()+"V2",
                                  &inspectionData);
+        this->m_jobPath = path.toStdString()+"V2";
         //step4.1.3 将检测程式数据写入xml文档
         inspectionData.writeInspectionDataToXml(path + "V2.xml");
         //step4.1.4 将检测对象数据在终端上显示
         inspectionData.pBoard()->pMeasuredObjList()->print();
+        //step4.1.5 编译检测程式(生成拍照计划及每个FOV的ROI)
+        compileJob(path.toStdString()+"V2");
     }
     //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -102,16 +120,13 @@ void MainWindow::loadJob(QString path)
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         //step 4.2.1
         //在终端上显示ID号和文件名称,供用户选择
-        cout << "ID Filename" << endl;
-        //将文件及文件的序号显示在终端上
-        for (int i = 0; i < list.size(); ++i)
+        cout << "ID Filename Version Board Components LastEditingTime" << endl;
+        //将文件及文件的序号,以及索引中的摘要信息显示在终端上
+        for (size_t i = 0; i < list.size(); ++i)
         {
-            QFileInfo fileInfo = list.at(i);
-
-            cout << qPrintable(QString("%1  %2")
-                               .arg(i + 1)
-                               .arg(fileInfo.fileName()));
-            cout << endl;
+            cout << i + 1 << "  " << list[i].fileName << "  "
+                 << list[i].version << "  " << list[i].boardName << "  "
+                 << list[i].componentCount << "  " << list[i].lastEditingTime << endl;
         }
         //选择对应检测程式文件的索引号
         int jobIndex{0};
@@ -131,7 +146,7 @@ void MainWindow::loadJob(QString path)
             if( (jobIndex - (int)jobIndex) == 0 )
             {
 
-                if(jobIndex > 0 && jobIndex <= list.size())
+                if(jobIndex > 0 && jobIndex <= (int)list.size())
                 {
                     break;
                 }
@@ -146,29 +161,72 @@ void MainWindow::loadJob(QString path)
 
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         //step2.4.2
-        //获取用户选择的检测程式路径
-        QString file = list.at(jobIndex-1).filePath();
+        //获取用户选择的检测程式路径及文件内容的哈希值
+        //文件的大小及修改时间与索引一致时直接使用索引中的哈希值,否则重新计算
+        //加载不修改检测程式文件(旧版本在内存中升级),哈希值即为文件当前的内容
+        const JobCatalogEntry & entry = list[jobIndex-1];
+        QString file = QString::fromStdString(entry.path);
+        this->m_jobPath = entry.path;
+        uint64_t contentHash = JobCatalog::isCurrent(entry) ? entry.hash : Hash::fileHash(entry.path);
+        this->m_jobContentHash = contentHash;
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         //step2.4.3
         //读取检测程式数据
-        SqliteDB sqlite;
-        sqlite.open(file.toStdString());             //打开检测程式文件
-        //获取检测程式中检测对象的数量
-        string sqlQuery = "SELECT COUNT(*) FROM MeasuredObjList";
-        sqlite.prepare(sqlQuery);
-        int objCnt = sqlite.executeScalar<int>(sqlQuery);
-
-        //根据检测程式中检测对象的数量新建一个存放检测对象数据的数组
-        MeasuredObj measuredObjArr[objCnt];
-
-        //将检测程式中的数据读取到内存中
-        readInspectionDataFromJob(objCnt,
-                                  &inspectionData,
-                                  measuredObjArr,
-                                  &sqlite);
-        sqlite.close();
+        //内存缓存中有相同内容的检测程式时直接复制元件表及空间索引,并发布缓存的快照
+        //否则优先映射磁盘缓存中的二进制文件(<哈希值>.bin),没有时从检测程式(sqlite数据库)读取并生成二进制文件
+        shared_ptr<const CachedJob> pCachedJob = this->m_jobCache.find(contentHash);
+        shared_ptr<const JobSnapshot> pSnapshot;
+        if(pCachedJob)
+        {
+            JobCache::restore(*pCachedJob, &inspectionData);
+            pSnapshot = pCachedJob->pSnapshot;
+            cout << "从缓存加载检测程式:" << entry.fileName << endl;
+        }
+        else
+        {
+            string binPath = this->m_jobCache.blobPath(contentHash);
+            if(!binPath.empty() && loadBinaryJob(binPath, contentHash))
+            {
+                this->m_jobCache.touch(binPath);
+            }
+            else
+            {
+                //当前版本的检测程式直接读取;旧版本只读打开并在内存中升级后读取,不修改检测程式文件
+                //连接只在当前线程使用,以NOMUTEX打开,读取每一列时不再加锁及解锁连接的互斥量
+                SqliteDB sqlite;
+                sqlite.open(file.toStdString(), SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX);     //打开检测程式文件
+                if(JobMigrator::readVersion(&sqlite) != this->m_jobMigrator.currentVersion())
+                {
+                    sqlite.close();
+                    string fileVersion = this->m_jobMigrator.openUpgraded(file.toStdString(), sqlite);
+                    cout << "检测程式版本为" << fileVersion << ",已在内存中升级到"
+                         << this->m_jobMigrator.currentVersion() << endl;
+                }
+                //获取检测程式中检测对象的数量
+                string sqlQuery = "SELECT COUNT(*) FROM MeasuredObjList";
+                sqlite.prepare(sqlQuery);
+                int objCnt = sqlite.executeScalar<int>(sqlQuery);
+
+                //将检测程式中的数据读取到内存中
+                readInspectionDataFromJob(objCnt,
+                                          &inspectionData,
+                                          &sqlite);
+                sqlite.close();
+
+                if(!binPath.empty())
+                {
+                    BinaryJob::write(binPath, &inspectionData, contentHash);
+                    this->m_jobCache.trimDisk(binPath);
+                }
+            }
+            //根据读取的检测对象生成列式存储的元件表
+            inspectionData.pBoard()->buildComponentTable();
+            pSnapshot = JobSnapshot::create(&inspectionData);
+        }
+        //发布检测程式的快照,供检测线程读取
+        this->m_jobStore.publish(pSnapshot);
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         //step2.4.4
         //将检测程式数据写入到xml文件中
@@ -176,6 +234,25 @@ void MainWindow::loadJob(QString path)
 
         //step2.4.5 将所有检测对象的数据显示在终端上
         inspectionData.pBoard()->pMeasuredObjList()->print();
+
+        //step2.4.6 编译检测程式(生成拍照计划及每个FOV的ROI)
+        //缓存中的计划与当前拍照参数一致时直接复制,否则重新编译,并将编译结果一起放入缓存
+        uint64_t planHash = this->planHash(contentHash);
+        if(pCachedJob && pCachedJob->planHash == planHash)
+        {
+            this->m_fovPlan = pCachedJob->fovPlan;
+            this->m_inspectionPlan = pCachedJob->inspectionPlan;
+        }
+        else
+        {
+            compileJob(file.toStdString(), contentHash);
+
+            shared_ptr<CachedJob> pNewCachedJob = JobCache::capture(contentHash, entry.path, &inspectionData, pSnapshot);
+            pNewCachedJob->planHash = planHash;
+            pNewCachedJob->fovPlan = this->m_fovPlan;
+            pNewCachedJob->inspectionPlan = this->m_inspectionPlan;
+            this->m_jobCache.insert(pNewCachedJob);
+        }
     }
     //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 }
@@ -190,7 +267,9 @@ void MainWindow::writeInspectionDataToJob(string path,
     {
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         //step1
+        //文件内容即将变化,先释放该文件在缓存中的检测程式
         //在指定路径下创建数据库并打开
+        this->m_jobCache.invalidate(path, knownContentHash(path));
         SqliteDB sqlite;                  //SqliteDB类实例化一个对象
         sqlite.open(path);                //根据指定路径打开sqlite数据库
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -230,33 +309,56 @@ void MainWindow::writeInspectionDataToJob(string path,
         //"Width","Height"字段,并将列表中数据写入到数据库中
         //2017.12.02 bob
         //添加写入检测对象的角度数据
-        sqlCreate = "CREATE TABLE MeasuredObjList(Name TEXT,PosX REAL,PosY REAL,Width REAL,Height REAL,Angle REAL);";
+        //Id为rowid的别名,作为元件的ID,VACUUM后也不会改变
+        sqlCreate = "CREATE TABLE MeasuredObjList(Id INTEGER PRIMARY KEY,Name TEXT,PosX REAL,PosY REAL,Width REAL,Height REAL,Angle REAL);";
         sqlite.execute(sqlCreate);
 
-        //4.2定义临时指针,取出MeasuredObjList中所有节点的数据,默认指向链表数据的头地址
-        MeasuredObj * pTmpObj = pInspectionData->pBoard()->pMeasuredObjList()->pHead();
+        //4.2遍历MeasuredObjList,将检测对象的数据按列取出
+        //新建的表中按链表顺序依次分配ID(1,2,3...),作为元件的ID
+        //2017.12.02 bob 添加写入检测对象的角度数据
+        MeasuredObjList<MeasuredObj> * pList = pInspectionData->pBoard()->pMeasuredObjList();
+        const size_t objCnt = (size_t)pList->size();
+        vector<int64_t> ids;
+        vector<string> names;
+        vector<double> xPos, yPos, width, height, angle;
+        ids.reserve(objCnt);
+        names.reserve(objCnt);
+        xPos.reserve(objCnt);
+        yPos.reserve(objCnt);
+        width.reserve(objCnt);
+        height.reserve(objCnt);
+        angle.reserve(objCnt);
+
+        for (MeasuredObj * pTmpObj = pList->pHead(); nullptr != pTmpObj; pTmpObj = pTmpObj->pNextMeasuredObj())
+        {
+            pTmpObj->setId((int64_t)ids.size() + 1);
+            ids.push_back(pTmpObj->id());
+            names.push_back(pTmpObj->name());
+            xPos.push_back(pTmpObj->rectangle().xPos());
+            yPos.push_back(pTmpObj->rectangle().yPos());
+            width.push_back(pTmpObj->rectangle().width());
+            height.push_back(pTmpObj->rectangle().height());
+            angle.push_back(pTmpObj->rectangle().angle());
+        }
 
-        //4.3将MeasuredObj中的数据插入到MeasuredObjList的表中
-        sqlInsert = "INSERT INTO MeasuredObjList(Name,PosX,PosY,Width,Height,Angle) VALUES(?,?,?,?,?,?);";
-        //执行插入语句
-        sqlite.prepare(sqlInsert);
-        sqlite.begin();
+        //4.3将所有检测对象批量插入到MeasuredObjList表中(一个事务,每条语句插入多行)
+        vector<string> columnNames = {"Id", "Name", "PosX", "PosY", "Width", "Height", "Angle"};
+        if(!sqlite.bulkInsert("MeasuredObjList", columnNames, ids.size(),
+                              ids.data(), names.data(),
+                              xPos.data(), yPos.data(),
+                              width.data(), height.data(), angle.data()))
+        {
+            THROW_EXCEPTION("写入检测对象失败!");
+        }
 
-        //将检测对象列表中索引数据插入到数据库的 MeasuredObjList 表中
-        //2017.12.02 bob 添加写入检测对象的角度数据
-        while (nullptr != pTmpObj)
+        //4.4插入完成后再建立元件位置的索引,供LazyJob按区域读取
+        if(!sqlite.execute(string("CREATE INDEX ") + LazyJob::POSITION_INDEX_NAME + " ON MeasuredObjList(PosX,PosY);"))
         {
-            string str = pTmpObj->name();
-            sqlite.executeWithParms(str.data(),
-                                    pTmpObj->rectangle().xPos(),
-                                    pTmpObj->rectangle().yPos(),
-                                    pTmpObj->rectangle().width(),
-                                    pTmpObj->rectangle().height(),
-                                    pTmpObj->rectangle().angle());
-            //获取下一个检测对象的地址
-            pTmpObj = pTmpObj->pNextMeasuredObj();
+            THROW_EXCEPTION("建立检测对象的位置索引失败!");
         }
-        sqlite.commit();                      //将数据列表中数据一次性写入数据库
+
+        //整个程式已写入,之前的修改记录不再需要
+        pInspectionData->pBoard()->changeTracker().clear();
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -270,9 +372,151 @@ void MainWindow::writeInspectionDataToJob(string path,
     }
 }
 
+void MainWindow::saveJobChanges(string path,
+                                InspectionData *pInspectionData)
+{
+    try
+    {
+        ChangeTracker & tracker = pInspectionData->pBoard()->changeTracker();
+        if(!tracker.isDirty())
+        {
+            return;
+        }
+
+        //文件内容即将变化,先按加载时记录的哈希值释放该文件在缓存中的检测程式(不重新计算哈希值)
+        this->m_jobCache.invalidate(path, knownContentHash(path));
+
+        //加载时旧版本只在内存中升级,保存修改需要写文件,此时才将文件就地升级到当前版本
+        this->m_jobMigrator.migrateFile(path);
+
+        //修改记录在一个事务中写入,失败时回滚,修改记录保持不变,可以再次保存
+        //最后一次编辑时间为本次保存的时间,提交成功后才更新到检测程式数据中
+        //保存后文件内容的哈希值未知(没有对应的缓存),下次加载时重新计算
+        string lastEditingTime = FormatConvertion::timeToString(time(NULL));
+        SqliteDB sqlite;
+        sqlite.open(path);
+        tracker.save(sqlite, lastEditingTime);
+        sqlite.close();
+        pInspectionData->setLastEditingTime(lastEditingTime);
+        if(pInspectionData == &this->m_inspectionData)
+        {
+            //已发布的快照只复制基本信息,元件块全部共享
+            shared_ptr<const JobSnapshot> base = this->m_jobStore.current();
+            while(base)
+            {
+                JobSnapshotEditor editor(base);
+                editor.mutableHeader().lastEditingTime = lastEditingTime;
+                if(this->m_jobStore.publishIf(base, editor.commit()))
+                {
+                    break;
+                }
+                base = this->m_jobStore.current();
+            }
+        }
+        if(path == this->m_jobPath)
+        {
+            this->m_jobContentHash = 0;
+        }
+    }
+    catch (const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+uint64_t MainWindow::knownContentHash(const string &path)
+{
+    //当前检测程式使用加载时记录的哈希值
+    if(path == this->m_jobPath)
+    {
+        return this->m_jobContentHash;
+    }
+
+    //其他文件使用目录索引中的哈希值(大小及修改时间与索引一致时才有效)
+    if(this->m_jobCatalog.isOpened())
+    {
+        vector<JobCatalogEntry> list = this->m_jobCatalog.entries();
+        for (size_t i = 0; i < list.size(); ++i)
+        {
+            if(list[i].path == path)
+            {
+                return JobCatalog::isCurrent(list[i]) ? list[i].hash : 0;
+            }
+        }
+    }
+
+    return 0;
+}
+
+void MainWindow::saveJob()
+{
+    try
+    {
+        if(this->m_jobPath.empty())
+        {
+            return;
+        }
+        saveJobChanges(this->m_jobPath, &this->m_inspectionData);
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+size_t MainWindow::importJobFromXml(const string &xmlPath,
+                                   const string &jobPath)
+{
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //先保存当前程式未保存的修改
+        //文件内容即将变化,先释放该文件在缓存中的检测程式
+        //xml中的元件直接写入检测程式文件及当前检测程式数据
+        saveJob();
+        this->m_jobCache.invalidate(jobPath, knownContentHash(jobPath));
+        this->m_jobPath.clear();
+        this->m_jobContentHash = 0;
+        XmlJobImporter importer;
+        size_t objCnt = importer.importJob(xmlPath, jobPath, &this->m_inspectionData);
+        this->m_jobPath = jobPath;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //生成元件表并发布快照,编译检测程式
+        this->m_inspectionData.pBoard()->buildComponentTable();
+        this->m_jobStore.publish(JobSnapshot::create(&this->m_inspectionData));
+        compileJob(jobPath);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        return objCnt;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+#ifdef USE_PARQUET
+size_t MainWindow::exportJobToParquet(const string &path,
+                                     const ParquetExportSetting &setting)
+{
+    try
+    {
+        ParquetExporter exporter(setting);
+        return exporter.exportComponents(this->m_inspectionData.pBoard(), path);
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+#endif
+
 void MainWindow::readInspectionDataFromJob(int objCnt,
                                            InspectionData * pInspectionData,
-                                           MeasuredObj measuredObjArr[],
                                            SqliteDB * sqlite)
 {
     try
@@ -281,66 +525,51 @@ void MainWindow::readInspectionDataFromJob(int objCnt,
         //step1
         //2017.12.02
         //读取检测程式的版本号
-        //如果检测程式的版本号与当前软件版本一致,则读取检测程式数据
-        //如果检测程式版本号是更低版本,则将低版本的程式转换为与当前软件匹配的版本
+        //只读取与当前软件版本一致的检测程式,更低版本的程式需要先通过JobMigrator升级
         //否则抛出异常
-        string selectedString = "select Version from Job";
-        sqlite->prepare(selectedString);
-        string version = sqlite->executeScalar<string>(selectedString);
-
-        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-        if("V2" != version )
+        //Job表及Board表均只有一行,各用一次查询读取所有字段
+        string version;
+        string lastEditingTime;
         {
-            if( "V1"  == version )
+            RowReader<string, string> jobReader(sqlite, "select Version,LastEditingTime from Job");
+            if(!jobReader.next(version, lastEditingTime))
             {
-                version = "V2";
-                convertJobToV2(sqlite);
-            }
-            else
-            {
-                THROW_EXCEPTION("检测程式版本有误,请确认!!");
+                THROW_EXCEPTION("读取检测程式的版本信息失败!");
             }
         }
+
+        if(this->m_jobMigrator.currentVersion() != version)
+        {
+            THROW_EXCEPTION("检测程式版本有误,请确认!!");
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         //step1.1
-        //获取检测程式的版本号
-        pInspectionData->setVersion(version);     //获取检测程式版本号
-
-        //获取检测程式的最后一次编辑时间
-        selectedString = "select LastEditingTime from Job";
-        sqlite->prepare(selectedString);
-        string lastEditingTime = sqlite->executeScalar<string>(selectedString);
+        //设置检测程式的版本号及最后一次编辑时间
+        pInspectionData->setVersion(version);
         pInspectionData->setLastEditingTime(lastEditingTime);
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         //step1.2
         //获取基板数据,(基板的名称,基板的x,y原点坐标,基板的长,基板的宽)
-        //获取基板的名称
-        selectedString = "select Name from Board";
-        sqlite->prepare(selectedString);
-        string boardName = sqlite->executeScalar<string>(selectedString);
-        pInspectionData->pBoard()->setName(boardName);
-        //获取基板原点x轴坐标
-        selectedString = "select OriginalX from Board";
-        sqlite->prepare(selectedString);
-        double originalX = sqlite->executeScalar<double>(selectedString);
-        pInspectionData->pBoard()->setOriginalX(originalX);
-        //获取基板原点y轴坐标
-        selectedString = "select OriginalY from Board";
-        sqlite->prepare(selectedString);
-        double originalY = sqlite->executeScalar<double>(selectedString);
-        pInspectionData->pBoard()->setOriginalY(originalY);
-        //获取基板的长
-        selectedString = "select SizeX from Board";
-        sqlite->prepare(selectedString);
-        double sizeX = sqlite->executeScalar<double>(selectedString);
-        pInspectionData->pBoard()->setSizeX(sizeX);
-        //获取基板的宽
-        selectedString = "select SizeY from Board";
-        sqlite->prepare(selectedString);
-        double sizeY = sqlite->executeScalar<double>(selectedString);
-        pInspectionData->pBoard()->setSizeY(sizeY);
+        {
+            string boardName;
+            double originalX = 0, originalY = 0, sizeX = 0, sizeY = 0;
+            RowReader<string, double, double, double, double> boardReader(
+                        sqlite, "select Name,OriginalX,OriginalY,SizeX,SizeY from Board");
+            if(!boardReader.next(boardName, originalX, originalY, sizeX, sizeY))
+            {
+                THROW_EXCEPTION("读取基板数据失败!");
+            }
+
+            pInspectionData->pBoard()->setName(boardName);
+            pInspectionData->pBoard()->setOriginalX(originalX);
+            pInspectionData->pBoard()->setOriginalY(originalY);
+            pInspectionData->pBoard()->setSizeX(sizeX);
+            pInspectionData->pBoard()->setSizeY(sizeY);
+        }
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -348,31 +577,41 @@ void MainWindow::readInspectionDataFromJob(int objCnt,
         //获取已检测对象的数据,具体数据如下:
         //被检查对象的名称,x,y轴坐标,宽和高
         //2017.12.02 bob 添加数据被检测对象的角度
-        selectedString = "select * from MeasuredObjList";
-        sqlite->prepare(selectedString);
+        if(objCnt <= 0)
+        {
+            return;
+        }
+
+        //根据检测程式中检测对象的数量,从board的内存池中一次性分配所有检测对象
+        MeasuredObj * measuredObjArr = pInspectionData->pBoard()->measuredObjPool().allocate(objCnt);
+
+        //rowid作为元件的ID(V3起Id列为rowid的别名,旧版本在内存中升级后读取)
+        RowReader<int64_t, string, double, double, double, double, double> objReader(
+                    sqlite, "select rowid,Name,PosX,PosY,Width,Height,Angle from MeasuredObjList");
 
-        for (int i = 0; i < objCnt; ++i)
+        int64_t id = 0;
+        string name;
+        double xPos = 0, yPos = 0, width = 0, height = 0, angle = 0;
+        int readCnt = 0;
+        while (readCnt < objCnt && objReader.next(id, name, xPos, yPos, width, height, angle))
         {
-            sqlite->step();
-            auto name  = sqlite->columnValue(0);     //检测对象的名称
-            measuredObjArr[i].setName((string)boost::get<string>(name));
-            auto xPos = sqlite->columnValue(1);      //检测对象x轴坐标
-            auto yPos = sqlite->columnValue(2);      //检测对象y轴坐标
-            auto width = sqlite->columnValue(3);     //被检测对象的宽
-            auto height = sqlite->columnValue(4);    //被检测对象的高
+            MeasuredObj & obj = measuredObjArr[readCnt];
+            obj.setId(id);
+            obj.setName(name);
             //2017.12.02  bob 添加检测对象的角度
-            auto angle = sqlite->columnValue(5);
-
-            auto rect = Rectangle((double)boost::get<double>(xPos),
-                                  (double)boost::get<double>(yPos),
-                                  (double)boost::get<double>(width),
-                                  (double)boost::get<double>(height),
-                                  (double)boost::get<double>(angle));
-            //设置检测对象的名称
-            measuredObjArr[i].setRectangle(&rect);
-            //将检测对象添加到链表的尾部
-            pInspectionData->pBoard()->pMeasuredObjList()->pushTail(&measuredObjArr[i]);
+            Rectangle rect(xPos, yPos, width, height, angle);
+            obj.setRectangle(&rect);
+            ++readCnt;
         }
+
+        if(readCnt != objCnt)
+        {
+            THROW_EXCEPTION("读取检测对象失败,读取的数量与检测程式中的数量不一致!");
+        }
+
+        //将所有检测对象一次性添加到链表的尾部
+        pInspectionData->pBoard()->pMeasuredObjList()->append(measuredObjArr,
+                                                             measuredObjArr + objCnt);
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     }
     catch(const exception &ex)
@@ -381,16 +620,149 @@ void MainWindow::readInspectionDataFromJob(int objCnt,
     }
 }
 
-//201712.02 bob
-//添加检测程式格式转换
-void MainWindow::convertJobToV2(SqliteDB *sqlite)
+bool MainWindow::loadBinaryJob(const string &binPath, uint64_t contentHash)
+{
+    BinaryJob binaryJob;
+    if(!binaryJob.open(binPath, contentHash))
+    {
+        return false;
+    }
+
+    try
+    {
+        binaryJob.loadInto(&this->m_inspectionData);
+        return true;
+    }
+    catch(const exception &ex)
+    {
+        //二进制文件已损坏: 丢弃已读取的数据,改为读取检测程式
+        cout << ex.what() << endl;
+        this->m_inspectionData.pBoard()->clearMeasuredObjs();
+        return false;
+    }
+}
+
+//2017.12.02 bob 添加检测程式格式转换
+//升级目录下所有旧版本的检测程式
+MigrationReport MainWindow::migrateJobFolder(QString path)
+{
+    try
+    {
+        MigrationReport report = this->m_jobMigrator.migrateFolder(
+                    path.toStdString(),
+                    0,
+                    [](int done, int total, const string & jobPath, bool ok)
+        {
+            cout << "[" << done << "/" << total << "] " << jobPath << (ok ? "" : "  升级失败") << endl;
+        });
+
+        cout << "检测程式:" << report.total << "\t"
+             << "已升级:" << report.migrated << "\t"
+             << "无需升级:" << report.upToDate << "\t"
+             << "失败:" << report.failed << endl;
+        for (size_t i = 0; i < report.failures.size(); ++i)
+        {
+            cout << report.failures[i].first << ": " << report.failures[i].second << endl;
+        }
+
+        return report;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//编译检测程式
+void MainWindow::compileJob(const string &jobPath)
+{
+    try
+    {
+        compileJob(jobPath, Hash::fileHash(jobPath));
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+uint64_t MainWindow::planHash(uint64_t contentHash) const
 {
-    //将检测程式的的版本号修改为"V2"
-    string sqlUpdate = "UPDATE Version SET Version='V2'" ;
-    sqlite->execute(sqlUpdate);
+    if(nullptr == this->m_pCaptureSetting)
+    {
+        return 0;
+    }
 
-    //将所有的检测对象添加Angle字段,并设置默认值为0
-    string addColumn = "ALTER TABLE MeasuredObjList ADD Angle REAL DEFAULT 0";
-    sqlite->execute(addColumn);
+    double pixelSize = this->m_pCaptureSetting->pixelSize();
+    double overlap = this->m_pCaptureSetting->fovOverlap();
+    int imgWidth = this->m_pCaptureSetting->imgWidth();
+    int imgHeight = this->m_pCaptureSetting->imgHeight();
+
+    uint64_t hash = contentHash;
+    hash = Hash::fnv1a(&pixelSize, sizeof(pixelSize), hash);
+    hash = Hash::fnv1a(&overlap, sizeof(overlap), hash);
+    hash = Hash::fnv1a(&imgWidth, sizeof(imgWidth), hash);
+    hash = Hash::fnv1a(&imgHeight, sizeof(imgHeight), hash);
+    return hash;
+}
+
+void MainWindow::compileJob(const string &jobPath, uint64_t contentHash)
+{
+    try
+    {
+        this->m_fovPlan.clear();
+        this->m_inspectionPlan.clear();
+        if(nullptr == this->m_pCaptureSetting)
+        {
+            return;
+        }
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //合并检测程式文件内容及拍照参数的哈希值,任何一项变化都需要重新编译
+        double pixelSize = this->m_pCaptureSetting->pixelSize();
+        double overlap = this->m_pCaptureSetting->fovOverlap();
+        int imgWidth = this->m_pCaptureSetting->imgWidth();
+        int imgHeight = this->m_pCaptureSetting->imgHeight();
+        uint64_t planHash = this->planHash(contentHash);
+
+        string planPath = jobPath + ".plan";
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //计划文件有效时直接读取,否则重新规划FOV,计算ROI并保存
+        if(this->m_inspectionPlan.load(planPath, planHash))
+        {
+            this->m_inspectionPlan.toFovPlan(this->m_fovPlan);
+            cout << "读取检测计划:" << planPath << endl;
+        }
+        else
+        {
+            //FOV的尺寸 = 图片尺寸 * 像素尺寸,龙门从基板原点出发
+            FovPlanner planner(this->m_pCaptureSetting->fovWidth(),
+                               this->m_pCaptureSetting->fovHeight(),
+                               overlap);
+            planner.setStartPoint(this->m_board.originalX(), this->m_board.originalY());
+            planner.plan(&this->m_board.componentTable(), this->m_fovPlan);
+
+            this->m_inspectionPlan.compile(&this->m_board.componentTable(),
+                                           this->m_fovPlan,
+                                           pixelSize,
+                                           imgWidth,
+                                           imgHeight);
+            this->m_inspectionPlan.save(planPath, planHash);
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        cout << "FOV数量:" << this->m_fovPlan.size() << "\t"
+             << "移动距离:" << this->m_fovPlan.travelDistance() << endl;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
 }
 //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -5,8 +5,22 @@
 #include <QString>
 
 #include "../sdk/DB/sqlitedb.hpp"
+#include "../sdk/DB/rowreader.hpp"
 #include "../job/inspectiondata.hpp"
+#include "../job/fovplanner.hpp"
+#include "../job/inspectionplan.hpp"
+#include "../job/jobstore.hpp"
+#include "../job/binaryjob.hpp"
+#include "../job/jobmigrator.hpp"
+#include "../job/jobcatalog.hpp"
+#include "../job/lazyjob.hpp"
+#include "../job/jobcache.hpp"
+#include "../job/xmljobimporter.hpp"
+#ifdef USE_PARQUET
+#include "../job/parquetexporter.hpp"
+#endif
 #include "./datageneration.hpp"
+#include "./capturesetting.hpp"
 
 using namespace std;
 using namespace Job;
@@ -41,6 +55,7 @@ namespace App
         /*
         *  @brief  loadJob
         *          加载检测程式(文件)
+        *          如果目录中没有检测程式文件但有之前导出的V2.xml,则通过importJobFromXml将其导入为检测程式V2
         *          如果目录中没有检测程式文件,则随机生成一个检测程式,将随机生成数据
         *              写入到xml文件中,并将数据在终端上显示
         *          如果目录中有检测程式文件,则将检测程式文件显示在终端上,供用户选择
@@ -66,6 +81,55 @@ namespace App
         void writeInspectionDataToJob(string path,
                                       InspectionData *pInspectionData);
 
+        /*
+        *  @brief   saveJobChanges
+        *           将上一次保存之后的修改增量写入到已有的检测程式文件中
+        *           只对被删除,修改及添加的元件执行DELETE,UPDATE及INSERT,并将最后一次编辑时间更新为当前时间
+        *           提交成功后检测程式数据(及当前检测程式已发布的快照)的最后一次编辑时间同步更新
+        *           所有语句在一个事务中执行,保存耗时与修改的数量成正比,与程式的大小无关
+        *           没有修改时不打开检测程式文件; 旧版本的检测程式文件在保存时才就地升级(加载时只在内存中升级)
+        *  @param   path : 检测程式文件的路径,必须是由writeInspectionDataToJob写入或已加载的程式
+        *           pInspectionData: 检测程式数据,修改记录取自board的changeTracker
+        *  @return  N/A
+        */
+        void saveJobChanges(string path,
+                            InspectionData *pInspectionData);
+
+        /*
+        *  @brief   saveJob
+        *           将当前检测程式的修改(board的changeTracker)保存到其检测程式文件中(见saveJobChanges)
+        *           loadJob加载其他程式之前自动调用,未加载检测程式或没有修改时不执行任何操作
+        *  @param   N/A
+        *  @return  N/A
+        */
+        void saveJob();
+
+        /*
+        *  @brief   importJobFromXml
+        *           将导出的xml文件(writeInspectionDataToXml的格式)导入为检测程式文件,并作为当前检测程式
+        *           xml通过XmlJobImporter流式读取,元件按批写入检测程式及当前检测程式数据,不建立文档树
+        *           所有元件都读入当前检测程式数据(成为当前检测程式),内存占用与元件数量成正比(O(N)),
+        *               与xml文件的大小无关; 只生成检测程式文件时直接使用XmlJobImporter(pInspectionData为空)
+        *           导入后生成元件表,发布快照并编译检测程式,与loadJob加载后的状态一致
+        *  @param   xmlPath : xml文件的路径
+        *           jobPath : 检测程式文件的路径,已存在时被替换
+        *  @return  导入的元件数量
+        */
+        size_t importJobFromXml(const string & xmlPath,
+                                const string & jobPath);
+
+#ifdef USE_PARQUET
+        /*
+        *  @brief   exportJobToParquet
+        *           将当前检测程式的所有元件按列导出为Parquet文件(见ParquetExporter)
+        *  @param   path : Parquet文件的路径
+        *           setting : RowGroup的行数及压缩格式
+        *  @return  导出的元件数量
+        */
+        size_t exportJobToParquet(const string & path,
+                                  const ParquetExportSetting & setting = ParquetExportSetting());
+#endif
+
         /*
         *  @brief  readInspectionDataFromJob
         *           从检测程式中读取数据,具体数据信息如下:
@@ -73,26 +137,93 @@ namespace App
         *           检测程式对应基板的名称,原点x ,y坐标,及长和宽
         *           基板中所有检查对象的名称,x,y轴坐标,及长和宽
         *           //2017.12.02 添加读取检测对象的角度
+        *           检测对象从board的内存池中一次性分配
+        *           只读取当前版本的检测程式,旧版本需要先通过JobMigrator升级(文件或内存数据库)
         *  @param   size: 文件中 measuredObj(检测对象)的数量
         *           pInspectionData : 指向存放检测程式数据的头指针
-        *           measuredObjArr : 存放检测对象数据的数组
         *           sqlite : 检测程式文件的地址(即读取已打开的检测程式中的数据)
         *  @return  N/A
         */
         void readInspectionDataFromJob(int objCnt,
                                        InspectionData * pInspectionData,
-                                       MeasuredObj measuredObjArr[],
                                        SqliteDB *sqlite);
 
         /*
-        *  @brief  convertJobToV2
-        *          将V1版本的检测程式转换成V2
-        *          将检测程式的版本信息改写为V2
-        *          将所有的检测对象添加angle,并设置为默认值0
-        *  @param  sqlite:需要转换成V2版本的检测程式
+        *  @brief  loadBinaryJob
+        *          二进制检测程式存在且格式正确时,通过mmap将其读取到当前检测程式数据中
+        *          二进制文件以检测程式内容的哈希值命名(见JobCache::blobPath),文件头中记录的哈希值也必须一致
+        *  @param  binPath:二进制检测程式的路径
+        *          contentHash:检测程式内容的哈希值
+        *  @return true:已从二进制文件读取; false:需要从检测程式文件读取
+        */
+        bool loadBinaryJob(const string & binPath, uint64_t contentHash);
+
+        /*
+        *  @brief  migrateJobFolder
+        *          将目录下所有旧版本的检测程式就地升级到当前版本(多线程),并在终端上显示进度
+        *          显式的批量操作(会修改文件),启动及加载时都不自动执行,加载时旧版本只在内存中升级
+        *  @param  path:检测程式目录
+        *  @return 升级结果
+        */
+        MigrationReport migrateJobFolder(QString path);
+
+        /*
+        *  @brief  compileJob
+        *          编译当前加载的检测程式: 根据CaptureSetting(图片尺寸,像素尺寸,重叠量)生成拍照计划,
+        *              并计算每个FOV内所有元件的像素ROI
+        *          编译结果保存在检测程式旁边的 <检测程式>.plan 文件中,
+        *              检测程式内容及拍照参数都未变化时直接读取该文件,不再重新计算
+        *          没有设置CaptureSetting时不编译
+        *  @param  jobPath:检测程式文件的路径
+        *          contentHash:检测程式文件内容的哈希值(已知时传入,不再重新计算)
         *  @return N/A
         */
-        void convertJobToV2(SqliteDB * sqlite);
+        void compileJob(const string & jobPath);
+        void compileJob(const string & jobPath, uint64_t contentHash);
+
+        //检测程式内容及拍照参数合并后的哈希值,任何一项变化都需要重新编译; 没有设置CaptureSetting时为0
+        uint64_t planHash(uint64_t contentHash) const;
+
+        //检测程式文件当前内容的哈希值,不读取文件: 当前检测程式取加载时记录的值,其他文件取目录索引中的值; 未知时为0
+        uint64_t knownContentHash(const string & path);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //访存函数
+        //获取当前加载的检测程式数据,loadJob返回后依然有效,直到下一次loadJob
+        InspectionData & inspectionData(){return this->m_inspectionData;}
+
+        //设置拍照参数,加载检测程式后根据该参数生成拍照计划
+        void setCaptureSetting(CaptureSetting * pCaptureSetting){this->m_pCaptureSetting = pCaptureSetting;}
+
+        //获取当前检测程式的拍照计划
+        FovPlan & fovPlan(){return this->m_fovPlan;}
+
+        //获取当前检测程式编译后的检测计划
+        InspectionPlan & inspectionPlan(){return this->m_inspectionPlan;}
+
+        //获取检测程式快照的发布者,检测线程通过JobSnapshotReader(&jobStore())读取当前检测程式
+        //加载检测程式时发布完整的快照,之后board的编辑函数通过JobSnapshotEditor及publishIf增量发布
+        JobStore & jobStore(){return this->m_jobStore;}
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        //当前加载的检测程式,检测对象的内存由m_board中的内存池持有
+        InspectionData m_inspectionData;
+        Board m_board;
+        MeasuredObjList<MeasuredObj> m_measuredObjList;
+
+        CaptureSetting * m_pCaptureSetting{nullptr};    //拍照参数
+        FovPlan m_fovPlan;                              //当前检测程式的拍照计划
+        InspectionPlan m_inspectionPlan;                //当前检测程式编译后的检测计划
+        JobStore m_jobStore;                            //当前检测程式的只读快照
+        JobMigrator m_jobMigrator;                      //检测程式格式的升级链
+        JobCatalog m_jobCatalog;                        //检测程式目录的索引
+        JobCache m_jobCache;                            //以检测程式内容哈希值为键的已加载检测程式缓存
+        string m_jobPath;                               //当前检测程式文件的路径,未加载时为空
+        uint64_t m_jobContentHash{0};                   //当前检测程式加载时文件内容的哈希值,0表示未知(如已保存修改)
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     };
 }  //End of namespace App
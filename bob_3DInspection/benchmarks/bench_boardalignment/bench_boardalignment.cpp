@@ -0,0 +1,55 @@
+#include <cstdio>
+#include <random>
+
+#include "benchmark.hpp"
+#include "job/boardalignment.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK;
+
+//每块基板的校正耗时:4个Mark点求解变换(solve)及变换所有元件(apply)
+//apply使用RectangleKernel::supportedIsa()的指令集,第一次apply之后不再分配内存
+int main()
+{
+    const char * isaNames[] = {"SCALAR", "SSE2", "AVX2"};
+    printf("supported isa: %s\n", isaNames[RectangleKernel::supportedIsa()]);
+    printf("%10s %12s %12s %14s\n", "count", "solve(ms)", "apply(ms)", "ns/component");
+
+    const double fiducials[][4] = {{5, 5, 5.31, 4.62}, {245, 8, 245.36, 9.06}, {240, 195, 238.97, 195.94}, {10, 190, 8.92, 189.62}};
+    mt19937 engine(11);
+    uniform_real_distribution<double> pos(0, 250), size(0.2, 5), angle(-180, 180);
+
+    for (int cnt : {10000, 100000, 1000000})
+    {
+        ComponentTable table;
+        table.reserve(cnt);
+        for (int i = 0; i < cnt; ++i)
+        {
+            Rectangle rect(pos(engine), pos(engine), size(engine), size(engine), angle(engine));
+            table.append("c", rect);
+        }
+
+        BoardAlignment alignment;
+        double solveMs = Benchmark::measureMs([&]()
+        {
+            alignment.clearFiducials();
+            for (const auto & fiducial : fiducials)
+            {
+                alignment.addFiducial(fiducial[0], fiducial[1], fiducial[2], fiducial[3]);
+            }
+            alignment.solve();
+        }, 20);
+
+        //第一次apply分配内存,之后每块基板重复使用
+        alignment.apply(&table);
+        double applyMs = Benchmark::measureMs([&]()
+        {
+            alignment.apply(&table);
+            Benchmark::doNotOptimize(alignment.xPos()[0]);
+        }, 20);
+
+        printf("%10d %12.4f %12.4f %14.2f\n", cnt, solveMs, applyMs, applyMs * 1e6 / cnt);
+    }
+    return 0;
+}
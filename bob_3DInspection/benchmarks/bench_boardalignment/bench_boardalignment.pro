@@ -0,0 +1,15 @@
+include(../benchmark.pri)
+include($$SRC_DIR/sdk/simd.pri)
+
+TARGET = bench_boardalignment
+
+SOURCES += \
+    bench_boardalignment.cpp \
+    $$SRC_DIR/sdk/customexception.cpp \
+    $$SRC_DIR/sdk/formatconvertion.cpp \
+    $$SRC_DIR/sdk/rectangle.cpp \
+    $$SRC_DIR/sdk/affinetransform.cpp \
+    $$SRC_DIR/sdk/rectanglekernel.cpp \
+    $$SRC_DIR/job/measuredobj.cpp \
+    $$SRC_DIR/job/componenttable.cpp \
+    $$SRC_DIR/job/boardalignment.cpp
@@ -0,0 +1,118 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <random>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "benchmark.hpp"
+#include "sdk/chunkedwriter.hpp"
+#include "sdk/formatconvertion.hpp"
+
+using namespace std;
+using namespace SSDK;
+
+namespace
+{
+    const char * OUT_PATH = "bench_chunkedwriter.out";
+
+    struct Component
+    {
+        double xPos, yPos, width, height, angle;
+    };
+
+    //与元件导出相同的一行: <MeasuredObj Name="c<i>" PosX=".." PosY=".." Width=".." Height=".." Angle=".."/>
+    void formatComponents(const vector<Component> & components, size_t begin, size_t end, string & buffer)
+    {
+        char number[FormatConvertion::MAX_NUMBER_LENGTH];
+        buffer.reserve((end - begin) * 110);
+        for (size_t i = begin; i < end; ++i)
+        {
+            const Component & c = components[i];
+            buffer += "    <MeasuredObj Name=\"c";
+            buffer.append(number, FormatConvertion::intToChars((int64_t)i, number));
+            buffer += "\" PosX=\"";
+            buffer.append(number, FormatConvertion::doubleToChars(c.xPos, number));
+            buffer += "\" PosY=\"";
+            buffer.append(number, FormatConvertion::doubleToChars(c.yPos, number));
+            buffer += "\" Width=\"";
+            buffer.append(number, FormatConvertion::doubleToChars(c.width, number));
+            buffer += "\" Height=\"";
+            buffer.append(number, FormatConvertion::doubleToChars(c.height, number));
+            buffer += "\" Angle=\"";
+            buffer.append(number, FormatConvertion::doubleToChars(c.angle, number));
+            buffer += "\"/>\n";
+        }
+    }
+}
+
+//ChunkedWriter按线程数的加速比: 100万个元件格式化为xml行并写入文件
+//serial为调用线程格式化及写入(不使用ChunkedWriter)的基准
+//加速比只在多核机器上有意义,单核时多线程只能让格式化与写入交替进行
+int main()
+{
+    const unsigned cores = std::thread::hardware_concurrency();
+    printf("hardware threads: %u\n", cores);
+    if(cores <= 1)
+    {
+        printf("WARNING: single core, the thread counts below cannot show a parallel speedup\n");
+    }
+
+    const size_t cnt = 1000000;
+    vector<Component> components(cnt);
+    mt19937 engine(22);
+    uniform_real_distribution<double> pos(0, 250), size(0.2, 5), angle(-180, 180);
+    for (size_t i = 0; i < cnt; ++i)
+    {
+        components[i] = Component{pos(engine), pos(engine), size(engine), size(engine), angle(engine)};
+    }
+
+    int fd = ::open(OUT_PATH, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0)
+    {
+        printf("cannot open %s\n", OUT_PATH);
+        return 1;
+    }
+    auto rewind = [fd]()
+    {
+        if(0 != ::ftruncate(fd, 0) || ::lseek(fd, 0, SEEK_SET) < 0)
+        {
+            printf("cannot truncate %s\n", OUT_PATH);
+        }
+    };
+
+    double serialMs = Benchmark::measureMs([&]()
+    {
+        rewind();
+        string buffer;
+        formatComponents(components, 0, cnt, buffer);
+        ChunkedWriter::writeAll(fd, &buffer, 1);
+    });
+    off_t fileSize = ::lseek(fd, 0, SEEK_CUR);
+    printf("%10s %12s %10s %10s\n", "threads", "ms", "MB/s", "speedup");
+    printf("%10s %12.1f %10.1f %10.2f\n", "serial", serialMs, fileSize / 1e3 / serialMs, 1.0);
+
+    vector<int> threadCounts = {1, 2, 4, 8, 16};
+    if(cores > 16)
+    {
+        threadCounts.push_back((int)cores);
+    }
+    for (size_t i = 0; i < threadCounts.size(); ++i)
+    {
+        ChunkedWriter writer(threadCounts[i]);
+        double ms = Benchmark::measureMs([&]()
+        {
+            rewind();
+            writer.write(fd, cnt, [&](size_t begin, size_t end, string & buffer)
+            {
+                formatComponents(components, begin, end, buffer);
+            });
+        });
+        printf("%10d %12.1f %10.1f %10.2f\n", threadCounts[i], ms, fileSize / 1e3 / ms, serialMs / ms);
+    }
+
+    ::close(fd);
+    ::unlink(OUT_PATH);
+    return 0;
+}
@@ -0,0 +1,9 @@
+include(../benchmark.pri)
+
+TARGET = bench_chunkedwriter
+
+SOURCES += \
+    bench_chunkedwriter.cpp \
+    $$SRC_DIR/sdk/customexception.cpp \
+    $$SRC_DIR/sdk/formatconvertion.cpp \
+    $$SRC_DIR/sdk/chunkedwriter.cpp
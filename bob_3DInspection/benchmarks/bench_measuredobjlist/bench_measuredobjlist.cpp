@@ -0,0 +1,95 @@
+#include <cstdio>
+#include <vector>
+#include <string>
+
+#include "benchmark.hpp"
+#include "job/measuredobjlist.hpp"
+#include "job/measuredobjpool.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//按readInspectionDataFromJob的方式加载cnt个元件:
+//    从内存池一次分配所有对象,逐个设置名称及位置,再链接到链表
+//    bulk为true时使用append一次链接,否则逐个pushTail
+double loadMs(int cnt, bool bulk)
+{
+    return Benchmark::measureMs([cnt, bulk]()
+    {
+        MeasuredObjPool<MeasuredObj> pool;
+        MeasuredObjList<MeasuredObj> list;
+        MeasuredObj * measuredObjArr = pool.allocate(cnt);
+        for (int i = 0; i < cnt; ++i)
+        {
+            Rectangle rect(i * 0.5, i * 0.25, 1.0, 0.5, 0);
+            measuredObjArr[i].setRectangle(&rect);
+            measuredObjArr[i].setName("ic" + to_string(i));
+            if(!bulk)
+            {
+                list.pushTail(&measuredObjArr[i]);
+            }
+        }
+        if(bulk)
+        {
+            list.append(measuredObjArr, measuredObjArr + cnt);
+        }
+        Benchmark::doNotOptimize(list.pTail());
+    }, 3);
+}
+
+//只测链表操作:cnt个对象逐个pushTail,再逐个pullTail
+double pushPullMs(vector<MeasuredObj> & objs, int cnt)
+{
+    return Benchmark::measureMs([&objs, cnt]()
+    {
+        MeasuredObjList<MeasuredObj> list;
+        for (int i = 0; i < cnt; ++i)
+        {
+            list.pushTail(&objs[i]);
+        }
+        while (list.size() > 0)
+        {
+            list.pullTail();
+        }
+        Benchmark::doNotOptimize(list.pHead());
+    });
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//输出每个规模下加载的总耗时及每个元件的耗时(ns)
+//加载为线性时,每个元件的耗时不随元件数量增长;
+//1M元件的单个耗时超过10K元件的4倍(允许缓存未命中带来的差异)时认为不是线性,返回1
+int main()
+{
+    const int counts[] = {1000, 10000, 100000, 1000000};
+    vector<MeasuredObj> objs(1000000);
+
+    printf("%10s %14s %14s %14s %14s %14s %14s\n",
+           "count", "append(ms)", "ns/obj", "pushTail(ms)", "ns/obj", "push+pull(ms)", "ns/obj");
+
+    double nsPerObj10K = 0, nsPerObj1M = 0;
+    for (int cnt : counts)
+    {
+        double appendMs = loadMs(cnt, true);
+        double pushTailMs = loadMs(cnt, false);
+        double listMs = pushPullMs(objs, cnt);
+        printf("%10d %14.3f %14.1f %14.3f %14.1f %14.3f %14.1f\n",
+               cnt,
+               appendMs, appendMs * 1e6 / cnt,
+               pushTailMs, pushTailMs * 1e6 / cnt,
+               listMs, listMs * 1e6 / cnt);
+
+        if(10000 == cnt)
+        {
+            nsPerObj10K = pushTailMs * 1e6 / cnt;
+        }
+        nsPerObj1M = pushTailMs * 1e6 / cnt;
+    }
+
+    bool isLinear = nsPerObj1M < 4 * nsPerObj10K;
+    printf("pushTail load: %.1f ns/obj at 10K, %.1f ns/obj at 1M -> %s\n",
+           nsPerObj10K, nsPerObj1M, isLinear ? "linear" : "NOT linear");
+    return isLinear ? 0 : 1;
+}
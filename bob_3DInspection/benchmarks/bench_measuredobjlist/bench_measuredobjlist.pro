@@ -0,0 +1,10 @@
+include(../benchmark.pri)
+
+TARGET = bench_measuredobjlist
+
+SOURCES += \
+    bench_measuredobjlist.cpp \
+    $$SRC_DIR/sdk/customexception.cpp \
+    $$SRC_DIR/sdk/formatconvertion.cpp \
+    $$SRC_DIR/sdk/rectangle.cpp \
+    $$SRC_DIR/job/measuredobj.cpp
@@ -0,0 +1,138 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <functional>
+
+#include "benchmark.hpp"
+#include "sdk/rectanglekernel.hpp"
+
+using namespace std;
+using namespace SSDK;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//测试数据:cnt个随机的旋转矩形(列式存储)
+struct Rects
+{
+    vector<double> xPos, yPos, width, height, angle;
+
+    explicit Rects(int cnt)
+    {
+        mt19937 engine(2026);
+        uniform_real_distribution<double> pos(0, 500), size(0.2, 5), rotation(-180, 180);
+        for (int i = 0; i < cnt; ++i)
+        {
+            this->xPos.push_back(pos(engine));
+            this->yPos.push_back(pos(engine));
+            this->width.push_back(size(engine));
+            this->height.push_back(size(engine));
+            this->angle.push_back(rotation(engine));
+        }
+    }
+
+    RectangleArray array() const
+    {
+        RectangleArray rects;
+        rects.xPos = this->xPos.data();
+        rects.yPos = this->yPos.data();
+        rects.width = this->width.data();
+        rects.height = this->height.data();
+        rects.angle = this->angle.data();
+        rects.size = (int)this->xPos.size();
+        return rects;
+    }
+};
+
+//直接调用std::cos/std::sin的外接矩形,作为未使用批量运算时的参考
+void naiveBounds(const Rects & rects, double * minX, double * minY, double * maxX, double * maxY)
+{
+    const double degToRad = 3.14159265358979323846 / 180.0;
+    for (size_t i = 0; i < rects.xPos.size(); ++i)
+    {
+        double c = std::fabs(std::cos(rects.angle[i] * degToRad));
+        double s = std::fabs(std::sin(rects.angle[i] * degToRad));
+        double halfX = 0.5 * (rects.width[i] * c + rects.height[i] * s);
+        double halfY = 0.5 * (rects.width[i] * s + rects.height[i] * c);
+        minX[i] = rects.xPos[i] - halfX;
+        maxX[i] = rects.xPos[i] + halfX;
+        minY[i] = rects.yPos[i] - halfY;
+        maxY[i] = rects.yPos[i] + halfY;
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//对100K个矩形执行每种运算,输出各指令集的吞吐量(百万个/秒)及相对标量实现的加速比
+int main()
+{
+    const int cnt = 100000;
+    Rects rects(cnt);
+    Rects others(cnt);
+    RectangleArray array = rects.array();
+    RectangleArray otherArray = others.array();
+
+    vector<double> out0(4 * cnt), out1(4 * cnt), out2(cnt), out3(cnt);
+    vector<unsigned char> mask(cnt);
+    AffineTransform transform(0.9999, -0.0141, 0.0141, 0.9999, 0.12, -0.08);
+    Rectangle probe(250, 250, 60, 40, 15);
+
+    //各运算,参数为指令集
+    vector<pair<const char *, function<void(RectangleKernel::Isa)>>> ops;
+    ops.push_back(make_pair("corners", [&](RectangleKernel::Isa isa)
+    {
+        RectangleKernel::corners(array, out0.data(), out1.data(), isa);
+    }));
+    ops.push_back(make_pair("bounds", [&](RectangleKernel::Isa isa)
+    {
+        RectangleKernel::bounds(array, out0.data(), out1.data(), out2.data(), out3.data(), isa);
+    }));
+    ops.push_back(make_pair("unionBounds", [&](RectangleKernel::Isa isa)
+    {
+        double minX, minY, maxX, maxY;
+        RectangleKernel::unionBounds(array, minX, minY, maxX, maxY, isa);
+        Benchmark::doNotOptimize(minX);
+    }));
+    ops.push_back(make_pair("contains", [&](RectangleKernel::Isa isa)
+    {
+        RectangleKernel::contains(array, 250, 250, mask.data(), isa);
+    }));
+    ops.push_back(make_pair("overlaps(pair)", [&](RectangleKernel::Isa isa)
+    {
+        RectangleKernel::overlaps(array, otherArray, mask.data(), isa);
+    }));
+    ops.push_back(make_pair("overlaps(one)", [&](RectangleKernel::Isa isa)
+    {
+        RectangleKernel::overlaps(probe, array, mask.data(), isa);
+    }));
+    ops.push_back(make_pair("transform", [&](RectangleKernel::Isa isa)
+    {
+        RectangleKernel::transform(array, transform, out0.data(), out1.data(), out2.data(), isa);
+    }));
+
+    const char * isaNames[] = {"SCALAR", "SSE2", "AVX2"};
+    printf("%d rectangles, supported isa: %s\n", cnt, isaNames[RectangleKernel::supportedIsa()]);
+    printf("%-16s %-8s %10s %12s %10s\n", "op", "isa", "time(ms)", "Mrect/s", "speedup");
+
+    double naiveMs = Benchmark::measureMs([&]()
+    {
+        naiveBounds(rects, out0.data(), out1.data(), out2.data(), out3.data());
+    }, 20);
+    printf("%-16s %-8s %10.3f %12.1f %10s\n", "bounds", "std::cos", naiveMs, cnt / naiveMs / 1e3, "-");
+
+    for (const auto & op : ops)
+    {
+        double scalarMs = 0;
+        for (int isa = RectangleKernel::SCALAR; isa <= RectangleKernel::supportedIsa(); ++isa)
+        {
+            double ms = Benchmark::measureMs([&]()
+            {
+                op.second((RectangleKernel::Isa)isa);
+            }, 20);
+            if(RectangleKernel::SCALAR == isa)
+            {
+                scalarMs = ms;
+            }
+            printf("%-16s %-8s %10.3f %12.1f %9.2fx\n", op.first, isaNames[isa], ms, cnt / ms / 1e3, scalarMs / ms);
+        }
+    }
+    return 0;
+}
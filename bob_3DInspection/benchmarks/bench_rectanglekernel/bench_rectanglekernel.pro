@@ -0,0 +1,11 @@
+include(../benchmark.pri)
+include($$SRC_DIR/sdk/simd.pri)
+
+TARGET = bench_rectanglekernel
+
+SOURCES += \
+    bench_rectanglekernel.cpp \
+    $$SRC_DIR/sdk/customexception.cpp \
+    $$SRC_DIR/sdk/rectangle.cpp \
+    $$SRC_DIR/sdk/affinetransform.cpp \
+    $$SRC_DIR/sdk/rectanglekernel.cpp
@@ -0,0 +1,235 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "benchmark.hpp"
+#include "sdk/DB/sqlitedb.hpp"
+#include "sdk/DB/rowreader.hpp"
+
+using namespace std;
+using namespace SSDK::DB;
+
+namespace
+{
+    const char * DB_PATH = "bench_rowreader.job";
+    const char * SQL_OBJ = "select rowid,Name,PosX,PosY,Width,Height,Angle from MeasuredObjList";
+
+    //建立与检测程式相同的Job,Board及MeasuredObjList表,MeasuredObjList中有cnt个元件
+    void createJob(int cnt)
+    {
+        std::remove(DB_PATH);
+        SqliteDB sqlite;
+        sqlite.open(DB_PATH);
+        sqlite.execute("CREATE TABLE Job(Version TEXT,LastEditingTime TEXT);");
+        sqlite.execute("INSERT INTO Job VALUES('V2','2026-10-17 12:00:00');");
+        sqlite.execute("CREATE TABLE Board(Name TEXT,OriginalX REAL,OriginalY REAL,SizeX REAL,SizeY REAL);");
+        sqlite.execute("INSERT INTO Board VALUES('board',0.5,0.25,300.0,200.0);");
+        sqlite.execute("CREATE TABLE MeasuredObjList(Id INTEGER PRIMARY KEY,Name TEXT,PosX REAL,PosY REAL,Width REAL,Height REAL,Angle REAL);");
+        sqlite.begin();
+        string sqlInsert = "INSERT INTO MeasuredObjList(Name,PosX,PosY,Width,Height,Angle) VALUES(?,?,?,?,?,?);";
+        sqlite.prepare(sqlInsert);
+        for (int i = 0; i < cnt; ++i)
+        {
+            string name = "ic" + to_string(i);
+            sqlite.executeWithParms(name.data(), i * 0.5 + 0.1, i * 0.25 + 0.1, 1.5, 0.75, (double)(i % 4) * 90);
+        }
+        sqlite.commit();
+    }
+
+    //只执行sqlite3_step,不读取任何列:两种读取方式共同的开销
+    double stepOnlyMs(SqliteDB & sqlite)
+    {
+        return Benchmark::measureMs([&sqlite]()
+        {
+            RowReader<> reader(&sqlite, SQL_OBJ);
+            int cnt = 0;
+            while (reader.next())
+            {
+                ++cnt;
+            }
+            Benchmark::doNotOptimize(cnt);
+        }, 11);
+    }
+
+    //原来的读取方式:prepare后逐行step,每列通过columnValue取得boost::variant再boost::get
+    double columnValueMs(SqliteDB & sqlite, int cnt)
+    {
+        return Benchmark::measureMs([&sqlite, cnt]()
+        {
+            string sql = SQL_OBJ;
+            sqlite.prepare(sql);
+            double sum = 0;
+            for (int i = 0; i < cnt; ++i)
+            {
+                sqlite.step();
+                auto id = sqlite.columnValue(0);
+                int64_t rowId = boost::get<int>(id);
+                auto name = sqlite.columnValue(1);
+                string str = (string)boost::get<string>(name);
+                auto xPos = sqlite.columnValue(2);
+                auto yPos = sqlite.columnValue(3);
+                auto width = sqlite.columnValue(4);
+                auto height = sqlite.columnValue(5);
+                auto angle = sqlite.columnValue(6);
+                sum += rowId + str.size()
+                        + (double)boost::get<double>(xPos) + (double)boost::get<double>(yPos)
+                        + (double)boost::get<double>(width) + (double)boost::get<double>(height)
+                        + (double)boost::get<double>(angle);
+            }
+            Benchmark::doNotOptimize(sum);
+        }, 11);
+    }
+
+    //RowReader:每列直接通过sqlite3_column_xxx写入调用者的变量
+    double rowReaderMs(SqliteDB & sqlite)
+    {
+        return Benchmark::measureMs([&sqlite]()
+        {
+            RowReader<int64_t, string, double, double, double, double, double> reader(&sqlite, SQL_OBJ);
+            int64_t rowId = 0;
+            string str;
+            double xPos = 0, yPos = 0, width = 0, height = 0, angle = 0;
+            double sum = 0;
+            while (reader.next(rowId, str, xPos, yPos, width, height, angle))
+            {
+                sum += rowId + str.size() + xPos + yPos + width + height + angle;
+            }
+            Benchmark::doNotOptimize(sum);
+        }, 11);
+    }
+
+    //直接调用sqlite3_column_xxx的循环:解码开销的下限,RowReader应与之相同
+    double rawColumnMs(SqliteDB & sqlite)
+    {
+        return Benchmark::measureMs([&sqlite]()
+        {
+            sqlite3_stmt * pStatement = nullptr;
+            sqlite3_prepare_v2(sqlite.dbHandle(), SQL_OBJ, -1, &pStatement, nullptr);
+            string str;
+            double sum = 0;
+            while (SQLITE_ROW == sqlite3_step(pStatement))
+            {
+                int64_t rowId = sqlite3_column_int64(pStatement, 0);
+                const char * pText = reinterpret_cast<const char *>(sqlite3_column_text(pStatement, 1));
+                str.assign(pText, sqlite3_column_bytes(pStatement, 1));
+                sum += rowId + str.size()
+                        + sqlite3_column_double(pStatement, 2) + sqlite3_column_double(pStatement, 3)
+                        + sqlite3_column_double(pStatement, 4) + sqlite3_column_double(pStatement, 5)
+                        + sqlite3_column_double(pStatement, 6);
+            }
+            sqlite3_finalize(pStatement);
+            Benchmark::doNotOptimize(sum);
+        }, 11);
+    }
+
+    //Job及Board表:原来每个字段一次prepare+executeScalar(7次),RowReader每个表一次查询
+    double headerScalarMs(SqliteDB & sqlite, int repeat)
+    {
+        return Benchmark::measureMs([&sqlite, repeat]()
+        {
+            double sum = 0;
+            for (int i = 0; i < repeat; ++i)
+            {
+                const char * stringFields[] = {"select Version from Job", "select LastEditingTime from Job", "select Name from Board"};
+                const char * doubleFields[] = {"select OriginalX from Board", "select OriginalY from Board",
+                                               "select SizeX from Board", "select SizeY from Board"};
+                for (const char * field : stringFields)
+                {
+                    string sql = field;
+                    sqlite.prepare(sql);
+                    sum += sqlite.executeScalar<string>(sql).size();
+                }
+                for (const char * field : doubleFields)
+                {
+                    string sql = field;
+                    sqlite.prepare(sql);
+                    sum += sqlite.executeScalar<double>(sql);
+                }
+            }
+            Benchmark::doNotOptimize(sum);
+        }, 11);
+    }
+
+    double headerRowReaderMs(SqliteDB & sqlite, int repeat)
+    {
+        return Benchmark::measureMs([&sqlite, repeat]()
+        {
+            double sum = 0;
+            for (int i = 0; i < repeat; ++i)
+            {
+                string version, lastEditingTime, boardName;
+                double originalX = 0, originalY = 0, sizeX = 0, sizeY = 0;
+                {
+                    RowReader<string, string> jobReader(&sqlite, "select Version,LastEditingTime from Job");
+                    jobReader.next(version, lastEditingTime);
+                }
+                {
+                    RowReader<string, double, double, double, double> boardReader(
+                                &sqlite, "select Name,OriginalX,OriginalY,SizeX,SizeY from Board");
+                    boardReader.next(boardName, originalX, originalY, sizeX, sizeY);
+                }
+                sum += version.size() + lastEditingTime.size() + boardName.size() + originalX + originalY + sizeX + sizeY;
+            }
+            Benchmark::doNotOptimize(sum);
+        }, 11);
+    }
+}
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//比较readInspectionDataFromJob原来的columnValue读取方式与RowReader
+//每行的解码开销 = 总耗时 - 只执行sqlite3_step的耗时
+//原来的连接以默认(串行化)模式打开,每次sqlite3_column_xxx都要加锁及解锁连接的互斥量;
+//loadJob现在以SQLITE_OPEN_NOMUTEX打开只在当前线程使用的连接,两种模式分别测量
+int main(int argc, char * argv[])
+{
+    const int cnt = argc > 1 ? atoi(argv[1]) : 150000;
+    createJob(cnt);
+
+    printf("MeasuredObjList, %d rows (rowid, name, 5 reals)\n", cnt);
+    printf("%-24s %12s %12s %16s\n", "", "total(ms)", "ns/row", "decode ns/row");
+
+    const int flags[] = {SQLITE_OPEN_READONLY, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX};
+    const char * modes[] = {"", " NOMUTEX"};
+    double oldDecodeNs = 0, newDecodeNs = 0, rawDecodeNs = 0;
+    for (int mode = 0; mode < 2; ++mode)
+    {
+        SqliteDB sqlite;
+        sqlite.open(DB_PATH, flags[mode]);
+
+        double stepMs = stepOnlyMs(sqlite);
+        double oldMs = columnValueMs(sqlite, cnt);
+        double newMs = rowReaderMs(sqlite);
+        double rawMs = rawColumnMs(sqlite);
+
+        printf("%-24s %12.3f %12.1f %16s\n", (string("step only") + modes[mode]).c_str(), stepMs, stepMs * 1e6 / cnt, "-");
+        printf("%-24s %12.3f %12.1f %16.1f\n", (string("columnValue") + modes[mode]).c_str(), oldMs, oldMs * 1e6 / cnt, (oldMs - stepMs) * 1e6 / cnt);
+        printf("%-24s %12.3f %12.1f %16.1f\n", (string("RowReader") + modes[mode]).c_str(), newMs, newMs * 1e6 / cnt, (newMs - stepMs) * 1e6 / cnt);
+        printf("%-24s %12.3f %12.1f %16.1f\n", (string("sqlite3_column") + modes[mode]).c_str(), rawMs, rawMs * 1e6 / cnt, (rawMs - stepMs) * 1e6 / cnt);
+
+        if(0 == mode)
+        {
+            oldDecodeNs = (oldMs - stepMs) * 1e6 / cnt;
+        }
+        else
+        {
+            newDecodeNs = (newMs - stepMs) * 1e6 / cnt;
+            rawDecodeNs = (rawMs - stepMs) * 1e6 / cnt;
+        }
+        sqlite.close();
+    }
+    printf("decode: columnValue -> RowReader NOMUTEX %.2fx (direct sqlite3_column_xxx loop: %.2fx)\n",
+           oldDecodeNs / newDecodeNs, oldDecodeNs / rawDecodeNs);
+
+    SqliteDB sqlite;
+    sqlite.open(DB_PATH, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX);
+    const int repeat = 1000;
+    double scalarMs = headerScalarMs(sqlite, repeat);
+    double readerMs = headerRowReaderMs(sqlite, repeat);
+    printf("Job+Board header x%d: 7 executeScalar %.3f ms, 2 RowReader %.3f ms (%.2fx)\n",
+           repeat, scalarMs, readerMs, scalarMs / readerMs);
+    sqlite.close();
+
+    std::remove(DB_PATH);
+    return 0;
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,9 @@
+include(../benchmark.pri)
+
+TARGET = bench_rowreader
+
+SOURCES += \
+    bench_rowreader.cpp \
+    $$SRC_DIR/sdk/DB/blob.cpp \
+    $$SRC_DIR/sdk/DB/sqlitedb.cpp \
+    $$SRC_DIR/sdk/DB/statement.cpp
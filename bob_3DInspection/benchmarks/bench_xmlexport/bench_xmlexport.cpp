@@ -0,0 +1,154 @@
+#include <cstdio>
+#include <string>
+#include <random>
+#include <thread>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <QFile>
+#include <QTextStream>
+#include <QDomDocument>
+
+#include "benchmark.hpp"
+#include "job/inspectiondata.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK;
+
+namespace
+{
+    const char * QDOM_PATH = "bench_xmlexport_qdom.xml";
+    const char * STREAM_PATH = "bench_xmlexport_stream.xml";
+
+    //检测程式数据,board的检测对象链表及inspectionData的board指向本结构中的成员
+    struct JobData
+    {
+        MeasuredObjList<MeasuredObj> list;
+        Board board;
+        InspectionData inspectionData;
+
+        JobData()
+        {
+            this->board.setMeasurdObjList(&this->list);
+            this->inspectionData.setBoard(&this->board);
+        }
+    };
+
+    //生成cnt个元件(名称为C0,C1,...),位置,大小及角度随机
+    void fillJob(JobData & job, int cnt)
+    {
+        job.inspectionData.setVersion("V3");
+        job.inspectionData.setLastEditingTime("2026/10/17 12:0:0");
+        job.board.setName("board");
+        job.board.setSizeX(250);
+        job.board.setSizeY(250);
+
+        mt19937 engine(21);
+        uniform_real_distribution<double> pos(0, 250), size(0.2, 5), angle(-180, 180);
+        MeasuredObj * measuredObjArr = job.board.measuredObjPool().allocate(cnt);
+        for (int i = 0; i < cnt; ++i)
+        {
+            measuredObjArr[i].setId(i + 1);
+            measuredObjArr[i].setName("C" + to_string(i));
+            Rectangle rect(pos(engine), pos(engine), size(engine), size(engine), angle(engine));
+            measuredObjArr[i].setRectangle(&rect);
+        }
+        job.list.append(measuredObjArr, measuredObjArr + cnt);
+    }
+
+    //原来的导出(改为XmlStreamWriter之前的InspectionData/Board::writeBoardDataToXml):
+    //先在内存中建立整个QDomDocument,再按4格缩进保存
+    void writeWithQDom(JobData & job, const QString & path)
+    {
+        QDomDocument inspectionData;
+        QDomElement jobInfo = inspectionData.createElement("Job");
+        jobInfo.setAttribute("版本号", QString::fromStdString(job.inspectionData.version()));
+        jobInfo.setAttribute("上次编辑时间", QString::fromStdString(job.inspectionData.lastEditingTime()));
+        inspectionData.appendChild(jobInfo);
+
+        QDomElement board = inspectionData.createElement("Board");
+        board.setAttribute("基板名称", QString::fromStdString(job.board.name()));
+        board.setAttribute("基板长度", job.board.sizeX());
+        board.setAttribute("基板宽度", job.board.sizeY());
+        board.setAttribute("X轴坐标", job.board.originalX());
+        board.setAttribute("Y轴坐标", job.board.originalY());
+        jobInfo.appendChild(board);
+
+        for (MeasuredObj * pTmpObj = job.list.pHead(); pTmpObj != nullptr; pTmpObj = pTmpObj->pNextMeasuredObj())
+        {
+            QDomElement measuredObj = inspectionData.createElement(QString::fromStdString(pTmpObj->name()));
+            measuredObj.setAttribute("X轴坐标", QString::number(pTmpObj->rectangle().xPos()));
+            measuredObj.setAttribute("Y轴坐标", QString::number(pTmpObj->rectangle().yPos()));
+            measuredObj.setAttribute("元件宽度", QString::number(pTmpObj->rectangle().width()));
+            measuredObj.setAttribute("元件高度", QString::number(pTmpObj->rectangle().height()));
+            measuredObj.setAttribute("元件角度", QString::number(pTmpObj->rectangle().angle()));
+            board.appendChild(measuredObj);
+        }
+
+        QFile file(path);
+        if (!file.open(QFile::WriteOnly | QFile::Text))
+        {
+            printf("cannot open %s\n", QDOM_PATH);
+            return;
+        }
+        QTextStream out(&file);
+        inspectionData.save(out, 4);
+        file.close();
+    }
+
+    //单线程的流式导出(与writeInspectionDataToXml相同,只是固定线程数)
+    void writeWithStream(JobData & job, const string & path, int threadCount)
+    {
+        XmlStreamWriter writer(4);
+        writer.open(path);
+        writer.writeStartElement("Job");
+        writer.writeAttribute("版本号", job.inspectionData.version());
+        writer.writeAttribute("上次编辑时间", job.inspectionData.lastEditingTime());
+        job.board.writeBoardDataToXml(writer, threadCount);
+        writer.writeEndElement();
+        writer.close();
+    }
+
+    long long fileSize(const char * path)
+    {
+        struct stat st;
+        return 0 == ::stat(path, &st) ? (long long)st.st_size : -1;
+    }
+}
+
+//10万个元件导出为xml: 原来的QDomDocument导出与XmlStreamWriter流式导出的耗时
+//stream 1为单线程流式导出,与QDom的比较不受核数影响;
+//stream default为writeInspectionDataToXml(按核数格式化元件行)
+//两个文件的大小应相同(内容相同,Qt5的QDom属性顺序可能不同)
+int main()
+{
+    const unsigned cores = std::thread::hardware_concurrency();
+    printf("hardware threads: %u\n", cores);
+
+    const int cnt = 100000;
+    JobData job;
+    fillJob(job, cnt);
+
+    double qdomMs = Benchmark::measureMs([&]()
+    {
+        writeWithQDom(job, QDOM_PATH);
+    });
+    double streamMs = Benchmark::measureMs([&]()
+    {
+        writeWithStream(job, STREAM_PATH, 1);
+    });
+    double defaultMs = Benchmark::measureMs([&]()
+    {
+        job.inspectionData.writeInspectionDataToXml(STREAM_PATH);
+    });
+
+    printf("%16s %12s %12s %10s\n", "export", "ms", "bytes", "speedup");
+    printf("%16s %12.1f %12lld %10.2f\n", "qdom", qdomMs, fileSize(QDOM_PATH), 1.0);
+    printf("%16s %12.1f %12lld %10.2f\n", "stream 1", streamMs, fileSize(STREAM_PATH), qdomMs / streamMs);
+    printf("%16s %12.1f %12lld %10.2f\n", "stream default", defaultMs, fileSize(STREAM_PATH), qdomMs / defaultMs);
+
+    ::unlink(QDOM_PATH);
+    ::unlink(STREAM_PATH);
+    return 0;
+}
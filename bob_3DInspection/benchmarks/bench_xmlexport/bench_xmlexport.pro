@@ -0,0 +1,27 @@
+include(../benchmark.pri)
+include($$SRC_DIR/sdk/simd.pri)
+#基准为原来的QDomDocument导出,需要QtXml
+QT += xml
+
+TARGET = bench_xmlexport
+
+SOURCES += \
+    bench_xmlexport.cpp \
+    $$SRC_DIR/sdk/customexception.cpp \
+    $$SRC_DIR/sdk/formatconvertion.cpp \
+    $$SRC_DIR/sdk/rectangle.cpp \
+    $$SRC_DIR/sdk/affinetransform.cpp \
+    $$SRC_DIR/sdk/rectanglekernel.cpp \
+    $$SRC_DIR/sdk/xmlstreamwriter.cpp \
+    $$SRC_DIR/sdk/chunkedwriter.cpp \
+    $$SRC_DIR/sdk/DB/blob.cpp \
+    $$SRC_DIR/sdk/DB/sqlitedb.cpp \
+    $$SRC_DIR/sdk/DB/statement.cpp \
+    $$SRC_DIR/job/measuredobj.cpp \
+    $$SRC_DIR/job/componenttable.cpp \
+    $$SRC_DIR/job/spatialindex.cpp \
+    $$SRC_DIR/job/changetracker.cpp \
+    $$SRC_DIR/job/board.cpp \
+    $$SRC_DIR/job/inspectiondata.cpp \
+    $$SRC_DIR/job/jobsnapshot.cpp \
+    $$SRC_DIR/job/jobstore.cpp
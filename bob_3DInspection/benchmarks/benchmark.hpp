@@ -0,0 +1,41 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+#include <limits>
+
+namespace Benchmark
+{
+    /*
+    *  @brief  measureMs
+    *          执行func共repeat次,返回最短的一次耗时(毫秒)
+    *          取最短值可以排除调度及缓存预热的干扰
+    *  @param  func:被测的函数(无参数)
+    *          repeat:执行次数
+    *  @return 最短耗时(毫秒)
+    */
+    template<class Func>
+    double measureMs(Func func, int repeat = 5)
+    {
+        double best = std::numeric_limits<double>::max();
+        for (int i = 0; i < repeat; ++i)
+        {
+            auto begin = std::chrono::steady_clock::now();
+            func();
+            auto end = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::milli>(end - begin).count());
+        }
+        return best;
+    }
+
+    //防止编译器把只计算不使用的结果优化掉
+    template<class T>
+    inline void doNotOptimize(const T & value)
+    {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+}   //End of namespace Benchmark
+
+#endif // BENCHMARK_HPP
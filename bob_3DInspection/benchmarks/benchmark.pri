@@ -0,0 +1,19 @@
+#所有性能测试共用的配置,被测源文件的路径相对于3DInspection.pro所在的目录(SRC_DIR)
+CONFIG += console c++11 release
+CONFIG -= app_bundle
+QT += core
+QT -= gui
+
+SRC_DIR = $$PWD/..
+
+INCLUDEPATH += $$SRC_DIR
+INCLUDEPATH += $$SRC_DIR/include
+INCLUDEPATH += $$PWD
+
+HEADERS += \
+    $$PWD/benchmark.hpp
+
+unix::LIBS += -L$$SRC_DIR/lib/ -lsqlite3
+
+unix:LIBS += -L/usr/lib/x86_64-linux-gnu\
+-ldl -lpthread
@@ -0,0 +1,12 @@
+#性能测试,每个子项目生成一个独立的可执行程序
+#在Release下编译后直接运行,结果输出到终端:
+#    qmake benchmarks.pro && make && ./bench_measuredobjlist/bench_measuredobjlist
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    bench_boardalignment \
+    bench_chunkedwriter \
+    bench_measuredobjlist \
+    bench_rectanglekernel \
+    bench_rowreader \
+    bench_xmlexport
@@ -0,0 +1,277 @@
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "binaryjob.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK;
+
+const uint32_t BinaryJob::FILE_MAGIC;
+const uint32_t BinaryJob::FILE_VERSION;
+
+namespace
+{
+    //将字符串追加到字符串表,返回其偏移及长度
+    void appendString(vector<char> & table, const string & str, uint32_t & offset, uint32_t & length)
+    {
+        offset = (uint32_t)table.size();
+        length = (uint32_t)str.size();
+        table.insert(table.end(), str.begin(), str.end());
+    }
+
+    //判断[offset,offset+length)是否在字符串表内
+    bool inRange(uint64_t offset, uint64_t length, uint64_t size)
+    {
+        return offset <= size && length <= size - offset;
+    }
+}
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//构造 & 析构函数
+BinaryJob::BinaryJob()
+{
+    this->m_pData = nullptr;
+    this->m_size = 0;
+}
+
+BinaryJob::~BinaryJob()
+{
+    this->close();
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//成员函数
+void BinaryJob::write(const string &path, InspectionData *pInspectionData, uint64_t sourceHash)
+{
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //生成基板数据,元件记录及字符串表
+        Board * pBoard = pInspectionData->pBoard();
+        vector<char> strings;
+
+        BinaryBoardBlock board;
+        board.originalX = pBoard->originalX();
+        board.originalY = pBoard->originalY();
+        board.sizeX = pBoard->sizeX();
+        board.sizeY = pBoard->sizeY();
+        appendString(strings, pBoard->name(), board.nameOffset, board.nameLength);
+        appendString(strings, pInspectionData->version(), board.versionOffset, board.versionLength);
+        appendString(strings, pInspectionData->lastEditingTime(), board.lastEditingTimeOffset, board.lastEditingTimeLength);
+
+        vector<BinaryComponentRecord> records;
+        records.reserve(pBoard->pMeasuredObjList()->size());
+        for (MeasuredObj * pObj = pBoard->pMeasuredObjList()->pHead(); nullptr != pObj; pObj = pObj->pNextMeasuredObj())
+        {
+            BinaryComponentRecord record;
+            record.id = pObj->id();
+            record.xPos = pObj->rectangle().xPos();
+            record.yPos = pObj->rectangle().yPos();
+            record.width = pObj->rectangle().width();
+            record.height = pObj->rectangle().height();
+            record.angle = pObj->rectangle().angle();
+            appendString(strings, pObj->name(), record.nameOffset, record.nameLength);
+            records.push_back(record);
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //计算各段的偏移,各结构的大小都是8的倍数,映射后可以直接按结构访问
+        BinaryJobHeader header;
+        header.magic = FILE_MAGIC;
+        header.version = FILE_VERSION;
+        header.recordSize = sizeof(BinaryComponentRecord);
+        header.componentCount = (uint32_t)records.size();
+        header.boardOffset = sizeof(BinaryJobHeader);
+        header.componentOffset = header.boardOffset + sizeof(BinaryBoardBlock);
+        header.stringOffset = header.componentOffset + records.size() * sizeof(BinaryComponentRecord);
+        header.fileSize = header.stringOffset + strings.size();
+        header.sourceHash = sourceHash;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step3
+        //先写入临时文件,写完后再替换原文件
+        string tmpPath = path + ".tmp";
+        ofstream file(tmpPath.c_str(), ios::out | ios::binary | ios::trunc);
+        if(!file.is_open())
+        {
+            THROW_EXCEPTION("打开文件失败!!");
+        }
+
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(&board), sizeof(board));
+        if(!records.empty())
+        {
+            file.write(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(BinaryComponentRecord));
+        }
+        if(!strings.empty())
+        {
+            file.write(strings.data(), strings.size());
+        }
+        file.close();
+        if(file.fail())
+        {
+            THROW_EXCEPTION("写入二进制检测程式失败!!");
+        }
+
+        std::remove(path.c_str());
+        if(0 != std::rename(tmpPath.c_str(), path.c_str()))
+        {
+            THROW_EXCEPTION("保存二进制检测程式失败!!");
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+bool BinaryJob::open(const string &path, uint64_t sourceHash)
+{
+    try
+    {
+        this->close();
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //只读映射整个文件,映射建立后即可关闭文件描述符
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+        {
+            return false;
+        }
+
+        struct stat st;
+        if(0 != ::fstat(fd, &st) || st.st_size < (off_t)sizeof(BinaryJobHeader))
+        {
+            ::close(fd);
+            return false;
+        }
+
+        void * pData = ::mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if(MAP_FAILED == pData)
+        {
+            return false;
+        }
+
+        this->m_pData = static_cast<const unsigned char *>(pData);
+        this->m_size = (size_t)st.st_size;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //校验文件头,各段的范围及源文件的哈希值,不符合时解除映射
+        //源文件的内容变化后哈希值不同,即使二进制文件的修改时间更新也不会被读取
+        const BinaryJobHeader & header = this->header();
+        bool valid = FILE_MAGIC == header.magic &&
+                     FILE_VERSION == header.version &&
+                     sourceHash == header.sourceHash &&
+                     sizeof(BinaryComponentRecord) == header.recordSize &&
+                     this->m_size == header.fileSize &&
+                     sizeof(BinaryJobHeader) == header.boardOffset &&
+                     header.boardOffset + sizeof(BinaryBoardBlock) == header.componentOffset &&
+                     header.componentOffset + (uint64_t)header.componentCount * header.recordSize == header.stringOffset &&
+                     header.stringOffset <= header.fileSize;
+        if(!valid)
+        {
+            this->close();
+            return false;
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        return true;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void BinaryJob::close()
+{
+    if(nullptr != this->m_pData)
+    {
+        ::munmap(const_cast<unsigned char *>(this->m_pData), this->m_size);
+    }
+    this->m_pData = nullptr;
+    this->m_size = 0;
+}
+
+void BinaryJob::loadInto(InspectionData *pInspectionData) const
+{
+    try
+    {
+        if(!this->isOpened())
+        {
+            THROW_EXCEPTION("二进制检测程式尚未打开!");
+        }
+
+        const uint64_t stringSize = this->header().fileSize - this->header().stringOffset;
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //读取检测程式及基板的基本信息
+        const BinaryBoardBlock & board = this->board();
+        if(!inRange(board.nameOffset, board.nameLength, stringSize) ||
+           !inRange(board.versionOffset, board.versionLength, stringSize) ||
+           !inRange(board.lastEditingTimeOffset, board.lastEditingTimeLength, stringSize))
+        {
+            THROW_EXCEPTION("二进制检测程式的字符串表已损坏!");
+        }
+
+        Board * pBoard = pInspectionData->pBoard();
+        pInspectionData->setVersion(std::string(this->text(board.versionOffset), board.versionLength));
+        pInspectionData->setLastEditingTime(std::string(this->text(board.lastEditingTimeOffset), board.lastEditingTimeLength));
+        pBoard->setName(std::string(this->text(board.nameOffset), board.nameLength));
+        pBoard->setOriginalX(board.originalX);
+        pBoard->setOriginalY(board.originalY);
+        pBoard->setSizeX(board.sizeX);
+        pBoard->setSizeY(board.sizeY);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //从映射的元件记录直接生成检测对象,一次性分配并链接到链表尾部
+        const int cnt = this->componentCount();
+        if(cnt <= 0)
+        {
+            return;
+        }
+
+        MeasuredObj * measuredObjArr = pBoard->measuredObjPool().allocate(cnt);
+        const BinaryComponentRecord * pRecords = this->components();
+        for (int i = 0; i < cnt; ++i)
+        {
+            const BinaryComponentRecord & record = pRecords[i];
+            if(!inRange(record.nameOffset, record.nameLength, stringSize))
+            {
+                THROW_EXCEPTION("二进制检测程式的字符串表已损坏!");
+            }
+
+            measuredObjArr[i].setId(record.id);
+            measuredObjArr[i].setName(std::string(this->text(record.nameOffset), record.nameLength));
+            Rectangle rect(record.xPos, record.yPos, record.width, record.height, record.angle);
+            measuredObjArr[i].setRectangle(&rect);
+        }
+        pBoard->pMeasuredObjList()->append(measuredObjArr, measuredObjArr + cnt);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,160 @@
+#ifndef BINARYJOB_HPP
+#define BINARYJOB_HPP
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+#include "../sdk/customexception.hpp"
+#include "inspectiondata.hpp"
+
+namespace Job
+{
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //二进制检测程式的文件结构,所有结构按字节直接写入文件,映射后原地读取
+    //文件依次为: 文件头 | 基板数据 | 元件记录(定长) | 字符串表
+    //字符串以(偏移,长度)记录,偏移相对字符串表的起始位置
+
+    //文件头
+    struct BinaryJobHeader
+    {
+        uint32_t magic;             //文件标识
+        uint32_t version;           //文件格式版本
+        uint32_t recordSize;        //每条元件记录的字节数
+        uint32_t componentCount;    //元件的数量
+        uint64_t boardOffset;       //基板数据的偏移
+        uint64_t componentOffset;   //元件记录的偏移
+        uint64_t stringOffset;      //字符串表的偏移
+        uint64_t fileSize;          //文件的总字节数
+        uint64_t sourceHash;        //生成该文件的sqlite检测程式内容的哈希值(Hash::fileHash)
+    };
+
+    //基板数据
+    struct BinaryBoardBlock
+    {
+        double originalX;                   //基板原点X轴坐标
+        double originalY;                   //基板原点Y轴坐标
+        double sizeX;                       //基板的长
+        double sizeY;                       //基板的宽
+        uint32_t nameOffset;                //基板名称
+        uint32_t nameLength;
+        uint32_t versionOffset;             //检测程式的版本
+        uint32_t versionLength;
+        uint32_t lastEditingTimeOffset;     //最后一次编辑时间
+        uint32_t lastEditingTimeLength;
+    };
+
+    //元件记录
+    struct BinaryComponentRecord
+    {
+        int64_t id;                 //元件的ID(MeasuredObjList表中的rowid)
+        double xPos;                //元件中心X轴坐标
+        double yPos;                //元件中心Y轴坐标
+        double width;               //元件的宽
+        double height;              //元件的高
+        double angle;               //元件的角度
+        uint32_t nameOffset;        //元件名称
+        uint32_t nameLength;
+    };
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    /**
+     *  @brief BinaryJob
+     *         检测程式的二进制格式(<检测程式>.bin),与sqlite格式的检测程式内容一致,用于快速换线
+     *         open通过mmap映射整个文件,元件记录及字符串直接在映射的内存中读取,不做任何解析
+     *         sqlite检测程式仍是唯一的源文件,二进制文件只是由其生成的缓存
+     *         文件头记录源文件内容的哈希值,open时与当前源文件的哈希值比较,不依赖文件的修改时间
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class BinaryJob
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //常量
+        static const uint32_t FILE_MAGIC = 0x4A494433;      //"3DIJ"
+        static const uint32_t FILE_VERSION = 2;             //2:文件头增加sourceHash
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        BinaryJob();
+
+        //解除文件映射
+        ~BinaryJob();
+
+        BinaryJob(const BinaryJob &) = delete;
+        BinaryJob & operator=(const BinaryJob &) = delete;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        /*
+        *  @brief  write
+        *          将检测程式写入二进制文件
+        *          先写入临时文件再替换原文件,中途失败不会留下不完整的文件
+        *  @param  path:二进制文件的路径
+        *          pInspectionData:检测程式数据,元件取自board的检测对象链表
+        *          sourceHash:读取检测程式数据的sqlite检测程式内容的哈希值
+        *  @return N/A
+        */
+        static void write(const std::string & path, InspectionData * pInspectionData, uint64_t sourceHash);
+
+        /*
+        *  @brief  open
+        *          只读映射二进制文件,并校验文件头,各段的范围及源文件的哈希值
+        *  @param  path:二进制文件的路径
+        *          sourceHash:当前sqlite检测程式内容的哈希值
+        *  @return true:映射成功; false:文件不存在,格式版本不符,文件不完整或不是由当前内容的检测程式生成
+        */
+        bool open(const std::string & path, uint64_t sourceHash);
+
+        //解除文件映射
+        void close();
+
+        /*
+        *  @brief  loadInto
+        *          将映射的检测程式复制到检测程式数据中
+        *          检测对象从board的内存池中一次性分配,调用前需要先clearMeasuredObjs
+        *  @param  pInspectionData:检测程式数据
+        *  @return N/A
+        */
+        void loadInto(InspectionData * pInspectionData) const;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //访存函数(只在open成功后有效,指向映射的内存)
+        bool isOpened() const {return nullptr != this->m_pData;}
+
+        const BinaryJobHeader & header() const {return *reinterpret_cast<const BinaryJobHeader *>(this->m_pData);}
+
+        const BinaryBoardBlock & board() const
+        {
+            return *reinterpret_cast<const BinaryBoardBlock *>(this->m_pData + this->header().boardOffset);
+        }
+
+        int componentCount() const {return (int)this->header().componentCount;}
+
+        const BinaryComponentRecord * components() const
+        {
+            return reinterpret_cast<const BinaryComponentRecord *>(this->m_pData + this->header().componentOffset);
+        }
+
+        //字符串表中偏移为offset的字符串(不以'\0'结尾,长度见对应的Length字段)
+        const char * text(uint32_t offset) const
+        {
+            return reinterpret_cast<const char *>(this->m_pData + this->header().stringOffset + offset);
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        const unsigned char * m_pData;      //映射的文件内容
+        size_t m_size;                      //映射的字节数
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace Job
+
+#endif // BINARYJOB_HPP
@@ -1,4 +1,5 @@
 #include "board.hpp"
+#include "jobstore.hpp"
 
 
 using namespace std;
@@ -14,6 +15,9 @@ Board::Board()
     this->m_sizeY = 0;
     this->m_originalX = 0;
     this->m_originalX = 0;
+    this->m_pMeasuredObjList = nullptr;
+    this->m_componentTableDirty = false;
+    this->m_pJobStore = nullptr;
 }
 
 Board::~Board()
@@ -25,7 +29,7 @@ Board::~Board()
 
 //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 //成员函数
-void Board::writeBoardDataToXml(QDomDocument inspectionData,QDomElement jobInfo)
+void Board::writeBoardDataToXml(SSDK::XmlStreamWriter &writer, int threadCount)
 {
     try
     {
@@ -33,51 +37,48 @@ void Board::writeBoardDataToXml(QDomDocument inspectionData,QDomElement jobInfo)
         //step1
         //在xml文档中添加一个board节点
         //设置board节点的属性(基板名称,基板长度,基板宽度,x轴原点坐标,y轴原点坐标)
-        //将board节点添加到jobInfo节点下
-        QDomElement board = inspectionData.createElement("Board");
-        //设置board元素的属性
-        board.setAttribute("基板名称",QString::fromStdString( this->name()));
-        board.setAttribute("基板长度",this->sizeX());
-        board.setAttribute("基板宽度",this->sizeY());
-        board.setAttribute("X轴坐标",this->originalX());
-        board.setAttribute("Y轴坐标",this->originalY());
-
-        //将board元素添加至jobInfo节点下
-        jobInfo.appendChild(board);
+        //基板的尺寸按QDomElement::setAttribute(double)的精度(16位有效数字)写入
+        writer.writeStartElement("Board");
+        writer.writeAttribute("基板名称", this->name());
+        writer.writeAttribute("基板长度", this->sizeX(), 16);
+        writer.writeAttribute("基板宽度", this->sizeY(), 16);
+        writer.writeAttribute("X轴坐标", this->originalX(), 16);
+        writer.writeAttribute("Y轴坐标", this->originalY(), 16);
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         //step2
-        //定义一个临时对象指针,指向列表中所有检测对象的地址,获取列表中检测对象数据
-        MeasuredObj * pTmpObj = this->m_pMeasuredObjList->pHead();
+        //按链表顺序取出所有检测对象的地址,供各线程按索引号分块读取
+        vector<MeasuredObj *> measuredObjs;
+        measuredObjs.reserve(this->m_pMeasuredObjList->size());
+        for (MeasuredObj * pTmpObj = this->m_pMeasuredObjList->pHead(); pTmpObj != nullptr; pTmpObj = pTmpObj->pNextMeasuredObj())
+        {
+            measuredObjs.push_back(pTmpObj);
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-        //当链表的临时指针不为nullptr时
-        //将列表中检测对象的名称添加到xml文档的节点下
-        //设置元件的属性(x,y坐标,高度,宽度)
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step3
+        //将检测对象的名称作为元素写入board节点下
+        //设置元件的属性(x,y坐标,高度,宽度),格式与QString::number一致
         //2017.12.02 bob
         //添加元件的角度属性写入到xml文件中
-        while (pTmpObj != nullptr)
+        writer.writeChunked(SSDK::ChunkedWriter(threadCount),
+                            measuredObjs.size(),
+                            [&measuredObjs](SSDK::XmlStreamWriter & fragment, size_t index)
         {
-            //在inspectionData文档中添加元素 measuredObj(元素为元件名称)
-            QDomElement measuredObj = inspectionData.createElement(QString::fromStdString(pTmpObj->name()));
-
-            //设置元件名称的属性(x,y轴坐标,角度,长和宽)
-            QString str = QString::number(pTmpObj->rectangle().xPos());
-            measuredObj.setAttribute("X轴坐标",str);
-            str = QString::number(pTmpObj->rectangle().yPos());
-            measuredObj.setAttribute("Y轴坐标",str);
-            str = QString::number(pTmpObj->rectangle().width());
-            measuredObj.setAttribute("元件宽度",str);
-            str = QString::number(pTmpObj->rectangle().height());
-            measuredObj.setAttribute("元件高度",str);
+            MeasuredObj * pObj = measuredObjs[index];
+            const SSDK::Rectangle & rect = pObj->rectangle();
+            fragment.writeStartElement(pObj->name());
+            fragment.writeAttribute("X轴坐标", rect.xPos());
+            fragment.writeAttribute("Y轴坐标", rect.yPos());
+            fragment.writeAttribute("元件宽度", rect.width());
+            fragment.writeAttribute("元件高度", rect.height());
             //2017.12.02 bob
-            str = QString::number(pTmpObj->rectangle().angle());
-            measuredObj.setAttribute("元件角度",str);
-            //将 measuredObj中的元素添加到board节点下
-            board.appendChild(measuredObj);
-            //获取下一个节点的地址
-            pTmpObj = pTmpObj->pNextMeasuredObj();
-        }
+            fragment.writeAttribute("元件角度", rect.angle());
+            fragment.writeEndElement();
+        });
+        writer.writeEndElement();
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     }
     catch(const exception &ex)
@@ -85,4 +86,173 @@ void Board::writeBoardDataToXml(QDomDocument inspectionData,QDomElement jobInfo)
         THROW_EXCEPTION(ex.what());
     }
 }
+
+void Board::buildComponentTable()
+{
+    try
+    {
+        if(nullptr == this->m_pMeasuredObjList)
+        {
+            THROW_EXCEPTION("检测对象链表为空,无法生成元件表!");
+        }
+        this->m_componentTable.loadFromList(this->m_pMeasuredObjList);
+        this->m_spatialIndex.build(&this->m_componentTable);
+        this->m_componentTableDirty = false;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void Board::clearMeasuredObjs()
+{
+    //先断开链表,再释放内存池,避免链表中残留失效的地址
+    if(nullptr != this->m_pMeasuredObjList)
+    {
+        this->m_pMeasuredObjList->clear();
+    }
+    this->m_spatialIndex.clear();
+    this->m_componentTable.clear();
+    this->m_changeTracker.clear();
+    this->m_measuredObjPool.clear();
+    this->m_componentTableDirty = false;
+}
+
+MeasuredObj *Board::addMeasuredObj(const string &name, const SSDK::Rectangle &rectangle)
+{
+    try
+    {
+        if(nullptr == this->m_pMeasuredObjList)
+        {
+            THROW_EXCEPTION("检测对象链表为空,无法添加检测对象!");
+        }
+
+        this->publishEdit(this->m_pMeasuredObjList->size(), [&](JobSnapshotEditor & editor)
+        {
+            editor.appendComponent(name, rectangle);
+        });
+
+        MeasuredObj * pMeasuredObj = this->m_measuredObjPool.allocate(1);
+        SSDK::Rectangle rect = rectangle;
+        pMeasuredObj->setName(name);
+        pMeasuredObj->setRectangle(&rect);
+        pMeasuredObj->setId(0);
+
+        this->m_pMeasuredObjList->pushTail(pMeasuredObj);
+        this->m_changeTracker.markAdded(pMeasuredObj);
+        this->m_componentTableDirty = true;
+
+        return pMeasuredObj;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void Board::updateMeasuredObj(MeasuredObj *pMeasuredObj, const SSDK::Rectangle &rectangle)
+{
+    try
+    {
+        if(nullptr != this->m_pJobStore && nullptr != this->m_pMeasuredObjList)
+        {
+            int index = this->indexOf(pMeasuredObj);
+            this->publishEdit(this->m_pMeasuredObjList->size(), [&](JobSnapshotEditor & editor)
+            {
+                editor.setComponent(index, pMeasuredObj->name(), rectangle);
+            });
+        }
+
+        SSDK::Rectangle rect = rectangle;
+        pMeasuredObj->setRectangle(&rect);
+        this->m_changeTracker.markModified(pMeasuredObj);
+        this->m_componentTableDirty = true;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void Board::removeMeasuredObj(MeasuredObj *pMeasuredObj)
+{
+    try
+    {
+        if(nullptr == this->m_pMeasuredObjList)
+        {
+            THROW_EXCEPTION("检测对象链表为空,无法删除检测对象!");
+        }
+
+        if(nullptr != this->m_pJobStore)
+        {
+            int index = this->indexOf(pMeasuredObj);
+            this->publishEdit(this->m_pMeasuredObjList->size(), [index](JobSnapshotEditor & editor)
+            {
+                editor.removeComponent(index);
+            });
+        }
+
+        this->m_pMeasuredObjList->remove(pMeasuredObj);
+        this->m_changeTracker.markDeleted(pMeasuredObj);
+        this->m_componentTableDirty = true;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+int Board::indexOf(MeasuredObj *pMeasuredObj)
+{
+    int index = 0;
+    for (MeasuredObj * pTmpObj = this->m_pMeasuredObjList->pHead(); pTmpObj != nullptr; pTmpObj = pTmpObj->pNextMeasuredObj())
+    {
+        if(pTmpObj == pMeasuredObj)
+        {
+            return index;
+        }
+        ++index;
+    }
+
+    THROW_EXCEPTION("检测对象不在链表中!");
+}
+
+void Board::publishEdit(int objCnt, const function<void(JobSnapshotEditor &)> &edit)
+{
+    try
+    {
+        if(nullptr == this->m_pJobStore)
+        {
+            return;
+        }
+
+        //step1
+        //基于当前快照编辑,当前快照未被其他编辑替换时发布
+        //其他编辑(如只修改基本信息)先发布时,基于新的当前快照重新编辑
+        while(true)
+        {
+            shared_ptr<const JobSnapshot> base = this->m_pJobStore->current();
+            if(!base)
+            {
+                return;
+            }
+            if(base->size() != objCnt)
+            {
+                THROW_EXCEPTION("当前快照的元件数量与检测对象链表不一致,快照不是由该基板生成的!");
+            }
+
+            JobSnapshotEditor editor(base);
+            edit(editor);
+            if(this->m_pJobStore->publishIf(base, editor.commit()))
+            {
+                return;
+            }
+        }
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
 //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
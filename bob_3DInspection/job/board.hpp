@@ -1,11 +1,16 @@
 #ifndef BOARD_HPP
 #define BOARD_HPP
 
-#include <QDomDocument>
 #include <QFile>
 #include <QTextStream>
+#include <functional>
 
+#include "../sdk/xmlstreamwriter.hpp"
 #include "measuredobjlist.hpp"
+#include "measuredobjpool.hpp"
+#include "componenttable.hpp"
+#include "spatialindex.hpp"
+#include "changetracker.hpp"
 
 #define SIZE 50
 
@@ -13,6 +18,9 @@ using namespace std;
 
 namespace Job
 {
+    class JobStore;
+    class JobSnapshotEditor;
+
     /**
      *  @brief Board
      *         设置&获取一个board(基板)信息,具体信息如下:
@@ -37,12 +45,67 @@ namespace Job
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         //成员函数,将PCB信息输出值XML文件
         /*
-        *  @brief  writeToXml
-        *          将PCB数据写入至指定路径的xml文件中
-        *  @param  path:将数据写入文件的路径
+        *  @brief  writeBoardDataToXml
+        *          将PCB数据(Board元素及其下所有元件元素)流式写入xml文件的当前元素(Job)下
+        *          元件按块分配到多个线程格式化,按链表顺序写入
+        *  @param  writer:已打开的xml写入器
+        *          threadCount:格式化元件的线程数,小于等于0时使用CPU核数
         *  @return  N/A
         */
-        void writeBoardDataToXml(QDomDocument inspectionData, QDomElement jobInfo);
+        void writeBoardDataToXml(SSDK::XmlStreamWriter & writer, int threadCount = 0);
+
+        /*
+        *  @brief  buildComponentTable
+        *          根据检测对象链表重新生成列式存储的元件表,并重新建立元件的空间索引
+        *          加载或生成程式(直接写入链表)后需要调用该函数同步元件表
+        *          通过下面的编辑函数修改链表时,元件表在下一次访问时自动重新生成
+        *  @param  N/A
+        *  @return N/A
+        */
+        void buildComponentTable();
+
+        /*
+        *  @brief  clearMeasuredObjs
+        *          清空检测对象链表,元件表,并释放检测对象内存池
+        *          重新加载程式之前调用
+        *  @param  N/A
+        *  @return N/A
+        */
+        void clearMeasuredObjs();
+
+        /*
+        *  @brief  addMeasuredObj
+        *          从内存池中分配一个检测对象,添加到链表的尾部,并记录为新添加的元件
+        *          设置了快照发布者时,先在当前快照的末尾添加该元件并发布(见publishEdit)
+        *  @param  name:元件的名称
+        *          rectangle:元件的X,Y坐标,宽,高及角度
+        *  @return 新添加的检测对象
+        */
+        MeasuredObj * addMeasuredObj(const string & name, const SSDK::Rectangle & rectangle);
+
+        /*
+        *  @brief  updateMeasuredObj
+        *          修改检测对象的位置,尺寸及角度,并记录为被修改的元件
+        *          设置了快照发布者时,先修改当前快照中对应的元件并发布
+        *  @param  pMeasuredObj:链表中的检测对象
+        *          rectangle:元件新的X,Y坐标,宽,高及角度
+        *  @return N/A
+        */
+        void updateMeasuredObj(MeasuredObj * pMeasuredObj, const SSDK::Rectangle & rectangle);
+
+        /*
+        *  @brief  removeMeasuredObj
+        *          将检测对象从链表中删除,并记录为被删除的元件
+        *          检测对象的内存仍由内存池持有,直到clearMeasuredObjs
+        *          设置了快照发布者时,先删除当前快照中对应的元件并发布
+        *  @param  pMeasuredObj:链表中的检测对象
+        *  @return N/A
+        */
+        void removeMeasuredObj(MeasuredObj * pMeasuredObj);
+
+        //以上编辑函数只将元件表标记为失效,下一次访问componentTable或spatialIndex时重新生成
+        //连续编辑多个元件只重新生成一次
+        //快照只复制被编辑元件所在的块(JobSnapshotEditor),不重新生成整个快照
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -73,8 +136,62 @@ namespace Job
             this->m_pMeasuredObjList = measuredObjList;
         }
         MeasuredObjList<MeasuredObj> * pMeasuredObjList() {return this->m_pMeasuredObjList;}
+
+        //获取检测对象的内存池,所有检测对象都从该池中分配
+        MeasuredObjPool<MeasuredObj> & measuredObjPool() {return this->m_measuredObjPool;}
+
+        //获取列式存储的元件表,编辑后失效时先重新生成
+        Job::ComponentTable & componentTable()
+        {
+            this->syncComponentTable();
+            return this->m_componentTable;
+        }
+
+        //获取元件的空间索引(查询结果为元件在componentTable中的索引号),编辑后失效时先重新生成
+        Job::SpatialIndex & spatialIndex()
+        {
+            this->syncComponentTable();
+            return this->m_spatialIndex;
+        }
+
+        //元件表及空间索引是否因编辑而失效
+        bool isComponentTableDirty() const {return this->m_componentTableDirty;}
+
+        //获取上一次保存之后被添加,修改及删除的元件记录
+        Job::ChangeTracker & changeTracker() {return this->m_changeTracker;}
+
+        //设置&获取检测程式快照的发布者,为nullptr时编辑不发布快照
+        //发布者的当前快照必须由该board生成(JobSnapshot::create),元件顺序与链表一致
+        void setJobStore(Job::JobStore * pJobStore) {this->m_pJobStore = pJobStore;}
+        Job::JobStore * pJobStore() {return this->m_pJobStore;}
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //元件表失效时重新生成元件表及空间索引
+        void syncComponentTable()
+        {
+            if(this->m_componentTableDirty)
+            {
+                this->buildComponentTable();
+            }
+        }
+
+        //检测对象在链表中的索引号(即在快照中的索引号),O(n)
+        int indexOf(MeasuredObj * pMeasuredObj);
+
+        /*
+        *  @brief  publishEdit
+        *          基于发布者的当前快照编辑并通过publishIf发布;期间有其他编辑发布时基于新的当前快照重新编辑
+        *          在修改链表之前调用,快照与链表不一致时抛出异常,链表保持不变
+        *          没有设置发布者或尚未发布快照时不做任何操作
+        *  @param  objCnt:编辑前链表中检测对象的数量,必须与当前快照的元件数量一致
+        *          edit:对快照的编辑
+        *  @return N/A
+        */
+        void publishEdit(int objCnt, const std::function<void(Job::JobSnapshotEditor &)> & edit);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         //成员变量
         string m_name;                     //记录PCB的名称
@@ -83,6 +200,12 @@ namespace Job
         double m_originalX;                     //记录PCB原点X轴的坐标
         double m_originalY;                     //记录PCB原点Y轴的坐标
         MeasuredObjList<MeasuredObj> *m_pMeasuredObjList;
+        MeasuredObjPool<MeasuredObj> m_measuredObjPool;  //检测对象的内存池
+        Job::ComponentTable m_componentTable;   //按列存储的元件数据,由检测对象链表生成
+        Job::SpatialIndex m_spatialIndex;       //元件的空间索引,由元件表生成
+        Job::ChangeTracker m_changeTracker;     //未保存的元件修改记录
+        Job::JobStore * m_pJobStore;            //检测程式快照的发布者,可以为nullptr
+        bool m_componentTableDirty;             //链表已编辑,元件表及空间索引需要重新生成
 //        MeasuredObjList * m_pMeasuredObjList;   //指向检测对象列表的头指针
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     };
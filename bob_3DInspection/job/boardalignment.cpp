@@ -0,0 +1,118 @@
+#include <cmath>
+
+#include "boardalignment.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//构造 & 析构函数
+BoardAlignment::BoardAlignment()
+{
+    this->m_residual = 0;
+    this->m_pTable = nullptr;
+}
+
+BoardAlignment::~BoardAlignment()
+{
+
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//成员函数
+void BoardAlignment::addFiducial(double nominalX, double nominalY, double measuredX, double measuredY)
+{
+    this->m_nominalX.push_back(nominalX);
+    this->m_nominalY.push_back(nominalY);
+    this->m_measuredX.push_back(measuredX);
+    this->m_measuredY.push_back(measuredY);
+}
+
+void BoardAlignment::clearFiducials()
+{
+    this->m_nominalX.clear();
+    this->m_nominalY.clear();
+    this->m_measuredX.clear();
+    this->m_measuredY.clear();
+    this->m_transform = AffineTransform();
+    this->m_residual = 0;
+}
+
+void BoardAlignment::solve()
+{
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //由Mark点求解检测程式坐标到实测坐标的变换
+        this->m_transform = AffineTransform::fromPoints(this->m_nominalX.data(),
+                                                        this->m_nominalY.data(),
+                                                        this->m_measuredX.data(),
+                                                        this->m_measuredY.data(),
+                                                        this->fiducialCount());
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //计算Mark点的均方根误差,误差过大说明Mark点识别有误或基板变形
+        double sum = 0;
+        for (int i = 0; i < this->fiducialCount(); ++i)
+        {
+            double x = 0, y = 0;
+            this->m_transform.map(this->m_nominalX[i], this->m_nominalY[i], x, y);
+            double dx = x - this->m_measuredX[i];
+            double dy = y - this->m_measuredY[i];
+            sum += dx * dx + dy * dy;
+        }
+        this->m_residual = std::sqrt(sum / this->fiducialCount());
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void BoardAlignment::apply(const ComponentTable *pTable)
+{
+    try
+    {
+        //resize在数量不变时不会重新分配内存,每块基板只做一次向量化的变换
+        const int cnt = pTable->size();
+        this->m_xPos.resize(cnt);
+        this->m_yPos.resize(cnt);
+        this->m_angle.resize(cnt);
+        this->m_pTable = pTable;
+
+        RectangleKernel::transform(pTable->rectangles(),
+                                   this->m_transform,
+                                   this->m_xPos.data(),
+                                   this->m_yPos.data(),
+                                   this->m_angle.data());
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+RectangleArray BoardAlignment::rectangles() const
+{
+    RectangleArray rects;
+    if(nullptr == this->m_pTable)
+    {
+        return rects;
+    }
+
+    rects.xPos = this->m_xPos.data();
+    rects.yPos = this->m_yPos.data();
+    rects.width = this->m_pTable->width();
+    rects.height = this->m_pTable->height();
+    rects.angle = this->m_angle.data();
+    rects.size = this->size();
+
+    return rects;
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,114 @@
+#ifndef BOARDALIGNMENT_HPP
+#define BOARDALIGNMENT_HPP
+
+#include <vector>
+
+#include "../sdk/customexception.hpp"
+#include "../sdk/affinetransform.hpp"
+#include "../sdk/rectanglekernel.hpp"
+#include "componenttable.hpp"
+
+namespace Job
+{
+    /**
+     *  @brief BoardAlignment
+     *         根据Mark点(基准点)的实测位置校正整块基板的偏移和旋转
+     *         1.添加Mark点在检测程式中的位置及实测位置,求解仿射变换
+     *           (1个点为平移,2个点为相似变换,3个及以上为最小二乘仿射变换)
+     *         2.将变换一次性(SIMD)作用于所有元件的中心和角度,结果保存在本对象中,不修改检测程式的元件表
+     *         每块基板检测前调用一次,对象可以重复使用(内存只在元件数量增加时重新分配)
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class BoardAlignment
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        BoardAlignment();
+
+        ~BoardAlignment();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //访存函数
+        //Mark点的数量
+        int fiducialCount() const {return (int)this->m_nominalX.size();}
+
+        //求解得到的变换
+        const SSDK::AffineTransform & transform() const {return this->m_transform;}
+
+        //Mark点经变换后与实测位置的均方根误差(单位:mm)
+        double residual() const {return this->m_residual;}
+
+        //校正后元件的数量
+        int size() const {return (int)this->m_xPos.size();}
+
+        //校正后各列数据的首地址(宽和高与元件表相同)
+        const double * xPos() const {return this->m_xPos.data();}
+        const double * yPos() const {return this->m_yPos.data();}
+        const double * angle() const {return this->m_angle.data();}
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        /*
+        *  @brief  addFiducial
+        *          添加一个Mark点
+        *  @param  nominalX,nominalY:Mark点在检测程式中的位置
+        *          measuredX,measuredY:Mark点在当前基板上的实测位置
+        *  @return N/A
+        */
+        void addFiducial(double nominalX, double nominalY, double measuredX, double measuredY);
+
+        //清空所有Mark点,并将变换恢复为单位变换
+        void clearFiducials();
+
+        /*
+        *  @brief  solve
+        *          根据已添加的Mark点求解变换,并计算残差
+        *          没有Mark点或Mark点退化(重合,共线)时抛出异常
+        *  @param  N/A
+        *  @return N/A
+        */
+        void solve();
+
+        /*
+        *  @brief  apply
+        *          将变换作用于元件表中所有元件的中心和角度
+        *  @param  pTable:检测程式的元件表(不会被修改)
+        *  @return N/A
+        */
+        void apply(const ComponentTable * pTable);
+
+        /*
+        *  @brief  rectangles
+        *          校正后的元件,可以直接用于RectangleKernel的批量运算
+        *          引用pTable的宽和高,pTable的内容变化或再次apply后失效
+        *  @param  N/A
+        *  @return 矩形数组
+        */
+        SSDK::RectangleArray rectangles() const;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        std::vector<double> m_nominalX;         //Mark点在检测程式中的X坐标
+        std::vector<double> m_nominalY;         //Mark点在检测程式中的Y坐标
+        std::vector<double> m_measuredX;        //Mark点的实测X坐标
+        std::vector<double> m_measuredY;        //Mark点的实测Y坐标
+
+        SSDK::AffineTransform m_transform;      //求解得到的变换
+        double m_residual;                      //Mark点的均方根误差
+
+        const ComponentTable * m_pTable;        //最近一次apply的元件表
+        std::vector<double> m_xPos;             //校正后元件中心X坐标
+        std::vector<double> m_yPos;             //校正后元件中心Y坐标
+        std::vector<double> m_angle;            //校正后元件的角度
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace Job
+
+#endif // BOARDALIGNMENT_HPP
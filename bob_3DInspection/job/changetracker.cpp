@@ -0,0 +1,175 @@
+#include <algorithm>
+
+#include "changetracker.hpp"
+
+using namespace std;
+using namespace Job;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//构造 & 析构函数
+ChangeTracker::ChangeTracker()
+{
+
+}
+
+ChangeTracker::~ChangeTracker()
+{
+
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//成员函数
+void ChangeTracker::markAdded(MeasuredObj *pMeasuredObj)
+{
+    if(0 != pMeasuredObj->id())
+    {
+        THROW_EXCEPTION("元件已写入检测程式,不能作为新元件添加!");
+    }
+
+    this->m_added.push_back(pMeasuredObj);
+}
+
+void ChangeTracker::markModified(MeasuredObj *pMeasuredObj)
+{
+    if(0 == pMeasuredObj->id())
+    {
+        return;
+    }
+
+    this->m_modified[pMeasuredObj->id()] = pMeasuredObj;
+}
+
+void ChangeTracker::markDeleted(MeasuredObj *pMeasuredObj)
+{
+    try
+    {
+        //尚未保存的元件: 从添加记录中移除即可
+        if(0 == pMeasuredObj->id())
+        {
+            vector<MeasuredObj *>::iterator it = std::find(this->m_added.begin(),
+                                                           this->m_added.end(),
+                                                           pMeasuredObj);
+            if(it != this->m_added.end())
+            {
+                this->m_added.erase(it);
+            }
+            return;
+        }
+
+        //已保存的元件: 之前的修改不再需要写入
+        this->m_modified.erase(pMeasuredObj->id());
+        this->m_deleted.insert(pMeasuredObj->id());
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void ChangeTracker::clear()
+{
+    this->m_added.clear();
+    this->m_modified.clear();
+    this->m_deleted.clear();
+}
+
+void ChangeTracker::save(SSDK::DB::SqliteDB &sqlite, const string &lastEditingTime)
+{
+    //所有修改在一个事务中写入,失败时回滚,检测程式保持上一次保存的状态
+    if(!sqlite.begin())
+    {
+        THROW_EXCEPTION("开始事务失败,无法保存检测程式!");
+    }
+
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //删除被删除的元件
+        string sqlDelete = "DELETE FROM MeasuredObjList WHERE rowid=?;";
+        sqlite.prepare(sqlDelete);
+        for (set<int64_t>::const_iterator it = this->m_deleted.begin(); it != this->m_deleted.end(); ++it)
+        {
+            if(!sqlite.executeWithParms(*it))
+            {
+                THROW_EXCEPTION("删除检测对象失败!");
+            }
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //更新被修改的元件
+        string sqlUpdate = "UPDATE MeasuredObjList SET Name=?,PosX=?,PosY=?,Width=?,Height=?,Angle=? WHERE rowid=?;";
+        sqlite.prepare(sqlUpdate);
+        for (map<int64_t, MeasuredObj *>::const_iterator it = this->m_modified.begin(); it != this->m_modified.end(); ++it)
+        {
+            MeasuredObj * pObj = it->second;
+            string str = pObj->name();
+            if(!sqlite.executeWithParms(str.data(),
+                                        pObj->rectangle().xPos(),
+                                        pObj->rectangle().yPos(),
+                                        pObj->rectangle().width(),
+                                        pObj->rectangle().height(),
+                                        pObj->rectangle().angle(),
+                                        it->first))
+            {
+                THROW_EXCEPTION("更新检测对象失败!");
+            }
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step3
+        //插入新添加的元件,记录数据库分配的rowid
+        //事务提交前ID只暂存,回滚时新元件仍保持ID为0
+        vector<int64_t> addedIds;
+        addedIds.reserve(this->m_added.size());
+        string sqlInsert = "INSERT INTO MeasuredObjList(Name,PosX,PosY,Width,Height,Angle) VALUES(?,?,?,?,?,?);";
+        sqlite.prepare(sqlInsert);
+        for (size_t i = 0; i < this->m_added.size(); ++i)
+        {
+            MeasuredObj * pObj = this->m_added[i];
+            string str = pObj->name();
+            if(!sqlite.executeWithParms(str.data(),
+                                        pObj->rectangle().xPos(),
+                                        pObj->rectangle().yPos(),
+                                        pObj->rectangle().width(),
+                                        pObj->rectangle().height(),
+                                        pObj->rectangle().angle()))
+            {
+                THROW_EXCEPTION("插入检测对象失败!");
+            }
+            addedIds.push_back(sqlite.lastInsertRowId());
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step4
+        //更新最后一次编辑时间并提交事务
+        string sqlJob = "UPDATE Job SET LastEditingTime=?;";
+        if(!sqlite.execute(sqlJob, lastEditingTime.data()))
+        {
+            THROW_EXCEPTION("更新检测程式编辑时间失败!");
+        }
+
+        if(!sqlite.commit())
+        {
+            THROW_EXCEPTION("提交事务失败,无法保存检测程式!");
+        }
+
+        for (size_t i = 0; i < addedIds.size(); ++i)
+        {
+            this->m_added[i]->setId(addedIds[i]);
+        }
+        this->clear();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    }
+    catch(const exception &ex)
+    {
+        sqlite.rollBack();
+        THROW_EXCEPTION(ex.what());
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,101 @@
+#ifndef CHANGETRACKER_HPP
+#define CHANGETRACKER_HPP
+
+#include <map>
+#include <set>
+#include <vector>
+#include <cstdint>
+
+#include "../sdk/customexception.hpp"
+#include "../sdk/DB/sqlitedb.hpp"
+#include "measuredobj.hpp"
+
+namespace Job
+{
+    /**
+     *  @brief ChangeTracker
+     *         记录检测程式上一次保存之后被添加,修改及删除的元件
+     *         已保存的元件按ID(MeasuredObjList表中的rowid)记录,新添加的元件ID为0,按对象地址记录
+     *         V3起Id列为rowid的别名,VACUUM后ID不变;旧版本的检测程式保存前先升级(见JobMigrator的V2->V3)
+     *         保存时只需要写入记录中的元件,保存的耗时与编辑的数量成正比,与程式的大小无关
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class ChangeTracker
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        ChangeTracker();
+
+        ~ChangeTracker();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //记录新添加的元件(ID必须为0)
+        void markAdded(MeasuredObj * pMeasuredObj);
+
+        /*
+        *  @brief  markModified
+        *          记录被修改的元件
+        *          新添加且尚未保存的元件不需要记录,保存时会写入其最新的数据
+        *  @param  pMeasuredObj:被修改的元件
+        *  @return N/A
+        */
+        void markModified(MeasuredObj * pMeasuredObj);
+
+        /*
+        *  @brief  markDeleted
+        *          记录被删除的元件
+        *          新添加且尚未保存的元件直接从添加记录中移除,不需要写入数据库
+        *  @param  pMeasuredObj:被删除的元件
+        *  @return N/A
+        */
+        void markDeleted(MeasuredObj * pMeasuredObj);
+
+        //清空所有记录,保存成功或重新加载检测程式后调用
+        void clear();
+
+        /*
+        *  @brief  save
+        *          将记录中的修改写入已打开的检测程式(MeasuredObjList表),并更新最后一次编辑时间
+        *          依次执行DELETE,UPDATE及INSERT,所有语句在一个事务中执行,失败时回滚并抛出异常,记录保持不变
+        *          提交成功后新添加的元件取得数据库分配的ID,并清空所有记录
+        *  @param  sqlite:已打开的检测程式
+        *          lastEditingTime:最后一次编辑时间(即本次保存的时间,由调用者生成)
+        *  @return N/A
+        */
+        void save(SSDK::DB::SqliteDB & sqlite, const std::string & lastEditingTime);
+
+        //是否有未保存的修改
+        bool isDirty() const
+        {
+            return !this->m_added.empty() || !this->m_modified.empty() || !this->m_deleted.empty();
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //访存函数
+        //新添加的元件,按添加的顺序排列
+        const std::vector<MeasuredObj *> & added() const {return this->m_added;}
+
+        //被修改的元件,按ID排序,更新时按rowid顺序访问数据库页
+        const std::map<int64_t, MeasuredObj *> & modified() const {return this->m_modified;}
+
+        //被删除的元件的ID
+        const std::set<int64_t> & deleted() const {return this->m_deleted;}
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        std::vector<MeasuredObj *> m_added;             //新添加的元件
+        std::map<int64_t, MeasuredObj *> m_modified;    //被修改的元件
+        std::set<int64_t> m_deleted;                    //被删除的元件的ID
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace Job
+
+#endif // CHANGETRACKER_HPP
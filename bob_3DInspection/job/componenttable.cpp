@@ -0,0 +1,220 @@
+#include <cmath>
+#include <algorithm>
+
+#include "componenttable.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK;
+
+//分块计算外接矩形时每块的元件数量
+static const int BOUNDS_BLOCK_SIZE = 256;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//ComponentView
+
+ComponentView::ComponentView(ComponentTable *pTable, int index)
+{
+    this->m_pTable = pTable;
+    this->m_index = index;
+}
+
+void ComponentView::setName(string name)
+{
+    this->m_pTable->setName(this->m_index, name);
+}
+
+string ComponentView::name()
+{
+    return this->m_pTable->name(this->m_index);
+}
+
+void ComponentView::setRectangle(Rectangle *rectangle)
+{
+    this->m_pTable->xPos()[this->m_index] = rectangle->xPos();
+    this->m_pTable->yPos()[this->m_index] = rectangle->yPos();
+    this->m_pTable->width()[this->m_index] = rectangle->width();
+    this->m_pTable->height()[this->m_index] = rectangle->height();
+    this->m_pTable->angle()[this->m_index] = rectangle->angle();
+}
+
+Rectangle ComponentView::rectangle()
+{
+    return Rectangle(this->m_pTable->xPos()[this->m_index],
+                     this->m_pTable->yPos()[this->m_index],
+                     this->m_pTable->width()[this->m_index],
+                     this->m_pTable->height()[this->m_index],
+                     this->m_pTable->angle()[this->m_index]);
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//构造 & 析构函数
+ComponentTable::ComponentTable()
+{
+
+}
+
+ComponentTable::~ComponentTable()
+{
+
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//成员函数
+void ComponentTable::reserve(int cnt)
+{
+    this->m_xPos.reserve(cnt);
+    this->m_yPos.reserve(cnt);
+    this->m_width.reserve(cnt);
+    this->m_height.reserve(cnt);
+    this->m_angle.reserve(cnt);
+    this->m_nameId.reserve(cnt);
+}
+
+void ComponentTable::clear()
+{
+    this->m_xPos.clear();
+    this->m_yPos.clear();
+    this->m_width.clear();
+    this->m_height.clear();
+    this->m_angle.clear();
+    this->m_nameId.clear();
+    this->m_namePool.clear();
+    this->m_nameIndex.clear();
+}
+
+int ComponentTable::append(const string &name, Rectangle &rectangle)
+{
+    try
+    {
+        this->m_xPos.push_back(rectangle.xPos());
+        this->m_yPos.push_back(rectangle.yPos());
+        this->m_width.push_back(rectangle.width());
+        this->m_height.push_back(rectangle.height());
+        this->m_angle.push_back(rectangle.angle());
+        this->m_nameId.push_back(this->internName(name));
+
+        return this->size() - 1;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void ComponentTable::loadFromList(MeasuredObjList<MeasuredObj> *pMeasuredObjList)
+{
+    try
+    {
+        this->clear();
+        this->reserve(pMeasuredObjList->size());
+
+        //按链表的顺序将检测对象逐个拷贝到表中
+        MeasuredObj * pTmpObj = pMeasuredObjList->pHead();
+        while (nullptr != pTmpObj)
+        {
+            this->append(pTmpObj->name(), pTmpObj->rectangle());
+            pTmpObj = pTmpObj->pNextMeasuredObj();
+        }
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+int ComponentTable::internName(const string &name)
+{
+    auto it = this->m_nameIndex.find(name);
+    if(it != this->m_nameIndex.end())
+    {
+        return it->second;
+    }
+
+    int id = (int)this->m_namePool.size();
+    this->m_namePool.push_back(name);
+    this->m_nameIndex.insert(make_pair(name, id));
+    return id;
+}
+
+void ComponentTable::setName(int index, const string &name)
+{
+    this->m_nameId[index] = this->internName(name);
+}
+
+ComponentView ComponentTable::component(int index)
+{
+    if(index < 0 || index >= this->size())
+    {
+        THROW_EXCEPTION("元件索引号超出范围!");
+    }
+    return ComponentView(this, index);
+}
+
+void ComponentTable::translate(double dx, double dy)
+{
+    const int cnt = this->size();
+    double * pX = this->m_xPos.data();
+    double * pY = this->m_yPos.data();
+
+    for (int i = 0; i < cnt; ++i)
+    {
+        pX[i] += dx;
+    }
+    for (int i = 0; i < cnt; ++i)
+    {
+        pY[i] += dy;
+    }
+}
+
+SSDK::RectangleArray ComponentTable::rectangles(int begin, int cnt) const
+{
+    if(cnt < 0)
+    {
+        cnt = this->size() - begin;
+    }
+
+    RectangleArray rects;
+    rects.xPos = this->m_xPos.data() + begin;
+    rects.yPos = this->m_yPos.data() + begin;
+    rects.width = this->m_width.data() + begin;
+    rects.height = this->m_height.data() + begin;
+    rects.angle = this->m_angle.data() + begin;
+    rects.size = cnt;
+
+    return rects;
+}
+
+bool ComponentTable::boundingBox(double &minX, double &minY, double &maxX, double &maxY) const
+{
+    return RectangleKernel::unionBounds(this->rectangles(), minX, minY, maxX, maxY);
+}
+
+void ComponentTable::queryRoi(double minX, double minY, double maxX, double maxY,
+                              vector<int> &indices) const
+{
+    indices.clear();
+
+    //分块计算外接矩形,再判断外接矩形是否与ROI相交
+    double boxMinX[BOUNDS_BLOCK_SIZE], boxMinY[BOUNDS_BLOCK_SIZE];
+    double boxMaxX[BOUNDS_BLOCK_SIZE], boxMaxY[BOUNDS_BLOCK_SIZE];
+
+    const int cnt = this->size();
+    for (int base = 0; base < cnt; base += BOUNDS_BLOCK_SIZE)
+    {
+        int n = std::min(BOUNDS_BLOCK_SIZE, cnt - base);
+        RectangleKernel::bounds(this->rectangles(base, n), boxMinX, boxMinY, boxMaxX, boxMaxY);
+
+        for (int i = 0; i < n; ++i)
+        {
+            if(boxMaxX[i] >= minX && boxMinX[i] <= maxX &&
+               boxMaxY[i] >= minY && boxMinY[i] <= maxY)
+            {
+                indices.push_back(base + i);
+            }
+        }
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,199 @@
+#ifndef COMPONENTTABLE_HPP
+#define COMPONENTTABLE_HPP
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "../sdk/rectangle.hpp"
+#include "../sdk/rectanglekernel.hpp"
+#include "../sdk/customexception.hpp"
+#include "measuredobjlist.hpp"
+
+using namespace std;
+
+namespace Job
+{
+    class ComponentTable;
+
+    /**
+     *  @brief ComponentView
+     *         ComponentTable中一个元件的轻量视图,接口与MeasuredObj保持一致
+     *         视图本身只记录表的地址和元件的索引号,读写都直接作用在表的列数据上
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class ComponentView
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造函数
+        ComponentView(ComponentTable * pTable, int index);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //访存函数
+        //获取元件在表中的索引号
+        int index(){return this->m_index;}
+
+        //设置及获取元件的名称
+        void setName(std::string name);
+        std::string name();
+
+        //设置&获取元件对象的X,Y轴坐标,角度,宽和高
+        void setRectangle(SSDK::Rectangle * rectangle);
+        SSDK::Rectangle rectangle();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        ComponentTable * m_pTable;      //元件所在的列式表
+        int m_index;                    //元件在表中的索引号
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+
+    /**
+     *  @brief ComponentTable
+     *         按列存储board上所有元件的数据(structure of arrays)
+     *         xPos,yPos,width,height,angle各自为一段连续的内存,
+     *         元件名称统一放在字符串池中,每个元件只记录名称的编号
+     *         整板的平移,外接矩形,ROI筛选等操作都是对连续数组的紧凑循环
+     *
+     *         坐标约定: (xPos,yPos)为元件中心,angle单位为度
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class ComponentTable
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        ComponentTable();
+
+        ~ComponentTable();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //访存函数
+        //获取元件的数量
+        int size() const {return (int)this->m_xPos.size();}
+
+        //获取各列数据的首地址
+        double * xPos(){return this->m_xPos.data();}
+        double * yPos(){return this->m_yPos.data();}
+        double * width(){return this->m_width.data();}
+        double * height(){return this->m_height.data();}
+        double * angle(){return this->m_angle.data();}
+        const double * xPos() const {return this->m_xPos.data();}
+        const double * yPos() const {return this->m_yPos.data();}
+        const double * width() const {return this->m_width.data();}
+        const double * height() const {return this->m_height.data();}
+        const double * angle() const {return this->m_angle.data();}
+
+        /*
+        *  @brief  rectangles
+        *          以列式矩形数组的形式引用表中的元件,供RectangleKernel批量运算
+        *  @param  begin:起始元件的索引号
+        *          cnt:元件的数量,小于0表示到表的末尾
+        *  @return 矩形数组(表的内容变化后失效)
+        */
+        SSDK::RectangleArray rectangles(int begin = 0, int cnt = -1) const;
+
+        //获取元件名称的编号,及根据编号获取名称
+        int nameId(int index) const {return this->m_nameId[index];}
+        const std::string & nameOfId(int nameId) const {return this->m_namePool[nameId];}
+        const std::string & name(int index) const {return this->m_namePool[this->m_nameId[index]];}
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        /*
+        *  @brief  reserve
+        *          预先为所有列分配cnt个元件的空间
+        *  @param  cnt:元件的数量
+        *  @return N/A
+        */
+        void reserve(int cnt);
+
+        //清空表中所有元件及名称池
+        void clear();
+
+        /*
+        *  @brief  append
+        *          在表的末尾添加一个元件
+        *  @param  name:元件名称
+        *          rectangle:元件的X,Y坐标,宽,高及角度
+        *  @return 元件在表中的索引号
+        */
+        int append(const std::string & name, SSDK::Rectangle & rectangle);
+
+        /*
+        *  @brief  loadFromList
+        *          清空当前表,按链表顺序将所有检测对象的数据拷贝到表中
+        *  @param  pMeasuredObjList:检测对象链表
+        *  @return N/A
+        */
+        void loadFromList(MeasuredObjList<MeasuredObj> * pMeasuredObjList);
+
+        /*
+        *  @brief  internName
+        *          将名称放入名称池,相同的名称只保存一份
+        *  @param  name:元件名称
+        *  @return 名称在池中的编号
+        */
+        int internName(const std::string & name);
+
+        //设置元件的名称
+        void setName(int index, const std::string & name);
+
+        //获取元件的视图
+        ComponentView component(int index);
+
+        /*
+        *  @brief  translate
+        *          将所有元件平移(dx,dy)
+        *  @param  dx:X方向的平移量
+        *          dy:Y方向的平移量
+        *  @return N/A
+        */
+        void translate(double dx, double dy);
+
+        /*
+        *  @brief  boundingBox
+        *          计算所有元件(考虑旋转角度)的外接矩形
+        *  @param  minX,minY,maxX,maxY:外接矩形的边界
+        *  @return 表为空时返回false
+        */
+        bool boundingBox(double & minX, double & minY, double & maxX, double & maxY) const;
+
+        /*
+        *  @brief  queryRoi
+        *          筛选外接矩形与ROI相交的元件
+        *  @param  minX,minY,maxX,maxY:ROI的边界
+        *          indices:输出,相交元件的索引号(按表中顺序)
+        *  @return N/A
+        */
+        void queryRoi(double minX, double minY, double maxX, double maxY,
+                      std::vector<int> & indices) const;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        std::vector<double> m_xPos;                            //元件中心X轴坐标
+        std::vector<double> m_yPos;                            //元件中心Y轴坐标
+        std::vector<double> m_width;                           //元件的宽
+        std::vector<double> m_height;                          //元件的高
+        std::vector<double> m_angle;                           //元件的角度
+        std::vector<int> m_nameId;                             //元件名称在名称池中的编号
+
+        std::vector<std::string> m_namePool;                   //名称池
+        std::unordered_map<std::string,int> m_nameIndex;       //名称到编号的索引
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace Job
+
+#endif // COMPONENTTABLE_HPP
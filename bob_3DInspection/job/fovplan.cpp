@@ -0,0 +1,218 @@
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+#include <rapidjson/document.h>
+#include <rapidjson/writer.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include "fovplan.hpp"
+
+using namespace std;
+using namespace rapidjson;
+using namespace Job;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//内部函数
+namespace
+{
+    //读取对象中名称为name的数值,不存在或不是数值时抛出异常(不能直接GetDouble,否则rapidjson会断言失败)
+    double numberMember(const Value & object, const char * name)
+    {
+        Value::ConstMemberIterator it = object.FindMember(name);
+        if(it == object.MemberEnd() || !it->value.IsNumber())
+        {
+            THROW_EXCEPTION(string("拍照计划文件格式错误:缺少数值") + name);
+        }
+        return it->value.GetDouble();
+    }
+
+    //读取对象中名称为name的数组,不存在或不是数组时抛出异常
+    const Value & arrayMember(const Value & object, const char * name)
+    {
+        Value::ConstMemberIterator it = object.FindMember(name);
+        if(it == object.MemberEnd() || !it->value.IsArray())
+        {
+            THROW_EXCEPTION(string("拍照计划文件格式错误:缺少数组") + name);
+        }
+        return it->value;
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//构造 & 析构函数
+FovPlan::FovPlan()
+{
+    this->m_fovWidth = 0;
+    this->m_fovHeight = 0;
+    this->m_overlap = 0;
+    this->m_startX = 0;
+    this->m_startY = 0;
+}
+
+FovPlan::~FovPlan()
+{
+
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//成员函数
+void FovPlan::clear()
+{
+    this->m_fovs.clear();
+}
+
+double FovPlan::travelDistance() const
+{
+    double distance = 0;
+    double preX = this->m_startX;
+    double preY = this->m_startY;
+
+    for (const Fov & fov : this->m_fovs)
+    {
+        distance += std::max(std::fabs(fov.xPos - preX), std::fabs(fov.yPos - preY));
+        preX = fov.xPos;
+        preY = fov.yPos;
+    }
+
+    return distance;
+}
+
+void FovPlan::writeToJson(const string &path) const
+{
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //将拍照计划的参数及所有FOV写入json串
+        StringBuffer buffer;
+        PrettyWriter<StringBuffer> writer(buffer);
+
+        writer.StartObject();
+        writer.String("FovWidth");
+        writer.Double(this->m_fovWidth);
+        writer.String("FovHeight");
+        writer.Double(this->m_fovHeight);
+        writer.String("Overlap");
+        writer.Double(this->m_overlap);
+        writer.String("StartX");
+        writer.Double(this->m_startX);
+        writer.String("StartY");
+        writer.Double(this->m_startY);
+
+        writer.String("Fovs");
+        writer.StartArray();
+        for (const Fov & fov : this->m_fovs)
+        {
+            writer.StartObject();
+            writer.String("X");
+            writer.Double(fov.xPos);
+            writer.String("Y");
+            writer.Double(fov.yPos);
+            writer.String("Components");
+            writer.StartArray();
+            for (int index : fov.componentIndices)
+            {
+                writer.Int(index);
+            }
+            writer.EndArray();
+            writer.EndObject();
+        }
+        writer.EndArray();
+        writer.EndObject();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //将json串写入文件
+        ofstream file(path.c_str(), ios::out | ios::trunc);
+        if(!file.is_open())
+        {
+            THROW_EXCEPTION("打开文件失败!!");
+        }
+        file << buffer.GetString();
+        file.close();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void FovPlan::readFromJson(const string &path)
+{
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //读取整个json文件并解析
+        ifstream file(path.c_str());
+        if(!file.is_open())
+        {
+            THROW_EXCEPTION("打开文件失败!!");
+        }
+        stringstream content;
+        content << file.rdbuf();
+        file.close();
+
+        Document doc;
+        doc.Parse<0>(content.str().c_str());
+        if(doc.HasParseError() || !doc.IsObject())
+        {
+            THROW_EXCEPTION("拍照计划文件格式错误!");
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //读取拍照计划的参数及所有FOV,每个成员都先检查类型
+        //先读到临时变量中,文件格式错误时原有的拍照计划保持不变
+        double fovWidth = numberMember(doc, "FovWidth");
+        double fovHeight = numberMember(doc, "FovHeight");
+        double overlap = numberMember(doc, "Overlap");
+        double startX = numberMember(doc, "StartX");
+        double startY = numberMember(doc, "StartY");
+
+        const Value & fovArray = arrayMember(doc, "Fovs");
+        vector<Fov> fovs(fovArray.Size());
+        for (SizeType i = 0; i < fovArray.Size(); ++i)
+        {
+            if(!fovArray[i].IsObject())
+            {
+                THROW_EXCEPTION("拍照计划文件格式错误:第" + to_string(i) + "个FOV不是对象");
+            }
+            Fov & fov = fovs[i];
+            fov.xPos = numberMember(fovArray[i], "X");
+            fov.yPos = numberMember(fovArray[i], "Y");
+
+            const Value & components = arrayMember(fovArray[i], "Components");
+            fov.componentIndices.reserve(components.Size());
+            for (SizeType j = 0; j < components.Size(); ++j)
+            {
+                if(!components[j].IsInt())
+                {
+                    THROW_EXCEPTION("拍照计划文件格式错误:第" + to_string(i) + "个FOV的元件索引不是整数");
+                }
+                fov.componentIndices.push_back(components[j].GetInt());
+            }
+        }
+
+        this->m_fovWidth = fovWidth;
+        this->m_fovHeight = fovHeight;
+        this->m_overlap = overlap;
+        this->m_startX = startX;
+        this->m_startY = startY;
+        this->m_fovs.swap(fovs);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
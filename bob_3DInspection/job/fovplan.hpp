@@ -0,0 +1,112 @@
+#ifndef FOVPLAN_HPP
+#define FOVPLAN_HPP
+
+#include <string>
+#include <vector>
+
+#include "../sdk/customexception.hpp"
+
+using namespace std;
+
+namespace Job
+{
+    /**
+     *  @brief Fov
+     *         一次拍照的视野(Field Of View)
+     *         FOV中心在基板上的坐标,及该FOV负责检测的元件(元件在ComponentTable中的索引号)
+     */
+    struct Fov
+    {
+        double xPos{0};                      //FOV中心X轴坐标(单位:mm)
+        double yPos{0};                      //FOV中心Y轴坐标(单位:mm)
+        std::vector<int> componentIndices;   //该FOV负责检测的元件索引号
+    };
+
+    /**
+     *  @brief FovPlan
+     *         整块基板的拍照计划,FOV按拍照(龙门移动)的顺序排列
+     *         可以写入json文件,也可以从json文件读取
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class FovPlan
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        FovPlan();
+
+        ~FovPlan();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //访存函数
+        //设置&获取FOV的宽度和高度(单位:mm)
+        void setFovWidth(double fovWidth){this->m_fovWidth = fovWidth;}
+        double fovWidth() const {return this->m_fovWidth;}
+        void setFovHeight(double fovHeight){this->m_fovHeight = fovHeight;}
+        double fovHeight() const {return this->m_fovHeight;}
+
+        //设置&获取相邻FOV的重叠量(单位:mm)
+        void setOverlap(double overlap){this->m_overlap = overlap;}
+        double overlap() const {return this->m_overlap;}
+
+        //设置&获取龙门的起始位置(单位:mm)
+        void setStartPoint(double x, double y){this->m_startX = x; this->m_startY = y;}
+        double startX() const {return this->m_startX;}
+        double startY() const {return this->m_startY;}
+
+        //获取所有的FOV(按拍照顺序)
+        std::vector<Fov> & fovs(){return this->m_fovs;}
+        const std::vector<Fov> & fovs() const {return this->m_fovs;}
+
+        //FOV的数量
+        int size() const {return (int)this->m_fovs.size();}
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //清空所有FOV
+        void clear();
+
+        /*
+        *  @brief  travelDistance
+        *          按当前顺序计算龙门从起始位置依次移动到每个FOV的总距离
+        *          X,Y轴同时运动,因此两点间的移动距离取max(|dx|,|dy|)
+        *  @param  N/A
+        *  @return 移动的总距离(单位:mm)
+        */
+        double travelDistance() const;
+
+        /*
+        *  @brief  writeToJson
+        *          将拍照计划写入json文件
+        *  @param  path:json文件的路径
+        *  @return N/A
+        */
+        void writeToJson(const std::string & path) const;
+
+        /*
+        *  @brief  readFromJson
+        *          从json文件中读取拍照计划,文件不存在或格式错误时抛出异常
+        *  @param  path:json文件的路径
+        *  @return N/A
+        */
+        void readFromJson(const std::string & path);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        double m_fovWidth;                  //FOV的宽度
+        double m_fovHeight;                 //FOV的高度
+        double m_overlap;                   //相邻FOV的重叠量
+        double m_startX;                    //龙门起始位置X轴坐标
+        double m_startY;                    //龙门起始位置Y轴坐标
+        std::vector<Fov> m_fovs;            //按拍照顺序排列的FOV
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace Job
+
+#endif // FOVPLAN_HPP
@@ -0,0 +1,277 @@
+#include <cmath>
+#include <algorithm>
+
+#include "fovplanner.hpp"
+
+using namespace std;
+using namespace Job;
+
+//龙门两点间的移动距离,X,Y轴同时运动,取较大的一个
+static inline double travel(const Fov & a, const Fov & b)
+{
+    return std::max(std::fabs(a.xPos - b.xPos), std::fabs(a.yPos - b.yPos));
+}
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//构造 & 析构函数
+FovPlanner::FovPlanner(double fovWidth, double fovHeight, double overlap)
+{
+    if(fovWidth <= 0 || fovHeight <= 0 ||
+       overlap < 0 || overlap >= fovWidth || overlap >= fovHeight)
+    {
+        THROW_EXCEPTION("FOV尺寸或重叠量设置错误!");
+    }
+
+    this->m_fovWidth = fovWidth;
+    this->m_fovHeight = fovHeight;
+    this->m_overlap = overlap;
+    this->m_startX = 0;
+    this->m_startY = 0;
+    this->m_maxOptimizePasses = 20;
+}
+
+FovPlanner::~FovPlanner()
+{
+
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//成员函数
+void FovPlanner::plan(ComponentTable *pTable, FovPlan &plan)
+{
+    try
+    {
+        plan.clear();
+        plan.setFovWidth(this->m_fovWidth);
+        plan.setFovHeight(this->m_fovHeight);
+        plan.setOverlap(this->m_overlap);
+        plan.setStartPoint(this->m_startX, this->m_startY);
+
+        this->coverComponents(pTable, plan.fovs());
+        this->orderFovs(plan.fovs());
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void FovPlanner::coverComponents(ComponentTable *pTable, vector<Fov> &fovs)
+{
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //step1
+    //计算FOV的有效区域(四周各去掉overlap/2)及每个元件旋转后的外接矩形
+    const double effW = this->m_fovWidth - this->m_overlap;
+    const double effH = this->m_fovHeight - this->m_overlap;
+
+    const int cnt = pTable->size();
+    vector<double> minX(cnt), minY(cnt), maxX(cnt), maxY(cnt);
+    SSDK::RectangleKernel::bounds(pTable->rectangles(),
+                                  minX.data(), minY.data(), maxX.data(), maxY.data());
+    vector<char> covered(cnt, 0);
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //step2
+    //比FOV有效区域还大的元件,以元件中心为中心按网格拆分到多个FOV
+    for (int i = 0; i < cnt; ++i)
+    {
+        double w = maxX[i] - minX[i];
+        double h = maxY[i] - minY[i];
+        if(w <= effW && h <= effH)
+        {
+            continue;
+        }
+
+        int nx = std::max(1, (int)std::ceil(w / effW));
+        int ny = std::max(1, (int)std::ceil(h / effH));
+        double left = 0.5 * (minX[i] + maxX[i]) - 0.5 * nx * effW;
+        double top = 0.5 * (minY[i] + maxY[i]) - 0.5 * ny * effH;
+
+        for (int row = 0; row < ny; ++row)
+        {
+            for (int col = 0; col < nx; ++col)
+            {
+                Fov fov;
+                fov.xPos = left + (col + 0.5) * effW;
+                fov.yPos = top + (row + 0.5) * effH;
+                fov.componentIndices.push_back(i);
+                fovs.push_back(fov);
+            }
+        }
+        covered[i] = 1;
+    }
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //step3
+    //按外接矩形的上边界(minY)排序,从最上方未覆盖的元件开始划分一个高度为effH的带
+    //带内完整包含的元件按左边界(minX)排序,从最左侧未覆盖的元件开始放置一个宽度为effW的FOV
+    //FOV内完整包含的元件都分配给该FOV,最后将FOV中心移到这些元件外接矩形的中心
+    vector<int> order;
+    order.reserve(cnt);
+    for (int i = 0; i < cnt; ++i)
+    {
+        if(!covered[i])
+        {
+            order.push_back(i);
+        }
+    }
+    sort(order.begin(), order.end(), [&minY](int a, int b){ return minY[a] < minY[b]; });
+
+    vector<int> candidates;
+    size_t first = 0;
+    while (true)
+    {
+        while (first < order.size() && covered[order[first]])
+        {
+            ++first;
+        }
+        if(first >= order.size())
+        {
+            break;
+        }
+
+        //step3.1 收集完整落在当前带内的未覆盖元件
+        const double bottom = minY[order[first]] + effH;
+        candidates.clear();
+        for (size_t j = first; j < order.size() && minY[order[j]] <= bottom; ++j)
+        {
+            int index = order[j];
+            if(!covered[index] && maxY[index] <= bottom)
+            {
+                candidates.push_back(index);
+            }
+        }
+        sort(candidates.begin(), candidates.end(), [&minX](int a, int b){ return minX[a] < minX[b]; });
+
+        //step3.2 在带内从左到右放置FOV
+        for (size_t k = 0; k < candidates.size(); ++k)
+        {
+            if(covered[candidates[k]])
+            {
+                continue;
+            }
+
+            const double right = minX[candidates[k]] + effW;
+            double boxMinX = minX[candidates[k]], boxMaxX = maxX[candidates[k]];
+            double boxMinY = minY[candidates[k]], boxMaxY = maxY[candidates[k]];
+
+            Fov fov;
+            for (size_t m = k; m < candidates.size() && minX[candidates[m]] <= right; ++m)
+            {
+                int index = candidates[m];
+                if(covered[index] || maxX[index] > right)
+                {
+                    continue;
+                }
+
+                fov.componentIndices.push_back(index);
+                covered[index] = 1;
+                boxMinX = std::min(boxMinX, minX[index]);
+                boxMaxX = std::max(boxMaxX, maxX[index]);
+                boxMinY = std::min(boxMinY, minY[index]);
+                boxMaxY = std::max(boxMaxY, maxY[index]);
+            }
+
+            sort(fov.componentIndices.begin(), fov.componentIndices.end());
+            fov.xPos = 0.5 * (boxMinX + boxMaxX);
+            fov.yPos = 0.5 * (boxMinY + boxMaxY);
+            fovs.push_back(fov);
+        }
+    }
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+}
+
+void FovPlanner::orderFovs(vector<Fov> &fovs)
+{
+    const int cnt = (int)fovs.size();
+    if(cnt < 2)
+    {
+        return;
+    }
+
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //step1
+    //最近邻法: 从起始位置出发,每次移动到最近的未拍照FOV
+    Fov start;
+    start.xPos = this->m_startX;
+    start.yPos = this->m_startY;
+
+    vector<int> path;
+    path.reserve(cnt);
+    vector<char> visited(cnt, 0);
+    const Fov * pCurrent = &start;
+
+    for (int step = 0; step < cnt; ++step)
+    {
+        int nearest = -1;
+        double nearestDistance = 0;
+        for (int i = 0; i < cnt; ++i)
+        {
+            if(visited[i])
+            {
+                continue;
+            }
+            double distance = travel(*pCurrent, fovs[i]);
+            if(nearest < 0 || distance < nearestDistance)
+            {
+                nearest = i;
+                nearestDistance = distance;
+            }
+        }
+        visited[nearest] = 1;
+        path.push_back(nearest);
+        pCurrent = &fovs[nearest];
+    }
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //step2
+    //2-opt: 起点固定,终点开放,反转path[i..j]能缩短路径时就反转,直到没有改进或达到最大轮数
+    for (int pass = 0; pass < this->m_maxOptimizePasses; ++pass)
+    {
+        bool improved = false;
+        for (int i = 0; i < cnt - 1; ++i)
+        {
+            const Fov & a = (0 == i) ? start : fovs[path[i - 1]];
+            const Fov & b = fovs[path[i]];
+            for (int j = i + 1; j < cnt; ++j)
+            {
+                const Fov & c = fovs[path[j]];
+                double delta = travel(a, c) - travel(a, b);
+                if(j + 1 < cnt)
+                {
+                    const Fov & d = fovs[path[j + 1]];
+                    delta += travel(b, d) - travel(c, d);
+                }
+
+                if(delta < -1e-9)
+                {
+                    reverse(path.begin() + i, path.begin() + j + 1);
+                    improved = true;
+                    break;
+                }
+            }
+        }
+        if(!improved)
+        {
+            break;
+        }
+    }
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //step3
+    //按路径顺序重新排列FOV
+    vector<Fov> ordered;
+    ordered.reserve(cnt);
+    for (int index : path)
+    {
+        ordered.push_back(std::move(fovs[index]));
+    }
+    fovs.swap(ordered);
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
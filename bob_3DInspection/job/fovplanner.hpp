@@ -0,0 +1,84 @@
+#ifndef FOVPLANNER_HPP
+#define FOVPLANNER_HPP
+
+#include <vector>
+
+#include "../sdk/customexception.hpp"
+#include "componenttable.hpp"
+#include "fovplan.hpp"
+
+namespace Job
+{
+    /**
+     *  @brief FovPlanner
+     *         根据相机FOV的大小,将board上所有元件分配到尽量少的FOV中,并规划拍照顺序
+     *         1.覆盖: FOV四周各留出 overlap/2 的重叠区,元件(旋转后的外接矩形)必须完整落在FOV的有效区域内
+     *                 按Y方向分带,带内按X方向贪心放置FOV,每个FOV尽可能多地包含元件
+     *                 比有效区域还大的元件,按网格拆分到多个FOV
+     *         2.排序: 龙门X,Y轴同时运动,两点间的移动时间取决于max(|dx|,|dy|)
+     *                 先用最近邻法生成路径,再用2-opt优化路径
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class FovPlanner
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        /*
+        *  @brief  FovPlanner
+        *  @param  fovWidth:FOV的宽度(单位:mm),即图片宽度*像素尺寸
+        *          fovHeight:FOV的高度(单位:mm),即图片高度*像素尺寸
+        *          overlap:相邻FOV的重叠量(单位:mm),必须小于FOV的宽和高
+        *  @return N/A
+        */
+        FovPlanner(double fovWidth, double fovHeight, double overlap);
+
+        ~FovPlanner();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //访存函数
+        //设置龙门的起始位置,默认为(0,0)
+        void setStartPoint(double x, double y){this->m_startX = x; this->m_startY = y;}
+
+        //设置2-opt优化的最大轮数,0表示只使用最近邻法
+        void setMaxOptimizePasses(int passes){this->m_maxOptimizePasses = passes;}
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        /*
+        *  @brief  plan
+        *          为元件表中的所有元件生成拍照计划
+        *  @param  pTable:元件表
+        *          plan:输出,按拍照顺序排列的FOV
+        *  @return N/A
+        */
+        void plan(ComponentTable * pTable, FovPlan & plan);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //将所有元件分配到FOV中
+        void coverComponents(ComponentTable * pTable, std::vector<Fov> & fovs);
+
+        //按龙门移动距离最短的原则对FOV排序
+        void orderFovs(std::vector<Fov> & fovs);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        double m_fovWidth;                  //FOV的宽度
+        double m_fovHeight;                 //FOV的高度
+        double m_overlap;                   //相邻FOV的重叠量
+        double m_startX;                    //龙门起始位置X轴坐标
+        double m_startY;                    //龙门起始位置Y轴坐标
+        int m_maxOptimizePasses;            //2-opt优化的最大轮数
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace Job
+
+#endif // FOVPLANNER_HPP
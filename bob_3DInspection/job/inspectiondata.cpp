@@ -21,44 +21,27 @@ void InspectionData::writeInspectionDataToXml(QString path)
     {
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         //step1
-        //定义一个QDomDocument xml文档类的对象
-        //在该文档下生成一个jobInfo节点,将版本号,上次编辑时间写入在该节点下
-        QDomDocument inspectionData;
-        //在文档中增加一个jobInfo元素
-        QDomElement jobInfo = inspectionData.createElement("Job");
-
-        //设置jobInfo元素的属性(版本号,上次编辑时间)
-        jobInfo.setAttribute("版本号",
-                             QString::fromStdString(this->version()));
-        jobInfo.setAttribute("上次编辑时间",
-                             QString::fromStdString(this->lastEditingTime()));
-        //将jobInfo元素的属性添加到 inspectionData 对象中
-        inspectionData.appendChild(jobInfo);
+        //打开xml文件,元素边生成边写入文件,不在内存中建立整个文档
+        //在文档中写入一个jobInfo节点,将版本号,上次编辑时间写入在该节点下
+        SSDK::XmlStreamWriter writer(4);
+        writer.open(path.toStdString());
+        writer.writeStartElement("Job");
+        writer.writeAttribute("版本号", this->version());
+        writer.writeAttribute("上次编辑时间", this->lastEditingTime());
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         //step2
-        //将board信息写入到inspectionData文档中的jobInfo节点下
-        this->pBoard()->writeBoardDataToXml(inspectionData,jobInfo);
+        //将board信息写入到jobInfo节点下
+        this->pBoard()->writeBoardDataToXml(writer);
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
         //step3
-        //设置文件路径,并将inspectionData中的数据写入到该路径下的xml文件中
-        QFile file(path);
-        //判断文件是否被打开,文档为只写模式,文档格式是文本格式
-        if (!file.open(QFile::WriteOnly | QFile::Text))
-        {
-            THROW_EXCEPTION("打开文件失败!!");
-        }
-        //定义文本输出流
-        QTextStream out(&file);
-        //保存文本文档,输出内容空4格
-        inspectionData.save(out,4);
-        //关闭文件
-        file.close();
+        //结束jobInfo节点,将缓冲区中剩余的内容写入文件并关闭文件
+        writer.writeEndElement();
+        writer.close();
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-
     }
     catch(const exception &ex)
     {
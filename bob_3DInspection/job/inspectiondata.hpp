@@ -1,7 +1,6 @@
 #ifndef INSPECTIONDATA_HPP
 #define INSPECTIONDATA_HPP
 
-#include <QDomDocument>
 #include <QFile>
 #include <QTextStream>
 
@@ -0,0 +1,328 @@
+#include <cstdio>
+#include <cmath>
+#include <fstream>
+#include <algorithm>
+
+#include "inspectionplan.hpp"
+
+using namespace std;
+using namespace Job;
+
+const uint32_t InspectionPlan::FILE_MAGIC;
+const uint32_t InspectionPlan::FILE_VERSION;
+
+namespace
+{
+    //计划文件的文件头,直接按字节写入文件
+    struct PlanFileHeader
+    {
+        uint32_t magic;             //文件标识
+        uint32_t version;           //文件格式版本
+        uint64_t contentHash;       //检测程式内容及拍照参数的哈希值
+        double pixelSize;           //像素尺寸
+        int32_t imgWidth;           //图片的宽
+        int32_t imgHeight;          //图片的高
+        double fovWidth;            //FOV的宽度
+        double fovHeight;           //FOV的高度
+        double overlap;             //相邻FOV的重叠量
+        double startX;              //龙门起始位置X轴坐标
+        double startY;              //龙门起始位置Y轴坐标
+        int32_t fovCount;           //FOV的数量
+        int32_t roiCount;           //ROI的总数
+    };
+
+    //将整段vector写入文件
+    template<class T>
+    void writeArray(ofstream & file, const vector<T> & arr)
+    {
+        if(!arr.empty())
+        {
+            file.write(reinterpret_cast<const char *>(arr.data()), arr.size() * sizeof(T));
+        }
+    }
+
+    //从文件读取cnt个元素到vector
+    template<class T>
+    bool readArray(ifstream & file, vector<T> & arr, size_t cnt)
+    {
+        arr.resize(cnt);
+        if(0 == cnt)
+        {
+            return true;
+        }
+        file.read(reinterpret_cast<char *>(arr.data()), cnt * sizeof(T));
+        return (size_t)file.gcount() == cnt * sizeof(T);
+    }
+}
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//构造 & 析构函数
+InspectionPlan::InspectionPlan()
+{
+    this->m_pixelSize = 0;
+    this->m_imgWidth = 0;
+    this->m_imgHeight = 0;
+    this->m_fovWidth = 0;
+    this->m_fovHeight = 0;
+    this->m_overlap = 0;
+    this->m_startX = 0;
+    this->m_startY = 0;
+    this->m_roiOffsets.push_back(0);
+}
+
+InspectionPlan::~InspectionPlan()
+{
+
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//成员函数
+void InspectionPlan::clear()
+{
+    this->m_fovX.clear();
+    this->m_fovY.clear();
+    this->m_roiOffsets.assign(1, 0);
+    this->m_rois.clear();
+}
+
+void InspectionPlan::compile(const ComponentTable *pTable,
+                             const FovPlan &fovPlan,
+                             double pixelSize,
+                             int imgWidth,
+                             int imgHeight)
+{
+    try
+    {
+        if(pixelSize <= 0 || imgWidth <= 0 || imgHeight <= 0)
+        {
+            THROW_EXCEPTION("像素尺寸或图片尺寸设置错误!");
+        }
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //记录拍照参数,并按FOV数量及元件总数一次性分配内存
+        this->clear();
+        this->m_pixelSize = pixelSize;
+        this->m_imgWidth = imgWidth;
+        this->m_imgHeight = imgHeight;
+        this->m_fovWidth = fovPlan.fovWidth();
+        this->m_fovHeight = fovPlan.fovHeight();
+        this->m_overlap = fovPlan.overlap();
+        this->m_startX = fovPlan.startX();
+        this->m_startY = fovPlan.startY();
+
+        const vector<Fov> & fovs = fovPlan.fovs();
+        size_t roiCnt = 0;
+        for (const Fov & fov : fovs)
+        {
+            roiCnt += fov.componentIndices.size();
+        }
+        this->m_fovX.reserve(fovs.size());
+        this->m_fovY.reserve(fovs.size());
+        this->m_roiOffsets.reserve(fovs.size() + 1);
+        this->m_rois.reserve(roiCnt);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //将元件从基板坐标(mm)转换到FOV图片的像素坐标
+        //图片左上角对应FOV的(xPos - 图片宽/2, yPos - 图片高/2),图片的行方向与基板Y轴方向相同
+        //外接矩形裁剪到图片范围内,超出FOV的大元件只检测本FOV内的部分
+        const double pixelPerMm = 1000.0 / pixelSize;
+        const double halfImgWidth = 0.5 * imgWidth;
+        const double halfImgHeight = 0.5 * imgHeight;
+
+        const double * xPos = pTable->xPos();
+        const double * yPos = pTable->yPos();
+        const double * width = pTable->width();
+        const double * height = pTable->height();
+        const double * angle = pTable->angle();
+
+        for (const Fov & fov : fovs)
+        {
+            this->m_fovX.push_back(fov.xPos);
+            this->m_fovY.push_back(fov.yPos);
+
+            for (int index : fov.componentIndices)
+            {
+                double c = 0, s = 0;
+                SSDK::RectangleKernel::sinCos(angle[index], c, s);
+                double halfW = 0.5 * width[index] * pixelPerMm;
+                double halfH = 0.5 * height[index] * pixelPerMm;
+                double halfX = std::fabs(halfW * c) + std::fabs(halfH * s);
+                double halfY = std::fabs(halfW * s) + std::fabs(halfH * c);
+
+                double cx = (xPos[index] - fov.xPos) * pixelPerMm + halfImgWidth;
+                double cy = (yPos[index] - fov.yPos) * pixelPerMm + halfImgHeight;
+
+                int left = std::max(0, (int)std::floor(cx - halfX));
+                int top = std::max(0, (int)std::floor(cy - halfY));
+                int right = std::min(imgWidth, (int)std::ceil(cx + halfX));
+                int bottom = std::min(imgHeight, (int)std::ceil(cy + halfY));
+
+                CompiledRoi roi;
+                roi.componentIndex = index;
+                roi.left = left;
+                roi.top = top;
+                roi.width = std::max(0, right - left);
+                roi.height = std::max(0, bottom - top);
+                roi.centerX = (float)cx;
+                roi.centerY = (float)cy;
+                roi.halfWidth = (float)halfW;
+                roi.halfHeight = (float)halfH;
+                roi.cosAngle = (float)c;
+                roi.sinAngle = (float)s;
+                this->m_rois.push_back(roi);
+            }
+            this->m_roiOffsets.push_back((int32_t)this->m_rois.size());
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void InspectionPlan::toFovPlan(FovPlan &fovPlan) const
+{
+    fovPlan.clear();
+    fovPlan.setFovWidth(this->m_fovWidth);
+    fovPlan.setFovHeight(this->m_fovHeight);
+    fovPlan.setOverlap(this->m_overlap);
+    fovPlan.setStartPoint(this->m_startX, this->m_startY);
+
+    vector<Fov> & fovs = fovPlan.fovs();
+    fovs.resize(this->fovCount());
+    for (int i = 0; i < this->fovCount(); ++i)
+    {
+        fovs[i].xPos = this->m_fovX[i];
+        fovs[i].yPos = this->m_fovY[i];
+        fovs[i].componentIndices.reserve(this->roiCount(i));
+        const CompiledRoi * pRoi = this->fovRois(i);
+        for (int j = 0; j < this->roiCount(i); ++j)
+        {
+            fovs[i].componentIndices.push_back(pRoi[j].componentIndex);
+        }
+    }
+}
+
+void InspectionPlan::save(const string &path, uint64_t contentHash) const
+{
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //先写入临时文件,写完后再替换原文件,避免中途失败留下不完整的计划文件
+        string tmpPath = path + ".tmp";
+        ofstream file(tmpPath.c_str(), ios::out | ios::binary | ios::trunc);
+        if(!file.is_open())
+        {
+            THROW_EXCEPTION("打开文件失败!!");
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //依次写入文件头,FOV坐标,ROI起始位置及所有ROI
+        PlanFileHeader header;
+        header.magic = FILE_MAGIC;
+        header.version = FILE_VERSION;
+        header.contentHash = contentHash;
+        header.pixelSize = this->m_pixelSize;
+        header.imgWidth = this->m_imgWidth;
+        header.imgHeight = this->m_imgHeight;
+        header.fovWidth = this->m_fovWidth;
+        header.fovHeight = this->m_fovHeight;
+        header.overlap = this->m_overlap;
+        header.startX = this->m_startX;
+        header.startY = this->m_startY;
+        header.fovCount = this->fovCount();
+        header.roiCount = (int32_t)this->m_rois.size();
+
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        writeArray(file, this->m_fovX);
+        writeArray(file, this->m_fovY);
+        writeArray(file, this->m_roiOffsets);
+        writeArray(file, this->m_rois);
+        file.close();
+        if(file.fail())
+        {
+            THROW_EXCEPTION("写入检测计划文件失败!!");
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step3
+        //用临时文件替换原文件
+        std::remove(path.c_str());
+        if(0 != std::rename(tmpPath.c_str(), path.c_str()))
+        {
+            THROW_EXCEPTION("保存检测计划文件失败!!");
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+bool InspectionPlan::load(const string &path, uint64_t contentHash)
+{
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //读取并校验文件头,文件不存在或与当前检测程式不匹配时返回false
+        ifstream file(path.c_str(), ios::in | ios::binary);
+        if(!file.is_open())
+        {
+            return false;
+        }
+
+        PlanFileHeader header;
+        file.read(reinterpret_cast<char *>(&header), sizeof(header));
+        if(file.gcount() != (streamsize)sizeof(header) ||
+           FILE_MAGIC != header.magic ||
+           FILE_VERSION != header.version ||
+           contentHash != header.contentHash ||
+           header.fovCount < 0 || header.roiCount < 0)
+        {
+            return false;
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //读取FOV坐标,ROI起始位置及所有ROI
+        this->clear();
+        bool ok = readArray(file, this->m_fovX, header.fovCount) &&
+                  readArray(file, this->m_fovY, header.fovCount) &&
+                  readArray(file, this->m_roiOffsets, header.fovCount + 1) &&
+                  readArray(file, this->m_rois, header.roiCount);
+        if(!ok || this->m_roiOffsets.back() != header.roiCount)
+        {
+            this->clear();
+            return false;
+        }
+
+        this->m_pixelSize = header.pixelSize;
+        this->m_imgWidth = header.imgWidth;
+        this->m_imgHeight = header.imgHeight;
+        this->m_fovWidth = header.fovWidth;
+        this->m_fovHeight = header.fovHeight;
+        this->m_overlap = header.overlap;
+        this->m_startX = header.startX;
+        this->m_startY = header.startY;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        return true;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
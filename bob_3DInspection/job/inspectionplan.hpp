@@ -0,0 +1,152 @@
+#ifndef INSPECTIONPLAN_HPP
+#define INSPECTIONPLAN_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "../sdk/customexception.hpp"
+#include "componenttable.hpp"
+#include "fovplan.hpp"
+
+namespace Job
+{
+    /**
+     *  @brief CompiledRoi
+     *         一个元件在某个FOV图片中的检测区域,全部为像素坐标(原点为图片左上角)
+     *         结构体只包含基本类型,可以直接按字节写入/读取文件
+     */
+    struct CompiledRoi
+    {
+        int32_t componentIndex;     //元件在ComponentTable中的索引号
+        int32_t left;               //外接矩形(已裁剪到图片内)的左边界
+        int32_t top;                //外接矩形(已裁剪到图片内)的上边界
+        int32_t width;              //外接矩形的宽
+        int32_t height;             //外接矩形的高
+        float centerX;              //元件中心X坐标(可能在图片外)
+        float centerY;              //元件中心Y坐标(可能在图片外)
+        float halfWidth;            //元件未旋转时宽的一半
+        float halfHeight;           //元件未旋转时高的一半
+        float cosAngle;             //元件旋转角度的余弦
+        float sinAngle;             //元件旋转角度的正弦
+    };
+
+    /**
+     *  @brief InspectionPlan
+     *         编译后的检测计划: 由FovPlan和拍照参数(像素尺寸,图片尺寸)预先计算出每个FOV内所有元件的像素ROI
+     *         所有ROI存放在一段连续内存中,第i个FOV的ROI为 rois()[roiOffset(i)] ~ rois()[roiOffset(i+1)-1]
+     *         计划可以保存到检测程式旁边的二进制文件中(<检测程式>.plan),文件头记录内容哈希值,
+     *         下次加载同一个检测程式(且拍照参数不变)时直接读取,不再重新计算
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class InspectionPlan
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //常量
+        static const uint32_t FILE_MAGIC = 0x50494433;     //文件标识 "3DIP"
+        static const uint32_t FILE_VERSION = 1;            //文件格式版本,格式变化时递增,旧文件自动失效
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        InspectionPlan();
+
+        ~InspectionPlan();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //访存函数
+        //FOV的数量
+        int fovCount() const {return (int)this->m_fovX.size();}
+
+        //第index个FOV中心的坐标(单位:mm)
+        double fovX(int index) const {return this->m_fovX[index];}
+        double fovY(int index) const {return this->m_fovY[index];}
+
+        //第index个FOV的ROI在rois()中的起始位置,roiOffset(fovCount())为ROI的总数
+        int roiOffset(int index) const {return this->m_roiOffsets[index];}
+
+        //第index个FOV的ROI数量及首地址
+        int roiCount(int index) const {return this->m_roiOffsets[index + 1] - this->m_roiOffsets[index];}
+        const CompiledRoi * fovRois(int index) const {return this->m_rois.data() + this->m_roiOffsets[index];}
+
+        //所有FOV的ROI(按FOV顺序连续存放)
+        const std::vector<CompiledRoi> & rois() const {return this->m_rois;}
+
+        //编译时使用的拍照参数
+        double pixelSize() const {return this->m_pixelSize;}
+        int imgWidth() const {return this->m_imgWidth;}
+        int imgHeight() const {return this->m_imgHeight;}
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //清空计划
+        void clear();
+
+        /*
+        *  @brief  compile
+        *          根据拍照计划计算每个FOV内所有元件的像素ROI及旋转参数
+        *  @param  pTable:元件表
+        *          fovPlan:拍照计划(FOV的顺序即为编译后的顺序)
+        *          pixelSize:像素尺寸(单位:um)
+        *          imgWidth,imgHeight:图片的宽和高(单位:pixel)
+        *  @return N/A
+        */
+        void compile(const ComponentTable * pTable,
+                     const FovPlan & fovPlan,
+                     double pixelSize,
+                     int imgWidth,
+                     int imgHeight);
+
+        /*
+        *  @brief  toFovPlan
+        *          由编译后的计划还原出拍照计划(FOV位置及元件索引号),用于从缓存加载时
+        *  @param  fovPlan:输出的拍照计划,FOV尺寸,重叠量及起始位置取自编译时的拍照计划
+        *  @return N/A
+        */
+        void toFovPlan(FovPlan & fovPlan) const;
+
+        /*
+        *  @brief  save
+        *          将计划写入二进制文件
+        *  @param  path:文件的路径(一般为 <检测程式>.plan)
+        *          contentHash:检测程式内容及拍照参数的哈希值,加载时用于校验
+        *  @return N/A
+        */
+        void save(const std::string & path, uint64_t contentHash) const;
+
+        /*
+        *  @brief  load
+        *          从二进制文件中读取计划
+        *  @param  path:文件的路径
+        *          contentHash:期望的哈希值
+        *  @return true:读取成功; false:文件不存在,格式版本不符或哈希值不匹配(需要重新编译)
+        */
+        bool load(const std::string & path, uint64_t contentHash);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        double m_pixelSize;                     //像素尺寸(单位:um)
+        int m_imgWidth;                         //图片的宽
+        int m_imgHeight;                        //图片的高
+        double m_fovWidth;                      //FOV的宽度(单位:mm)
+        double m_fovHeight;                     //FOV的高度(单位:mm)
+        double m_overlap;                       //相邻FOV的重叠量(单位:mm)
+        double m_startX;                        //龙门起始位置X轴坐标
+        double m_startY;                        //龙门起始位置Y轴坐标
+
+        std::vector<double> m_fovX;             //每个FOV中心的X坐标
+        std::vector<double> m_fovY;             //每个FOV中心的Y坐标
+        std::vector<int32_t> m_roiOffsets;      //每个FOV的ROI起始位置,共fovCount()+1个
+        std::vector<CompiledRoi> m_rois;        //所有FOV的ROI
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace Job
+
+#endif // INSPECTIONPLAN_HPP
@@ -0,0 +1,391 @@
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+
+#include "jobcache.hpp"
+#include "board.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//构造 & 析构函数
+JobCache::JobCache()
+    : m_memoryCapacity(DEFAULT_MEMORY_CAPACITY),
+      m_memorySize(0),
+      m_diskCapacity(DEFAULT_DISK_CAPACITY),
+      m_hitCount(0),
+      m_missCount(0)
+{
+
+}
+
+JobCache::~JobCache()
+{
+
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//访存函数
+void JobCache::setMemoryCapacity(size_t capacity)
+{
+    this->m_memoryCapacity = capacity;
+    this->evict();
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//成员函数
+void JobCache::setDiskFolder(const string &folderPath, uint64_t capacity)
+{
+    try
+    {
+        this->m_diskFolder.clear();
+        this->m_diskCapacity = capacity;
+        if(folderPath.empty())
+        {
+            return;
+        }
+
+        string folder = folderPath;
+        if('/' != folder.back())
+        {
+            folder += '/';
+        }
+
+        struct stat folderStat;
+        if(0 != ::stat(folder.c_str(), &folderStat) && 0 != ::mkdir(folder.c_str(), 0755))
+        {
+            THROW_EXCEPTION("创建检测程式缓存目录失败:" + folder);
+        }
+        this->m_diskFolder = folder;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+shared_ptr<const CachedJob> JobCache::find(uint64_t contentHash)
+{
+    map<uint64_t, Entry>::iterator it = this->m_entries.find(contentHash);
+    if(it == this->m_entries.end())
+    {
+        ++this->m_missCount;
+        return shared_ptr<const CachedJob>();
+    }
+
+    //移到LRU链表的头部
+    ++this->m_hitCount;
+    this->m_lruList.splice(this->m_lruList.begin(), this->m_lruList, it->second.lruIt);
+    return it->second.pCachedJob;
+}
+
+void JobCache::insert(shared_ptr<const CachedJob> pCachedJob)
+{
+    try
+    {
+        if(!pCachedJob)
+        {
+            THROW_EXCEPTION("缓存的检测程式为空!");
+        }
+
+        this->erase(pCachedJob->contentHash);
+
+        Entry entry;
+        entry.pCachedJob = pCachedJob;
+        entry.byteSize = estimateSize(*pCachedJob);
+        this->m_lruList.push_front(pCachedJob->contentHash);
+        entry.lruIt = this->m_lruList.begin();
+        this->m_entries[pCachedJob->contentHash] = entry;
+        this->m_memorySize += entry.byteSize;
+
+        //刚放入的检测程式始终保留(即使单独超出容量),只淘汰更早的
+        this->evict();
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+string JobCache::blobPath(uint64_t contentHash) const
+{
+    if(this->m_diskFolder.empty())
+    {
+        return string();
+    }
+
+    return this->m_diskFolder + Hash::toHexString(contentHash) + ".bin";
+}
+
+void JobCache::touch(const string &path)
+{
+    //times为nullptr时将访问及修改时间设置为当前时间
+    ::utimensat(AT_FDCWD, path.c_str(), nullptr, 0);
+}
+
+int JobCache::trimDisk(const string &keepPath)
+{
+    try
+    {
+        if(this->m_diskFolder.empty())
+        {
+            return 0;
+        }
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //读取缓存目录中所有缓存文件的大小及修改时间
+        DIR * pDir = opendir(this->m_diskFolder.c_str());
+        if(nullptr == pDir)
+        {
+            return 0;
+        }
+
+        vector<pair<int64_t, pair<string, uint64_t>>> files;  //(修改时间,(路径,大小))
+        uint64_t totalSize = 0;
+        for (dirent * pEntry = readdir(pDir); nullptr != pEntry; pEntry = readdir(pDir))
+        {
+            string fileName = pEntry->d_name;
+            if(fileName.size() <= 4 || 0 != fileName.compare(fileName.size() - 4, 4, ".bin"))
+            {
+                continue;
+            }
+
+            string path = this->m_diskFolder + fileName;
+            struct stat fileStat;
+            if(0 != ::stat(path.c_str(), &fileStat) || !S_ISREG(fileStat.st_mode))
+            {
+                continue;
+            }
+
+            int64_t modifiedTime = (int64_t)fileStat.st_mtim.tv_sec * 1000000000 + fileStat.st_mtim.tv_nsec;
+            files.push_back(make_pair(modifiedTime, make_pair(path, (uint64_t)fileStat.st_size)));
+            totalSize += (uint64_t)fileStat.st_size;
+        }
+        closedir(pDir);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //从最久未使用的文件开始删除,直到总大小不超过容量
+        std::sort(files.begin(), files.end());
+        int removedCnt = 0;
+        for (size_t i = 0; i < files.size() && totalSize > this->m_diskCapacity; ++i)
+        {
+            const string & path = files[i].second.first;
+            if(path == keepPath)
+            {
+                continue;
+            }
+            if(0 == ::unlink(path.c_str()))
+            {
+                totalSize -= files[i].second.second;
+                ++removedCnt;
+            }
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        return removedCnt;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void JobCache::invalidate(const string &jobPath, uint64_t contentHash)
+{
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //删除内存中该文件的所有检测程式(同一路径先后加载过不同内容)及当前内容的检测程式
+        vector<uint64_t> hashes;
+        if(0 != contentHash)
+        {
+            hashes.push_back(contentHash);
+        }
+        for (map<uint64_t, Entry>::const_iterator it = this->m_entries.begin(); it != this->m_entries.end(); ++it)
+        {
+            if(it->second.pCachedJob->jobPath == jobPath && it->first != contentHash)
+            {
+                hashes.push_back(it->first);
+            }
+        }
+        for (size_t i = 0; i < hashes.size(); ++i)
+        {
+            this->erase(hashes[i]);
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //按哈希值删除对应的磁盘缓存文件,不读取检测程式文件
+        //哈希值未知时,旧内容的磁盘缓存不会再被使用,由trimDisk按容量淘汰
+        for (size_t i = 0; i < hashes.size(); ++i)
+        {
+            string path = this->blobPath(hashes[i]);
+            if(!path.empty())
+            {
+                ::unlink(path.c_str());
+            }
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void JobCache::clear()
+{
+    this->m_entries.clear();
+    this->m_lruList.clear();
+    this->m_memorySize = 0;
+}
+
+shared_ptr<CachedJob> JobCache::capture(uint64_t contentHash,
+                                        const string &jobPath,
+                                        InspectionData *pInspectionData,
+                                        shared_ptr<const JobSnapshot> pSnapshot)
+{
+    try
+    {
+        Board * pBoard = pInspectionData->pBoard();
+        if(pBoard->componentTable().size() != pBoard->pMeasuredObjList()->size())
+        {
+            THROW_EXCEPTION("元件表与检测对象链表不一致,请先生成元件表!");
+        }
+
+        shared_ptr<CachedJob> pCachedJob = make_shared<CachedJob>();
+        pCachedJob->contentHash = contentHash;
+        pCachedJob->jobPath = jobPath;
+        pCachedJob->pSnapshot = pSnapshot;
+
+        //元件表及索引中只有索引号,元件的ID按链表(即元件表)的顺序另外保存
+        pCachedJob->ids.reserve(pBoard->pMeasuredObjList()->size());
+        for (MeasuredObj * pObj = pBoard->pMeasuredObjList()->pHead(); nullptr != pObj; pObj = pObj->pNextMeasuredObj())
+        {
+            pCachedJob->ids.push_back(pObj->id());
+        }
+
+        //复制元件表,空间索引关联到缓存项自己的元件表
+        pCachedJob->componentTable = pBoard->componentTable();
+        pCachedJob->spatialIndex.assign(pBoard->spatialIndex(), &pCachedJob->componentTable);
+
+        return pCachedJob;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void JobCache::restore(const CachedJob &cachedJob, InspectionData *pInspectionData)
+{
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //清空原有的检测对象,从快照中恢复检测程式及基板的基本信息
+        Board * pBoard = pInspectionData->pBoard();
+        pBoard->clearMeasuredObjs();
+
+        const SnapshotHeader & header = cachedJob.pSnapshot->header();
+        pInspectionData->setVersion(header.version);
+        pInspectionData->setLastEditingTime(header.lastEditingTime);
+        pBoard->setName(header.boardName);
+        pBoard->setOriginalX(header.originalX);
+        pBoard->setOriginalY(header.originalY);
+        pBoard->setSizeX(header.sizeX);
+        pBoard->setSizeY(header.sizeY);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //从元件表生成检测对象,一次性分配并链接到链表尾部
+        const ComponentTable & table = cachedJob.componentTable;
+        const int cnt = table.size();
+        if(cnt > 0)
+        {
+            MeasuredObj * measuredObjArr = pBoard->measuredObjPool().allocate(cnt);
+            for (int i = 0; i < cnt; ++i)
+            {
+                measuredObjArr[i].setId(cachedJob.ids[i]);
+                measuredObjArr[i].setName(table.name(i));
+                Rectangle rect(table.xPos()[i], table.yPos()[i], table.width()[i], table.height()[i], table.angle()[i]);
+                measuredObjArr[i].setRectangle(&rect);
+            }
+            pBoard->pMeasuredObjList()->append(measuredObjArr, measuredObjArr + cnt);
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step3
+        //复制元件表及空间索引,不再重新建立
+        pBoard->componentTable() = table;
+        pBoard->spatialIndex().assign(cachedJob.spatialIndex, &pBoard->componentTable());
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void JobCache::erase(uint64_t contentHash)
+{
+    map<uint64_t, Entry>::iterator it = this->m_entries.find(contentHash);
+    if(it == this->m_entries.end())
+    {
+        return;
+    }
+
+    this->m_memorySize -= it->second.byteSize;
+    this->m_lruList.erase(it->second.lruIt);
+    this->m_entries.erase(it);
+}
+
+void JobCache::evict()
+{
+    //至少保留最近使用的一项
+    while(this->m_memorySize > this->m_memoryCapacity && this->m_lruList.size() > 1)
+    {
+        this->erase(this->m_lruList.back());
+    }
+}
+
+size_t JobCache::estimateSize(const CachedJob &cachedJob)
+{
+    //元件表的列数据,ID,R-tree(每个元件的外接矩形及索引号,按节点填充率约1.5倍计),
+    //快照中的列数据及名称,再加上所有名称的字符数(元件表的名称池及快照各一份)
+    const size_t cnt = (size_t)cachedJob.componentTable.size();
+    size_t byteSize = sizeof(CachedJob);
+    byteSize += cnt * (5 * sizeof(double) + sizeof(int) + sizeof(int64_t));
+    byteSize += cnt * (4 * sizeof(double) + sizeof(int)) * 3 / 2;
+    byteSize += cnt * (5 * sizeof(double) + sizeof(std::string));
+    for (size_t i = 0; i < cnt; ++i)
+    {
+        byteSize += cachedJob.componentTable.name((int)i).size() * 2;
+    }
+
+    //拍照计划中每个FOV的元件索引号,及检测计划的ROI
+    const vector<Fov> & fovs = cachedJob.fovPlan.fovs();
+    for (size_t i = 0; i < fovs.size(); ++i)
+    {
+        byteSize += sizeof(Fov) + fovs[i].componentIndices.size() * sizeof(int);
+    }
+    byteSize += cachedJob.inspectionPlan.rois().size() * sizeof(CompiledRoi);
+    byteSize += (size_t)(cachedJob.inspectionPlan.fovCount() + 1) * (2 * sizeof(double) + sizeof(int));
+
+    return byteSize;
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
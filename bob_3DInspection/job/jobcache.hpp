@@ -0,0 +1,209 @@
+#ifndef JOBCACHE_HPP
+#define JOBCACHE_HPP
+
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <memory>
+#include <cstdint>
+
+#include "../sdk/customexception.hpp"
+#include "../sdk/hash.hpp"
+#include "inspectiondata.hpp"
+#include "componenttable.hpp"
+#include "spatialindex.hpp"
+#include "jobsnapshot.hpp"
+#include "fovplan.hpp"
+#include "inspectionplan.hpp"
+
+namespace Job
+{
+    /**
+     *  @brief CachedJob
+     *         缓存中一个已完全建立的检测程式: 元件表,空间索引,只读快照及编译后的拍照/检测计划
+     *         放入缓存后不再修改,可以被多次恢复
+     */
+    struct CachedJob
+    {
+        uint64_t contentHash{0};                        //检测程式文件内容的哈希值
+        std::string jobPath;                            //检测程式文件的路径
+        std::shared_ptr<const JobSnapshot> pSnapshot;   //检测程式的只读快照(含检测程式及基板的基本信息)
+        std::vector<int64_t> ids;                       //元件的ID,与元件表的顺序一致
+        ComponentTable componentTable;                  //元件表
+        SpatialIndex spatialIndex;                      //元件的空间索引,关联到本结构中的componentTable
+        uint64_t planHash{0};                           //编译拍照/检测计划时的哈希值(检测程式内容及拍照参数),0表示未编译
+        FovPlan fovPlan;                                //拍照计划
+        InspectionPlan inspectionPlan;                  //检测计划
+    };
+
+    /**
+     *  @brief JobCache
+     *         以检测程式文件内容的哈希值为键的缓存,重复加载未修改的检测程式时不再读取及建立
+     *         1.内存缓存: 保存CachedJob,按估计占用的内存淘汰最久未使用的检测程式
+     *         2.磁盘缓存: 目录中以哈希值命名的二进制检测程式(<哈希值>.bin,BinaryJob格式),
+     *           使用时通过mmap读取; 按文件修改时间(每次使用时更新)淘汰,总大小不超过容量
+     *         内容相同的文件哈希值相同,缓存项不会被用于内容不同的文件;
+     *         保存检测程式时调用invalidate,立即释放该文件旧内容的缓存
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class JobCache
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //常量
+        static const size_t DEFAULT_MEMORY_CAPACITY = 512ULL * 1024 * 1024;    //内存缓存的默认容量(字节)
+        static const uint64_t DEFAULT_DISK_CAPACITY = 2ULL * 1024 * 1024 * 1024;   //磁盘缓存的默认容量(字节)
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        JobCache();
+
+        ~JobCache();
+
+        JobCache(const JobCache &) = delete;
+        JobCache & operator=(const JobCache &) = delete;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //访存函数
+        //设置内存缓存的容量(字节),超出时立即淘汰
+        void setMemoryCapacity(size_t capacity);
+        size_t memoryCapacity() const {return this->m_memoryCapacity;}
+
+        //内存缓存当前估计占用的内存及检测程式的数量
+        size_t memorySize() const {return this->m_memorySize;}
+        int memoryCount() const {return (int)this->m_entries.size();}
+
+        //磁盘缓存的目录,为空时不使用磁盘缓存
+        const std::string & diskFolder() const {return this->m_diskFolder;}
+
+        //内存缓存命中及未命中的次数
+        uint64_t hitCount() const {return this->m_hitCount;}
+        uint64_t missCount() const {return this->m_missCount;}
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        /*
+        *  @brief  setDiskFolder
+        *          设置磁盘缓存的目录(不存在时创建)及容量
+        *  @param  folderPath:磁盘缓存的目录
+        *          capacity:磁盘缓存的容量(字节)
+        *  @return N/A
+        */
+        void setDiskFolder(const std::string & folderPath, uint64_t capacity = DEFAULT_DISK_CAPACITY);
+
+        /*
+        *  @brief  find
+        *          在内存缓存中查找检测程式
+        *  @param  contentHash:检测程式文件内容的哈希值
+        *  @return 缓存的检测程式,没有时为空
+        */
+        std::shared_ptr<const CachedJob> find(uint64_t contentHash);
+
+        //将检测程式放入内存缓存(相同哈希值的旧项被替换),超出容量时淘汰最久未使用的检测程式
+        void insert(std::shared_ptr<const CachedJob> pCachedJob);
+
+        /*
+        *  @brief  blobPath
+        *          磁盘缓存中二进制检测程式的路径(<目录>/<哈希值>.bin),文件不一定存在
+        *  @param  contentHash:检测程式文件内容的哈希值
+        *  @return 路径,没有设置磁盘缓存时为空
+        */
+        std::string blobPath(uint64_t contentHash) const;
+
+        //记录磁盘缓存中的文件被使用(更新修改时间),淘汰时最后淘汰
+        void touch(const std::string & path);
+
+        /*
+        *  @brief  trimDisk
+        *          磁盘缓存超出容量时,按修改时间从旧到新删除文件
+        *  @param  keepPath:不删除的文件(如刚写入的文件)
+        *  @return 删除的文件数量
+        */
+        int trimDisk(const std::string & keepPath = "");
+
+        /*
+        *  @brief  invalidate
+        *          在修改检测程式文件之前调用,删除该文件在内存缓存中的检测程式,
+        *          以及文件当前内容对应的磁盘缓存文件(修改后不会再被使用)
+        *          不读取检测程式文件,当前内容的哈希值由调用者提供(加载时记录或取自目录索引)
+        *  @param  jobPath:检测程式文件的路径
+        *          contentHash:文件当前内容的哈希值,0表示未知(只删除内存缓存中该路径的检测程式)
+        *  @return N/A
+        */
+        void invalidate(const std::string & jobPath, uint64_t contentHash);
+
+        //清空内存缓存(不删除磁盘缓存)
+        void clear();
+
+        /*
+        *  @brief  capture
+        *          由当前已建立的检测程式(元件表及空间索引已建立)生成缓存项,复制元件表及空间索引
+        *  @param  contentHash:检测程式文件内容的哈希值
+        *          jobPath:检测程式文件的路径
+        *          pInspectionData:检测程式数据
+        *          pSnapshot:检测程式的只读快照
+        *  @return 缓存项(拍照/检测计划由调用者设置)
+        */
+        static std::shared_ptr<CachedJob> capture(uint64_t contentHash,
+                                                  const std::string & jobPath,
+                                                  InspectionData * pInspectionData,
+                                                  std::shared_ptr<const JobSnapshot> pSnapshot);
+
+        /*
+        *  @brief  restore
+        *          将缓存的检测程式恢复到pInspectionData: 基本信息,检测对象(从board的内存池中一次性分配),
+        *          元件表及空间索引(复制,不重新建立)
+        *  @param  cachedJob:缓存的检测程式
+        *          pInspectionData:检测程式数据,原有的检测对象被清空
+        *  @return N/A
+        */
+        static void restore(const CachedJob & cachedJob, InspectionData * pInspectionData);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //从内存缓存中删除一项
+        void erase(uint64_t contentHash);
+
+        //超出容量时淘汰最久未使用的检测程式
+        void evict();
+
+        //估计缓存项占用的内存(字节)
+        static size_t estimateSize(const CachedJob & cachedJob);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //类型
+        //内存缓存的一项: 缓存的检测程式,在LRU链表中的位置及估计占用的内存
+        struct Entry
+        {
+            std::shared_ptr<const CachedJob> pCachedJob;
+            std::list<uint64_t>::iterator lruIt;
+            size_t byteSize;
+        };
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        size_t m_memoryCapacity;                        //内存缓存的容量
+        size_t m_memorySize;                            //内存缓存估计占用的内存
+        std::list<uint64_t> m_lruList;                  //按使用时间排列的哈希值,最近使用的在前
+        std::map<uint64_t, Entry> m_entries;           //内存缓存,以哈希值为键
+
+        std::string m_diskFolder;                       //磁盘缓存的目录(以'/'结尾)
+        uint64_t m_diskCapacity;                        //磁盘缓存的容量
+
+        uint64_t m_hitCount;
+        uint64_t m_missCount;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace Job
+
+#endif // JOBCACHE_HPP
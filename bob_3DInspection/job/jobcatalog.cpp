@@ -0,0 +1,365 @@
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <map>
+#include <algorithm>
+
+#include "jobcatalog.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK;
+using namespace SSDK::DB;
+
+const char * JobCatalog::CATALOG_FILE_NAME = ".jobcatalog";
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//构造 & 析构函数
+JobCatalog::JobCatalog()
+    : m_changed(true)
+{
+
+}
+
+JobCatalog::~JobCatalog()
+{
+    this->close();
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//成员函数
+void JobCatalog::open(const string &folderPath, bool watch)
+{
+    try
+    {
+        this->close();
+
+        this->m_folderPath = folderPath;
+        if(!this->m_folderPath.empty() && '/' != this->m_folderPath.back())
+        {
+            this->m_folderPath += '/';
+        }
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //打开索引数据库,以文件名为主键,按基板名称建立索引供搜索
+        unique_ptr<SqliteDB> pCatalogDb(new SqliteDB());
+        if(!pCatalogDb->open(this->m_folderPath + CATALOG_FILE_NAME))
+        {
+            THROW_EXCEPTION("打开检测程式索引失败:" + this->m_folderPath);
+        }
+        bool ok = pCatalogDb->execute("CREATE TABLE IF NOT EXISTS JobCatalog("
+                                      "FileName TEXT PRIMARY KEY,Version TEXT,BoardName TEXT,ComponentCount INTEGER,"
+                                      "LastEditingTime TEXT,Size INTEGER,ModifiedTime INTEGER,Hash INTEGER);") &&
+                  pCatalogDb->execute("CREATE INDEX IF NOT EXISTS JobCatalogBoardName ON JobCatalog(BoardName);");
+        if(!ok)
+        {
+            THROW_EXCEPTION("创建检测程式索引失败:" + this->m_folderPath);
+        }
+        this->m_pCatalogDb = std::move(pCatalogDb);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //监视目录,目录中的文件新增,删除或修改时置位m_changed
+        //没有QCoreApplication时通知永远不会分发,开启监视会使索引不再更新,只按文件的大小及修改时间比较
+        this->m_changed = true;
+        if(watch && nullptr != QCoreApplication::instance())
+        {
+            this->m_pWatcher.reset(new QFileSystemWatcher());
+            this->m_pWatcher->addPath(QString::fromStdString(this->m_folderPath));
+            std::atomic<bool> * pChanged = &this->m_changed;
+            QObject::connect(this->m_pWatcher.get(), &QFileSystemWatcher::directoryChanged,
+                             [pChanged](const QString &)
+            {
+                *pChanged = true;
+            });
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void JobCatalog::close()
+{
+    this->m_pWatcher.reset();
+    if(this->m_pCatalogDb)
+    {
+        this->m_pCatalogDb->close();
+        this->m_pCatalogDb.reset();
+    }
+}
+
+int JobCatalog::refresh()
+{
+    try
+    {
+        if(!this->isOpened())
+        {
+            THROW_EXCEPTION("检测程式索引尚未打开!");
+        }
+        //先清除标志,扫描期间的变化留给下一次refresh
+        this->m_changed = false;
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //读取索引中所有文件的大小及修改时间
+        map<string, pair<int64_t, int64_t>> indexed;
+        {
+            string fileName;
+            int64_t size = 0, modifiedTime = 0;
+            RowReader<string, int64_t, int64_t> reader(this->m_pCatalogDb.get(),
+                                                       "select FileName,Size,ModifiedTime from JobCatalog");
+            while(reader.next(fileName, size, modifiedTime))
+            {
+                indexed[fileName] = make_pair(size, modifiedTime);
+            }
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //扫描目录,只比较大小及修改时间(stat),新增及变化的文件才打开读取
+        DIR * pDir = opendir(this->m_folderPath.c_str());
+        if(nullptr == pDir)
+        {
+            THROW_EXCEPTION("检测程式目录不存在:" + this->m_folderPath);
+        }
+
+        vector<JobCatalogEntry> changedEntries;
+        for (dirent * pEntry = readdir(pDir); nullptr != pEntry; pEntry = readdir(pDir))
+        {
+            string fileName = pEntry->d_name;
+            struct stat fileStat;
+            string path = this->m_folderPath + fileName;
+            if(!isJobFileName(fileName) || 0 != ::stat(path.c_str(), &fileStat) || !S_ISREG(fileStat.st_mode))
+            {
+                continue;
+            }
+
+            int64_t size = (int64_t)fileStat.st_size;
+            int64_t modifiedTime = (int64_t)fileStat.st_mtim.tv_sec * 1000000000 + fileStat.st_mtim.tv_nsec;
+            map<string, pair<int64_t, int64_t>>::iterator it = indexed.find(fileName);
+            if(it != indexed.end())
+            {
+                bool unchanged = (it->second.first == size && it->second.second == modifiedTime);
+                indexed.erase(it);
+                if(unchanged)
+                {
+                    continue;
+                }
+            }
+
+            JobCatalogEntry entry;
+            entry.fileName = fileName;
+            entry.path = path;
+            entry.size = size;
+            entry.modifiedTime = modifiedTime;
+            readEntry(entry);
+            changedEntries.push_back(entry);
+        }
+        closedir(pDir);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step3
+        //在一个事务中写入变化的检测程式,并删除已不存在的文件(indexed中剩余的)
+        if(changedEntries.empty() && indexed.empty())
+        {
+            return 0;
+        }
+
+        SqliteDB * pDb = this->m_pCatalogDb.get();
+        if(!pDb->begin())
+        {
+            THROW_EXCEPTION("开始事务失败,无法更新检测程式索引!");
+        }
+
+        bool ok = true;
+        pDb->prepare("INSERT OR REPLACE INTO JobCatalog(FileName,Version,BoardName,ComponentCount,"
+                     "LastEditingTime,Size,ModifiedTime,Hash) VALUES(?,?,?,?,?,?,?,?);");
+        for (size_t i = 0; ok && i < changedEntries.size(); ++i)
+        {
+            const JobCatalogEntry & entry = changedEntries[i];
+            ok = pDb->executeWithParms(entry.fileName.data(),
+                                       entry.version.data(),
+                                       entry.boardName.data(),
+                                       entry.componentCount,
+                                       entry.lastEditingTime.data(),
+                                       entry.size,
+                                       entry.modifiedTime,
+                                       entry.hash);
+        }
+
+        pDb->prepare("DELETE FROM JobCatalog WHERE FileName=?;");
+        for (map<string, pair<int64_t, int64_t>>::const_iterator it = indexed.begin(); ok && it != indexed.end(); ++it)
+        {
+            ok = pDb->executeWithParms(it->first.data());
+        }
+
+        if(!ok || !pDb->commit())
+        {
+            pDb->rollBack();
+            THROW_EXCEPTION("更新检测程式索引失败!");
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        return (int)(changedEntries.size() + indexed.size());
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+int JobCatalog::refreshIfChanged()
+{
+    if(this->m_pWatcher && !this->m_changed)
+    {
+        return 0;
+    }
+
+    return this->refresh();
+}
+
+vector<JobCatalogEntry> JobCatalog::entries()
+{
+    return this->query("", "");
+}
+
+vector<JobCatalogEntry> JobCatalog::search(const string &keyword)
+{
+    //转义LIKE的通配符,关键字按字面匹配
+    string pattern = "%";
+    for (size_t i = 0; i < keyword.size(); ++i)
+    {
+        if('%' == keyword[i] || '_' == keyword[i] || '\\' == keyword[i])
+        {
+            pattern += '\\';
+        }
+        pattern += keyword[i];
+    }
+    pattern += '%';
+
+    return this->query("FileName LIKE ?1 ESCAPE '\\' OR BoardName LIKE ?1 ESCAPE '\\'", pattern);
+}
+
+bool JobCatalog::isJobFileName(const string &fileName)
+{
+    static const char * excludedSuffixes[] = {".xml", ".plan", ".bin", ".tmp", "-wal", "-shm", "-journal"};
+
+    if(fileName.empty() || '.' == fileName[0])
+    {
+        return false;
+    }
+
+    for (const char * suffix : excludedSuffixes)
+    {
+        size_t length = char_traits<char>::length(suffix);
+        if(fileName.size() >= length &&
+           0 == fileName.compare(fileName.size() - length, length, suffix))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool JobCatalog::isCurrent(const JobCatalogEntry &entry)
+{
+    struct stat fileStat;
+    if(0 != ::stat(entry.path.c_str(), &fileStat))
+    {
+        return false;
+    }
+
+    int64_t modifiedTime = (int64_t)fileStat.st_mtim.tv_sec * 1000000000 + fileStat.st_mtim.tv_nsec;
+    return (int64_t)fileStat.st_size == entry.size && modifiedTime == entry.modifiedTime;
+}
+
+bool JobCatalog::readEntry(JobCatalogEntry &entry)
+{
+    try
+    {
+        SqliteDB sqlite;
+        if(!sqlite.open(entry.path, SQLITE_OPEN_READONLY))
+        {
+            return false;
+        }
+
+        bool ok = false;
+        {
+            RowReader<string, string> jobReader(&sqlite, "select Version,LastEditingTime from Job");
+            RowReader<string> boardReader(&sqlite, "select Name from Board");
+            RowReader<int> countReader(&sqlite, "select count(*) from MeasuredObjList");
+            ok = jobReader.next(entry.version, entry.lastEditingTime) &&
+                 boardReader.next(entry.boardName) &&
+                 countReader.next(entry.componentCount);
+        }
+        sqlite.close();
+
+        if(!ok)
+        {
+            entry.version.clear();
+            return false;
+        }
+
+        entry.hash = Hash::fileHash(entry.path);
+        return true;
+    }
+    catch(const exception &ex)
+    {
+        //不是检测程式或已损坏: 只记录文件信息
+        entry.version.clear();
+        return false;
+    }
+}
+
+vector<JobCatalogEntry> JobCatalog::query(const string &where, const string &keyword)
+{
+    try
+    {
+        if(!this->isOpened())
+        {
+            THROW_EXCEPTION("检测程式索引尚未打开!");
+        }
+
+        //版本为空的是无法读取的文件,不列出
+        string sqlQuery = "select FileName,Version,BoardName,ComponentCount,LastEditingTime,Size,ModifiedTime,Hash "
+                          "from JobCatalog where Version<>''";
+        if(!where.empty())
+        {
+            sqlQuery += " and (" + where + ")";
+        }
+        sqlQuery += " order by FileName";
+
+        RowReader<string, string, string, int, string, int64_t, int64_t, int64_t> reader(this->m_pCatalogDb.get(), sqlQuery);
+        if(!keyword.empty() && !reader.bind(keyword))
+        {
+            THROW_EXCEPTION("绑定检测程式索引的查询参数失败!");
+        }
+
+        vector<JobCatalogEntry> result;
+        JobCatalogEntry entry;
+        int64_t hash = 0;
+        while(reader.next(entry.fileName, entry.version, entry.boardName, entry.componentCount,
+                          entry.lastEditingTime, entry.size, entry.modifiedTime, hash))
+        {
+            entry.path = this->m_folderPath + entry.fileName;
+            entry.hash = (uint64_t)hash;
+            result.push_back(entry);
+        }
+
+        return result;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,147 @@
+#ifndef JOBCATALOG_HPP
+#define JOBCATALOG_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+
+#include <QFileSystemWatcher>
+#include <QCoreApplication>
+
+#include "../sdk/customexception.hpp"
+#include "../sdk/hash.hpp"
+#include "../sdk/DB/sqlitedb.hpp"
+#include "../sdk/DB/rowreader.hpp"
+
+namespace Job
+{
+    /**
+     *  @brief JobCatalogEntry
+     *         目录中一个检测程式的摘要信息
+     */
+    struct JobCatalogEntry
+    {
+        std::string fileName;           //文件名(不含目录)
+        std::string path;               //文件的完整路径
+        std::string version;            //检测程式的版本
+        std::string boardName;          //基板的名称
+        int componentCount{0};          //检测对象的数量
+        std::string lastEditingTime;    //最后一次编辑时间
+        int64_t size{0};                //文件大小(字节)
+        int64_t modifiedTime{0};        //文件的修改时间(自1970-01-01起的纳秒数)
+        uint64_t hash{0};               //文件内容的哈希值(Hash::fileHash)
+    };
+
+    /**
+     *  @brief JobCatalog
+     *         检测程式目录的索引
+     *         目录中所有检测程式的摘要信息保存在该目录下的索引数据库(.jobcatalog)中,
+     *         列出及搜索检测程式只查询索引,不打开检测程式文件
+     *         refresh只比较文件的大小及修改时间,只重新读取新增及变化的检测程式,并删除已不存在的
+     *         开启监视后(需要Qt事件循环),目录没有变化时refreshIfChanged不再扫描目录;
+     *             没有QCoreApplication时(如控制台程序)不监视,每次refreshIfChanged都比较文件的大小及修改时间
+     *         无法读取的文件(非检测程式)也记录在索引中(版本为空),文件不变时不再重复打开,但不会列出
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class JobCatalog
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //常量
+        static const char * CATALOG_FILE_NAME;      //索引数据库的文件名
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        JobCatalog();
+
+        ~JobCatalog();
+
+        JobCatalog(const JobCatalog &) = delete;
+        JobCatalog & operator=(const JobCatalog &) = delete;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        /*
+        *  @brief  open
+        *          打开(不存在时创建)目录的索引,之前打开的索引先关闭
+        *  @param  folderPath:检测程式目录
+        *          watch:是否监视目录的变化; 通知由Qt事件循环分发,没有QCoreApplication时忽略该参数(不会收到通知)
+        *                sqlite写入时在目录中创建及删除日志文件,就地修改检测程式(及写入索引本身)也会触发一次通知
+        *  @return N/A
+        */
+        void open(const std::string & folderPath, bool watch = false);
+
+        //是否正在监视目录的变化
+        bool isWatching() const {return nullptr != this->m_pWatcher;}
+
+        //关闭索引及监视
+        void close();
+
+        //索引是否已打开
+        bool isOpened() const {return nullptr != this->m_pCatalogDb;}
+
+        //检测程式目录(以'/'结尾)
+        const std::string & folderPath() const {return this->m_folderPath;}
+
+        /*
+        *  @brief  refresh
+        *          扫描目录,更新新增及变化的检测程式,删除已不存在的检测程式
+        *          所有修改在一个事务中写入索引
+        *  @param  N/A
+        *  @return 索引中新增,更新及删除的检测程式的数量
+        */
+        int refresh();
+
+        /*
+        *  @brief  refreshIfChanged
+        *          没有开启监视,或监视到目录变化时才调用refresh
+        *  @param  N/A
+        *  @return 索引中新增,更新及删除的检测程式的数量
+        */
+        int refreshIfChanged();
+
+        //按文件名排序列出所有检测程式
+        std::vector<JobCatalogEntry> entries();
+
+        /*
+        *  @brief  search
+        *          按文件名或基板名称搜索检测程式(不区分大小写的部分匹配)
+        *  @param  keyword:关键字
+        *  @return 按文件名排序的检测程式
+        */
+        std::vector<JobCatalogEntry> search(const std::string & keyword);
+
+        //目录下的文件名是否可能是检测程式(排除导出及生成的文件,隐藏文件及sqlite的日志文件)
+        static bool isJobFileName(const std::string & fileName);
+
+        //文件的大小及修改时间是否仍与索引中记录的一致(一致时entry.hash即为文件当前内容的哈希值)
+        static bool isCurrent(const JobCatalogEntry & entry);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //读取检测程式文件的摘要信息,失败时返回false(entry中只有文件信息)
+        static bool readEntry(JobCatalogEntry & entry);
+
+        //执行查询,where为空时列出所有检测程式
+        std::vector<JobCatalogEntry> query(const std::string & where, const std::string & keyword);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        std::string m_folderPath;                                   //检测程式目录
+        std::unique_ptr<SSDK::DB::SqliteDB> m_pCatalogDb;           //索引数据库
+        std::unique_ptr<QFileSystemWatcher> m_pWatcher;             //目录监视,未开启时为空
+        std::atomic<bool> m_changed;                                //监视到目录变化后置位,refresh后清除
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace Job
+
+#endif // JOBCATALOG_HPP
@@ -0,0 +1,306 @@
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+
+#include "jobmigrator.hpp"
+#include "jobcatalog.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK::DB;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//内置的升级
+namespace
+{
+    //2017.12.02 bob
+    //V1 -> V2: 所有的检测对象添加Angle字段,并设置默认值为0
+    bool upgradeV1ToV2(SqliteDB * sqlite)
+    {
+        return sqlite->execute("ALTER TABLE MeasuredObjList ADD Angle REAL DEFAULT 0;");
+    }
+
+    //2026.10.17 bob
+    //V2 -> V3: 重建MeasuredObjList表,添加Id INTEGER PRIMARY KEY列(rowid的别名),保留原来的rowid作为Id
+    //没有INTEGER PRIMARY KEY的表在VACUUM时rowid可能重新编号,ChangeTracker按rowid保存修改,需要稳定的ID
+    bool upgradeV2ToV3(SqliteDB * sqlite)
+    {
+        return sqlite->execute("CREATE TABLE MeasuredObjListV3(Id INTEGER PRIMARY KEY,Name TEXT,PosX REAL,PosY REAL,Width REAL,Height REAL,Angle REAL);") &&
+               sqlite->execute("INSERT INTO MeasuredObjListV3(Id,Name,PosX,PosY,Width,Height,Angle) "
+                               "SELECT rowid,Name,PosX,PosY,Width,Height,Angle FROM MeasuredObjList ORDER BY rowid;") &&
+               sqlite->execute("DROP TABLE MeasuredObjList;") &&
+               sqlite->execute("ALTER TABLE MeasuredObjListV3 RENAME TO MeasuredObjList;");
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//构造 & 析构函数
+JobMigrator::JobMigrator()
+{
+    //最早的版本为V1,新的格式在此处按顺序注册
+    this->m_currentVersion = "V1";
+    this->registerStep("V1", "V2", upgradeV1ToV2);
+    this->registerStep("V2", "V3", upgradeV2ToV3);
+}
+
+JobMigrator::~JobMigrator()
+{
+
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//成员函数
+void JobMigrator::registerStep(const string &fromVersion,
+                               const string &toVersion,
+                               function<bool (SqliteDB *)> upgrade)
+{
+    if(fromVersion != this->m_currentVersion)
+    {
+        THROW_EXCEPTION("升级必须从当前版本" + this->m_currentVersion + "开始!");
+    }
+    if(toVersion == fromVersion || this->isSupported(toVersion))
+    {
+        THROW_EXCEPTION("升级后的版本" + toVersion + "已存在!");
+    }
+
+    MigrationStep step;
+    step.fromVersion = fromVersion;
+    step.toVersion = toVersion;
+    step.upgrade = upgrade;
+    this->m_steps[fromVersion] = step;
+    this->m_currentVersion = toVersion;
+}
+
+bool JobMigrator::isSupported(const string &version) const
+{
+    return version == this->m_currentVersion || this->m_steps.count(version) > 0;
+}
+
+string JobMigrator::readVersion(SqliteDB *sqlite)
+{
+    string version;
+    RowReader<string> reader(sqlite, "select Version from Job");
+    if(!reader.next(version))
+    {
+        THROW_EXCEPTION("读取检测程式的版本信息失败!");
+    }
+
+    return version;
+}
+
+string JobMigrator::migrate(SqliteDB *sqlite) const
+{
+    try
+    {
+        const string originalVersion = readVersion(sqlite);
+        if(!this->isSupported(originalVersion))
+        {
+            THROW_EXCEPTION("检测程式版本有误,请确认!!");
+        }
+
+        //每一步(升级及修改版本号)在一个事务中执行,中途失败时文件停留在上一个完整的版本
+        string version = originalVersion;
+        while(version != this->m_currentVersion)
+        {
+            const MigrationStep & step = this->m_steps.find(version)->second;
+            if(!sqlite->begin())
+            {
+                THROW_EXCEPTION("开始事务失败,无法升级检测程式!");
+            }
+
+            bool ok = step.upgrade(sqlite) &&
+                      sqlite->execute("UPDATE Job SET Version=?;", step.toVersion.data()) &&
+                      sqlite->commit();
+            if(!ok)
+            {
+                sqlite->rollBack();
+                THROW_EXCEPTION("检测程式从" + step.fromVersion + "升级到" + step.toVersion + "失败!");
+            }
+            version = step.toVersion;
+        }
+
+        return originalVersion;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+bool JobMigrator::migrateFile(const string &path) const
+{
+    try
+    {
+        //先只读检查版本,已是当前版本的检测程式不需要写权限
+        SqliteDB sqlite;
+        if(!sqlite.open(path, SQLITE_OPEN_READONLY))
+        {
+            THROW_EXCEPTION("打开检测程式失败:" + path);
+        }
+        string version = readVersion(&sqlite);
+        sqlite.close();
+        if(version == this->m_currentVersion)
+        {
+            return false;
+        }
+
+        if(!sqlite.open(path, SQLITE_OPEN_READWRITE))
+        {
+            THROW_EXCEPTION("打开检测程式失败:" + path);
+        }
+        this->migrate(&sqlite);
+        sqlite.close();
+
+        return true;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+string JobMigrator::openUpgraded(const string &path, SqliteDB &memoryDb) const
+{
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //只读打开检测程式,整个复制到内存数据库后立即关闭文件
+        SqliteDB file;
+        if(!file.open(path, SQLITE_OPEN_READONLY))
+        {
+            THROW_EXCEPTION("打开检测程式失败:" + path);
+        }
+        if(!memoryDb.open(":memory:") || !memoryDb.copyFrom(file))
+        {
+            file.close();
+            THROW_EXCEPTION("读取检测程式到内存失败:" + path);
+        }
+        file.close();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //在内存中升级,之后从memoryDb读取的即为当前版本的表结构
+        return this->migrate(&memoryDb);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+MigrationReport JobMigrator::migrateFolder(const string &folderPath,
+                                           int threadCount,
+                                           ProgressCallback progress) const
+{
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //扫描目录下的检测程式文件
+        DIR * pDir = opendir(folderPath.c_str());
+        if(nullptr == pDir)
+        {
+            THROW_EXCEPTION("检测程式目录不存在:" + folderPath);
+        }
+
+        string folder = folderPath;
+        if(!folder.empty() && '/' != folder.back())
+        {
+            folder += '/';
+        }
+
+        vector<string> paths;
+        for (dirent * pEntry = readdir(pDir); nullptr != pEntry; pEntry = readdir(pDir))
+        {
+            string path = folder + pEntry->d_name;
+            struct stat fileStat;
+            if(JobCatalog::isJobFileName(pEntry->d_name) && 0 == stat(path.c_str(), &fileStat) && S_ISREG(fileStat.st_mode))
+            {
+                paths.push_back(path);
+            }
+        }
+        closedir(pDir);
+        std::sort(paths.begin(), paths.end());
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //每个线程依次领取下一个文件,各自打开独立的连接升级
+        MigrationReport report;
+        report.total = (int)paths.size();
+        if(threadCount <= 0)
+        {
+            threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+        }
+        threadCount = std::min(threadCount, std::max(1, report.total));
+
+        atomic<int> nextIndex(0);
+        mutex reportMutex;
+        auto worker = [&]()
+        {
+            for (int i = nextIndex++; i < report.total; i = nextIndex++)
+            {
+                bool ok = true;
+                bool migrated = false;
+                string reason;
+                try
+                {
+                    migrated = this->migrateFile(paths[i]);
+                }
+                catch(const exception &ex)
+                {
+                    ok = false;
+                    reason = ex.what();
+                }
+
+                lock_guard<mutex> lock(reportMutex);
+                if(!ok)
+                {
+                    ++report.failed;
+                    report.failures.push_back(make_pair(paths[i], reason));
+                }
+                else if(migrated)
+                {
+                    ++report.migrated;
+                }
+                else
+                {
+                    ++report.upToDate;
+                }
+
+                if(progress)
+                {
+                    progress(report.failed + report.migrated + report.upToDate, report.total, paths[i], ok);
+                }
+            }
+        };
+
+        vector<thread> threads;
+        for (int i = 1; i < threadCount; ++i)
+        {
+            threads.push_back(thread(worker));
+        }
+        worker();
+        for (size_t i = 0; i < threads.size(); ++i)
+        {
+            threads[i].join();
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        return report;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,140 @@
+#ifndef JOBMIGRATOR_HPP
+#define JOBMIGRATOR_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+
+#include "../sdk/customexception.hpp"
+#include "../sdk/DB/sqlitedb.hpp"
+#include "../sdk/DB/rowreader.hpp"
+
+namespace Job
+{
+    /**
+     *  @brief MigrationStep
+     *         检测程式格式的一次升级(fromVersion -> toVersion)
+     *         upgrade只修改表结构及数据,不需要修改Job表中的版本号,也不需要开启事务
+     */
+    struct MigrationStep
+    {
+        std::string fromVersion;                                //升级前的版本
+        std::string toVersion;                                  //升级后的版本
+        std::function<bool(SSDK::DB::SqliteDB *)> upgrade;      //升级操作,失败返回false
+    };
+
+    /**
+     *  @brief MigrationReport
+     *         批量升级一个目录的结果
+     */
+    struct MigrationReport
+    {
+        int total{0};           //检测程式文件的数量
+        int migrated{0};        //已升级的数量
+        int upToDate{0};        //已是当前版本的数量
+        int failed{0};          //升级失败的数量
+        std::vector<std::pair<std::string, std::string>> failures;     //升级失败的文件及原因
+    };
+
+    /**
+     *  @brief JobMigrator
+     *         检测程式格式的升级链(V1->V2->...->Vn)
+     *         构造时注册所有内置的升级,当前版本即最后一次升级的toVersion
+     *         1.migrate: 就地升级检测程式文件,每一步在一个事务中执行(包括修改版本号),失败时回滚到该步之前的版本
+     *         2.openUpgraded: 只读方式打开检测程式,将其读入内存数据库后在内存中升级,不修改文件(加载及复判使用)
+     *         3.migrateFolder: 多线程升级目录下所有的检测程式,并报告进度(显式的批量操作,不在加载时自动执行)
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class JobMigrator
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //类型
+        //批量升级的进度回调: 已处理的数量,总数,刚处理完的文件,该文件是否成功
+        using ProgressCallback = std::function<void(int done, int total, const std::string & path, bool ok)>;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        JobMigrator();
+
+        ~JobMigrator();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        /*
+        *  @brief  registerStep
+        *          注册一次升级,fromVersion必须是当前版本(即升级链只能在末尾延长)
+        *  @param  fromVersion:升级前的版本
+        *          toVersion:升级后的版本,成为新的当前版本
+        *          upgrade:升级操作
+        *  @return N/A
+        */
+        void registerStep(const std::string & fromVersion,
+                          const std::string & toVersion,
+                          std::function<bool(SSDK::DB::SqliteDB *)> upgrade);
+
+        //当前(最新)版本
+        const std::string & currentVersion() const {return this->m_currentVersion;}
+
+        //version能否升级到当前版本(包括已是当前版本)
+        bool isSupported(const std::string & version) const;
+
+        //读取检测程式的版本(Job表的Version字段),读取失败时抛出异常
+        static std::string readVersion(SSDK::DB::SqliteDB * sqlite);
+
+        /*
+        *  @brief  migrate
+        *          将已打开的检测程式逐步升级到当前版本,每一步在一个事务中执行
+        *          某一步失败时回滚该步并抛出异常,之前已成功的步骤保留
+        *  @param  sqlite:已打开的检测程式(文件或内存数据库)
+        *  @return 升级前的版本
+        */
+        std::string migrate(SSDK::DB::SqliteDB * sqlite) const;
+
+        /*
+        *  @brief  migrateFile
+        *          打开检测程式文件并就地升级到当前版本,已是当前版本时只读取版本号
+        *  @param  path:检测程式文件的路径
+        *  @return true:已升级; false:已是当前版本,文件未修改
+        */
+        bool migrateFile(const std::string & path) const;
+
+        /*
+        *  @brief  openUpgraded
+        *          以只读方式打开检测程式,复制到内存数据库中并升级到当前版本,检测程式文件不会被修改
+        *          已是当前版本时同样复制到内存数据库(调用者可以在内存中建立索引等,不修改文件)
+        *  @param  path:检测程式文件的路径
+        *          memoryDb:未打开的数据库,返回时为已升级的内存数据库
+        *  @return 检测程式文件的版本
+        */
+        std::string openUpgraded(const std::string & path, SSDK::DB::SqliteDB & memoryDb) const;
+
+        /*
+        *  @brief  migrateFolder
+        *          升级目录下所有的检测程式,多个线程同时处理不同的文件
+        *          单个文件失败不影响其他文件,失败的文件及原因记录在报告中
+        *  @param  folderPath:检测程式目录(如AppSetting中的JobFolderPath)
+        *          threadCount:线程数,0表示使用CPU的核心数
+        *          progress:每处理完一个文件调用一次(在加锁的状态下调用,可以直接输出)
+        *  @return 升级结果
+        */
+        MigrationReport migrateFolder(const std::string & folderPath,
+                                      int threadCount = 0,
+                                      ProgressCallback progress = ProgressCallback()) const;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        std::map<std::string, MigrationStep> m_steps;   //以fromVersion为键的升级
+        std::string m_currentVersion;                   //当前版本
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace Job
+
+#endif // JOBMIGRATOR_HPP
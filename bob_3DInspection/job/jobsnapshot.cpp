@@ -0,0 +1,287 @@
+#include <algorithm>
+
+#include "jobsnapshot.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK;
+
+const int JobSnapshot::CHUNK_SIZE;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//ComponentChunk
+RectangleArray ComponentChunk::rectangles() const
+{
+    RectangleArray rects;
+    rects.xPos = this->m_xPos.data();
+    rects.yPos = this->m_yPos.data();
+    rects.width = this->m_width.data();
+    rects.height = this->m_height.data();
+    rects.angle = this->m_angle.data();
+    rects.size = this->size();
+
+    return rects;
+}
+
+void ComponentChunk::append(const string &name, const Rectangle &rectangle)
+{
+    this->m_name.push_back(name);
+    this->m_xPos.push_back(rectangle.xPos());
+    this->m_yPos.push_back(rectangle.yPos());
+    this->m_width.push_back(rectangle.width());
+    this->m_height.push_back(rectangle.height());
+    this->m_angle.push_back(rectangle.angle());
+}
+
+void ComponentChunk::set(int index, const string &name, const Rectangle &rectangle)
+{
+    this->m_name[index] = name;
+    this->m_xPos[index] = rectangle.xPos();
+    this->m_yPos[index] = rectangle.yPos();
+    this->m_width[index] = rectangle.width();
+    this->m_height[index] = rectangle.height();
+    this->m_angle[index] = rectangle.angle();
+}
+
+void ComponentChunk::remove(int index)
+{
+    this->m_name.erase(this->m_name.begin() + index);
+    this->m_xPos.erase(this->m_xPos.begin() + index);
+    this->m_yPos.erase(this->m_yPos.begin() + index);
+    this->m_width.erase(this->m_width.begin() + index);
+    this->m_height.erase(this->m_height.begin() + index);
+    this->m_angle.erase(this->m_angle.begin() + index);
+}
+
+void ComponentChunk::reserve(int cnt)
+{
+    this->m_name.reserve(cnt);
+    this->m_xPos.reserve(cnt);
+    this->m_yPos.reserve(cnt);
+    this->m_width.reserve(cnt);
+    this->m_height.reserve(cnt);
+    this->m_angle.reserve(cnt);
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//JobSnapshot
+JobSnapshot::JobSnapshot()
+{
+    this->m_revision = 0;
+    this->m_size = 0;
+}
+
+Rectangle JobSnapshot::rectangle(int index) const
+{
+    int chunkIndex = this->chunkIndexOf(index);
+    const ComponentChunk & chunk = *this->m_chunks[chunkIndex];
+    int i = index - this->m_chunkStarts[chunkIndex];
+
+    return Rectangle(chunk.xPos(i), chunk.yPos(i), chunk.width(i), chunk.height(i), chunk.angle(i));
+}
+
+shared_ptr<const JobSnapshot> JobSnapshot::create(InspectionData *pInspectionData)
+{
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //复制检测程式及基板的基本信息
+        shared_ptr<JobSnapshot> pSnapshot(new JobSnapshot());
+        Board * pBoard = pInspectionData->pBoard();
+
+        shared_ptr<SnapshotHeader> pHeader = make_shared<SnapshotHeader>();
+        pHeader->version = pInspectionData->version();
+        pHeader->lastEditingTime = pInspectionData->lastEditingTime();
+        pHeader->boardName = pBoard->name();
+        pHeader->originalX = pBoard->originalX();
+        pHeader->originalY = pBoard->originalY();
+        pHeader->sizeX = pBoard->sizeX();
+        pHeader->sizeY = pBoard->sizeY();
+        pSnapshot->m_pHeader = pHeader;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //将元件表按CHUNK_SIZE分块复制
+        const ComponentTable & table = pBoard->componentTable();
+        const int cnt = table.size();
+        pSnapshot->m_chunks.reserve((cnt + CHUNK_SIZE - 1) / CHUNK_SIZE);
+        pSnapshot->m_chunkStarts.reserve((cnt + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+        for (int base = 0; base < cnt; base += CHUNK_SIZE)
+        {
+            int n = std::min(CHUNK_SIZE, cnt - base);
+            shared_ptr<ComponentChunk> pChunk = make_shared<ComponentChunk>();
+            pChunk->reserve(n);
+            for (int i = base; i < base + n; ++i)
+            {
+                pChunk->append(table.name(i),
+                               Rectangle(table.xPos()[i], table.yPos()[i],
+                                         table.width()[i], table.height()[i],
+                                         table.angle()[i]));
+            }
+            pSnapshot->m_chunks.push_back(pChunk);
+            pSnapshot->m_chunkStarts.push_back(base);
+        }
+        pSnapshot->m_size = cnt;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        return pSnapshot;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+int JobSnapshot::chunkIndexOf(int index) const
+{
+    //最后一个起始索引号不大于index的块
+    return (int)(std::upper_bound(this->m_chunkStarts.begin(), this->m_chunkStarts.end(), index)
+                 - this->m_chunkStarts.begin()) - 1;
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//JobSnapshotEditor
+JobSnapshotEditor::JobSnapshotEditor(shared_ptr<const JobSnapshot> base)
+{
+    if(!base)
+    {
+        THROW_EXCEPTION("编辑的基础快照为空!");
+    }
+
+    //新快照先与基础快照共享所有块,只复制块指针数组
+    this->m_pSnapshot.reset(new JobSnapshot());
+    this->m_pSnapshot->m_revision = base->m_revision + 1;
+    this->m_pSnapshot->m_pHeader = base->m_pHeader;
+    this->m_pSnapshot->m_chunks = base->m_chunks;
+    this->m_pSnapshot->m_chunkStarts = base->m_chunkStarts;
+    this->m_pSnapshot->m_size = base->m_size;
+    this->m_mutableChunks.assign(base->m_chunks.size(), nullptr);
+}
+
+JobSnapshotEditor::~JobSnapshotEditor()
+{
+
+}
+
+SnapshotHeader &JobSnapshotEditor::mutableHeader()
+{
+    this->checkEditable();
+
+    if(!this->m_pMutableHeader)
+    {
+        this->m_pMutableHeader = make_shared<SnapshotHeader>(*this->m_pSnapshot->m_pHeader);
+        this->m_pSnapshot->m_pHeader = this->m_pMutableHeader;
+    }
+
+    return *this->m_pMutableHeader;
+}
+
+void JobSnapshotEditor::setComponent(int index, const string &name, const Rectangle &rectangle)
+{
+    this->checkEditable();
+    if(index < 0 || index >= this->m_pSnapshot->m_size)
+    {
+        THROW_EXCEPTION("元件的索引号超出范围!");
+    }
+
+    int chunkIndex = this->m_pSnapshot->chunkIndexOf(index);
+    this->mutableChunk(chunkIndex)->set(index - this->m_pSnapshot->m_chunkStarts[chunkIndex],
+                                        name,
+                                        rectangle);
+}
+
+int JobSnapshotEditor::appendComponent(const string &name, const Rectangle &rectangle)
+{
+    this->checkEditable();
+
+    //没有块或最后一块已满时新建一块
+    JobSnapshot * pSnapshot = this->m_pSnapshot.get();
+    int index = pSnapshot->m_size;
+    if(pSnapshot->m_chunks.empty() || pSnapshot->m_chunks.back()->size() >= JobSnapshot::CHUNK_SIZE)
+    {
+        shared_ptr<ComponentChunk> pChunk = make_shared<ComponentChunk>();
+        pSnapshot->m_chunks.push_back(pChunk);
+        pSnapshot->m_chunkStarts.push_back(index);
+        this->m_mutableChunks.push_back(pChunk.get());
+    }
+
+    this->mutableChunk((int)pSnapshot->m_chunks.size() - 1)->append(name, rectangle);
+    ++pSnapshot->m_size;
+
+    return index;
+}
+
+void JobSnapshotEditor::removeComponent(int index)
+{
+    this->checkEditable();
+    JobSnapshot * pSnapshot = this->m_pSnapshot.get();
+    if(index < 0 || index >= pSnapshot->m_size)
+    {
+        THROW_EXCEPTION("元件的索引号超出范围!");
+    }
+
+    //step1
+    //只复制元件所在的块并删除该元件,块被删空时移除该块
+    int chunkIndex = pSnapshot->chunkIndexOf(index);
+    ComponentChunk * pChunk = this->mutableChunk(chunkIndex);
+    pChunk->remove(index - pSnapshot->m_chunkStarts[chunkIndex]);
+    if(0 == pChunk->size())
+    {
+        pSnapshot->m_chunks.erase(pSnapshot->m_chunks.begin() + chunkIndex);
+        pSnapshot->m_chunkStarts.erase(pSnapshot->m_chunkStarts.begin() + chunkIndex);
+        this->m_mutableChunks.erase(this->m_mutableChunks.begin() + chunkIndex);
+    }
+    else
+    {
+        ++chunkIndex;
+    }
+
+    //step2
+    //之后的块内容不变,起始索引号减1
+    for (size_t i = chunkIndex; i < pSnapshot->m_chunkStarts.size(); ++i)
+    {
+        --pSnapshot->m_chunkStarts[i];
+    }
+    --pSnapshot->m_size;
+}
+
+shared_ptr<const JobSnapshot> JobSnapshotEditor::commit()
+{
+    if(!this->m_pSnapshot)
+    {
+        THROW_EXCEPTION("快照已提交,不能重复提交!");
+    }
+
+    shared_ptr<const JobSnapshot> pSnapshot = this->m_pSnapshot;
+    this->m_pSnapshot.reset();
+    this->m_pMutableHeader.reset();
+    this->m_mutableChunks.clear();
+
+    return pSnapshot;
+}
+
+void JobSnapshotEditor::checkEditable() const
+{
+    if(!this->m_pSnapshot)
+    {
+        THROW_EXCEPTION("快照已提交,不能继续编辑!");
+    }
+}
+
+ComponentChunk *JobSnapshotEditor::mutableChunk(int chunkIndex)
+{
+    if(nullptr == this->m_mutableChunks[chunkIndex])
+    {
+        shared_ptr<ComponentChunk> pChunk = make_shared<ComponentChunk>(*this->m_pSnapshot->m_chunks[chunkIndex]);
+        this->m_pSnapshot->m_chunks[chunkIndex] = pChunk;
+        this->m_mutableChunks[chunkIndex] = pChunk.get();
+    }
+
+    return this->m_mutableChunks[chunkIndex];
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,254 @@
+#ifndef JOBSNAPSHOT_HPP
+#define JOBSNAPSHOT_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "../sdk/customexception.hpp"
+#include "../sdk/rectangle.hpp"
+#include "../sdk/rectanglekernel.hpp"
+#include "inspectiondata.hpp"
+
+namespace Job
+{
+    /**
+     *  @brief SnapshotHeader
+     *         快照中检测程式及基板的基本信息
+     */
+    struct SnapshotHeader
+    {
+        std::string version;            //检测程式的版本
+        std::string lastEditingTime;    //最后一次编辑时间
+        std::string boardName;          //基板的名称
+        double originalX{0};            //基板原点X轴坐标
+        double originalY{0};            //基板原点Y轴坐标
+        double sizeX{0};                //基板的长
+        double sizeY{0};                //基板的宽
+    };
+
+    /**
+     *  @brief ComponentChunk
+     *         快照中一段连续的元件(最多JobSnapshot::CHUNK_SIZE个,删除元件后可能更少),按列存储
+     *         块发布后不再修改,编辑时只复制被修改的块,未修改的块由新旧快照共享
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class ComponentChunk
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //访存函数
+        //块中元件的数量
+        int size() const {return (int)this->m_xPos.size();}
+
+        //块中第index个元件的数据
+        const std::string & name(int index) const {return this->m_name[index];}
+        double xPos(int index) const {return this->m_xPos[index];}
+        double yPos(int index) const {return this->m_yPos[index];}
+        double width(int index) const {return this->m_width[index];}
+        double height(int index) const {return this->m_height[index];}
+        double angle(int index) const {return this->m_angle[index];}
+
+        //块中所有元件,可以直接用于RectangleKernel的批量运算
+        SSDK::RectangleArray rectangles() const;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数(只在块发布之前由JobSnapshot及JobSnapshotEditor调用)
+        //在块的末尾添加一个元件
+        void append(const std::string & name, const SSDK::Rectangle & rectangle);
+
+        //修改块中第index个元件
+        void set(int index, const std::string & name, const SSDK::Rectangle & rectangle);
+
+        //删除块中第index个元件,之后的元件前移
+        void remove(int index);
+
+        //预先分配cnt个元件的空间
+        void reserve(int cnt);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        std::vector<std::string> m_name;        //元件名称
+        std::vector<double> m_xPos;             //元件中心X轴坐标
+        std::vector<double> m_yPos;             //元件中心Y轴坐标
+        std::vector<double> m_width;            //元件的宽
+        std::vector<double> m_height;           //元件的高
+        std::vector<double> m_angle;            //元件的角度
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+
+    /**
+     *  @brief JobSnapshot
+     *         检测程式某一版本的只读快照,创建后不再修改,可以被任意多个线程同时读取
+     *         元件按CHUNK_SIZE分块存放,块之间通过shared_ptr共享,
+     *         通过JobSnapshotEditor编辑时只复制被修改的块及块指针数组,不复制整个检测程式
+     *         删除元件后块的大小不再相同,元件所在的块通过每块第一个元件的索引号(chunkStart)二分查找
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class JobSnapshot
+    {
+        friend class JobSnapshotEditor;
+
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //常量
+        static const int CHUNK_SIZE = 1024;     //每块元件的数量
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //访存函数
+        //快照的修订号,每次编辑提交后加1
+        uint64_t revision() const {return this->m_revision;}
+
+        //检测程式及基板的基本信息
+        const SnapshotHeader & header() const {return *this->m_pHeader;}
+
+        //元件的数量
+        int size() const {return this->m_size;}
+
+        //块的数量,第index块及其第一个元件的索引号
+        int chunkCount() const {return (int)this->m_chunks.size();}
+        const ComponentChunk & chunk(int index) const {return *this->m_chunks[index];}
+        int chunkStart(int index) const {return this->m_chunkStarts[index];}
+
+        //第index个元件的数据
+        const std::string & name(int index) const
+        {
+            int chunkIndex = this->chunkIndexOf(index);
+            return this->m_chunks[chunkIndex]->name(index - this->m_chunkStarts[chunkIndex]);
+        }
+        SSDK::Rectangle rectangle(int index) const;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        /*
+        *  @brief  create
+        *          根据当前加载的检测程式创建第一个快照(修订号为0)
+        *          元件数据取自board的元件表,调用前需要先buildComponentTable
+        *  @param  pInspectionData:检测程式数据
+        *  @return 快照
+        */
+        static std::shared_ptr<const JobSnapshot> create(InspectionData * pInspectionData);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造函数,只能通过create或JobSnapshotEditor创建
+        JobSnapshot();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //第index个元件所在块的索引号
+        int chunkIndexOf(int index) const;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        uint64_t m_revision;                                            //修订号
+        std::shared_ptr<const SnapshotHeader> m_pHeader;                //基本信息(未修改时新旧快照共享)
+        std::vector<std::shared_ptr<const ComponentChunk>> m_chunks;    //元件块
+        std::vector<int> m_chunkStarts;                                 //每块第一个元件的索引号(递增)
+        int m_size;                                                     //元件的数量
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+
+    /**
+     *  @brief JobSnapshotEditor
+     *         在一个快照的基础上编辑,commit后生成新的快照,原快照不受影响
+     *         同一块内的多次修改只复制一次该块(写时复制)
+     *         编辑器本身不是线程安全的,一次编辑只在一个线程中进行
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class JobSnapshotEditor
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        /*
+        *  @brief  JobSnapshotEditor
+        *  @param  base:编辑的基础快照,不能为空
+        *  @return N/A
+        */
+        explicit JobSnapshotEditor(std::shared_ptr<const JobSnapshot> base);
+
+        ~JobSnapshotEditor();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //获取及修改基本信息,修改时复制一份基本信息
+        const SnapshotHeader & header() const {return *this->m_pSnapshot->m_pHeader;}
+        SnapshotHeader & mutableHeader();
+
+        //当前元件的数量(包括本次添加的元件)
+        int size() const {return this->m_pSnapshot->m_size;}
+
+        /*
+        *  @brief  setComponent
+        *          修改第index个元件,只复制该元件所在的块
+        *  @param  index:元件的索引号
+        *          name:元件的名称
+        *          rectangle:元件的X,Y坐标,宽,高及角度
+        *  @return N/A
+        */
+        void setComponent(int index, const std::string & name, const SSDK::Rectangle & rectangle);
+
+        /*
+        *  @brief  appendComponent
+        *          在末尾添加一个元件,只复制最后一块(或新建一块)
+        *  @param  name:元件的名称
+        *          rectangle:元件的X,Y坐标,宽,高及角度
+        *  @return 元件的索引号
+        */
+        int appendComponent(const std::string & name, const SSDK::Rectangle & rectangle);
+
+        /*
+        *  @brief  removeComponent
+        *          删除第index个元件,之后的元件索引号减1
+        *          只复制该元件所在的块,之后的块仍然共享(只修改块的起始索引号);块被删空时移除该块
+        *  @param  index:元件的索引号
+        *  @return N/A
+        */
+        void removeComponent(int index);
+
+        /*
+        *  @brief  commit
+        *          结束编辑,生成修订号加1的新快照;之后编辑器不能再使用
+        *  @param  N/A
+        *  @return 新快照
+        */
+        std::shared_ptr<const JobSnapshot> commit();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //获取第chunkIndex块的可写副本,第一次修改该块时复制
+        ComponentChunk * mutableChunk(int chunkIndex);
+
+        //编辑器已提交时抛出异常
+        void checkEditable() const;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        std::shared_ptr<JobSnapshot> m_pSnapshot;                       //正在编辑的新快照
+        std::shared_ptr<SnapshotHeader> m_pMutableHeader;               //已复制的基本信息
+        std::vector<ComponentChunk *> m_mutableChunks;                  //已复制的块(未复制为nullptr)
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace Job
+
+#endif // JOBSNAPSHOT_HPP
@@ -0,0 +1,83 @@
+#include "jobstore.hpp"
+
+using namespace std;
+using namespace Job;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//JobStore
+JobStore::JobStore()
+    : m_sequence(0)
+{
+
+}
+
+JobStore::~JobStore()
+{
+
+}
+
+shared_ptr<const JobSnapshot> JobStore::current() const
+{
+    return std::atomic_load(&this->m_current);
+}
+
+void JobStore::publish(shared_ptr<const JobSnapshot> snapshot)
+{
+    //先替换快照再增加发布次数,读者看到新的发布次数时一定能取到新快照
+    std::atomic_store(&this->m_current, snapshot);
+    this->m_sequence.fetch_add(1, std::memory_order_release);
+}
+
+bool JobStore::publishIf(shared_ptr<const JobSnapshot> expected,
+                         shared_ptr<const JobSnapshot> snapshot)
+{
+    if(!std::atomic_compare_exchange_strong(&this->m_current, &expected, snapshot))
+    {
+        return false;
+    }
+
+    this->m_sequence.fetch_add(1, std::memory_order_release);
+    return true;
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//JobSnapshotReader
+JobSnapshotReader::JobSnapshotReader(const JobStore *pStore)
+{
+    this->m_pStore = pStore;
+    this->m_sequence = 0;
+}
+
+JobSnapshotReader::~JobSnapshotReader()
+{
+
+}
+
+const JobSnapshot &JobSnapshotReader::current()
+{
+    this->refresh();
+    if(!this->m_cached)
+    {
+        THROW_EXCEPTION("检测程式快照尚未发布!");
+    }
+
+    return *this->m_cached;
+}
+
+shared_ptr<const JobSnapshot> JobSnapshotReader::shared()
+{
+    this->refresh();
+    return this->m_cached;
+}
+
+void JobSnapshotReader::refresh()
+{
+    uint64_t sequence = this->m_pStore->sequence();
+    if(sequence != this->m_sequence || !this->m_cached)
+    {
+        this->m_cached = this->m_pStore->current();
+        this->m_sequence = sequence;
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,118 @@
+#ifndef JOBSTORE_HPP
+#define JOBSTORE_HPP
+
+#include <memory>
+#include <atomic>
+#include <cstdint>
+
+#include "../sdk/customexception.hpp"
+#include "jobsnapshot.hpp"
+
+namespace Job
+{
+    /**
+     *  @brief JobStore
+     *         发布检测程式的当前快照
+     *         编辑线程: 基于current()编辑,提交后通过publish/publishIf原子地替换当前快照
+     *         检测线程: 通过JobSnapshotReader读取,只有快照更换时才访问共享指针
+     *         旧快照在最后一个读者释放后自动销毁
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class JobStore
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        JobStore();
+
+        ~JobStore();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //获取当前快照(原子读取共享指针),没有发布过时为空
+        std::shared_ptr<const JobSnapshot> current() const;
+
+        //发布次数,每次发布后加1,读者据此判断快照是否更换
+        uint64_t sequence() const {return this->m_sequence.load(std::memory_order_acquire);}
+
+        /*
+        *  @brief  publish
+        *          无条件地将snapshot设为当前快照(如重新加载检测程式)
+        *  @param  snapshot:新的快照
+        *  @return N/A
+        */
+        void publish(std::shared_ptr<const JobSnapshot> snapshot);
+
+        /*
+        *  @brief  publishIf
+        *          当前快照仍为expected时才发布snapshot,用于检测并发的编辑
+        *  @param  expected:编辑时的基础快照
+        *          snapshot:新的快照
+        *  @return true:发布成功; false:期间已有其他编辑发布,需要基于新的当前快照重新编辑
+        */
+        bool publishIf(std::shared_ptr<const JobSnapshot> expected,
+                       std::shared_ptr<const JobSnapshot> snapshot);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        std::shared_ptr<const JobSnapshot> m_current;       //当前快照,只通过std::atomic_load/atomic_store访问
+        std::atomic<uint64_t> m_sequence;                   //发布次数
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+
+    /**
+     *  @brief JobSnapshotReader
+     *         检测线程读取快照的入口,每个线程持有一个
+     *         current()只比较一次发布次数(一个原子整数读取),快照未更换时直接返回缓存的快照,
+     *         不加锁也不修改共享指针的引用计数; 快照更换后的第一次调用才重新获取
+     *         返回的引用在下一次调用current()之前一直有效
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class JobSnapshotReader
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        explicit JobSnapshotReader(const JobStore * pStore);
+
+        ~JobSnapshotReader();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        /*
+        *  @brief  current
+        *          获取最新发布的快照
+        *  @param  N/A
+        *  @return 快照,没有发布过时抛出异常
+        */
+        const JobSnapshot & current();
+
+        //获取最新发布的快照的共享指针,需要在当前调用之外继续持有快照时使用
+        std::shared_ptr<const JobSnapshot> shared();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //发布次数变化时重新获取快照
+        void refresh();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        const JobStore * m_pStore;                          //快照的发布者
+        std::shared_ptr<const JobSnapshot> m_cached;        //缓存的快照
+        uint64_t m_sequence;                                //缓存快照时的发布次数
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace Job
+
+#endif // JOBSTORE_HPP
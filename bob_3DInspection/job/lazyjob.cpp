@@ -0,0 +1,400 @@
+#include <cmath>
+#include <iostream>
+#include <algorithm>
+
+#include "lazyjob.hpp"
+#include "../sdk/rectanglekernel.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK;
+using namespace SSDK::DB;
+
+const char * LazyJob::POSITION_INDEX_NAME = "MeasuredObjListPos";
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//构造 & 析构函数
+LazyJob::LazyJob()
+{
+
+}
+
+LazyJob::~LazyJob()
+{
+    this->close();
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//成员函数
+void LazyJob::open(const string &path,
+                   InspectionData *pInspectionData,
+                   const LazyJobSetting &setting)
+{
+    try
+    {
+        this->close();
+
+        lock_guard<mutex> lock(this->m_mutex);
+        this->m_setting = setting;
+        this->m_setting.idPageSize = std::max(1, this->m_setting.idPageSize);
+        this->m_setting.cachePageCount = std::max(1, this->m_setting.cachePageCount);
+        if(!(this->m_setting.tileSize > 0))
+        {
+            THROW_EXCEPTION("区域页的边长必须大于0!");
+        }
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //只读打开检测程式,当前版本且已有位置索引时直接查询文件
+        //否则读入内存数据库,在内存中升级并建立索引; 检测程式文件始终不修改(内容哈希值不变,目录索引及缓存仍然有效)
+        JobMigrator migrator;
+        unique_ptr<SqliteDB> pSqlite(new SqliteDB());
+        if(!pSqlite->open(path, SQLITE_OPEN_READONLY))
+        {
+            THROW_EXCEPTION("打开检测程式失败:" + path);
+        }
+        if(JobMigrator::readVersion(pSqlite.get()) != migrator.currentVersion() ||
+           !hasPositionIndex(pSqlite.get()))
+        {
+            pSqlite->close();
+            pSqlite.reset(new SqliteDB());
+            migrator.openUpgraded(path, *pSqlite);
+            if(!pSqlite->execute(string("CREATE INDEX IF NOT EXISTS ") + POSITION_INDEX_NAME + " ON MeasuredObjList(PosX,PosY);"))
+            {
+                THROW_EXCEPTION("建立元件的位置索引失败:" + path);
+            }
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //读取检测程式及基板的基本信息,不分配检测对象
+        pInspectionData->pBoard()->clearMeasuredObjs();
+        {
+            string version, lastEditingTime;
+            RowReader<string, string> jobReader(pSqlite.get(), "select Version,LastEditingTime from Job");
+            if(!jobReader.next(version, lastEditingTime))
+            {
+                THROW_EXCEPTION("读取检测程式的版本信息失败!");
+            }
+            pInspectionData->setVersion(version);
+            pInspectionData->setLastEditingTime(lastEditingTime);
+
+            string boardName;
+            double originalX = 0, originalY = 0, sizeX = 0, sizeY = 0;
+            RowReader<string, double, double, double, double> boardReader(
+                        pSqlite.get(), "select Name,OriginalX,OriginalY,SizeX,SizeY from Board");
+            if(!boardReader.next(boardName, originalX, originalY, sizeX, sizeY))
+            {
+                THROW_EXCEPTION("读取基板数据失败!");
+            }
+            pInspectionData->pBoard()->setName(boardName);
+            pInspectionData->pBoard()->setOriginalX(originalX);
+            pInspectionData->pBoard()->setOriginalY(originalY);
+            pInspectionData->pBoard()->setSizeX(sizeX);
+            pInspectionData->pBoard()->setSizeY(sizeY);
+            this->m_originalX = originalX;
+            this->m_originalY = originalY;
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step3
+        //读取所有元件的ID及名称(按ID排列),几何数据在查询时按页读取
+        {
+            int objCnt = 0;
+            RowReader<int> countReader(pSqlite.get(), "select count(*) from MeasuredObjList");
+            if(countReader.next(objCnt))
+            {
+                this->m_ids.reserve(objCnt);
+                this->m_names.reserve(objCnt);
+            }
+
+            int64_t id = 0;
+            string name;
+            RowReader<int64_t, string> nameReader(pSqlite.get(), "select rowid,Name from MeasuredObjList order by rowid");
+            while(nameReader.next(id, name))
+            {
+                this->m_ids.push_back(id);
+                this->m_names.push_back(name);
+            }
+
+            //元件中心到外接矩形边界的最大距离不超过其对角线的一半(与角度无关)
+            //区域查询按此向外扩大,再按每个元件实际的外接矩形筛选
+            double maxDiagonal2 = 0;
+            RowReader<double> extentReader(pSqlite.get(), "select ifnull(max(Width*Width+Height*Height),0) from MeasuredObjList");
+            if(extentReader.next(maxDiagonal2))
+            {
+                this->m_maxHalfExtent = std::sqrt(maxDiagonal2) / 2;
+            }
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        this->m_pSqlite = std::move(pSqlite);
+    }
+    catch(const exception &ex)
+    {
+        this->m_ids.clear();
+        this->m_names.clear();
+        this->m_maxHalfExtent = 0;
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void LazyJob::close()
+{
+    lock_guard<mutex> lock(this->m_mutex);
+    if(this->m_pSqlite)
+    {
+        this->m_pSqlite->close();
+        this->m_pSqlite.reset();
+    }
+    this->m_ids.clear();
+    this->m_names.clear();
+    this->m_lruList.clear();
+    this->m_pages.clear();
+    this->m_maxHalfExtent = 0;
+    this->m_hitCount = 0;
+    this->m_missCount = 0;
+}
+
+const string &LazyJob::name(int64_t id) const
+{
+    vector<int64_t>::const_iterator it = std::lower_bound(this->m_ids.begin(), this->m_ids.end(), id);
+    if(it == this->m_ids.end() || *it != id)
+    {
+        THROW_EXCEPTION("元件的ID不存在!");
+    }
+
+    return this->m_names[it - this->m_ids.begin()];
+}
+
+void LazyJob::queryRect(double minX, double minY, double maxX, double maxY,
+                        vector<LazyComponent> &components)
+{
+    try
+    {
+        components.clear();
+        if(!this->isOpened())
+        {
+            THROW_EXCEPTION("检测程式尚未打开!");
+        }
+
+        lock_guard<mutex> lock(this->m_mutex);
+        //中心在区域外的元件也可能与区域相交,读取的区域页按元件的最大半径向外扩大
+        const double extent = this->m_maxHalfExtent;
+        const int64_t tileX0 = this->tileX(minX - extent), tileX1 = this->tileX(maxX + extent);
+        const int64_t tileY0 = this->tileY(minY - extent), tileY1 = this->tileY(maxY + extent);
+        const int64_t innerX0 = this->tileX(minX), innerX1 = this->tileX(maxX);
+        const int64_t innerY0 = this->tileY(minY), innerY1 = this->tileY(maxY);
+        for (int64_t tx = tileX0; tx <= tileX1; ++tx)
+        {
+            for (int64_t ty = tileY0; ty <= tileY1; ++ty)
+            {
+                //整页都在区域内的页直接取所有元件,其余的页按元件的外接矩形筛选
+                PagePtr pPage = this->page(PageKey(TILE_PAGE, tx, ty));
+                bool inside = (tx > innerX0 && tx < innerX1 && ty > innerY0 && ty < innerY1);
+                for (size_t i = 0; i < pPage->size(); ++i)
+                {
+                    const LazyComponent & component = (*pPage)[i];
+                    if(!inside)
+                    {
+                        double boundMinX = 0, boundMinY = 0, boundMaxX = 0, boundMaxY = 0;
+                        RectangleKernel::bounds(Rectangle(component.xPos, component.yPos,
+                                                          component.width, component.height, component.angle),
+                                                boundMinX, boundMinY, boundMaxX, boundMaxY);
+                        if(boundMaxX < minX || boundMinX > maxX || boundMaxY < minY || boundMinY > maxY)
+                        {
+                            continue;
+                        }
+                    }
+                    components.push_back(component);
+                }
+            }
+        }
+
+        std::sort(components.begin(), components.end(),
+                  [](const LazyComponent & a, const LazyComponent & b){return a.id < b.id;});
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void LazyJob::queryIdRange(int64_t firstId, int64_t lastId, vector<LazyComponent> &components)
+{
+    try
+    {
+        components.clear();
+        if(!this->isOpened())
+        {
+            THROW_EXCEPTION("检测程式尚未打开!");
+        }
+        if(firstId > lastId)
+        {
+            return;
+        }
+
+        lock_guard<mutex> lock(this->m_mutex);
+        const int64_t pageSize = this->m_setting.idPageSize;
+        for (int64_t pageIndex = firstId / pageSize; pageIndex <= lastId / pageSize; ++pageIndex)
+        {
+            PagePtr pPage = this->page(PageKey(ID_PAGE, pageIndex, 0));
+            for (size_t i = 0; i < pPage->size(); ++i)
+            {
+                const LazyComponent & component = (*pPage)[i];
+                if(component.id >= firstId && component.id <= lastId)
+                {
+                    components.push_back(component);
+                }
+            }
+        }
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void LazyJob::prefetchRect(double minX, double minY, double maxX, double maxY)
+{
+    try
+    {
+        if(!this->isOpened())
+        {
+            return;
+        }
+
+        //与queryRect读取相同的区域页(按元件的最大半径向外扩大)
+        lock_guard<mutex> lock(this->m_mutex);
+        const double extent = this->m_maxHalfExtent;
+        for (int64_t tx = this->tileX(minX - extent); tx <= this->tileX(maxX + extent); ++tx)
+        {
+            for (int64_t ty = this->tileY(minY - extent); ty <= this->tileY(maxY + extent); ++ty)
+            {
+                this->page(PageKey(TILE_PAGE, tx, ty));
+            }
+        }
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void LazyJob::prefetch(const FovPlan &plan, int firstFov, int fovCount)
+{
+    const double halfWidth = plan.fovWidth() / 2;
+    const double halfHeight = plan.fovHeight() / 2;
+    const int lastFov = std::min(plan.size(), firstFov + fovCount);
+    for (int i = std::max(0, firstFov); i < lastFov; ++i)
+    {
+        const Fov & fov = plan.fovs()[i];
+        this->prefetchRect(fov.xPos - halfWidth, fov.yPos - halfHeight,
+                           fov.xPos + halfWidth, fov.yPos + halfHeight);
+    }
+}
+
+bool LazyJob::hasPositionIndex(SqliteDB *pSqlite)
+{
+    int indexCount = 0;
+    RowReader<int> indexReader(pSqlite, "select count(*) from sqlite_master where type='index' and name=?");
+    if(!indexReader.bind(POSITION_INDEX_NAME) || !indexReader.next(indexCount))
+    {
+        indexCount = 0;
+    }
+
+    return indexCount > 0;
+}
+
+int64_t LazyJob::tileX(double x) const
+{
+    return (int64_t)std::floor((x - this->m_originalX) / this->m_setting.tileSize);
+}
+
+int64_t LazyJob::tileY(double y) const
+{
+    return (int64_t)std::floor((y - this->m_originalY) / this->m_setting.tileSize);
+}
+
+LazyJob::PagePtr LazyJob::page(const PageKey &key)
+{
+    //命中时移到LRU链表的最前面
+    map<PageKey, pair<PagePtr, list<PageKey>::iterator>>::iterator it = this->m_pages.find(key);
+    if(it != this->m_pages.end())
+    {
+        ++this->m_hitCount;
+        this->m_lruList.splice(this->m_lruList.begin(), this->m_lruList, it->second.second);
+        return it->second.first;
+    }
+
+    //未命中时查询数据库,超出缓存页数时淘汰最久未使用的页
+    ++this->m_missCount;
+    PagePtr pPage = this->loadPage(key);
+    this->m_lruList.push_front(key);
+    this->m_pages[key] = make_pair(pPage, this->m_lruList.begin());
+    while((int)this->m_pages.size() > this->m_setting.cachePageCount)
+    {
+        this->m_pages.erase(this->m_lruList.back());
+        this->m_lruList.pop_back();
+    }
+
+    return pPage;
+}
+
+LazyJob::PagePtr LazyJob::loadPage(const PageKey &key)
+{
+    shared_ptr<Page> pPage = make_shared<Page>();
+    LazyComponent component;
+
+    if(TILE_PAGE == std::get<0>(key))
+    {
+        //查询条件向外扩大一点,再按tileX/tileY筛选,避免浮点误差使网格边界上的元件被遗漏或重复
+        const int64_t tx = std::get<1>(key);
+        const int64_t ty = std::get<2>(key);
+        const double size = this->m_setting.tileSize;
+        const double margin = size * 1e-6;
+        RowReader<int64_t, double, double, double, double, double> reader(
+                    this->m_pSqlite.get(),
+                    "select rowid,PosX,PosY,Width,Height,Angle from MeasuredObjList "
+                    "where PosX>=? and PosX<? and PosY>=? and PosY<?");
+        if(!reader.bind(this->m_originalX + tx * size - margin,
+                        this->m_originalX + (tx + 1) * size + margin,
+                        this->m_originalY + ty * size - margin,
+                        this->m_originalY + (ty + 1) * size + margin))
+        {
+            THROW_EXCEPTION("查询区域页失败!");
+        }
+        while(reader.next(component.id, component.xPos, component.yPos,
+                          component.width, component.height, component.angle))
+        {
+            if(this->tileX(component.xPos) == tx && this->tileY(component.yPos) == ty)
+            {
+                pPage->push_back(component);
+            }
+        }
+    }
+    else
+    {
+        const int64_t pageSize = this->m_setting.idPageSize;
+        const int64_t firstId = std::get<1>(key) * pageSize;
+        RowReader<int64_t, double, double, double, double, double> reader(
+                    this->m_pSqlite.get(),
+                    "select rowid,PosX,PosY,Width,Height,Angle from MeasuredObjList "
+                    "where rowid>=? and rowid<=? order by rowid");
+        if(!reader.bind(firstId, firstId + pageSize - 1))
+        {
+            THROW_EXCEPTION("查询ID页失败!");
+        }
+        while(reader.next(component.id, component.xPos, component.yPos,
+                          component.width, component.height, component.angle))
+        {
+            pPage->push_back(component);
+        }
+    }
+
+    return pPage;
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,194 @@
+#ifndef LAZYJOB_HPP
+#define LAZYJOB_HPP
+
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <tuple>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+
+#include "../sdk/customexception.hpp"
+#include "../sdk/DB/sqlitedb.hpp"
+#include "../sdk/DB/rowreader.hpp"
+#include "inspectiondata.hpp"
+#include "jobmigrator.hpp"
+#include "fovplan.hpp"
+
+namespace Job
+{
+    /**
+     *  @brief LazyComponent
+     *         按需读取的一个元件的几何数据
+     */
+    struct LazyComponent
+    {
+        int64_t id{0};          //元件的ID(MeasuredObjList表中的rowid)
+        double xPos{0};         //元件中心X轴坐标
+        double yPos{0};         //元件中心Y轴坐标
+        double width{0};        //元件的宽
+        double height{0};       //元件的高
+        double angle{0};        //元件的角度
+    };
+
+    /**
+     *  @brief LazyJobSetting
+     *         按需加载的分页参数
+     */
+    struct LazyJobSetting
+    {
+        double tileSize{10};        //区域页的边长(单位:mm),基板按此划分网格,每格为一页
+        int idPageSize{4096};       //ID页包含的ID数量
+        int cachePageCount{256};    //缓存的页数,超出时淘汰最久未使用的页
+    };
+
+    /**
+     *  @brief LazyJob
+     *         按需加载检测程式,用于超大基板的编辑及复判
+     *         open只读取Job表,Board表及所有元件的ID和名称,元件的几何数据按区域或ID范围分页读取:
+     *             区域页: 元件中心落在同一网格内的元件,通过MeasuredObjList(PosX,PosY)索引查询
+     *                     区域查询读取按元件最大半径(对角线的一半)扩大后的区域页,再按每个元件的外接矩形筛选
+     *             ID页: ID连续的idPageSize个元件,通过rowid查询
+     *         读取的页保存在LRU缓存中,prefetch可以提前读取后续FOV的区域
+     *         检测程式文件只读打开,从不修改; 旧版本或没有位置索引的程式读入内存数据库,在内存中升级并建立索引
+     *         所有函数都可以在多个线程中调用(内部加锁),如在检测当前FOV的同时由另一线程预读后续FOV
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class LazyJob
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //常量
+        static const char * POSITION_INDEX_NAME;    //MeasuredObjList(PosX,PosY)索引的名称
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        LazyJob();
+
+        ~LazyJob();
+
+        LazyJob(const LazyJob &) = delete;
+        LazyJob & operator=(const LazyJob &) = delete;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        /*
+        *  @brief  open
+        *          打开检测程式,读取检测程式及基板的基本信息到pInspectionData(不分配检测对象),
+        *          并读取所有元件的ID及名称
+        *  @param  path:检测程式文件的路径
+        *          pInspectionData:接收基本信息,原有的检测对象被清空
+        *          setting:分页参数
+        *  @return N/A
+        */
+        void open(const std::string & path,
+                  InspectionData * pInspectionData,
+                  const LazyJobSetting & setting = LazyJobSetting());
+
+        //关闭检测程式并清空缓存
+        void close();
+
+        //是否已打开
+        bool isOpened() const {return nullptr != this->m_pSqlite;}
+
+        //元件的数量
+        int componentCount() const {return (int)this->m_ids.size();}
+
+        //所有元件的ID(从小到大)及对应的名称
+        const std::vector<int64_t> & ids() const {return this->m_ids;}
+        const std::vector<std::string> & names() const {return this->m_names;}
+
+        //ID为id的元件的名称,不存在时抛出异常
+        const std::string & name(int64_t id) const;
+
+        /*
+        *  @brief  queryRect
+        *          读取外接矩形(考虑角度)与指定区域相交的元件(包括中心在区域外的元件)
+        *          只读取与区域(向外扩大元件的最大半径)相交的区域页
+        *  @param  minX,minY,maxX,maxY:查询区域的边界
+        *          components:输出,按ID从小到大排列
+        *  @return N/A
+        */
+        void queryRect(double minX, double minY, double maxX, double maxY,
+                       std::vector<LazyComponent> & components);
+
+        /*
+        *  @brief  queryIdRange
+        *          读取ID在[firstId,lastId]范围内的元件,只读取覆盖该范围的ID页
+        *  @param  firstId,lastId:ID的范围
+        *          components:输出,按ID从小到大排列
+        *  @return N/A
+        */
+        void queryIdRange(int64_t firstId, int64_t lastId, std::vector<LazyComponent> & components);
+
+        //将queryRect查询指定区域时需要的区域页读入缓存
+        void prefetchRect(double minX, double minY, double maxX, double maxY);
+
+        /*
+        *  @brief  prefetch
+        *          将拍照计划中第firstFov个起连续fovCount个FOV的区域读入缓存
+        *  @param  plan:拍照计划
+        *          firstFov:第一个预读的FOV
+        *          fovCount:预读的FOV的数量
+        *  @return N/A
+        */
+        void prefetch(const FovPlan & plan, int firstFov, int fovCount);
+
+        //缓存命中及未命中(需要查询数据库)的次数
+        uint64_t hitCount() const {return this->m_hitCount;}
+        uint64_t missCount() const {return this->m_missCount;}
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //类型
+        //页的键: 类型(区域页/ID页),区域页的网格坐标或ID页的页号
+        enum PAGE_KIND {TILE_PAGE = 0, ID_PAGE = 1};
+        using PageKey = std::tuple<int, int64_t, int64_t>;
+        using Page = std::vector<LazyComponent>;
+        using PagePtr = std::shared_ptr<const Page>;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //已打开的检测程式中是否已有位置索引
+        static bool hasPositionIndex(SSDK::DB::SqliteDB * pSqlite);
+
+        //计算坐标所在的网格
+        int64_t tileX(double x) const;
+        int64_t tileY(double y) const;
+
+        //获取一页(缓存中没有时查询数据库),调用前需要加锁
+        PagePtr page(const PageKey & key);
+
+        //查询数据库读取一页
+        PagePtr loadPage(const PageKey & key);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        LazyJobSetting m_setting;                       //分页参数
+        std::unique_ptr<SSDK::DB::SqliteDB> m_pSqlite;  //检测程式(只读打开的文件)
+        double m_originalX{0};                          //网格的原点(基板原点)
+        double m_originalY{0};
+        double m_maxHalfExtent{0};                      //元件中心到外接矩形边界的最大距离(对角线的一半)
+
+        std::vector<int64_t> m_ids;                     //所有元件的ID
+        std::vector<std::string> m_names;               //所有元件的名称
+
+        std::mutex m_mutex;                             //保护数据库连接及缓存
+        std::list<PageKey> m_lruList;                   //按使用时间排列的页,最近使用的在前
+        std::map<PageKey, std::pair<PagePtr, std::list<PageKey>::iterator>> m_pages;    //缓存的页
+        uint64_t m_hitCount{0};
+        uint64_t m_missCount{0};
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace Job
+
+#endif // LAZYJOB_HPP
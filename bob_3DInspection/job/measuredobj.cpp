@@ -13,6 +13,8 @@ MeasuredObj::MeasuredObj()
     this->m_pNextMeasuredObj = nullptr;
     //初始化指向下一个MeasuredOb对象的指针,将其置为nullptr
     this->m_pPreMeasuredObj = nullptr;
+    //初始化元件的ID,尚未写入检测程式
+    this->m_id = 0;
 }
 
 MeasuredObj::~MeasuredObj()
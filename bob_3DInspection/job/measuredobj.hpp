@@ -1,6 +1,8 @@
 #ifndef MEASUREDOBJ_HPP
 #define MEASUREDOBJ_HPP
 
+#include <cstdint>
+
 #include "../sdk/rectangle.hpp"
 #include "../sdk/customexception.hpp"
 
@@ -60,6 +62,11 @@ namespace Job
             this->m_rectangle = (*rectangle);
         }
         SSDK::Rectangle & rectangle() {return this->m_rectangle;}
+
+        //设置&获取元件的ID(即检测程式MeasuredObjList表中的rowid),0表示尚未写入检测程式
+        //ID在元件的生命周期内不变,增量保存时据此定位数据库中的记录
+        void setId(int64_t id){this->m_id = id;}
+        int64_t id(){return this->m_id;}
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     private:
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -68,6 +75,7 @@ namespace Job
         Job::MeasuredObj *m_pPreMeasuredObj;     //下一个被检测对象的头指针
         std::string m_name;                      //当前被检测对象的名称
         SSDK::Rectangle m_rectangle;             //实例化一个Rectangle对象
+        int64_t m_id;                            //元件的ID(MeasuredObjList表中的rowid)
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     };
 } //End of namespace Job
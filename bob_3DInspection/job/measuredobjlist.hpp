@@ -7,29 +7,89 @@
 #include "../sdk/formatconvertion.hpp"
 #include "measuredobj.hpp"
 
+/**
+ *  @brief MeasuredObjList
+ *         检测对象的双向链表,同时记录表头和表尾的指针
+ *         pushHead/pushTail/pullHead/pullTail 均为O(1)操作
+ *         append 可将一段连续的检测对象一次性链接到表尾
+ */
 template <class T>
 class MeasuredObjList
 {
 public:
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //构造 & 析构函数
+    //初始化成员变量(表头,表尾指针为nullptr,长度为0)
+    MeasuredObjList();
+
+    ~MeasuredObjList();
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //成员函数
     void pushHead(T *pMeasuredObj);
 
     void pushTail(T *pMeasuredObj);
 
+    /*
+    *  @brief  append
+    *          将区间[first,last)内的检测对象依次链接到链表的尾部
+    *          只遍历一次区间,不会遍历已有的链表
+    *  @param  first: 区间的起始迭代器(解引用后为检测对象,如数组的首地址)
+    *          last:  区间的结束迭代器
+    *  @return N/A
+    */
+    template <class Iterator>
+    void append(Iterator first, Iterator last);
+
     void pullHead();
 
     void pullTail();
 
+    /*
+    *  @brief  remove
+    *          将检测对象从链表中断开,O(1)操作,不释放检测对象
+    *  @param  pMeasuredObj:链表中的检测对象
+    *  @return N/A
+    */
+    void remove(T *pMeasuredObj);
+
+    //清空链表,只断开链表与检测对象的关系,不释放检测对象
+    void clear();
+
     T * pHead();
 
+    T * pTail();
+
+    int size();
+
     void print();
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 private:
-    T *m_pHeadObj;
-    int m_size;
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //成员变量
+    T *m_pHeadObj;          //链表的表头
+    T *m_pTailObj;          //链表的表尾
+    int m_size;             //链表的长度
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 };
 
-#endif // MEASUREDOBJLIST_HPP
 
+template<class T>
+MeasuredObjList<T>::MeasuredObjList()
+{
+    this->m_pHeadObj = nullptr;
+    this->m_pTailObj = nullptr;
+    this->m_size = 0;
+}
+
+template<class T>
+MeasuredObjList<T>::~MeasuredObjList()
+{
+    this->m_pHeadObj = nullptr;
+    this->m_pTailObj = nullptr;
+}
 
 template<class T>
 void MeasuredObjList<T>::pushHead(T *pMeasuredObj)
@@ -39,14 +99,19 @@ void MeasuredObjList<T>::pushHead(T *pMeasuredObj)
         T * pTmpObj = this->m_pHeadObj;  //pTmpObj为临时记录列表检测对象的地址
 
         //设置对象的成员变量(指向上一个检测对象的指针),设置为nullptr
-        pMeasuredObj->setNextMeasuredObjPtr(nullptr);
+        pMeasuredObj->setPreMeasuredObjPtr(nullptr);
         //设置对象的成员变量(指向下一个检测对象的指针)指向原来的表头
         pMeasuredObj->setNextMeasuredObjPtr(pTmpObj);
 
         //如果列表原来的头指针不为nullptr,则设置原来表头上一个头指针指向当前的表头
+        //否则链表为空,当前对象同时也是表尾
         if(nullptr != pTmpObj)
         {
-            pTmpObj->setPreMeasuredObjPtr(pTmpObj);
+            pTmpObj->setPreMeasuredObjPtr(pMeasuredObj);
+        }
+        else
+        {
+            this->m_pTailObj = pMeasuredObj;
         }
 
         this->m_pHeadObj = pMeasuredObj;                //重新设置列表的头指针
@@ -64,30 +129,14 @@ void MeasuredObjList<T>::pushTail(T *pMeasuredObj)
 {
     try
     {
-        T * pTailObj = this->m_pHeadObj; //pTailObj:为记录列表尾部检测对象的指针
-        T * pTmpObj;                   //pTmpObj:为临时记录列表检测对象地址的指针
-
-        if(nullptr != this->m_pHeadObj)
-        {
-            pTmpObj = this->m_pHeadObj->pNextMeasuredObj();
-        }
-        else
-        {
-            pTmpObj = nullptr;
-        }
-
-        while (nullptr != pTmpObj)
-        {
-            pTailObj = pTmpObj;
-            pTmpObj = pTmpObj->pNextMeasuredObj();
-        }
+        T * pTailObj = this->m_pTailObj; //pTailObj:为记录列表尾部检测对象的指针
 
         // 设置对象中成员变量(指向下一个检测对象的指针)设置为nullptr
         pMeasuredObj->setNextMeasuredObjPtr(nullptr);
-        // 将新创建对象中成员变量(指向下一个检测对象的指针)设置为nullptr
+        // 将对象中成员变量(指向上一个检测对象的指针)指向原来的表尾
         pMeasuredObj->setPreMeasuredObjPtr(pTailObj);
 
-        //如果列表尾部不为nullptr,则将列表尾部成员变量(指向下一个检测对象的指针)指向列表尾部
+        //如果列表尾部不为nullptr,则将列表尾部成员变量(指向下一个检测对象的指针)指向当前对象
         if(nullptr != pTailObj)
         {
             pTailObj->setNextMeasuredObjPtr(pMeasuredObj);
@@ -96,6 +145,7 @@ void MeasuredObjList<T>::pushTail(T *pMeasuredObj)
         {
             this->m_pHeadObj = pMeasuredObj;
         }
+        this->m_pTailObj = pMeasuredObj;            //重新设置列表的尾指针
         this->m_size++;                             //将列表的长度 +1
     }
     catch(const exception &ex)
@@ -104,6 +154,45 @@ void MeasuredObjList<T>::pushTail(T *pMeasuredObj)
     }
 }
 
+template<class T>
+template<class Iterator>
+void MeasuredObjList<T>::append(Iterator first, Iterator last)
+{
+    try
+    {
+        //pPreObj:记录上一个被链接的检测对象,初始为原来的表尾
+        T * pPreObj = this->m_pTailObj;
+        int cnt = 0;
+
+        for (; first != last; ++first)
+        {
+            T * pMeasuredObj = &(*first);
+
+            pMeasuredObj->setPreMeasuredObjPtr(pPreObj);
+            pMeasuredObj->setNextMeasuredObjPtr(nullptr);
+
+            if(nullptr != pPreObj)
+            {
+                pPreObj->setNextMeasuredObjPtr(pMeasuredObj);
+            }
+            else
+            {
+                this->m_pHeadObj = pMeasuredObj;
+            }
+
+            pPreObj = pMeasuredObj;
+            ++cnt;
+        }
+
+        this->m_pTailObj = pPreObj;                 //重新设置列表的尾指针
+        this->m_size += cnt;                        //将列表的长度加上插入的数量
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
 template<class T>
 void MeasuredObjList<T>::pullHead()
 {
@@ -119,6 +208,10 @@ void MeasuredObjList<T>::pullHead()
             {
                 pTmpObj->setPreMeasuredObjPtr(nullptr);
             }
+            else
+            {
+                this->m_pTailObj = nullptr;
+            }
 
             this->m_pHeadObj = pTmpObj;
 
@@ -142,23 +235,15 @@ void MeasuredObjList<T>::pullTail()
     {
         if(this->m_size > 0)
         {
-            T * pTailObj = this->m_pHeadObj;
-            T * pTmpObj = this->m_pHeadObj->pNextMeasuredObj();
-
-            while (pTmpObj != nullptr)
-            {
-                pTailObj = pTmpObj;
-                pTmpObj = pTmpObj->pNextMeasuredObj();
-            }
-
-            pTmpObj = pTailObj->pPreMeasuredObj();
+            T * pTailObj = this->m_pTailObj;
+            T * pTmpObj = pTailObj->pPreMeasuredObj();
 
             pTailObj->setPreMeasuredObjPtr(nullptr);
             pTailObj = nullptr;
 
             if(pTmpObj != nullptr)
             {
-                //将倒数第二个检测对象中的成员变量(指向下一个检测对象的指针)
+                //将倒数第二个检测对象中的成员变量(指向下一个检测对象的指针)置为nullptr
                 pTmpObj->setNextMeasuredObjPtr(nullptr);
             }
             else
@@ -166,6 +251,7 @@ void MeasuredObjList<T>::pullTail()
                 this->m_pHeadObj = nullptr;
             }
 
+            this->m_pTailObj = pTmpObj;         //倒数第二个检测对象成为新的表尾
             this->m_size--;                     //将列表的长度减一
         }
         else
@@ -179,32 +265,122 @@ void MeasuredObjList<T>::pullTail()
     }
 }
 
+template<class T>
+void MeasuredObjList<T>::remove(T *pMeasuredObj)
+{
+    try
+    {
+        if(this->m_size <= 0)
+        {
+            THROW_EXCEPTION("列表长度为0,无法删除检测对象!");
+        }
+
+        T * pPreObj = pMeasuredObj->pPreMeasuredObj();
+        T * pNextObj = pMeasuredObj->pNextMeasuredObj();
+
+        //前后都为nullptr时,对象必须是链表唯一的元素,否则对象不在链表中
+        if(nullptr == pPreObj && nullptr == pNextObj && this->m_pHeadObj != pMeasuredObj)
+        {
+            THROW_EXCEPTION("检测对象不在列表中,无法删除!");
+        }
+
+        //将上一个对象与下一个对象直接相连,被删除的对象为表头或表尾时更新表头或表尾
+        if(nullptr != pPreObj)
+        {
+            pPreObj->setNextMeasuredObjPtr(pNextObj);
+        }
+        else
+        {
+            this->m_pHeadObj = pNextObj;
+        }
+
+        if(nullptr != pNextObj)
+        {
+            pNextObj->setPreMeasuredObjPtr(pPreObj);
+        }
+        else
+        {
+            this->m_pTailObj = pPreObj;
+        }
+
+        pMeasuredObj->setPreMeasuredObjPtr(nullptr);
+        pMeasuredObj->setNextMeasuredObjPtr(nullptr);
+
+        this->m_size--;                         //将列表的长度减一
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+template<class T>
+void MeasuredObjList<T>::clear()
+{
+    this->m_pHeadObj = nullptr;
+    this->m_pTailObj = nullptr;
+    this->m_size = 0;
+}
+
 template<class T>
 T *MeasuredObjList<T>::pHead()
 {
     return this->m_pHeadObj;
 }
 
+template<class T>
+T *MeasuredObjList<T>::pTail()
+{
+    return this->m_pTailObj;
+}
+
+template<class T>
+int MeasuredObjList<T>::size()
+{
+    return this->m_size;
+}
+
 template<class T>
 void MeasuredObjList<T>::print()
 {
     try
     {
+        //每个数值直接格式化到缓冲区(格式与cout的默认格式相同),缓冲区满64K时一次输出
+        std::string text;
+        text.reserve(64 * 1024 + 256);
+        char number[SSDK::FormatConvertion::MAX_NUMBER_LENGTH];
+        auto appendNumber = [&](const char * label, double value)
+        {
+            text += label;
+            text.append(number, SSDK::FormatConvertion::doubleToChars(value, 6, number));
+        };
+
         T *pTmpObj = this->m_pHeadObj;
 
         while (pTmpObj != nullptr)
         {
-            cout<<"Name:"<<pTmpObj->name()<<"\t"
-               <<"X:"<< pTmpObj->rectangle().xPos()<<"\t"
-              <<"Y:"<<pTmpObj->rectangle().yPos()<<"\t"
-             <<"Width:"<<pTmpObj->rectangle().width()<<"\t"
-            <<"Height:"<<pTmpObj->rectangle().height()<<"\t"
-            <<"Angle:"<<pTmpObj->rectangle().angle()<<endl;
+            const SSDK::Rectangle & rect = pTmpObj->rectangle();
+            text += "Name:";
+            text += pTmpObj->name();
+            appendNumber("\tX:", rect.xPos());
+            appendNumber("\tY:", rect.yPos());
+            appendNumber("\tWidth:", rect.width());
+            appendNumber("\tHeight:", rect.height());
+            appendNumber("\tAngle:", rect.angle());
+            text += '\n';
+            if(text.size() >= 64 * 1024)
+            {
+                cout << text;
+                text.clear();
+            }
             pTmpObj = pTmpObj->pNextMeasuredObj();
         }
+        cout << text << flush;
     }
     catch(const exception &ex)
     {
         THROW_EXCEPTION(ex.what());
     }
 }
+
+#endif // MEASUREDOBJLIST_HPP
@@ -0,0 +1,178 @@
+#ifndef MEASUREDOBJPOOL_HPP
+#define MEASUREDOBJPOOL_HPP
+
+#include <vector>
+#include <new>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+#include "../sdk/customexception.hpp"
+#include "measuredobj.hpp"
+
+/**
+ *  @brief MeasuredObjPool
+ *         检测对象的内存池,由Board持有
+ *         内存按块分配,块一旦分配就不会移动,因此分配出去的对象地址在池释放之前一直有效
+ *         加载程式时先调用reserve(元件数量),整个程式只做一次大块分配
+ *         块只分配未初始化的内存,allocate时才在其中构造对象,预留但未使用的空间不会构造
+ *         clear 不需要逐个对象归还内存,但仍要对已分配的对象调用析构函数:
+ *             T有非平凡的析构函数时(如MeasuredObj的名称std::string)为O(已分配对象数)
+ *             T可平凡析构时跳过析构,只释放各个块,为O(块数)
+ */
+template <class T>
+class MeasuredObjPool
+{
+public:
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //构造 & 析构函数
+    MeasuredObjPool();
+
+    ~MeasuredObjPool();
+
+    //块中保存的是裸指针,禁止复制
+    MeasuredObjPool(const MeasuredObjPool &) = delete;
+    MeasuredObjPool & operator=(const MeasuredObjPool &) = delete;
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //成员函数
+    /*
+    *  @brief  reserve
+    *          保证池中至少还有cnt个连续的空闲对象,不足时分配一个新的块
+    *  @param  cnt:需要预留的对象数量
+    *  @return N/A
+    */
+    void reserve(int cnt);
+
+    /*
+    *  @brief  allocate
+    *          从池中分配cnt个地址连续的对象
+    *  @param  cnt:对象的数量
+    *  @return 第一个对象的地址
+    */
+    T * allocate(int cnt = 1);
+
+    //释放池中所有的块,之前分配的对象全部失效
+    void clear();
+
+    //已分配对象的数量
+    int size(){return this->m_size;}
+
+    //池中所有块的对象总数
+    int capacity(){return this->m_capacity;}
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+private:
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //成员变量
+    //内存块(未初始化的内存),只有前used个位置构造了对象
+    struct Block
+    {
+        T * pData;
+        int used;
+    };
+
+    std::vector<Block> m_blocks;                    //所有的内存块,最后一个为当前块
+    int m_blockSize;                                //当前块的对象数量
+    int m_size;                                     //已分配对象的总数
+    int m_capacity;                                 //所有块的对象总数
+
+    static const int MIN_BLOCK_SIZE = 64;           //自动扩容时新块的最小对象数量
+
+    static_assert(alignof(T) <= alignof(std::max_align_t), "::operator new无法保证T的对齐");
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+};
+
+template<class T>
+MeasuredObjPool<T>::MeasuredObjPool()
+{
+    this->m_blockSize = 0;
+    this->m_size = 0;
+    this->m_capacity = 0;
+}
+
+template<class T>
+MeasuredObjPool<T>::~MeasuredObjPool()
+{
+    this->clear();
+}
+
+template<class T>
+void MeasuredObjPool<T>::reserve(int cnt)
+{
+    try
+    {
+        if(!this->m_blocks.empty() && cnt <= this->m_blockSize - this->m_blocks.back().used)
+        {
+            return;
+        }
+
+        //当前块剩余空间不足,分配一个新的块,新块大小至少为已有容量,保证自动扩容时按倍数增长
+        //只分配内存,不构造对象
+        int blockSize = std::max(cnt, std::max(this->m_capacity, (int)MIN_BLOCK_SIZE));
+        this->m_blocks.reserve(this->m_blocks.size() + 1);
+        Block block;
+        block.pData = static_cast<T *>(::operator new(sizeof(T) * (size_t)blockSize));
+        block.used = 0;
+        this->m_blocks.push_back(block);
+        this->m_blockSize = blockSize;
+        this->m_capacity += blockSize;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+template<class T>
+T *MeasuredObjPool<T>::allocate(int cnt)
+{
+    try
+    {
+        if(cnt <= 0)
+        {
+            THROW_EXCEPTION("分配检测对象的数量必须大于0!");
+        }
+
+        this->reserve(cnt);
+
+        //在当前块的空闲位置上构造cnt个对象
+        Block & block = this->m_blocks.back();
+        T * pObj = block.pData + block.used;
+        for (int i = 0; i < cnt; ++i)
+        {
+            new (pObj + i) T();
+            ++block.used;               //构造成功后才计数,构造抛出异常时clear只析构已构造的对象
+        }
+        this->m_size += cnt;
+
+        return pObj;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+template<class T>
+void MeasuredObjPool<T>::clear()
+{
+    for (Block & block : this->m_blocks)
+    {
+        if(!std::is_trivially_destructible<T>::value)
+        {
+            for (int i = 0; i < block.used; ++i)
+            {
+                block.pData[i].~T();
+            }
+        }
+        ::operator delete(block.pData);
+    }
+    this->m_blocks.clear();
+    this->m_blockSize = 0;
+    this->m_size = 0;
+    this->m_capacity = 0;
+}
+
+#endif // MEASUREDOBJPOOL_HPP
@@ -0,0 +1,21 @@
+#Parquet导出(SSDK::Archive::Parquet),需要SSDK,parquet-cpp及arrow库: qmake CONFIG+=parquet
+#头文件使用include下的版本,库文件需要放在lib目录下(与头文件版本一致),缺少时qmake直接报错,不等到链接时才失败
+#被3DInspection.pro及tests/tst_parquetexporter共用
+DEFINES += USE_PARQUET
+
+SOURCES += \
+    $$PWD/parquetexporter.cpp
+
+HEADERS += \
+    $$PWD/parquetexporter.hpp
+
+INCLUDEPATH += $$PWD/../include/SSDK
+INCLUDEPATH += $$PWD/../include/parquet
+
+for(parquetLib, $$list(SSDK parquet arrow)) {
+    !exists($$PWD/../lib/lib$${parquetLib}.*) {
+        error("CONFIG+=parquet需要 lib/lib$${parquetLib}.so 或 lib/lib$${parquetLib}.a")
+    }
+}
+
+unix::LIBS += -L$$PWD/../lib/ -lSSDK -lparquet -larrow
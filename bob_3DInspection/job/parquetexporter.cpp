@@ -0,0 +1,298 @@
+#include <cstdio>
+#include <algorithm>
+
+#include "parquetexporter.hpp"
+#include "../sdk/DB/rowreader.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK::DB;
+using SSDK::Archive::Parquet;
+using parquet::schema::PrimitiveNode;
+using parquet::Repetition;
+using parquet::Type;
+using parquet::LogicalType;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//内部函数
+namespace
+{
+    //字符串列的值引用std::string的内容,写入RowGroup之前字符串必须保持不变
+    inline parquet::ByteArray byteArray(const string & value)
+    {
+        return parquet::ByteArray((uint32_t)value.size(), reinterpret_cast<const uint8_t *>(value.data()));
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//构造 & 析构函数
+ParquetExporter::ParquetExporter(const ParquetExportSetting &setting)
+    : m_setting(setting)
+{
+    this->m_setting.rowGroupSize = std::max(1, this->m_setting.rowGroupSize);
+}
+
+ParquetExporter::~ParquetExporter()
+{
+    this->abort();
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//成员函数
+size_t ParquetExporter::exportComponents(Board *pBoard, const string &path)
+{
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //元件的ID只保存在检测对象中,按链表顺序(即元件表的顺序)取出
+        const ComponentTable & table = pBoard->componentTable();
+        const size_t rowCnt = (size_t)table.size();
+        vector<int64_t> ids;
+        ids.reserve(rowCnt);
+        for (MeasuredObj * pObj = pBoard->pMeasuredObjList()->pHead(); nullptr != pObj; pObj = pObj->pNextMeasuredObj())
+        {
+            ids.push_back(pObj->id());
+        }
+        if(ids.size() != rowCnt)
+        {
+            THROW_EXCEPTION("元件表与检测对象的数量不一致,请先生成元件表!");
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //与MeasuredObjList表相同的列
+        vector<parquet::schema::NodePtr> fields;
+        fields.push_back(PrimitiveNode::Make("Id", Repetition::REQUIRED, Type::INT64));
+        fields.push_back(PrimitiveNode::Make("Name", Repetition::REQUIRED, Type::BYTE_ARRAY, LogicalType::UTF8));
+        fields.push_back(PrimitiveNode::Make("PosX", Repetition::REQUIRED, Type::DOUBLE));
+        fields.push_back(PrimitiveNode::Make("PosY", Repetition::REQUIRED, Type::DOUBLE));
+        fields.push_back(PrimitiveNode::Make("Width", Repetition::REQUIRED, Type::DOUBLE));
+        fields.push_back(PrimitiveNode::Make("Height", Repetition::REQUIRED, Type::DOUBLE));
+        fields.push_back(PrimitiveNode::Make("Angle", Repetition::REQUIRED, Type::DOUBLE));
+        this->open(fields, path);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step3
+        //每个RowGroup从元件表中复制一段连续的行,名称直接引用元件表的名称池
+        const uint groupSize = (uint)this->m_setting.rowGroupSize;
+        Parquet::ColumnVector<int64_t> idColumn(groupSize);
+        Parquet::ColumnVector<parquet::ByteArray> nameColumn(groupSize);
+        Parquet::ColumnVector<double> xPosColumn(groupSize), yPosColumn(groupSize);
+        Parquet::ColumnVector<double> widthColumn(groupSize), heightColumn(groupSize), angleColumn(groupSize);
+
+        for (size_t begin = 0; begin < rowCnt; begin += groupSize)
+        {
+            const uint cnt = (uint)std::min<size_t>(groupSize, rowCnt - begin);
+            std::copy(ids.begin() + begin, ids.begin() + begin + cnt, idColumn.values().begin());
+            std::copy(table.xPos() + begin, table.xPos() + begin + cnt, xPosColumn.values().begin());
+            std::copy(table.yPos() + begin, table.yPos() + begin + cnt, yPosColumn.values().begin());
+            std::copy(table.width() + begin, table.width() + begin + cnt, widthColumn.values().begin());
+            std::copy(table.height() + begin, table.height() + begin + cnt, heightColumn.values().begin());
+            std::copy(table.angle() + begin, table.angle() + begin + cnt, angleColumn.values().begin());
+            for (uint i = 0; i < cnt; ++i)
+            {
+                nameColumn.values()[i] = byteArray(table.name((int)(begin + i)));
+            }
+
+            this->writeRowGroup(cnt, idColumn, nameColumn, xPosColumn, yPosColumn, widthColumn, heightColumn, angleColumn);
+        }
+
+        this->close();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        return rowCnt;
+    }
+    catch(const exception &ex)
+    {
+        this->abort();
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+size_t ParquetExporter::exportResults(SqliteDB *pSqlite, const string &boardSerial, const string &path)
+{
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //与InspectionResult表相同的列,检测时间为自1970-01-01起的毫秒数
+        vector<parquet::schema::NodePtr> fields;
+        fields.push_back(PrimitiveNode::Make("BoardSerial", Repetition::REQUIRED, Type::BYTE_ARRAY, LogicalType::UTF8));
+        fields.push_back(PrimitiveNode::Make("ComponentId", Repetition::REQUIRED, Type::INT64));
+        fields.push_back(PrimitiveNode::Make("Timestamp", Repetition::REQUIRED, Type::INT64, LogicalType::TIMESTAMP_MILLIS));
+        fields.push_back(PrimitiveNode::Make("Status", Repetition::REQUIRED, Type::INT32));
+        fields.push_back(PrimitiveNode::Make("Height", Repetition::REQUIRED, Type::DOUBLE));
+        fields.push_back(PrimitiveNode::Make("Area", Repetition::REQUIRED, Type::DOUBLE));
+        fields.push_back(PrimitiveNode::Make("Volume", Repetition::REQUIRED, Type::DOUBLE));
+        fields.push_back(PrimitiveNode::Make("OffsetX", Repetition::REQUIRED, Type::DOUBLE));
+        fields.push_back(PrimitiveNode::Make("OffsetY", Repetition::REQUIRED, Type::DOUBLE));
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //按(BoardSerial,ComponentId,Timestamp)索引的顺序读取,指定基板时只读取该基板的结果
+        string sqlQuery = "SELECT BoardSerial,ComponentId,Timestamp,Status,Height,Area,Volume,OffsetX,OffsetY FROM InspectionResult";
+        if(!boardSerial.empty())
+        {
+            sqlQuery += " WHERE BoardSerial=?";
+        }
+        sqlQuery += " ORDER BY BoardSerial,ComponentId,Timestamp;";
+
+        RowReader<string, int64_t, int64_t, int, double, double, double, double, double> reader(pSqlite, sqlQuery);
+        if(!reader.isValid() || (!boardSerial.empty() && !reader.bind(boardSerial.data())))
+        {
+            THROW_EXCEPTION("查询检测结果失败!");
+        }
+        this->open(fields, path);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step3
+        //逐行读取,凑满一个RowGroup写入一次
+        //基板序列号在写入该RowGroup之前保存在serials中,字符串列引用其内容
+        const uint groupSize = (uint)this->m_setting.rowGroupSize;
+        vector<string> serials(groupSize);
+        Parquet::ColumnVector<parquet::ByteArray> serialColumn(groupSize);
+        Parquet::ColumnVector<int64_t> componentIdColumn(groupSize), timestampColumn(groupSize);
+        Parquet::ColumnVector<int> statusColumn(groupSize);
+        Parquet::ColumnVector<double> heightColumn(groupSize), areaColumn(groupSize), volumeColumn(groupSize);
+        Parquet::ColumnVector<double> offsetXColumn(groupSize), offsetYColumn(groupSize);
+
+        size_t rowCnt = 0;
+        uint cnt = 0;
+        auto flush = [&]()
+        {
+            for (uint i = 0; i < cnt; ++i)
+            {
+                serialColumn.values()[i] = byteArray(serials[i]);
+            }
+            this->writeRowGroup(cnt, serialColumn, componentIdColumn, timestampColumn, statusColumn,
+                                heightColumn, areaColumn, volumeColumn, offsetXColumn, offsetYColumn);
+            rowCnt += cnt;
+            cnt = 0;
+        };
+
+        while(reader.next(serials[cnt],
+                          componentIdColumn.values()[cnt],
+                          timestampColumn.values()[cnt],
+                          statusColumn.values()[cnt],
+                          heightColumn.values()[cnt],
+                          areaColumn.values()[cnt],
+                          volumeColumn.values()[cnt],
+                          offsetXColumn.values()[cnt],
+                          offsetYColumn.values()[cnt]))
+        {
+            if(++cnt == groupSize)
+            {
+                flush();
+            }
+        }
+        if(SQLITE_DONE != reader.latestErrorCode())
+        {
+            THROW_EXCEPTION("读取检测结果失败!");
+        }
+        if(cnt > 0)
+        {
+            flush();
+        }
+
+        this->close();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        return rowCnt;
+    }
+    catch(const exception &ex)
+    {
+        this->abort();
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void ParquetExporter::open(vector<parquet::schema::NodePtr> &fields, const string &path)
+{
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //与Parquet::writeToFilePath一致,parquet-cpp不支持LZO
+        if(parquet::Compression::LZO == this->m_setting.codec)
+        {
+            THROW_EXCEPTION("parquet-cpp不支持LZO压缩!");
+        }
+        this->abort();
+        this->m_path = path;
+        this->m_tmpPath = path + ".tmp";
+        this->m_pParquet.reset(new Parquet(fields));
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //在临时文件上打开写入器,所有列使用同一压缩格式
+        ::arrow::Status status = ::arrow::io::FileOutputStream::Open(this->m_tmpPath, &this->m_pOutFile);
+        if(!status.ok())
+        {
+            THROW_EXCEPTION("创建Parquet文件失败:" + this->m_tmpPath + "," + status.ToString());
+        }
+
+        parquet::WriterProperties::Builder builder;
+        builder.compression(this->m_setting.codec);
+        this->m_pWriter = parquet::ParquetFileWriter::Open(this->m_pOutFile,
+                                                          std::static_pointer_cast<parquet::schema::GroupNode>(this->m_pParquet->nodePtr()),
+                                                          builder.build());
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void ParquetExporter::close()
+{
+    try
+    {
+        //写入文件尾(元数据)后关闭文件,再替换目标文件
+        this->m_pWriter->Close();
+        this->m_pWriter.reset();
+        ::arrow::Status status = this->m_pOutFile->Close();
+        this->m_pOutFile.reset();
+        if(!status.ok())
+        {
+            THROW_EXCEPTION("写入Parquet文件失败:" + status.ToString());
+        }
+
+        if(0 != std::rename(this->m_tmpPath.c_str(), this->m_path.c_str()))
+        {
+            THROW_EXCEPTION("保存Parquet文件失败:" + this->m_path);
+        }
+        this->m_tmpPath.clear();
+        this->m_pParquet.reset();
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void ParquetExporter::abort()
+{
+    //导出失败时释放写入器(析构时的异常被忽略)及输出流,删除临时文件
+    this->m_pWriter.reset();
+    if(this->m_pOutFile)
+    {
+        this->m_pOutFile->Close();
+        this->m_pOutFile.reset();
+    }
+    if(!this->m_tmpPath.empty())
+    {
+        std::remove(this->m_tmpPath.c_str());
+        this->m_tmpPath.clear();
+    }
+    this->m_pParquet.reset();
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,119 @@
+#ifndef PARQUETEXPORTER_HPP
+#define PARQUETEXPORTER_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+//SSDK的Exception/marcoexception.hpp只定义THROW_EXCEPTION_WITH_OBJ等宏,抛出SSDK::Exception::CustomException;
+//sdk/customexception.hpp的THROW_EXCEPTION抛出SSDK::CustomException,两者的宏名,头文件保护宏及类所在的命名空间都不相同,
+//    且都派生自std::exception,可以同时包含(与顺序无关),本文件中的catch(const exception &)对两者都有效
+#include <Archive/parquet.hpp>
+
+#include "../sdk/customexception.hpp"
+#include "../sdk/DB/sqlitedb.hpp"
+#include "board.hpp"
+
+namespace Job
+{
+    /**
+     *  @brief ParquetExportSetting
+     *         Parquet导出的参数
+     */
+    struct ParquetExportSetting
+    {
+        int rowGroupSize{65536};                                        //每个RowGroup的行数,导出时只缓存一个RowGroup
+        parquet::Compression::type codec{parquet::Compression::SNAPPY}; //所有列的压缩格式(不支持LZO)
+    };
+
+    /**
+     *  @brief ParquetExporter
+     *         将检测程式的元件及检测结果按列导出为Parquet文件,供离线分析按列读取
+     *         Schema通过SSDK::Archive::Parquet建立,每一列通过其writeBatchedColumnsToRowGroup写入,
+     *         RowGroup由导出器按setting.rowGroupSize逐个追加:
+     *             只缓存当前RowGroup的各列(ColumnVector重复使用),内存占用与导出的行数无关
+     *         导出的列:
+     *             元件: Id(INT64),Name(UTF8),PosX,PosY,Width,Height,Angle(DOUBLE),与MeasuredObjList表一致
+     *             检测结果: BoardSerial(UTF8),ComponentId(INT64),Timestamp(INT64,毫秒),Status(INT32),
+     *                       Height,Area,Volume,OffsetX,OffsetY(DOUBLE),与InspectionResult表一致
+     *         先写入<文件>.tmp,完成后再替换目标文件,失败时删除临时文件
+     *         超过rowGroupSize行的文件有多个RowGroup,需要按RowGroup读取(如parquet::ParquetFileReader::RowGroup(i));
+     *             SSDK::Archive::Parquet::readAllColumns按RowGroup内的行号写入,只能读取只有一个RowGroup的文件
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class ParquetExporter
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        explicit ParquetExporter(const ParquetExportSetting & setting = ParquetExportSetting());
+
+        ~ParquetExporter();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //访存函数
+        const ParquetExportSetting & setting() const {return this->m_setting;}
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        /*
+        *  @brief  exportComponents
+        *          导出基板的所有元件,顺序与元件表一致
+        *  @param  pBoard:基板,元件表必须已由buildComponentTable生成
+        *          path:Parquet文件的路径
+        *  @return 导出的行数
+        */
+        size_t exportComponents(Board * pBoard, const std::string & path);
+
+        /*
+        *  @brief  exportResults
+        *          导出一块基板(或所有基板)的检测结果,按元件ID及检测时间排序
+        *  @param  pSqlite:结果数据库(可以是连接池的读连接)
+        *          boardSerial:基板序列号,为空时导出所有基板
+        *          path:Parquet文件的路径
+        *  @return 导出的行数
+        */
+        size_t exportResults(SSDK::DB::SqliteDB * pSqlite, const std::string & boardSerial, const std::string & path);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //根据字段建立Schema,在临时文件上打开写入器
+        void open(std::vector<parquet::schema::NodePtr> & fields, const std::string & path);
+
+        //追加一个rowCnt行的RowGroup,按Schema的顺序写入各列的前rowCnt个值
+        template<class... Columns>
+        void writeRowGroup(uint rowCnt, Columns &... columns)
+        {
+            parquet::RowGroupWriter * pGroupWriter = this->m_pWriter->AppendRowGroup(rowCnt);
+            std::initializer_list<int> {(this->m_pParquet->writeBatchedColumnsToRowGroup(columns, pGroupWriter, 0, rowCnt), 0)...};
+            pGroupWriter->Close();
+        }
+
+        //关闭写入器,用临时文件替换目标文件
+        void close();
+
+        //关闭写入器并删除临时文件(不抛出异常)
+        void abort();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        ParquetExportSetting m_setting;                                 //导出的参数
+        std::string m_path;                                             //目标文件的路径
+        std::string m_tmpPath;                                          //临时文件的路径
+        std::unique_ptr<SSDK::Archive::Parquet> m_pParquet;             //当前文件的Schema
+        std::shared_ptr<::arrow::io::FileOutputStream> m_pOutFile;      //当前文件的输出流
+        std::unique_ptr<parquet::ParquetFileWriter> m_pWriter;          //当前文件的写入器
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace Job
+
+#endif // PARQUETEXPORTER_HPP
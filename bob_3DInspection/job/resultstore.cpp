@@ -0,0 +1,407 @@
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+#include "resultstore.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK::DB;
+
+const int InspectionResult::BOARD_SERIAL_SIZE;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//构造 & 析构函数
+ResultStore::ResultStore(SqliteConnectionPool *pPool, const ResultStoreSetting &setting)
+    : m_pPool(pPool),
+      m_setting(setting),
+      m_queue(std::max(1, std::min(setting.queueCapacity, 65535))),
+      m_running(false),
+      m_stopping(false),
+      m_writerWaiting(false),
+      m_pushWaiters(0),
+      m_activePushers(0),
+      m_flushWaiters(0),
+      m_pushed(0),
+      m_written(0),
+      m_failed(0),
+      m_retries(0),
+      m_groups(0),
+      m_queueFullCount(0),
+      m_stallMicroseconds(0),
+      m_rejected(0),
+      m_lastGroupMicroseconds(0)
+{
+    try
+    {
+        this->m_setting.groupSize = std::max(1, this->m_setting.groupSize);
+        this->m_setting.groupIntervalMs = std::max(0, this->m_setting.groupIntervalMs);
+        this->m_setting.pushTimeoutMs = std::max(0, this->m_setting.pushTimeoutMs);
+        this->m_setting.maxRetries = std::max(0, this->m_setting.maxRetries);
+        this->m_setting.retryIntervalMs = std::max(0, this->m_setting.retryIntervalMs);
+
+        //结果表按基板序列号,元件及检测时间建立索引,供复判及统计查询
+        SqliteConnectionPool::WriteGuard writer = this->m_pPool->writer();
+        bool ok = writer->execute("CREATE TABLE IF NOT EXISTS InspectionResult("
+                                  "BoardSerial TEXT,ComponentId INTEGER,Timestamp INTEGER,Status INTEGER,"
+                                  "Height REAL,Area REAL,Volume REAL,OffsetX REAL,OffsetY REAL);") &&
+                  writer->execute("CREATE INDEX IF NOT EXISTS InspectionResultKey "
+                                  "ON InspectionResult(BoardSerial,ComponentId,Timestamp);");
+        if(!ok)
+        {
+            THROW_EXCEPTION("创建检测结果表失败!");
+        }
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+ResultStore::~ResultStore()
+{
+    this->stop();
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//成员函数
+void ResultStore::start()
+{
+    if(this->m_running)
+    {
+        return;
+    }
+
+    this->m_stopping = false;
+    this->m_running = true;
+    this->m_writerThread = std::thread(&ResultStore::writerLoop, this);
+}
+
+void ResultStore::stop()
+{
+    if(!this->m_running)
+    {
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(this->m_mutex);
+        this->m_stopping = true;
+    }
+    this->m_wakeCondition.notify_all();
+    this->m_writerThread.join();
+    this->m_running = false;
+
+    //写线程已退出,唤醒仍在等待的flush
+    {
+        lock_guard<mutex> lock(this->m_mutex);
+    }
+    this->m_flushCondition.notify_all();
+}
+
+bool ResultStore::push(const InspectionResult &result)
+{
+    //先登记再检查是否在运行:stop之后不再放入,已登记的push完成之前写线程不退出
+    this->m_activePushers.fetch_add(1);
+    if(!this->m_running || this->m_stopping)
+    {
+        this->m_activePushers.fetch_sub(1);
+        this->m_rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    bool ok = this->m_queue.bounded_push(result);
+    if(!ok)
+    {
+        //队列已满: 在条件变量上等待写线程腾出空间,最多等待pushTimeoutMs,并记录等待的次数及时间
+        this->m_queueFullCount.fetch_add(1, std::memory_order_relaxed);
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        chrono::steady_clock::time_point deadline = start + chrono::milliseconds(this->m_setting.pushTimeoutMs);
+
+        this->m_pushWaiters.fetch_add(1);
+        {
+            unique_lock<mutex> lock(this->m_mutex);
+            while(!(ok = this->m_queue.bounded_push(result)))
+            {
+                if(cv_status::timeout == this->m_spaceCondition.wait_until(lock, deadline))
+                {
+                    ok = this->m_queue.bounded_push(result);
+                    break;
+                }
+            }
+        }
+        this->m_pushWaiters.fetch_sub(1);
+
+        this->m_stallMicroseconds.fetch_add(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count(),
+                                            std::memory_order_relaxed);
+    }
+
+    if(ok)
+    {
+        this->m_pushed.fetch_add(1, std::memory_order_relaxed);
+        this->wakeWriter();
+    }
+    else
+    {
+        this->m_rejected.fetch_add(1, std::memory_order_relaxed);
+    }
+    this->m_activePushers.fetch_sub(1);
+
+    return ok;
+}
+
+bool ResultStore::tryPush(const InspectionResult &result)
+{
+    this->m_activePushers.fetch_add(1);
+    bool ok = this->m_running && !this->m_stopping && this->m_queue.bounded_push(result);
+    if(ok)
+    {
+        this->m_pushed.fetch_add(1, std::memory_order_relaxed);
+        this->wakeWriter();
+    }
+    else
+    {
+        this->m_rejected.fetch_add(1, std::memory_order_relaxed);
+    }
+    this->m_activePushers.fetch_sub(1);
+
+    return ok;
+}
+
+void ResultStore::flush()
+{
+    uint64_t target = this->m_pushed.load();
+
+    this->m_flushWaiters.fetch_add(1);
+    {
+        unique_lock<mutex> lock(this->m_mutex);
+        this->m_wakeCondition.notify_all();
+        this->m_flushCondition.wait(lock, [this, target]()
+        {
+            return this->m_written.load() + this->m_failed.load() >= target || !this->m_running;
+        });
+    }
+    this->m_flushWaiters.fetch_sub(1);
+}
+
+ResultStoreMetrics ResultStore::metrics() const
+{
+    ResultStoreMetrics metrics;
+    metrics.pushed = this->m_pushed.load();
+    metrics.written = this->m_written.load();
+    metrics.failed = this->m_failed.load();
+    metrics.retries = this->m_retries.load();
+    metrics.groups = this->m_groups.load();
+    metrics.queueFullCount = this->m_queueFullCount.load();
+    metrics.stallMicroseconds = this->m_stallMicroseconds.load();
+    metrics.rejected = this->m_rejected.load();
+    metrics.lastGroupMicroseconds = this->m_lastGroupMicroseconds.load();
+
+    return metrics;
+}
+
+vector<InspectionResult> ResultStore::takeUnwritten()
+{
+    vector<InspectionResult> unwritten;
+    lock_guard<mutex> lock(this->m_mutex);
+    unwritten.swap(this->m_unwritten);
+    return unwritten;
+}
+
+void ResultStore::setBoardSerial(InspectionResult &result, const string &boardSerial)
+{
+    size_t length = std::min(boardSerial.size(), (size_t)InspectionResult::BOARD_SERIAL_SIZE - 1);
+    std::memcpy(result.boardSerial, boardSerial.data(), length);
+    result.boardSerial[length] = '\0';
+}
+
+int64_t ResultStore::currentTimestamp()
+{
+    return chrono::duration_cast<chrono::milliseconds>(chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void ResultStore::writerLoop()
+{
+    vector<InspectionResult> group;
+    group.reserve(this->m_setting.groupSize);
+    chrono::steady_clock::time_point groupStart;
+    const chrono::milliseconds groupInterval(this->m_setting.groupIntervalMs);
+    int failures = 0;       //当前一组连续提交失败的次数
+
+    while(true)
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //从队列中取出结果,最多取到一组,取出后唤醒等待空间的push
+        InspectionResult result;
+        bool popped = false;
+        while((int)group.size() < this->m_setting.groupSize && this->m_queue.pop(result))
+        {
+            if(group.empty())
+            {
+                groupStart = chrono::steady_clock::now();
+            }
+            group.push_back(result);
+            popped = true;
+        }
+        if(popped)
+        {
+            this->wakePushers();
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //满一组,最早的结果等待超时,停止或有flush等待时提交
+        //提交失败时保留这一组,间隔retryIntervalMs后重试;重试maxRetries次仍失败时移入未写入的结果
+        bool stopping = this->m_stopping.load();
+        bool flushing = this->m_flushWaiters.load() > 0;
+        if(!group.empty() &&
+           ((int)group.size() >= this->m_setting.groupSize ||
+            chrono::steady_clock::now() - groupStart >= groupInterval ||
+            stopping || flushing))
+        {
+            if(this->writeGroup(group))
+            {
+                failures = 0;
+                group.clear();
+                this->notifyFlushed();
+                continue;
+            }
+
+            if(++failures > this->m_setting.maxRetries)
+            {
+                cout << "写入检测结果失败,已重试" << this->m_setting.maxRetries << "次,"
+                     << group.size() << "条结果移入未写入的结果" << endl;
+                {
+                    lock_guard<mutex> lock(this->m_mutex);
+                    this->m_unwritten.insert(this->m_unwritten.end(), group.begin(), group.end());
+                }
+                this->m_failed.fetch_add(group.size());
+                failures = 0;
+                group.clear();
+                this->notifyFlushed();
+                continue;
+            }
+
+            this->m_retries.fetch_add(1);
+            unique_lock<mutex> lock(this->m_mutex);
+            this->m_wakeCondition.wait_for(lock, chrono::milliseconds(this->m_setting.retryIntervalMs));
+            continue;
+        }
+
+        //停止时队列已空,没有未提交的结果且没有正在放入的push,写线程退出
+        //有push已登记但尚未放入时让出CPU,等其放入或放弃
+        if(stopping && group.empty() && this->m_queue.empty())
+        {
+            if(0 == this->m_activePushers.load())
+            {
+                break;
+            }
+            std::this_thread::yield();
+            continue;
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step3
+        //在条件变量上等待新的结果,stop或flush;已有未提交的结果时最多等到这一组的提交时间
+        //先登记为等待再检查队列,push放入后看到登记才加锁通知,不会错过通知
+        unique_lock<mutex> lock(this->m_mutex);
+        this->m_writerWaiting = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto ready = [this]()
+        {
+            return !this->m_queue.empty() || this->m_stopping || this->m_flushWaiters.load() > 0;
+        };
+        if(group.empty())
+        {
+            this->m_wakeCondition.wait(lock, ready);
+        }
+        else
+        {
+            this->m_wakeCondition.wait_until(lock, groupStart + groupInterval, ready);
+        }
+        this->m_writerWaiting = false;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    }
+}
+
+void ResultStore::wakeWriter()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(this->m_writerWaiting.load())
+    {
+        lock_guard<mutex> lock(this->m_mutex);
+        this->m_wakeCondition.notify_one();
+    }
+}
+
+void ResultStore::wakePushers()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(this->m_pushWaiters.load() > 0)
+    {
+        lock_guard<mutex> lock(this->m_mutex);
+        this->m_spaceCondition.notify_all();
+    }
+}
+
+void ResultStore::notifyFlushed()
+{
+    //加锁后通知,flush检查完条件到开始等待之间不会错过通知
+    lock_guard<mutex> lock(this->m_mutex);
+    this->m_flushCondition.notify_all();
+}
+
+bool ResultStore::writeGroup(vector<InspectionResult> &group)
+{
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    //按列整理后批量插入,一组结果在一个事务中提交
+    const size_t cnt = group.size();
+    vector<const char *> boardSerials(cnt);
+    vector<int64_t> componentIds(cnt), timestamps(cnt);
+    vector<int> status(cnt);
+    vector<double> height(cnt), area(cnt), volume(cnt), offsetX(cnt), offsetY(cnt);
+    for(size_t i = 0; i < cnt; ++i)
+    {
+        group[i].boardSerial[InspectionResult::BOARD_SERIAL_SIZE - 1] = '\0';
+        boardSerials[i] = group[i].boardSerial;
+        componentIds[i] = group[i].componentId;
+        timestamps[i] = group[i].timestamp;
+        status[i] = group[i].status;
+        height[i] = group[i].height;
+        area[i] = group[i].area;
+        volume[i] = group[i].volume;
+        offsetX[i] = group[i].offsetX;
+        offsetY[i] = group[i].offsetY;
+    }
+
+    static const vector<string> columnNames = {"BoardSerial", "ComponentId", "Timestamp", "Status",
+                                               "Height", "Area", "Volume", "OffsetX", "OffsetY"};
+    bool ok = false;
+    {
+        SqliteConnectionPool::WriteGuard writer = this->m_pPool->writer();
+        ok = writer->bulkInsert("InspectionResult", columnNames, cnt,
+                                boardSerials.data(), componentIds.data(), timestamps.data(), status.data(),
+                                height.data(), area.data(), volume.data(), offsetX.data(), offsetY.data());
+        if(!ok)
+        {
+            cout << "写入检测结果失败,错误码:" << writer->latestErrorCode() << endl;
+        }
+    }
+
+    if(!ok)
+    {
+        return false;
+    }
+
+    this->m_written.fetch_add(cnt);
+    this->m_groups.fetch_add(1);
+    this->m_lastGroupMicroseconds = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    return true;
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
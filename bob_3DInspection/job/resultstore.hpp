@@ -0,0 +1,201 @@
+#ifndef RESULTSTORE_HPP
+#define RESULTSTORE_HPP
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+#include <boost/lockfree/queue.hpp>
+
+#include "../sdk/customexception.hpp"
+#include "../sdk/DB/sqliteconnectionpool.hpp"
+
+namespace Job
+{
+    /**
+     *  @brief InspectionResult
+     *         一个元件的检测结果,按值放入无锁队列,因此只包含定长的数据
+     */
+    struct InspectionResult
+    {
+        static const int BOARD_SERIAL_SIZE = 32;
+
+        char boardSerial[BOARD_SERIAL_SIZE];    //基板序列号(以'\0'结尾,超出部分截断)
+        int64_t componentId;                    //元件的ID(MeasuredObjList表中的rowid)
+        int64_t timestamp;                      //检测时间(自1970-01-01起的毫秒数)
+        int32_t status;                         //检测结果,0:合格,其他:不良代码
+        double height;                          //高度
+        double area;                            //面积
+        double volume;                          //体积
+        double offsetX;                         //X轴偏移
+        double offsetY;                         //Y轴偏移
+    };
+
+    /**
+     *  @brief ResultStoreSetting
+     *         结果存储的参数
+     */
+    struct ResultStoreSetting
+    {
+        int queueCapacity{16384};       //队列的容量(最大65535),队列满时push等待
+        int pushTimeoutMs{1000};        //队列满时push最多等待的时间,超时后不放入并返回false
+        int groupSize{1024};            //攒够groupSize条结果提交一次
+        int groupIntervalMs{100};       //不足groupSize时,最早的结果等待超过该时间也提交
+        int maxRetries{3};              //一组结果提交失败后的重试次数,仍失败时移入未写入的结果(takeUnwritten)
+        int retryIntervalMs{100};       //两次重试之间的间隔
+    };
+
+    /**
+     *  @brief ResultStoreMetrics
+     *         结果存储的运行统计,用于观察写入是否跟得上检测
+     */
+    struct ResultStoreMetrics
+    {
+        uint64_t pushed{0};             //已放入队列的结果数
+        uint64_t written{0};            //已提交到数据库的结果数
+        uint64_t failed{0};             //重试后仍提交失败,移入未写入结果的结果数
+        uint64_t retries{0};            //提交失败后重试的次数
+        uint64_t groups{0};             //提交成功的次数(事务数)
+        uint64_t queueFullCount{0};     //push时队列已满的次数
+        uint64_t stallMicroseconds{0};  //push因队列已满累计等待的时间(微秒)
+        uint64_t rejected{0};           //未运行,push等待超时或tryPush时队列已满而未放入的结果数
+        uint64_t lastGroupMicroseconds{0};  //最近一次提交的耗时(微秒)
+    };
+
+    /**
+     *  @brief ResultStore
+     *         检测结果的异步存储(写后存储)
+     *         检测线程通过push把结果放入有界的无锁队列后立即返回,不访问数据库;
+     *         后台写线程从队列取出结果,攒够一组(按数量或时间)后在一个事务中批量写入InspectionResult表
+     *         队列为空时写线程在条件变量上等待,push只在写线程等待时才加锁通知
+     *         队列满时push在条件变量上等待(背压),最多等待pushTimeoutMs,等待的次数及时间记录在metrics中
+     *         提交失败的一组结果保留在写线程中按retryIntervalMs重试,重试maxRetries次仍失败时
+     *         移入未写入的结果,由调用者通过takeUnwritten取出另行保存(未写入的结果一直保留在内存中)
+     *         未start或stop之后push/tryPush直接返回false;stop(及析构)会先写完队列中所有的结果再返回
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class ResultStore
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        /*
+        *  @brief  ResultStore
+        *          创建结果表(不存在时)
+        *  @param  pPool:结果数据库的连接池,写入使用其写连接,复判及统计可以同时使用读连接
+        *          setting:队列容量及提交的条件
+        *  @return N/A
+        */
+        ResultStore(SSDK::DB::SqliteConnectionPool * pPool, const ResultStoreSetting & setting = ResultStoreSetting());
+
+        //停止写线程,写完队列中所有的结果
+        ~ResultStore();
+
+        ResultStore(const ResultStore &) = delete;
+        ResultStore & operator=(const ResultStore &) = delete;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //启动后台写线程
+        void start();
+
+        //停止后台写线程,返回前所有已放入队列的结果都已提交(或移入未写入的结果)
+        void stop();
+
+        /*
+        *  @brief  push
+        *          将结果放入队列,可以在多个检测线程中同时调用
+        *          队列满时等待写线程腾出空间,最多等待setting.pushTimeoutMs
+        *  @param  result:检测结果
+        *  @return true:已放入队列; false:未start,已stop或等待超时,结果未放入
+        */
+        bool push(const InspectionResult & result);
+
+        /*
+        *  @brief  tryPush
+        *          将结果放入队列,队列满时不等待
+        *  @param  result:检测结果
+        *  @return true:已放入队列; false:未start,已stop或队列已满,结果未放入
+        */
+        bool tryPush(const InspectionResult & result);
+
+        /*
+        *  @brief  flush
+        *          等待调用之前放入队列的结果全部提交
+        *  @param  N/A
+        *  @return N/A
+        */
+        void flush();
+
+        //获取运行统计
+        ResultStoreMetrics metrics() const;
+
+        //取出重试后仍提交失败的结果(取出后清空),可以另行保存或重新push
+        std::vector<InspectionResult> takeUnwritten();
+
+        //设置结果中的基板序列号
+        static void setBoardSerial(InspectionResult & result, const std::string & boardSerial);
+
+        //当前时间(自1970-01-01起的毫秒数)
+        static int64_t currentTimestamp();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //后台写线程
+        void writerLoop();
+
+        //在一个事务中提交一组结果,失败时返回false,group保持不变
+        bool writeGroup(std::vector<InspectionResult> & group);
+
+        //放入结果后,写线程正在等待时唤醒写线程
+        void wakeWriter();
+
+        //取出结果后,有push在等待空间时唤醒push
+        void wakePushers();
+
+        //一组结果已提交或移入未写入的结果后,唤醒flush
+        void notifyFlushed();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        SSDK::DB::SqliteConnectionPool * m_pPool;   //结果数据库的连接池
+        ResultStoreSetting m_setting;               //队列容量及提交的条件
+
+        boost::lockfree::queue<InspectionResult, boost::lockfree::fixed_sized<true>> m_queue;     //待写入的结果
+
+        std::thread m_writerThread;                 //后台写线程
+        std::atomic<bool> m_running;                //写线程是否在运行
+        std::atomic<bool> m_stopping;               //是否要求写线程退出
+        std::mutex m_mutex;                         //配合条件变量使用,并保护m_unwritten
+        std::condition_variable m_wakeCondition;    //唤醒写线程(push/stop/flush)
+        std::condition_variable m_spaceCondition;   //通知push队列中有空间
+        std::condition_variable m_flushCondition;   //通知flush已写入的数量
+        std::atomic<bool> m_writerWaiting;          //写线程是否在m_wakeCondition上等待
+        std::atomic<int> m_pushWaiters;             //因队列已满而等待的push数
+        std::atomic<int> m_activePushers;           //正在执行push/tryPush的线程数,不为0时写线程不退出
+        std::atomic<int> m_flushWaiters;            //正在flush等待的线程数,不为0时写线程不等凑满一组
+        std::vector<InspectionResult> m_unwritten;  //重试后仍提交失败的结果
+
+        std::atomic<uint64_t> m_pushed;
+        std::atomic<uint64_t> m_written;
+        std::atomic<uint64_t> m_failed;
+        std::atomic<uint64_t> m_retries;
+        std::atomic<uint64_t> m_groups;
+        std::atomic<uint64_t> m_queueFullCount;
+        std::atomic<uint64_t> m_stallMicroseconds;
+        std::atomic<uint64_t> m_rejected;
+        std::atomic<uint64_t> m_lastGroupMicroseconds;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace Job
+
+#endif // RESULTSTORE_HPP
@@ -0,0 +1,132 @@
+#include <cmath>
+#include <algorithm>
+#include <iterator>
+
+#include "spatialindex.hpp"
+
+using namespace std;
+using namespace Job;
+
+namespace bgi = boost::geometry::index;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//构造 & 析构函数
+SpatialIndex::SpatialIndex()
+{
+    this->m_pTable = nullptr;
+}
+
+SpatialIndex::~SpatialIndex()
+{
+
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//成员函数
+void SpatialIndex::build(ComponentTable *pTable)
+{
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //计算每个元件旋转后的外接矩形
+        const int cnt = pTable->size();
+        vector<double> minX(cnt), minY(cnt), maxX(cnt), maxY(cnt);
+        SSDK::RectangleKernel::bounds(pTable->rectangles(),
+                                      minX.data(), minY.data(), maxX.data(), maxY.data());
+
+        vector<Value> values;
+        values.reserve(cnt);
+        for (int i = 0; i < cnt; ++i)
+        {
+            values.push_back(make_pair(Box(Point(minX[i], minY[i]), Point(maxX[i], maxY[i])), i));
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //通过区间构造R-tree,boost会使用批量装载(packing)算法,比逐个插入快且树更平衡
+        RTree rtree(values.begin(), values.end());
+        this->m_rtree.swap(rtree);
+        this->m_pTable = pTable;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void SpatialIndex::assign(const SpatialIndex &other, ComponentTable *pTable)
+{
+    if(&other != this)
+    {
+        this->m_rtree = other.m_rtree;
+    }
+    this->m_pTable = pTable;
+}
+
+void SpatialIndex::clear()
+{
+    this->m_rtree.clear();
+    this->m_pTable = nullptr;
+}
+
+void SpatialIndex::queryRect(double minX, double minY, double maxX, double maxY,
+                             vector<int> &indices) const
+{
+    try
+    {
+        indices.clear();
+
+        vector<Value> result;
+        this->m_rtree.query(bgi::intersects(Box(Point(minX, minY), Point(maxX, maxY))),
+                            back_inserter(result));
+
+        indices.reserve(result.size());
+        for (const Value & value : result)
+        {
+            indices.push_back(value.second);
+        }
+        sort(indices.begin(), indices.end());
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void SpatialIndex::queryPoint(double x, double y, vector<int> &indices) const
+{
+    try
+    {
+        indices.clear();
+
+        //先通过外接矩形筛选出候选元件
+        vector<Value> result;
+        this->m_rtree.query(bgi::intersects(Point(x, y)), back_inserter(result));
+
+        //再判断点是否在旋转矩形内
+        for (const Value & value : result)
+        {
+            int i = value.second;
+            SSDK::Rectangle rectangle(this->m_pTable->xPos()[i],
+                                      this->m_pTable->yPos()[i],
+                                      this->m_pTable->width()[i],
+                                      this->m_pTable->height()[i],
+                                      this->m_pTable->angle()[i]);
+
+            if(SSDK::RectangleKernel::contains(rectangle, x, y))
+            {
+                indices.push_back(i);
+            }
+        }
+        sort(indices.begin(), indices.end());
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
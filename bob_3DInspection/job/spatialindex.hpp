@@ -0,0 +1,100 @@
+#ifndef SPATIALINDEX_HPP
+#define SPATIALINDEX_HPP
+
+#include <vector>
+#include <utility>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+#include "../sdk/customexception.hpp"
+#include "componenttable.hpp"
+
+namespace Job
+{
+    /**
+     *  @brief SpatialIndex
+     *         board上所有元件的空间索引(R-tree),加载程式时根据ComponentTable建立
+     *         索引中保存每个元件(考虑旋转角度)的外接矩形,查询结果为元件在ComponentTable中的索引号
+     *         用于相机FOV,复判站缩放窗口及鼠标点选等区域查询,避免每次都遍历所有元件
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class SpatialIndex
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //enum & struct & define/typedef/using
+        using Point = boost::geometry::model::point<double, 2, boost::geometry::cs::cartesian>;
+        using Box = boost::geometry::model::box<Point>;
+        using Value = std::pair<Box, int>;                   //外接矩形及元件索引号
+        using RTree = boost::geometry::index::rtree<Value, boost::geometry::index::rstar<16>>;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        SpatialIndex();
+
+        ~SpatialIndex();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        /*
+        *  @brief  build
+        *          根据元件表重新建立索引(使用批量装载,不逐个插入)
+        *          索引只记录元件表的地址,元件表的内容变化后需要重新建立索引
+        *  @param  pTable:元件表
+        *  @return N/A
+        */
+        void build(ComponentTable * pTable);
+
+        /*
+        *  @brief  assign
+        *          复制另一个索引的R-tree(逐节点复制,不重新排序装载),并关联到pTable
+        *          pTable的内容必须与other建立索引时的元件表一致(如元件表的副本)
+        *  @param  other:已建立的索引
+        *          pTable:索引关联的元件表
+        *  @return N/A
+        */
+        void assign(const SpatialIndex & other, ComponentTable * pTable);
+
+        //清空索引
+        void clear();
+
+        //索引中元件的数量
+        int size() const {return (int)this->m_rtree.size();}
+
+        /*
+        *  @brief  queryRect
+        *          查询外接矩形与指定矩形区域相交的元件(如相机FOV,复判站缩放窗口)
+        *  @param  minX,minY,maxX,maxY:查询区域的边界
+        *          indices:输出,元件在ComponentTable中的索引号,按索引号从小到大排列
+        *  @return N/A
+        */
+        void queryRect(double minX, double minY, double maxX, double maxY,
+                       std::vector<int> & indices) const;
+
+        /*
+        *  @brief  queryPoint
+        *          查询包含指定点的元件(如鼠标点选),按旋转后的实际矩形判断
+        *  @param  x,y:点的坐标
+        *          indices:输出,元件在ComponentTable中的索引号,按索引号从小到大排列
+        *  @return N/A
+        */
+        void queryPoint(double x, double y, std::vector<int> & indices) const;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        RTree m_rtree;                          //元件外接矩形的R-tree
+        ComponentTable * m_pTable;              //建立索引的元件表
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace Job
+
+#endif // SPATIALINDEX_HPP
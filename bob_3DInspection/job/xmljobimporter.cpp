@@ -0,0 +1,331 @@
+#include <cstdio>
+
+#include "xmljobimporter.hpp"
+#include "jobmigrator.hpp"
+#include "lazyjob.hpp"
+#include "../sdk/formatconvertion.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK;
+using namespace SSDK::DB;
+
+const size_t XmlJobImporter::DEFAULT_BATCH_SIZE;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//内部函数
+namespace
+{
+    //读取字符串属性,不存在时为空字符串
+    string textAttribute(const XmlStreamReader & reader, const string & name)
+    {
+        const string * pValue = reader.attribute(name);
+        return nullptr != pValue ? *pValue : string();
+    }
+
+    //读取数值属性,不存在时为defaultValue(required为true时抛出异常)
+    double numberAttribute(const XmlStreamReader & reader, const string & name, bool required, double defaultValue = 0)
+    {
+        const string * pValue = reader.attribute(name);
+        if(nullptr == pValue)
+        {
+            if(required)
+            {
+                THROW_EXCEPTION("xml第" + to_string(reader.lineNumber()) + "行:元素" + reader.name() + "缺少属性" + name);
+            }
+            return defaultValue;
+        }
+
+        double value = 0;
+        if(!FormatConvertion::charsToDouble(pValue->c_str(), value))
+        {
+            THROW_EXCEPTION("xml第" + to_string(reader.lineNumber()) + "行:元素" + reader.name() + "的属性" + name + "不是数值:" + *pValue);
+        }
+        return value;
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//构造 & 析构函数
+XmlJobImporter::XmlJobImporter(size_t batchSize)
+    : m_batchSize(batchSize > 0 ? batchSize : DEFAULT_BATCH_SIZE),
+      m_batchCount(0),
+      m_nextId(1)
+{
+
+}
+
+XmlJobImporter::~XmlJobImporter()
+{
+
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//成员函数
+size_t XmlJobImporter::importJob(const string &xmlPath,
+                                 const string &jobPath,
+                                 InspectionData *pInspectionData)
+{
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //step1
+    //每一批的各列只分配一次,之后重复使用
+    this->m_ids.resize(this->m_batchSize);
+    this->m_names.resize(this->m_batchSize);
+    this->m_xPos.resize(this->m_batchSize);
+    this->m_yPos.resize(this->m_batchSize);
+    this->m_width.resize(this->m_batchSize);
+    this->m_height.resize(this->m_batchSize);
+    this->m_angle.resize(this->m_batchSize);
+    this->m_batchCount = 0;
+    this->m_nextId = 1;
+
+    if(nullptr != pInspectionData)
+    {
+        pInspectionData->pBoard()->clearMeasuredObjs();
+    }
+
+    const string tmpPath = jobPath + ".tmp";
+    std::remove(tmpPath.c_str());
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    SqliteDB sqlite;
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //在临时文件中创建与writeInspectionDataToJob相同的表,所有写入在一个事务中完成
+        XmlStreamReader reader;
+        reader.open(xmlPath);
+
+        if(!sqlite.open(tmpPath))
+        {
+            THROW_EXCEPTION("创建检测程式失败:" + tmpPath);
+        }
+        if(!sqlite.begin())
+        {
+            THROW_EXCEPTION("开始事务失败,无法导入检测程式!");
+        }
+        if(!sqlite.execute("CREATE TABLE Job(Version TEXT,LastEditingTime TEXT);") ||
+           !sqlite.execute("CREATE TABLE Board(Name TEXT,OriginalX REAL,OriginalY REAL,SizeX REAL,SizeY REAL);") ||
+           !sqlite.execute("CREATE TABLE MeasuredObjList(Id INTEGER PRIMARY KEY,Name TEXT,PosX REAL,PosY REAL,Width REAL,Height REAL,Angle REAL);"))
+        {
+            THROW_EXCEPTION("创建检测程式的表失败!");
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step3
+        //根元素必须是<Job>
+        if(XmlStreamReader::START_ELEMENT != reader.readNext() || "Job" != reader.name())
+        {
+            THROW_EXCEPTION("xml第" + to_string(reader.lineNumber()) + "行:根元素不是Job,不是检测程式导出的xml文件!");
+        }
+        this->readJob(reader, sqlite, pInspectionData);
+        if(XmlStreamReader::END_DOCUMENT != reader.readNext())
+        {
+            THROW_EXCEPTION("xml第" + to_string(reader.lineNumber()) + "行:根元素Job之后还有其他元素!");
+        }
+        reader.close();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step4
+        //所有元件插入后再建立位置索引,提交后替换原有的检测程式
+        if(!sqlite.execute(string("CREATE INDEX ") + LazyJob::POSITION_INDEX_NAME + " ON MeasuredObjList(PosX,PosY);"))
+        {
+            THROW_EXCEPTION("建立检测对象的位置索引失败!");
+        }
+        if(!sqlite.commit())
+        {
+            THROW_EXCEPTION("提交事务失败,无法导入检测程式!");
+        }
+        sqlite.close();
+
+        //rename直接替换已有的检测程式,其他进程不会读到不完整的文件
+        if(0 != std::rename(tmpPath.c_str(), jobPath.c_str()))
+        {
+            THROW_EXCEPTION("保存检测程式失败:" + jobPath);
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //整个程式来自xml,没有需要保存的修改
+        if(nullptr != pInspectionData)
+        {
+            pInspectionData->pBoard()->changeTracker().clear();
+        }
+        return (size_t)(this->m_nextId - 1);
+    }
+    catch(const exception &ex)
+    {
+        sqlite.rollBack();
+        sqlite.close();
+        std::remove(tmpPath.c_str());
+        std::remove((tmpPath + "-journal").c_str());
+        if(nullptr != pInspectionData)
+        {
+            pInspectionData->pBoard()->clearMeasuredObjs();
+        }
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void XmlJobImporter::readJob(XmlStreamReader &reader, SqliteDB &sqlite, InspectionData *pInspectionData)
+{
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //写入Job表,版本号为当前版本
+        const string version = JobMigrator().currentVersion();
+        const string lastEditingTime = textAttribute(reader, "上次编辑时间");
+        if(!sqlite.execute("INSERT INTO Job(Version,LastEditingTime) VALUES(?,?);", version.data(), lastEditingTime.data()))
+        {
+            THROW_EXCEPTION("写入检测程式的版本信息失败!");
+        }
+        if(nullptr != pInspectionData)
+        {
+            pInspectionData->setVersion(version);
+            pInspectionData->setLastEditingTime(lastEditingTime);
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //读取唯一的<Board>,跳过其他元素
+        bool hasBoard = false;
+        while(XmlStreamReader::END_ELEMENT != reader.readNext())
+        {
+            if("Board" != reader.name())
+            {
+                reader.skipCurrentElement();
+                continue;
+            }
+            if(hasBoard)
+            {
+                THROW_EXCEPTION("xml第" + to_string(reader.lineNumber()) + "行:检测程式只能有一个Board!");
+            }
+            hasBoard = true;
+            this->readBoard(reader, sqlite, pInspectionData);
+        }
+
+        if(!hasBoard)
+        {
+            THROW_EXCEPTION("xml中没有Board,无法导入检测程式!");
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void XmlJobImporter::readBoard(XmlStreamReader &reader, SqliteDB &sqlite, InspectionData *pInspectionData)
+{
+    try
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //写入Board表(基板名称,原点x,y坐标,长和宽)
+        const string boardName = textAttribute(reader, "基板名称");
+        const double sizeX = numberAttribute(reader, "基板长度", true);
+        const double sizeY = numberAttribute(reader, "基板宽度", true);
+        const double originalX = numberAttribute(reader, "X轴坐标", true);
+        const double originalY = numberAttribute(reader, "Y轴坐标", true);
+        if(!sqlite.execute("INSERT INTO Board(Name,OriginalX,OriginalY,SizeX,SizeY) VALUES(?,?,?,?,?);",
+                           boardName.data(), originalX, originalY, sizeX, sizeY))
+        {
+            THROW_EXCEPTION("写入基板数据失败!");
+        }
+        if(nullptr != pInspectionData)
+        {
+            pInspectionData->pBoard()->setName(boardName);
+            pInspectionData->pBoard()->setOriginalX(originalX);
+            pInspectionData->pBoard()->setOriginalY(originalY);
+            pInspectionData->pBoard()->setSizeX(sizeX);
+            pInspectionData->pBoard()->setSizeY(sizeY);
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //每个子元素为一个元件,元素名为元件名称,元件的子元素被跳过
+        //2017.12.02 bob 旧版本导出的xml没有元件角度,默认为0
+        while(XmlStreamReader::END_ELEMENT != reader.readNext())
+        {
+            const size_t index = this->m_batchCount;
+            this->m_ids[index] = this->m_nextId;
+            this->m_names[index] = reader.name();
+            this->m_xPos[index] = numberAttribute(reader, "X轴坐标", true);
+            this->m_yPos[index] = numberAttribute(reader, "Y轴坐标", true);
+            this->m_width[index] = numberAttribute(reader, "元件宽度", true);
+            this->m_height[index] = numberAttribute(reader, "元件高度", true);
+            this->m_angle[index] = numberAttribute(reader, "元件角度", false, 0);
+            reader.skipCurrentElement();
+
+            ++this->m_nextId;
+            if(++this->m_batchCount == this->m_batchSize)
+            {
+                this->flushBatch(sqlite, pInspectionData);
+            }
+        }
+        this->flushBatch(sqlite, pInspectionData);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void XmlJobImporter::flushBatch(SqliteDB &sqlite, InspectionData *pInspectionData)
+{
+    try
+    {
+        if(0 == this->m_batchCount)
+        {
+            return;
+        }
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //在已开启的事务中批量插入这一批元件
+        vector<string> columnNames = {"Id", "Name", "PosX", "PosY", "Width", "Height", "Angle"};
+        if(!sqlite.bulkInsert("MeasuredObjList", columnNames, this->m_batchCount,
+                              this->m_ids.data(), this->m_names.data(),
+                              this->m_xPos.data(), this->m_yPos.data(),
+                              this->m_width.data(), this->m_height.data(), this->m_angle.data()))
+        {
+            THROW_EXCEPTION("写入检测对象失败!");
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //从board的内存池中一次分配这一批检测对象,添加到链表的尾部
+        if(nullptr != pInspectionData)
+        {
+            Board * pBoard = pInspectionData->pBoard();
+            MeasuredObj * measuredObjArr = pBoard->measuredObjPool().allocate((int)this->m_batchCount);
+            for (size_t i = 0; i < this->m_batchCount; ++i)
+            {
+                MeasuredObj & obj = measuredObjArr[i];
+                obj.setId(this->m_ids[i]);
+                obj.setName(this->m_names[i]);
+                Rectangle rect(this->m_xPos[i], this->m_yPos[i], this->m_width[i], this->m_height[i], this->m_angle[i]);
+                obj.setRectangle(&rect);
+            }
+            pBoard->pMeasuredObjList()->append(measuredObjArr, measuredObjArr + this->m_batchCount);
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        this->m_batchCount = 0;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
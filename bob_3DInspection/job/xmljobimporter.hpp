@@ -0,0 +1,102 @@
+#ifndef XMLJOBIMPORTER_HPP
+#define XMLJOBIMPORTER_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "../sdk/customexception.hpp"
+#include "../sdk/xmlstreamreader.hpp"
+#include "../sdk/DB/sqlitedb.hpp"
+#include "inspectiondata.hpp"
+
+namespace Job
+{
+    /**
+     *  @brief XmlJobImporter
+     *         将InspectionData::writeInspectionDataToXml导出的xml文件导入为检测程式(sqlite)
+     *         通过XmlStreamReader逐个元素读取,不建立文档树:
+     *             1.<Job>及<Board>的属性分别写入Job表及Board表
+     *             2.<Board>下的每个子元素为一个元件(元素名为元件名称),按读取顺序分配ID(1,2,3...),
+     *               每batchSize个元件通过bulkInsert写入MeasuredObjList表,
+     *               同时可以从board的内存池中分配同样的一批检测对象,添加到检测对象链表中
+     *             3.元件的子元素及其他未知元素被跳过
+     *         不写入内存时,内存占用只有读取缓冲区及一批元件(O(batchSize)),与xml文件的大小无关;
+     *             写入内存(pInspectionData不为空)时,所有检测对象都在内存中,内存占用为O(N)(N为元件数量)
+     *         所有数据先写入<检测程式>.tmp并在一个事务中提交,完成后再替换检测程式,
+     *             导入失败(xml格式错误,缺少属性等)时删除临时文件,原有的检测程式不变
+     *         Job表中的版本号为当前版本(导出的xml总是包含元件角度),不使用xml中的版本号
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class XmlJobImporter
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //常量
+        static const size_t DEFAULT_BATCH_SIZE = 4096;  //每次批量插入的元件数量
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        explicit XmlJobImporter(size_t batchSize = DEFAULT_BATCH_SIZE);
+
+        ~XmlJobImporter();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //访存函数
+        size_t batchSize() const {return this->m_batchSize;}
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        /*
+        *  @brief  importJob
+        *          将xml文件导入为检测程式文件(已存在时被替换)
+        *  @param  xmlPath:xml文件的路径
+        *          jobPath:检测程式文件的路径
+        *          pInspectionData:不为空时同时将检测程式读入该数据(先清空原有的检测对象),
+        *                          元件的ID与检测程式中的一致,失败时检测对象被清空;
+        *                          所有检测对象都保存在内存中(O(N)),只生成检测程式文件时传入nullptr
+        *  @return 导入的元件数量,失败时抛出异常(异常信息中包含xml的行号)
+        */
+        size_t importJob(const std::string & xmlPath,
+                         const std::string & jobPath,
+                         InspectionData * pInspectionData = nullptr);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //读取<Job>下的所有元素
+        void readJob(SSDK::XmlStreamReader & reader, SSDK::DB::SqliteDB & sqlite, InspectionData * pInspectionData);
+
+        //读取<Board>及其所有元件
+        void readBoard(SSDK::XmlStreamReader & reader, SSDK::DB::SqliteDB & sqlite, InspectionData * pInspectionData);
+
+        //将当前一批元件写入检测程式(及内存),并清空这一批
+        void flushBatch(SSDK::DB::SqliteDB & sqlite, InspectionData * pInspectionData);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        size_t m_batchSize;                 //每次批量插入的元件数量
+        size_t m_batchCount;                //当前一批中的元件数量
+        int64_t m_nextId;                   //下一个元件的ID
+
+        //当前一批元件的各列(大小固定为m_batchSize,重复使用)
+        std::vector<int64_t> m_ids;
+        std::vector<std::string> m_names;
+        std::vector<double> m_xPos;
+        std::vector<double> m_yPos;
+        std::vector<double> m_width;
+        std::vector<double> m_height;
+        std::vector<double> m_angle;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace Job
+
+#endif // XMLJOBIMPORTER_HPP
@@ -17,6 +17,7 @@ int main()
 
     //读取程式
     MainWindow mainWindow;
+    mainWindow.setCaptureSetting(&config.captureSetting());
     mainWindow.loadJob(JOB_DIR);
 
     return 0;
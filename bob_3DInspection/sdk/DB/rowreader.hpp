@@ -0,0 +1,226 @@
+#ifndef ROWREADER_HPP
+#define ROWREADER_HPP
+
+#include <string>
+#include <cstdint>
+#include <sqlite3.h>
+
+#include "sqlitedb.hpp"
+
+namespace SSDK
+{
+    namespace DB
+    {
+        /**
+        *  @brief 按行读取查询结果的类型化游标
+        *
+        *         模板参数依次对应查询结果的各列, 每一行直接调用sqlite3_column_xxx把值写入调用者提供的变量,
+        *  不经过columnValue的类型表查找, std::function调用和boost::variant的构造与拆解
+        *
+        *         支持的列类型: int, int64_t, double, float, std::string
+        *
+        *  用法:
+        *         RowReader<std::string,double,double> reader(&sqlite, "select Name,PosX,PosY from MeasuredObjList");
+        *         std::string name; double x, y;
+        *         while(reader.next(name, x, y)) { ... }
+        *
+        *  注意:
+        *         1.RowReader持有自己的Statement(取自连接的语句缓存), 与SqliteDB中的当前语句互不影响, 析构时归还给缓存
+        *         2.列的类型由调用者保证, 与实际存储类型不同时按sqlite的规则转换(如NULL读为0或空字符串)
+        *
+        *  @author bob
+        *  @version 1.00 2026-10-17 bob
+        *                note:create it
+        */
+        template<typename... Ts>
+        class RowReader
+        {
+        public:
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //constructor & deconstructor
+            /**
+             * @brief RowReader
+             *              准备查询语句
+             * @param pDB
+             *              已打开的数据库
+             * @param sqlStr
+             *              查询语句, 结果的列数不能少于模板参数的个数
+             *
+             * 注意:
+             *         准备失败或列数不足时isValid()为false, next()直接返回false
+             */
+            RowReader(SqliteDB * pDB, const std::string & sqlStr);
+            ~RowReader();
+
+            RowReader(const RowReader &) = delete;
+            RowReader & operator=(const RowReader &) = delete;
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //get & set functions
+            /**
+             * @brief isValid
+             * @return
+             *          查询语句是否准备成功
+             */
+            bool isValid() const {return this->m_statement.isValid();}
+
+            /**
+             * @brief latestErrorCode
+             * @return
+             *          最近一次执行的返回码, 读取完所有行后为SQLITE_DONE
+             */
+            int latestErrorCode() const {return this->m_latestResultCode;}
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //read functions
+            /**
+             * @brief bind
+             *             在读取第一行之前, 从第1个占位符开始依次绑定查询参数
+             * @param args
+             *             参数列表, 支持的类型同Statement::bind
+             * @return
+             *             是否成功
+             */
+            template<typename... Args>
+            bool bind(Args &&... args)
+            {
+                bool ok = this->m_statement.bind(std::forward<Args>(args)...);
+                this->m_latestResultCode = this->m_statement.latestErrorCode();
+                return ok;
+            }
+
+            /**
+             * @brief next
+             *             读取下一行, 将各列的值依次写入values
+             * @param values
+             *             接收各列值的变量, 类型与模板参数一致
+             * @return
+             *             读取到一行返回true; 已读完或出错返回false, 通过latestErrorCode区分
+             */
+            bool next(Ts &... values);
+
+            /**
+             * @brief reset
+             *            重置游标, 下一次next从第一行开始读取
+             * @return
+             *            是否成功
+             */
+            bool reset();
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        private:
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //member variant
+            Statement m_statement;                  //查询语句
+            int m_latestResultCode{-1};             //最近一次sqlite执行的返回码
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //column functions
+            template<int... indexes>
+            void readRow(SqliteDB::indexTuple<indexes...> &&, Ts &... values);
+
+            /**
+             *以下的重载函数根据列的类型调用不同的sqlite3_column_XXX函数
+             */
+            static void readColumn(sqlite3_stmt * pstatement, int index, int & value)
+            {
+                value = sqlite3_column_int(pstatement, index);
+            }
+
+            static void readColumn(sqlite3_stmt * pstatement, int index, int64_t & value)
+            {
+                value = sqlite3_column_int64(pstatement, index);
+            }
+
+            static void readColumn(sqlite3_stmt * pstatement, int index, double & value)
+            {
+                value = sqlite3_column_double(pstatement, index);
+            }
+
+            static void readColumn(sqlite3_stmt * pstatement, int index, float & value)
+            {
+                value = (float)sqlite3_column_double(pstatement, index);
+            }
+
+            static void readColumn(sqlite3_stmt * pstatement, int index, std::string & value)
+            {
+                //先取文本再取长度(sqlite要求的顺序), assign可以复用value已有的内存
+                const char * pText = reinterpret_cast<const char *>(sqlite3_column_text(pstatement, index));
+                if(nullptr == pText)
+                {
+                    value.clear();
+                    return;
+                }
+                value.assign(pText, sqlite3_column_bytes(pstatement, index));
+            }
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        };
+    }//End of namespace DB
+}//End of namespace SSDK
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//template functions out of class
+
+template<typename... Ts>
+SSDK::DB::RowReader<Ts...>::RowReader(SqliteDB *pDB, const std::string &sqlStr)
+{
+    this->m_statement = pDB->statement(sqlStr);
+    this->m_latestResultCode = pDB->latestErrorCode();
+    if(!this->m_statement.isValid())
+    {
+        return;
+    }
+
+    //查询结果的列数少于模板参数的个数时无法读取
+    if(this->m_statement.columnCount() < (int)sizeof...(Ts))
+    {
+        this->m_statement.release();
+        this->m_latestResultCode = SQLITE_RANGE;
+    }
+}
+
+template<typename... Ts>
+SSDK::DB::RowReader<Ts...>::~RowReader()
+{
+
+}
+
+template<typename... Ts>
+bool SSDK::DB::RowReader<Ts...>::next(Ts &... values)
+{
+    if(!this->m_statement.next())
+    {
+        this->m_latestResultCode = this->m_statement.latestErrorCode();
+        return false;
+    }
+
+    this->m_latestResultCode = SQLITE_ROW;
+    this->readRow(typename SqliteDB::makeIndexes<sizeof...(Ts)>::type(), values...);
+    return true;
+}
+
+template<typename... Ts>
+bool SSDK::DB::RowReader<Ts...>::reset()
+{
+    bool ok = this->m_statement.reset();
+    this->m_latestResultCode = this->m_statement.latestErrorCode();
+    return ok;
+}
+
+template<typename... Ts>
+template<int... indexes>
+void SSDK::DB::RowReader<Ts...>::readRow(SqliteDB::indexTuple<indexes...> &&, Ts &... values)
+{
+    //逐列展开: 第indexes列写入对应的values
+    sqlite3_stmt* pstatement = this->m_statement.handle();
+    int expand[] = {0, (readColumn(pstatement, indexes, values), 0)...};
+    (void)expand;
+    (void)pstatement;       //没有列(只执行step)时不读取
+}
+
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // ROWREADER_HPP
@@ -0,0 +1,93 @@
+#include "sqliteconnectionpool.hpp"
+#include "../customexception.hpp"
+
+using namespace std;
+using namespace SSDK::DB;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//constructor & deconstructor
+
+SqliteConnectionPool::SqliteConnectionPool(const string &dbPath,
+                                           int readerBusyTimeout,
+                                           int writerBusyTimeout):
+    m_dbPath(dbPath),
+    m_readerBusyTimeout(readerBusyTimeout)
+{
+    //>>>--------------------------------------------------------------------------------
+    //step1
+    //打开写连接, 数据库不存在时创建
+    if(!this->m_writer.open(dbPath, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX))
+    {
+        THROW_EXCEPTION("打开数据库失败: " + dbPath);
+    }
+    this->m_writer.setBusyTimeout(writerBusyTimeout);
+    //<<<--------------------------------------------------------------------------------
+
+    //>>>--------------------------------------------------------------------------------
+    //step2
+    //切换为WAL模式(记录在数据库文件中, 之后所有连接都使用WAL)
+    //WAL模式下synchronous=NORMAL只在检查点时同步磁盘, 断电不会损坏数据库, 最多丢失最近提交的事务
+    string journalMode = this->m_writer.executeScalar<string>("PRAGMA journal_mode=WAL;");
+    if("wal" != journalMode)
+    {
+        THROW_EXCEPTION("数据库无法切换为WAL模式: " + dbPath);
+    }
+    this->m_writer.execute("PRAGMA synchronous=NORMAL;");
+    //<<<--------------------------------------------------------------------------------
+}
+
+SqliteConnectionPool::~SqliteConnectionPool()
+{
+    lock_guard<mutex> lock(this->m_readersMutex);
+    this->m_readers.clear();
+    this->m_writer.close();
+}
+
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//connection functions
+
+size_t SqliteConnectionPool::readerCount()
+{
+    lock_guard<mutex> lock(this->m_readersMutex);
+    return this->m_readers.size();
+}
+
+SqliteDB *SqliteConnectionPool::reader()
+{
+    thread::id threadId = this_thread::get_id();
+
+    lock_guard<mutex> lock(this->m_readersMutex);
+    auto it = this->m_readers.find(threadId);
+    if(it != this->m_readers.end())
+    {
+        return it->second.get();
+    }
+
+    //只读打开: 读连接不会意外写入, 也不会取得写锁
+    unique_ptr<SqliteDB> pReader(new SqliteDB());
+    if(!pReader->open(this->m_dbPath, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX))
+    {
+        THROW_EXCEPTION("打开数据库读连接失败: " + this->m_dbPath);
+    }
+    pReader->setBusyTimeout(this->m_readerBusyTimeout);
+
+    SqliteDB * pDB = pReader.get();
+    this->m_readers[threadId] = std::move(pReader);
+    return pDB;
+}
+
+void SqliteConnectionPool::releaseReader()
+{
+    lock_guard<mutex> lock(this->m_readersMutex);
+    this->m_readers.erase(this_thread::get_id());
+}
+
+SqliteConnectionPool::WriteGuard SqliteConnectionPool::writer()
+{
+    unique_lock<mutex> lock(this->m_writerMutex);
+    return WriteGuard(&this->m_writer, std::move(lock));
+}
+
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
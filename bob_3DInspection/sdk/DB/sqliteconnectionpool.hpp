@@ -0,0 +1,147 @@
+#ifndef SQLITECONNECTIONPOOL_HPP
+#define SQLITECONNECTIONPOOL_HPP
+
+#include <string>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "sqlitedb.hpp"
+
+namespace SSDK
+{
+    namespace DB
+    {
+        /**
+        *  @brief 同一个sqlite数据库的连接池, 数据库以WAL模式打开
+        *
+        *         WAL模式下读和写互不阻塞: 读连接看到的是事务开始时的快照, 写入(如每块基板的检测结果)
+        *  不会让加载程式, 复判及统计等读操作等待
+        *
+        *         1.读连接: 每个线程一个, 第一次调用reader()时以只读方式打开, 之后该线程一直复用
+        *                   读连接只能在取得它的线程中使用, 线程结束前调用releaseReader()关闭
+        *         2.写连接: 整个池只有一个, 通过writer()取得WriteGuard, 持有期间其他线程的writer()等待,
+        *                   写入在进程内串行, 不会在sqlite内部相互等待(SQLITE_BUSY)
+        *
+        *  注意:
+        *         所有连接以SQLITE_OPEN_NOMUTEX打开, 线程安全由连接池保证(读连接不跨线程, 写连接加锁)
+        *
+        *  @author bob
+        *  @version 1.00 2026-10-17 bob
+        *                note:create it
+        */
+        class SqliteConnectionPool
+        {
+        public:
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //enum & struct & define/typedef/using
+            /**
+             * 写连接的独占句柄, 析构时释放写锁
+             * 可以移动, 不能复制
+             */
+            class WriteGuard
+            {
+            public:
+                WriteGuard(SqliteDB * pDB, std::unique_lock<std::mutex> && lock):
+                    m_pDB(pDB),
+                    m_lock(std::move(lock))
+                {
+
+                }
+
+                WriteGuard(WriteGuard && other):
+                    m_pDB(other.m_pDB),
+                    m_lock(std::move(other.m_lock))
+                {
+                    other.m_pDB = nullptr;
+                }
+
+                WriteGuard(const WriteGuard &) = delete;
+                WriteGuard & operator=(const WriteGuard &) = delete;
+
+                SqliteDB * operator->() const {return this->m_pDB;}
+                SqliteDB & db() const {return *this->m_pDB;}
+
+            private:
+                SqliteDB * m_pDB;                       //写连接
+                std::unique_lock<std::mutex> m_lock;    //写锁
+            };
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //constructor & deconstructor
+            /**
+             * @brief SqliteConnectionPool
+             *              打开写连接并将数据库切换为WAL模式, 数据库不存在时创建
+             * @param dbPath
+             *              sqlite路径
+             * @param readerBusyTimeout
+             *              读连接等待锁的超时时间(毫秒), WAL模式下读连接只在检查点等少数情况下需要等待
+             * @param writerBusyTimeout
+             *              写连接等待锁的超时时间(毫秒), 用于等待其他进程的写入
+             *
+             * 注意:
+             *         打开数据库或切换WAL模式失败时抛出异常
+             */
+            explicit SqliteConnectionPool(const std::string& dbPath,
+                                          int readerBusyTimeout = 1000,
+                                          int writerBusyTimeout = 5000);
+
+            //关闭所有连接, 调用前所有线程都应停止使用读连接并释放WriteGuard
+            ~SqliteConnectionPool();
+
+            SqliteConnectionPool(const SqliteConnectionPool &) = delete;
+            SqliteConnectionPool & operator=(const SqliteConnectionPool &) = delete;
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //get & set functions
+            const std::string& dbPath() const {return this->m_dbPath;}
+
+            //当前打开的读连接数量
+            size_t readerCount();
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //connection functions
+            /**
+             * @brief reader
+             *             获取当前线程的读连接, 第一次调用时打开
+             * @return
+             *             读连接, 只能在当前线程中使用
+             */
+            SqliteDB * reader();
+
+            /**
+             * @brief releaseReader
+             *             关闭当前线程的读连接, 线程结束前调用
+             */
+            void releaseReader();
+
+            /**
+             * @brief writer
+             *             获取写连接, 其他线程持有时等待
+             * @return
+             *             写连接的独占句柄
+             */
+            WriteGuard writer();
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        private:
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //member variant
+            std::string m_dbPath;                   //sqlite路径
+            int m_readerBusyTimeout;                //读连接等待锁的超时时间(毫秒)
+
+            SqliteDB m_writer;                      //写连接
+            std::mutex m_writerMutex;               //写锁
+
+            std::unordered_map<std::thread::id, std::unique_ptr<SqliteDB>> m_readers;  //每个线程的读连接
+            std::mutex m_readersMutex;              //保护m_readers
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        };
+    }//End of namespace DB
+}//End of namespace SSDK
+
+#endif // SQLITECONNECTIONPOOL_HPP
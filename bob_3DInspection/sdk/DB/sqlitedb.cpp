@@ -41,6 +41,8 @@ std::unordered_map <int, std::function<void(sqlite3_stmt*,int,SqliteDB::JsonBuil
     { std::make_pair(SQLITE_NULL,    [](sqlite3_stmt* stmt, int index, SqliteDB::JsonBuilder& builder){ builder.Null(); })},//当为NULL时, stmt和index都没有用到, 所以这里会产生一个警告
 };
 
+const size_t SqliteDB::DEFAULT_STATEMENT_CACHE_CAPACITY;
+const size_t SqliteDB::BULK_INSERT_MAX_ROWS;
 std::string SqliteDB::m_beginStr = "begin";
 std::string SqliteDB::m_commitStr = "commit";
 std::string SqliteDB::m_rollbackStr = "rollback";
@@ -85,9 +87,57 @@ bool SqliteDB::open(const string &dbPath)
     this->m_latestResultCode = sqlite3_open(dbPath.data(),&this->m_pdbHandle);
     this->m_isdbOpened = (this->m_latestResultCode  == SQLITE_OK && nullptr != this->m_pdbHandle);
 
+    if(this->m_isdbOpened)
+    {
+        this->m_pStatementCache = std::make_shared<StatementCache>(this->m_pdbHandle, DEFAULT_STATEMENT_CACHE_CAPACITY);
+    }
+
+    return this->m_isdbOpened;
+}
+
+bool SqliteDB::open(const string &dbPath, int flags)
+{
+    this->m_isdbOpened = false;
+
+    this->m_latestResultCode = sqlite3_open_v2(dbPath.data(),&this->m_pdbHandle,flags,nullptr);
+    this->m_isdbOpened = (this->m_latestResultCode  == SQLITE_OK && nullptr != this->m_pdbHandle);
+
+    if(this->m_isdbOpened)
+    {
+        this->m_pStatementCache = std::make_shared<StatementCache>(this->m_pdbHandle, DEFAULT_STATEMENT_CACHE_CAPACITY);
+    }
+
     return this->m_isdbOpened;
 }
 
+bool SqliteDB::setBusyTimeout(int milliseconds)
+{
+    this->m_latestResultCode = sqlite3_busy_timeout(this->m_pdbHandle, milliseconds);
+    return (this->m_latestResultCode  == SQLITE_OK);
+}
+
+bool SqliteDB::copyFrom(SqliteDB &source)
+{
+    if(nullptr == this->m_pdbHandle || nullptr == source.m_pdbHandle)
+    {
+        this->m_latestResultCode = SQLITE_MISUSE;
+        return false;
+    }
+
+    sqlite3_backup* pBackup = sqlite3_backup_init(this->m_pdbHandle, "main", source.m_pdbHandle, "main");
+    if(nullptr == pBackup)
+    {
+        this->m_latestResultCode = sqlite3_errcode(this->m_pdbHandle);
+        return false;
+    }
+
+    //一次复制所有页(-1), 复制期间源数据库被读锁定
+    sqlite3_backup_step(pBackup, -1);
+    this->m_latestResultCode = sqlite3_backup_finish(pBackup);
+
+    return (this->m_latestResultCode == SQLITE_OK);
+}
+
 bool SqliteDB::close()
 {
     if(nullptr == this->m_pdbHandle)
@@ -102,31 +152,18 @@ bool SqliteDB::close()
         }
     }
 
-    sqlite3_finalize(this->m_pstatement);
-
     //>>>--------------------------------------------------------------------------------
     //close db handle
 
     /**
-     *在关闭连接数据库的时候，需要判断关闭所有的结果码，需要循环调用sqlite3_next_stmt释放所有的sqlite3_stmt
-     *对象，最后关闭sqlite3对象
+     *先归还当前语句并释放缓存中所有空闲的语句, 再关闭连接
+     *使用sqlite3_close_v2: 调用者仍持有的Statement在其析构时释放, 连接在最后一条语句释放后才真正关闭
      */
+    this->m_currentStatement.release();
+    this->m_pstatement = nullptr;
+    this->m_pStatementCache.reset();
 
-    this->m_latestResultCode = sqlite3_close(this->m_pdbHandle);
-    while( this->m_latestResultCode == SQLITE_BUSY)
-    {
-        this->m_latestResultCode = SQLITE_OK;
-        auto stmt = sqlite3_next_stmt( this->m_pdbHandle ,nullptr);
-
-        if(nullptr == stmt)
-            break;
-
-        this->m_latestResultCode =sqlite3_finalize(stmt);
-        if(this->m_latestResultCode == SQLITE_OK)
-        {
-            this->m_latestResultCode = sqlite3_close(this->m_pdbHandle);
-        }
-    }
+    this->m_latestResultCode = sqlite3_close_v2(this->m_pdbHandle);
 
     //<<<--------------------------------------------------------------------------------
 
@@ -142,14 +179,22 @@ bool SqliteDB::close()
 
 bool SqliteDB::prepare(const string &sqlStr)
 {
-    this->m_latestResultCode = sqlite3_prepare_v2(
-                this->m_pdbHandle,
-                sqlStr.data(),
-                -1,
-                &this->m_pstatement,
-                nullptr);
+    //上一条当前语句在赋值时归还给缓存, 相同的sql再次prepare时直接复用
+    this->m_currentStatement = this->statement(sqlStr);
+    this->m_pstatement = this->m_currentStatement.handle();
 
-    return (this->m_latestResultCode  == SQLITE_OK);
+    return (this->m_latestResultCode  == SQLITE_OK && nullptr != this->m_pstatement);
+}
+
+Statement SqliteDB::statement(const string &sqlStr)
+{
+    if(!this->m_pStatementCache)
+    {
+        this->m_latestResultCode = SQLITE_MISUSE;
+        return Statement();
+    }
+
+    return this->m_pStatementCache->acquire(sqlStr, this->m_latestResultCode);
 }
 
 bool SqliteDB::step()
@@ -414,4 +459,40 @@ void SqliteDB::bindToJsonValue(int index)
 
 //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//bulk insert
+
+std::string SqliteDB::bulkInsertSql(const std::string &table,
+                                    const std::vector<std::string> &columnNames,
+                                    size_t rowCount)
+{
+    std::string sql = "INSERT INTO " + table + "(";
+    std::string row = "(";
+    for(size_t c = 0; c < columnNames.size(); ++c)
+    {
+        if(c > 0)
+        {
+            sql += ",";
+            row += ",";
+        }
+        sql += columnNames[c];
+        row += "?";
+    }
+    sql += ") VALUES";
+    row += ")";
+
+    sql.reserve(sql.size() + rowCount * (row.size() + 1));
+    for(size_t r = 0; r < rowCount; ++r)
+    {
+        if(r > 0)
+        {
+            sql += ",";
+        }
+        sql += row;
+    }
+    sql += ";";
+
+    return sql;
+}
 
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
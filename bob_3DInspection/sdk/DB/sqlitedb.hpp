@@ -4,6 +4,8 @@
 #include <string>
 #include <type_traits>
 #include <map>
+#include <vector>
+#include <algorithm>
 #include <unordered_map>
 #include <functional>
 #include <memory>
@@ -24,6 +26,7 @@
 //#include "Exception/customexception.hpp"
 //#include "Archive/Json/json.hpp"
 #include "blob.hpp"
+#include "statement.hpp"
 //#include "./stringop.hpp"
 
     namespace SSDK
@@ -104,6 +107,8 @@
                  */
                 static std::unordered_map< int, std::function<void(sqlite3_stmt*,int, JsonBuilder&)> > m_jsonBuilderMap;
 
+                static const size_t DEFAULT_STATEMENT_CACHE_CAPACITY = 32;//每个连接默认缓存的空闲语句数量
+                static const size_t BULK_INSERT_MAX_ROWS = 128;//bulkInsert每条语句最多插入的行数
                 static std::string m_beginStr;//开始
                 static std::string m_commitStr;//提交
                 static std::string m_rollbackStr;//回滚
@@ -149,6 +154,30 @@
                  */
                 int latestErrorCode(){return this->m_latestResultCode;}
 
+                /**
+                 * @brief lastInsertRowId
+                 * @return
+                 *           最近一次成功insert的记录的rowid
+                 *
+                 * 注意:
+                 *         表中定义了INTEGER PRIMARY KEY时, rowid即为该主键的值
+                 */
+                sqlite3_int64 lastInsertRowId(){return sqlite3_last_insert_rowid(this->m_pdbHandle);}
+
+                /**
+                 * @brief dbHandle
+                 * @return
+                 *           数据库操作句柄, 供RowReader等需要独立statement的类使用
+                 */
+                sqlite3* dbHandle(){return this->m_pdbHandle;}
+
+                /**
+                 * @brief statementCache
+                 * @return
+                 *           当前连接的语句缓存, 数据库未打开时为nullptr
+                 */
+                StatementCache* statementCache(){return this->m_pStatementCache.get();}
+
                 //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
                 //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -166,6 +195,17 @@
                  *         如果数据库不存在，数据库将被创建并打开, 如果创建失败则设置失败标志
                  */
                 bool open(const std::string& dbPath);
+                /**
+                 * @brief open
+                 *             按指定的标志打开一个sqlite数据库(sqlite3_open_v2)
+                 * @param dbPath
+                 *              sqlite路径
+                 * @param flags
+                 *              SQLITE_OPEN_READONLY, SQLITE_OPEN_READWRITE, SQLITE_OPEN_CREATE, SQLITE_OPEN_NOMUTEX等的组合
+                 * @return
+                 *              打开是否成功
+                 */
+                bool open(const std::string& dbPath, int flags);
 
                 /**
                  * @brief close
@@ -174,6 +214,27 @@
                  *              关闭是否成功, 成功返回为true,否则返回为false
                  */
                 bool close();
+                /**
+                 * @brief setBusyTimeout
+                 *              设置等待数据库锁的超时时间, 超时后返回SQLITE_BUSY
+                 * @param milliseconds
+                 *              超时时间(毫秒), 0表示不等待
+                 * @return
+                 *              是否成功
+                 */
+                bool setBusyTimeout(int milliseconds);
+                /**
+                 * @brief copyFrom
+                 *              将另一个已打开的数据库的内容完整复制到当前数据库(sqlite3_backup), 当前数据库原有的内容被替换
+                 * @param source
+                 *              源数据库, 只读取不修改
+                 * @return
+                 *              是否成功
+                 *
+                 * 注意:
+                 *         当前数据库以":memory:"打开时, 即把源数据库整个读入内存, 之后的修改不会写回源数据库
+                 */
+                bool copyFrom(SqliteDB& source);
 
                 //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -194,6 +255,18 @@
                  *              是否成功
                  */
                 bool prepare(const std::string& sqlStr);
+                /**
+                 * @brief statement
+                 *             获取sql对应的独立语句句柄, 与prepare使用的当前语句互不影响,
+                 *             可以同时持有多个, 用于需要同时进行的多个查询或反复执行的语句
+                 *
+                 *             语句优先从连接的缓存中取得, 相同的sql文本不会重复调用sqlite3_prepare_v2
+                 * @param sqlStr
+                 *              sql语句
+                 * @return
+                 *              语句句柄, 准备失败时isValid()为false, 错误码见latestErrorCode
+                 */
+                Statement statement(const std::string& sqlStr);
 
                 /**
                  * @brief step
@@ -386,6 +459,35 @@
                 template<int... indexes,typename Tuple>//用到了in的类型便于参数展开, 但是没有直接用到in, 所以这里会发生一个警告
                 bool insertTupleToSqlite( indexTuple< indexes... >&& in,Tuple&& tuple);
 
+                //>>>-------------------------------------------------------------------------------------------------------------------------------------
+                //4.bulk (insert)
+
+                /**
+                 * @brief bulkInsert
+                 *             按列批量插入数据
+                 * @param table
+                 *             表名
+                 * @param columnNames
+                 *             列名, 数量与columns一致
+                 * @param rowCount
+                 *             行数
+                 * @param columns
+                 *             各列数据的首地址(每列rowCount个元素), 支持double,int,int64_t,std::string,const char*
+                 * @return
+                 *             是否成功
+                 *
+                 * 注意:
+                 *         1.每条语句一次插入多行(INSERT ... VALUES(...),(...),...), 行数受sqlite的参数数量上限及
+                 * BULK_INSERT_MAX_ROWS限制; 整块的语句只准备一次反复使用, 最后不足一块的行再用一条语句插入
+                 *         2.当前没有事务时在一个事务中完成, 失败时回滚; 已在事务中时由调用者提交或回滚
+                 *         3.字符串以SQLITE_STATIC绑定, 不复制, 调用期间columns必须保持有效
+                 */
+                template<typename... Columns>
+                bool bulkInsert(const std::string& table,
+                                const std::vector<std::string>& columnNames,
+                                size_t rowCount,
+                                const Columns*... columns);
+
                 //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
                 //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -433,6 +535,8 @@
                  */
                 sqlite3* m_pdbHandle{nullptr};//数据库操作句柄
                 sqlite3_stmt* m_pstatement{nullptr};//数据路状态句柄, 已经把sql语句解析了的、用sqlite自己标记记录的内部数据结构。
+                Statement m_currentStatement;//prepare使用的当前语句, m_pstatement即为其句柄, 再次prepare时归还给缓存
+                std::shared_ptr<StatementCache> m_pStatementCache;//已准备好的语句的缓存, 以sql文本为键
 
                 int m_latestResultCode {-1};//最近一次sqlite执行的返回码
                 bool m_isdbOpened{false};//db是否打开
@@ -565,6 +669,52 @@
                  */
                 void bindJsonNumberToSqlite(const rapidjson::Value& val,int index);
 
+                //>>>-------------------------------------------------------------------------------------------------------------------------------------
+                //3.interaction of bulk insert and sqlite type
+
+                /**
+                 * @brief bulkInsertSql
+                 *             生成一次插入rowCount行的语句: INSERT INTO table(c1,c2) VALUES(?,?),(?,?)...
+                 */
+                static std::string bulkInsertSql(const std::string& table,
+                                                 const std::vector<std::string>& columnNames,
+                                                 size_t rowCount);
+
+                /**
+                 * @brief bindBulkRows
+                 *             将第first行起的rowCount行绑定到statement, 第r行第c列绑定到第r*列数+c+1个参数
+                 */
+                template<int... indexes, typename... Columns>
+                static int bindBulkRows(sqlite3_stmt* pstatement,
+                                        size_t first,
+                                        size_t rowCount,
+                                        indexTuple<indexes...>&& in,
+                                        const Columns*... columns);
+
+                /**
+                 *以下的重载函数根据列的类型调用不同的sqlite3_bind_XXX函数
+                 */
+                static int bindBulkValue(sqlite3_stmt* pstatement, int index, double value)
+                {
+                    return sqlite3_bind_double(pstatement, index, value);
+                }
+                static int bindBulkValue(sqlite3_stmt* pstatement, int index, int value)
+                {
+                    return sqlite3_bind_int(pstatement, index, value);
+                }
+                static int bindBulkValue(sqlite3_stmt* pstatement, int index, int64_t value)
+                {
+                    return sqlite3_bind_int64(pstatement, index, value);
+                }
+                static int bindBulkValue(sqlite3_stmt* pstatement, int index, const std::string& value)
+                {
+                    return sqlite3_bind_text(pstatement, index, value.data(), (int)value.length(), SQLITE_STATIC);
+                }
+                static int bindBulkValue(sqlite3_stmt* pstatement, int index, const char* value)
+                {
+                    return sqlite3_bind_text(pstatement, index, value, -1, SQLITE_STATIC);
+                }
+
             };//End of namespace Sqlite
         }//End of namespace DB
     }//End of namespace SSDK
@@ -645,6 +795,134 @@
         return res;
     }
 
+    template<typename... Columns>
+    bool SSDK::DB::SqliteDB::bulkInsert(const std::string& table,
+                                        const std::vector<std::string>& columnNames,
+                                        size_t rowCount,
+                                        const Columns*... columns)
+    {
+        const size_t colCount = sizeof...(Columns);
+        if(0 == colCount || columnNames.size() != colCount || nullptr == this->m_pdbHandle)
+        {
+            this->m_latestResultCode = SQLITE_MISUSE;
+            return false;
+        }
+        if(0 == rowCount)
+        {
+            return true;
+        }
+
+        //>>>--------------------------------------------------------------------------------
+        //step1
+        //每条语句的行数: 不超过sqlite的参数数量上限
+        size_t maxVariables = (size_t)sqlite3_limit(this->m_pdbHandle, SQLITE_LIMIT_VARIABLE_NUMBER, -1);
+        size_t chunkRows = std::min(BULK_INSERT_MAX_ROWS, maxVariables / colCount);
+        if(0 == chunkRows)
+        {
+            this->m_latestResultCode = SQLITE_RANGE;
+            return false;
+        }
+
+        //当前没有事务时自己开启事务
+        bool ownTransaction = (0 != sqlite3_get_autocommit(this->m_pdbHandle));
+        if(ownTransaction && !this->begin())
+        {
+            return false;
+        }
+        //<<<--------------------------------------------------------------------------------
+
+        //>>>--------------------------------------------------------------------------------
+        //step2
+        //整块的行用同一条语句反复插入, 最后不足一块的行用另一条语句插入
+        bool ok = true;
+        size_t first = 0;
+        size_t fullChunks = rowCount / chunkRows;
+        if(fullChunks > 0)
+        {
+            Statement statement = this->statement(bulkInsertSql(table, columnNames, chunkRows));
+            ok = statement.isValid();
+            for(size_t i = 0; ok && i < fullChunks; ++i, first += chunkRows)
+            {
+                this->m_latestResultCode = bindBulkRows(statement.handle(), first, chunkRows,
+                                                        typename makeIndexes<sizeof...(Columns)>::type(),
+                                                        columns...);
+                ok = (SQLITE_OK == this->m_latestResultCode) && !statement.next() &&
+                     SQLITE_DONE == statement.latestErrorCode();
+                if(!ok && SQLITE_OK == this->m_latestResultCode)
+                {
+                    this->m_latestResultCode = statement.latestErrorCode();
+                }
+                sqlite3_reset(statement.handle());
+            }
+        }
+
+        size_t tailRows = rowCount - first;
+        if(ok && tailRows > 0)
+        {
+            Statement statement = this->statement(bulkInsertSql(table, columnNames, tailRows));
+            ok = statement.isValid();
+            if(ok)
+            {
+                this->m_latestResultCode = bindBulkRows(statement.handle(), first, tailRows,
+                                                        typename makeIndexes<sizeof...(Columns)>::type(),
+                                                        columns...);
+                ok = (SQLITE_OK == this->m_latestResultCode) && !statement.next() &&
+                     SQLITE_DONE == statement.latestErrorCode();
+                if(!ok && SQLITE_OK == this->m_latestResultCode)
+                {
+                    this->m_latestResultCode = statement.latestErrorCode();
+                }
+            }
+        }
+        //<<<--------------------------------------------------------------------------------
+
+        //>>>--------------------------------------------------------------------------------
+        //step3
+        //提交或回滚自己开启的事务
+        if(ownTransaction)
+        {
+            int resultCode = this->m_latestResultCode;
+            if(ok)
+            {
+                ok = this->commit();
+            }
+            else
+            {
+                this->rollBack();
+                this->m_latestResultCode = resultCode;
+            }
+        }
+        //<<<--------------------------------------------------------------------------------
+
+        return ok;
+    }
+
+    template<int... indexes, typename... Columns>
+    int SSDK::DB::SqliteDB::bindBulkRows(sqlite3_stmt* pstatement,
+                                         size_t first,
+                                         size_t rowCount,
+                                         indexTuple<indexes...>&&,
+                                         const Columns*... columns)
+    {
+        const int colCount = sizeof...(Columns);
+        for(size_t r = 0; r < rowCount; ++r)
+        {
+            //逐列展开: 第indexes列绑定到第r*colCount+indexes+1个参数
+            int base = (int)r * colCount + 1;
+            size_t row = first + r;
+            int resultCodes[] = {bindBulkValue(pstatement, base + indexes, columns[row])...};
+            for(int c = 0; c < colCount; ++c)
+            {
+                if(SQLITE_OK != resultCodes[c])
+                {
+                    return resultCodes[c];
+                }
+            }
+        }
+
+        return SQLITE_OK;
+    }
+
     template<typename Tuple>
     bool SSDK::DB::SqliteDB::insertTupleToSqlite(const std::string& sqlStr, Tuple&& t)
     {
@@ -0,0 +1,209 @@
+#include "statement.hpp"
+
+using namespace std;
+using namespace SSDK::DB;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//Statement
+
+Statement::Statement()
+{
+
+}
+
+Statement::Statement(sqlite3_stmt *pstatement,
+                     const string &sql,
+                     const weak_ptr<StatementCache> &pCache):
+    m_pstatement(pstatement),
+    m_sql(sql),
+    m_pCache(pCache),
+    m_latestResultCode(SQLITE_OK)
+{
+
+}
+
+Statement::~Statement()
+{
+    this->release();
+}
+
+Statement::Statement(Statement &&other):
+    m_pstatement(other.m_pstatement),
+    m_sql(std::move(other.m_sql)),
+    m_pCache(std::move(other.m_pCache)),
+    m_latestResultCode(other.m_latestResultCode)
+{
+    other.m_pstatement = nullptr;
+}
+
+Statement &Statement::operator=(Statement &&other)
+{
+    if(this != &other)
+    {
+        this->release();
+        this->m_pstatement = other.m_pstatement;
+        this->m_sql = std::move(other.m_sql);
+        this->m_pCache = std::move(other.m_pCache);
+        this->m_latestResultCode = other.m_latestResultCode;
+        other.m_pstatement = nullptr;
+    }
+
+    return *this;
+}
+
+bool Statement::next()
+{
+    if(nullptr == this->m_pstatement)
+    {
+        return false;
+    }
+
+    this->m_latestResultCode = sqlite3_step(this->m_pstatement);
+    return SQLITE_ROW == this->m_latestResultCode;
+}
+
+bool Statement::reset()
+{
+    if(nullptr == this->m_pstatement)
+    {
+        return false;
+    }
+
+    this->m_latestResultCode = sqlite3_reset(this->m_pstatement);
+    sqlite3_clear_bindings(this->m_pstatement);
+    return SQLITE_OK == this->m_latestResultCode;
+}
+
+void Statement::release()
+{
+    if(nullptr == this->m_pstatement)
+    {
+        return;
+    }
+
+    //先重置语句, 空闲的语句不能持有读事务, 否则会阻塞写入
+    sqlite3_reset(this->m_pstatement);
+    sqlite3_clear_bindings(this->m_pstatement);
+
+    shared_ptr<StatementCache> pCache = this->m_pCache.lock();
+    if(pCache)
+    {
+        pCache->release(this->m_sql, this->m_pstatement);
+    }
+    else
+    {
+        //连接已关闭(缓存已销毁), 直接释放
+        sqlite3_finalize(this->m_pstatement);
+    }
+
+    this->m_pstatement = nullptr;
+    this->m_pCache.reset();
+}
+
+string Statement::columnText(int index) const
+{
+    const char* pText = reinterpret_cast<const char*>(sqlite3_column_text(this->m_pstatement, index));
+    if(nullptr == pText)
+    {
+        return string();
+    }
+
+    return string(pText, sqlite3_column_bytes(this->m_pstatement, index));
+}
+
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//StatementCache
+
+StatementCache::StatementCache(sqlite3 *pdbHandle, size_t capacity):
+    m_pdbHandle(pdbHandle),
+    m_capacity(capacity)
+{
+
+}
+
+StatementCache::~StatementCache()
+{
+    this->clear();
+}
+
+void StatementCache::setCapacity(size_t capacity)
+{
+    this->m_capacity = capacity;
+    this->evict();
+}
+
+Statement StatementCache::acquire(const string &sql, int &resultCode)
+{
+    //命中: 从缓存中取出, 由Statement独占, 归还前其他acquire不会拿到同一条语句
+    auto it = this->m_index.find(sql);
+    if(it != this->m_index.end())
+    {
+        sqlite3_stmt* pstatement = it->second->pstatement;
+        this->m_lru.erase(it->second);
+        this->m_index.erase(it);
+        ++this->m_hitCount;
+
+        resultCode = SQLITE_OK;
+        return Statement(pstatement, sql, this->shared_from_this());
+    }
+
+    //未命中: 准备新的语句
+    ++this->m_missCount;
+    sqlite3_stmt* pstatement = nullptr;
+    resultCode = sqlite3_prepare_v2(this->m_pdbHandle,
+                                    sql.data(),
+                                    (int)sql.length(),
+                                    &pstatement,
+                                    nullptr);
+    if(SQLITE_OK != resultCode || nullptr == pstatement)
+    {
+        //sql为空白或只有注释时prepare成功但没有语句
+        sqlite3_finalize(pstatement);
+        return Statement();
+    }
+
+    return Statement(pstatement, sql, this->shared_from_this());
+}
+
+void StatementCache::clear()
+{
+    for(auto it = this->m_lru.begin(); it != this->m_lru.end(); ++it)
+    {
+        sqlite3_finalize(it->pstatement);
+    }
+    this->m_lru.clear();
+    this->m_index.clear();
+}
+
+void StatementCache::release(const string &sql, sqlite3_stmt *pstatement)
+{
+    //相同sql的空闲语句已在缓存中时, 多余的直接释放
+    if(0 == this->m_capacity || this->m_index.find(sql) != this->m_index.end())
+    {
+        sqlite3_finalize(pstatement);
+        return;
+    }
+
+    Entry entry;
+    entry.sql = sql;
+    entry.pstatement = pstatement;
+    this->m_lru.push_front(entry);
+    this->m_index[sql] = this->m_lru.begin();
+
+    this->evict();
+}
+
+void StatementCache::evict()
+{
+    while(this->m_lru.size() > this->m_capacity)
+    {
+        Entry & entry = this->m_lru.back();
+        sqlite3_finalize(entry.pstatement);
+        this->m_index.erase(entry.sql);
+        this->m_lru.pop_back();
+    }
+}
+
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
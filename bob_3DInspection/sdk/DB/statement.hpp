@@ -0,0 +1,327 @@
+#ifndef STATEMENT_HPP
+#define STATEMENT_HPP
+
+#include <string>
+#include <list>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+#include <sqlite3.h>
+
+#include "blob.hpp"
+
+namespace SSDK
+{
+    namespace DB
+    {
+        class StatementCache;
+
+        /**
+        *  @brief 一条已准备好的sql语句(sqlite3_stmt)的句柄
+        *
+        *         Statement只能移动不能复制, 析构或release时语句被重置并归还给所属连接的StatementCache,
+        *  下一次准备相同的sql文本时直接复用, 不再调用sqlite3_prepare_v2
+        *         同一个连接上可以同时持有多个Statement(包括sql文本相同的), 彼此互不影响
+        *
+        *  注意:
+        *         1.Statement只能在打开它的连接所在的线程中使用
+        *         2.连接关闭后Statement仍可以安全析构, 此时语句直接释放
+        *
+        *  @author bob
+        *  @version 1.00 2026-10-17 bob
+        *                note:create it
+        */
+        class Statement
+        {
+            friend class StatementCache;
+
+        public:
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //constructor & deconstructor
+            Statement();
+            ~Statement();
+
+            Statement(Statement && other);
+            Statement & operator=(Statement && other);
+
+            Statement(const Statement &) = delete;
+            Statement & operator=(const Statement &) = delete;
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //get & set functions
+            /**
+             * @brief isValid
+             * @return
+             *          是否持有一条已准备好的语句
+             */
+            bool isValid() const {return nullptr != this->m_pstatement;}
+
+            /**
+             * @brief handle
+             * @return
+             *          sqlite3_stmt句柄, 供需要直接调用sqlite3_column_xxx的代码使用
+             */
+            sqlite3_stmt* handle() const {return this->m_pstatement;}
+
+            /**
+             * @brief sql
+             * @return
+             *          语句的sql文本
+             */
+            const std::string& sql() const {return this->m_sql;}
+
+            /**
+             * @brief latestErrorCode
+             * @return
+             *          最近一次执行的返回码
+             */
+            int latestErrorCode() const {return this->m_latestResultCode;}
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //execute functions
+            /**
+             * @brief bind
+             *             从第1个占位符开始依次绑定参数
+             * @param args
+             *             参数列表, 支持int,int64_t,double,float,std::string,const char*,Blob,nullptr
+             * @return
+             *             是否成功
+             */
+            template<typename... Args>
+            bool bind(Args &&... args);
+
+            /**
+             * @brief next
+             *             执行一次sqlite3_step
+             * @return
+             *             得到一行结果返回true; 执行完毕或出错返回false, 通过latestErrorCode区分
+             */
+            bool next();
+
+            /**
+             * @brief execute
+             *             绑定参数并执行一次(insert,update,delete等), 执行后重置语句以便再次执行
+             * @param args
+             *             参数列表
+             * @return
+             *             执行完毕(SQLITE_DONE)返回true
+             */
+            template<typename... Args>
+            bool execute(Args &&... args);
+
+            /**
+             * @brief reset
+             *            重置语句并清除绑定的参数
+             * @return
+             *            是否成功
+             */
+            bool reset();
+
+            /**
+             * @brief release
+             *            重置语句并归还给StatementCache, 之后isValid()为false
+             */
+            void release();
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //column functions
+            int columnCount() const {return sqlite3_column_count(this->m_pstatement);}
+            int columnInt(int index) const {return sqlite3_column_int(this->m_pstatement, index);}
+            int64_t columnInt64(int index) const {return sqlite3_column_int64(this->m_pstatement, index);}
+            double columnDouble(int index) const {return sqlite3_column_double(this->m_pstatement, index);}
+            std::string columnText(int index) const;
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        private:
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //constructor
+            Statement(sqlite3_stmt* pstatement,
+                      const std::string& sql,
+                      const std::weak_ptr<StatementCache>& pCache);
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //member variant
+            sqlite3_stmt* m_pstatement{nullptr};        //语句句柄
+            std::string m_sql;                          //sql文本, 归还时作为缓存的键
+            std::weak_ptr<StatementCache> m_pCache;     //所属连接的缓存, 连接关闭后失效
+            int m_latestResultCode{-1};                 //最近一次执行的返回码
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //bind functions
+            int bindArgs(int){return SQLITE_OK;}
+            template<typename T, typename... Args>
+            int bindArgs(int current, T && first, Args &&... args);
+
+            /**
+             *以下的重载函数根据参数类型调用不同的sqlite3_bind_XXX函数
+             */
+            int bindValue(int current, double value){return sqlite3_bind_double(this->m_pstatement, current, value);}
+            int bindValue(int current, float value){return sqlite3_bind_double(this->m_pstatement, current, value);}
+            int bindValue(int current, int value){return sqlite3_bind_int(this->m_pstatement, current, value);}
+            int bindValue(int current, unsigned int value){return sqlite3_bind_int64(this->m_pstatement, current, value);}
+            int bindValue(int current, long value){return sqlite3_bind_int64(this->m_pstatement, current, value);}
+            int bindValue(int current, long long value){return sqlite3_bind_int64(this->m_pstatement, current, value);}
+            int bindValue(int current, unsigned long value){return sqlite3_bind_int64(this->m_pstatement, current, (sqlite3_int64)value);}
+            int bindValue(int current, unsigned long long value){return sqlite3_bind_int64(this->m_pstatement, current, (sqlite3_int64)value);}
+            int bindValue(int current, const std::string& value)
+            {
+                return sqlite3_bind_text(this->m_pstatement, current, value.data(), (int)value.length(), SQLITE_TRANSIENT);
+            }
+            int bindValue(int current, const char* value)
+            {
+                return sqlite3_bind_text(this->m_pstatement, current, value, -1, SQLITE_TRANSIENT);
+            }
+            int bindValue(int current, const Blob& value)
+            {
+                return sqlite3_bind_blob(this->m_pstatement, current, value.buf(), value.size(), SQLITE_TRANSIENT);
+            }
+            int bindValue(int current, std::nullptr_t){return sqlite3_bind_null(this->m_pstatement, current);}
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        };
+
+        /**
+        *  @brief 一个连接上已准备好的语句的LRU缓存, 以sql文本为键
+        *
+        *         acquire时从缓存中取出空闲的语句(命中)或新准备一条(未命中), 语句由返回的Statement持有;
+        *  Statement归还时放回缓存的最前面, 超出容量时释放最久未使用的语句
+        *         每个sql文本最多缓存一条空闲语句, 多个相同sql的Statement同时归还时多余的直接释放
+        *
+        *  @author bob
+        *  @version 1.00 2026-10-17 bob
+        *                note:create it
+        */
+        class StatementCache : public std::enable_shared_from_this<StatementCache>
+        {
+        public:
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //constructor & deconstructor
+            /**
+             * @brief StatementCache
+             * @param pdbHandle
+             *              数据库连接
+             * @param capacity
+             *              最多缓存的空闲语句数量
+             */
+            StatementCache(sqlite3* pdbHandle, size_t capacity);
+
+            //释放所有空闲的语句
+            ~StatementCache();
+
+            StatementCache(const StatementCache &) = delete;
+            StatementCache & operator=(const StatementCache &) = delete;
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //get & set functions
+            size_t size() const {return this->m_lru.size();}
+            size_t capacity() const {return this->m_capacity;}
+            void setCapacity(size_t capacity);
+
+            //命中及未命中(需要sqlite3_prepare_v2)的次数
+            uint64_t hitCount() const {return this->m_hitCount;}
+            uint64_t missCount() const {return this->m_missCount;}
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //cache functions
+            /**
+             * @brief acquire
+             *             获取sql对应的语句, 缓存中有空闲的语句时直接使用, 否则调用sqlite3_prepare_v2
+             * @param sql
+             *             sql文本
+             * @param resultCode
+             *             sqlite3_prepare_v2的返回码(命中时为SQLITE_OK)
+             * @return
+             *             语句的句柄, 准备失败时isValid()为false
+             */
+            Statement acquire(const std::string& sql, int& resultCode);
+
+            /**
+             * @brief clear
+             *             释放所有空闲的语句
+             */
+            void clear();
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        private:
+            friend class Statement;
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //member variant
+            struct Entry
+            {
+                std::string sql;
+                sqlite3_stmt* pstatement;
+            };
+
+            sqlite3* m_pdbHandle;                                                       //数据库连接
+            size_t m_capacity;                                                          //最多缓存的空闲语句数量
+            std::list<Entry> m_lru;                                                     //空闲的语句, 最前面为最近归还的
+            std::unordered_map<std::string, std::list<Entry>::iterator> m_index;        //sql文本到m_lru中位置的索引
+            uint64_t m_hitCount{0};
+            uint64_t m_missCount{0};
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //cache functions
+            //归还语句(已重置), 由Statement调用
+            void release(const std::string& sql, sqlite3_stmt* pstatement);
+
+            //释放超出容量的最久未使用的语句
+            void evict();
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        };
+    }//End of namespace DB
+}//End of namespace SSDK
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//template functions out of class
+
+template<typename... Args>
+bool SSDK::DB::Statement::bind(Args &&... args)
+{
+    if(nullptr == this->m_pstatement)
+    {
+        return false;
+    }
+
+    this->m_latestResultCode = this->bindArgs(1, std::forward<Args>(args)...);
+    return SQLITE_OK == this->m_latestResultCode;
+}
+
+template<typename... Args>
+bool SSDK::DB::Statement::execute(Args &&... args)
+{
+    if(!this->bind(std::forward<Args>(args)...))
+    {
+        return false;
+    }
+
+    this->m_latestResultCode = sqlite3_step(this->m_pstatement);
+    int resultCode = this->m_latestResultCode;
+    sqlite3_reset(this->m_pstatement);
+
+    return SQLITE_DONE == resultCode;
+}
+
+template<typename T, typename... Args>
+int SSDK::DB::Statement::bindArgs(int current, T && first, Args &&... args)
+{
+    int resultCode = this->bindValue(current, first);
+    if(SQLITE_OK != resultCode)
+    {
+        return resultCode;
+    }
+
+    return this->bindArgs(current + 1, std::forward<Args>(args)...);
+}
+
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // STATEMENT_HPP
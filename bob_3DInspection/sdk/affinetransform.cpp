@@ -0,0 +1,136 @@
+#include <cmath>
+
+#include "affinetransform.hpp"
+
+using namespace std;
+using namespace SSDK;
+
+//弧度转角度的系数
+static const double RAD_TO_DEG = 180.0 / 3.14159265358979323846;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//构造 & 析构函数
+AffineTransform::AffineTransform()
+{
+    this->m_a = 1;
+    this->m_b = 0;
+    this->m_c = 0;
+    this->m_d = 1;
+    this->m_tx = 0;
+    this->m_ty = 0;
+}
+
+AffineTransform::AffineTransform(double a, double b, double c, double d, double tx, double ty)
+{
+    this->m_a = a;
+    this->m_b = b;
+    this->m_c = c;
+    this->m_d = d;
+    this->m_tx = tx;
+    this->m_ty = ty;
+}
+
+AffineTransform::~AffineTransform()
+{
+
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//成员函数
+double AffineTransform::rotation() const
+{
+    return std::atan2(this->m_c, this->m_a) * RAD_TO_DEG;
+}
+
+AffineTransform AffineTransform::fromPoints(const double *srcX, const double *srcY,
+                                            const double *dstX, const double *dstY,
+                                            int cnt)
+{
+    if(cnt < 1)
+    {
+        THROW_EXCEPTION("求解变换至少需要1组对应点!");
+    }
+
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //step1
+    //计算两组点的重心,后面都使用去重心后的坐标,提高数值稳定性
+    double srcCx = 0, srcCy = 0, dstCx = 0, dstCy = 0;
+    for (int i = 0; i < cnt; ++i)
+    {
+        srcCx += srcX[i];
+        srcCy += srcY[i];
+        dstCx += dstX[i];
+        dstCy += dstY[i];
+    }
+    srcCx /= cnt;
+    srcCy /= cnt;
+    dstCx /= cnt;
+    dstCy /= cnt;
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //step2
+    //根据点的数量求解线性部分
+    double a = 1, b = 0, c = 0, d = 1;
+    if(2 == cnt)
+    {
+        //相似变换: [a -c; c a],由两点连线的旋转和缩放确定
+        double sx = srcX[1] - srcX[0];
+        double sy = srcY[1] - srcY[0];
+        double tx = dstX[1] - dstX[0];
+        double ty = dstY[1] - dstY[0];
+        double len2 = sx * sx + sy * sy;
+        if(len2 <= 0)
+        {
+            THROW_EXCEPTION("两个Mark点重合,无法求解变换!");
+        }
+
+        a = (sx * tx + sy * ty) / len2;
+        c = (sx * ty - sy * tx) / len2;
+        b = -c;
+        d = a;
+    }
+    else if(cnt >= 3)
+    {
+        //最小二乘: 求解正规方程 [Sxx Sxy; Sxy Syy] * [a b]^T = [Sxu Syu]^T, [c d]同理
+        double sxx = 0, sxy = 0, syy = 0;
+        double sxu = 0, syu = 0, sxv = 0, syv = 0;
+        for (int i = 0; i < cnt; ++i)
+        {
+            double x = srcX[i] - srcCx;
+            double y = srcY[i] - srcCy;
+            double u = dstX[i] - dstCx;
+            double v = dstY[i] - dstCy;
+
+            sxx += x * x;
+            sxy += x * y;
+            syy += y * y;
+            sxu += x * u;
+            syu += y * u;
+            sxv += x * v;
+            syv += y * v;
+        }
+
+        double det = sxx * syy - sxy * sxy;
+        if(std::fabs(det) <= 1e-12 * (sxx * syy + 1e-300))
+        {
+            THROW_EXCEPTION("Mark点共线,无法求解仿射变换!");
+        }
+
+        a = (sxu * syy - syu * sxy) / det;
+        b = (syu * sxx - sxu * sxy) / det;
+        c = (sxv * syy - syv * sxy) / det;
+        d = (syv * sxx - sxv * sxy) / det;
+    }
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //step3
+    //平移部分使两组点的重心重合
+    return AffineTransform(a, b, c, d,
+                           dstCx - (a * srcCx + b * srcCy),
+                           dstCy - (c * srcCx + d * srcCy));
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,82 @@
+#ifndef AFFINETRANSFORM_HPP
+#define AFFINETRANSFORM_HPP
+
+#include "customexception.hpp"
+
+namespace SSDK
+{
+    /**
+     *  @brief AffineTransform
+     *         二维仿射变换: x' = a*x + b*y + tx
+     *                       y' = c*x + d*y + ty
+     *         可以根据若干组对应点求解: 1组为平移,2组为相似变换(平移+旋转+等比缩放),3组及以上为最小二乘仿射变换
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class AffineTransform
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        //默认为单位变换
+        AffineTransform();
+
+        AffineTransform(double a, double b, double c, double d, double tx, double ty);
+
+        ~AffineTransform();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //访存函数
+        //获取变换矩阵的各项
+        double a() const {return this->m_a;}
+        double b() const {return this->m_b;}
+        double c() const {return this->m_c;}
+        double d() const {return this->m_d;}
+        double tx() const {return this->m_tx;}
+        double ty() const {return this->m_ty;}
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //变换一个点
+        void map(double x, double y, double & mappedX, double & mappedY) const
+        {
+            mappedX = this->m_a * x + this->m_b * y + this->m_tx;
+            mappedY = this->m_c * x + this->m_d * y + this->m_ty;
+        }
+
+        //X轴经变换后的旋转角度(单位:度),用于修正元件的角度
+        double rotation() const;
+
+        /*
+        *  @brief  fromPoints
+        *          根据对应点求解变换,使 (srcX[i],srcY[i]) 变换后尽量接近 (dstX[i],dstY[i])
+        *          cnt=1: 平移
+        *          cnt=2: 相似变换(两点重合或距离为0时抛出异常)
+        *          cnt>=3: 最小二乘仿射变换(所有点共线时抛出异常)
+        *  @param  srcX,srcY:变换前的点
+        *          dstX,dstY:变换后的点
+        *          cnt:点的数量,至少为1
+        *  @return 求解得到的变换
+        */
+        static AffineTransform fromPoints(const double * srcX, const double * srcY,
+                                          const double * dstX, const double * dstY,
+                                          int cnt);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        double m_a;
+        double m_b;
+        double m_c;
+        double m_d;
+        double m_tx;
+        double m_ty;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace SSDK
+
+#endif // AFFINETRANSFORM_HPP
@@ -0,0 +1,236 @@
+#include <sys/uio.h>
+#include <unistd.h>
+#include <limits.h>
+#include <errno.h>
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+
+#include "chunkedwriter.hpp"
+
+using namespace std;
+using namespace SSDK;
+
+const size_t ChunkedWriter::DEFAULT_CHUNK_SIZE;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//构造 & 析构函数
+ChunkedWriter::ChunkedWriter(int threadCount, size_t chunkSize)
+{
+    this->m_threadCount = threadCount > 0 ? threadCount : std::max(1, (int)std::thread::hardware_concurrency());
+    this->m_chunkSize = std::max<size_t>(1, chunkSize);
+}
+
+ChunkedWriter::~ChunkedWriter()
+{
+
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//成员函数
+void ChunkedWriter::write(int fd, size_t itemCount, const FormatFunction &format) const
+{
+    try
+    {
+        const size_t chunkCount = (itemCount + this->m_chunkSize - 1) / this->m_chunkSize;
+        if(0 == chunkCount)
+        {
+            return;
+        }
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //只有一个线程时在调用线程中逐块格式化并写入
+        if(1 == this->m_threadCount || 1 == chunkCount)
+        {
+            string buffer;
+            for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+            {
+                size_t begin = chunk * this->m_chunkSize;
+                buffer.clear();
+                format(begin, std::min(itemCount, begin + this->m_chunkSize), buffer);
+                writeAll(fd, &buffer, 1);
+            }
+            return;
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step2
+        //工作线程领取下一块并格式化,只领取窗口内(已写入的块之后window块以内)的块
+        const size_t window = (size_t)this->m_threadCount * 4;
+        vector<string> buffers(chunkCount);
+        vector<char> ready(chunkCount, 0);
+        size_t writtenCount = 0;            //已写入文件的块数
+        bool failed = false;
+        exception_ptr error;
+        mutex stateMutex;
+        condition_variable readyCondition;  //有块格式化完成
+        condition_variable windowCondition; //窗口向后移动
+        atomic<size_t> nextChunk(0);
+
+        auto worker = [&]()
+        {
+            string buffer;
+            for (size_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++)
+            {
+                {
+                    unique_lock<mutex> lock(stateMutex);
+                    windowCondition.wait(lock, [&]{return failed || chunk < writtenCount + window;});
+                    if(failed)
+                    {
+                        return;
+                    }
+                }
+
+                try
+                {
+                    size_t begin = chunk * this->m_chunkSize;
+                    buffer.clear();
+                    format(begin, std::min(itemCount, begin + this->m_chunkSize), buffer);
+                }
+                catch(...)
+                {
+                    lock_guard<mutex> lock(stateMutex);
+                    if(!failed)
+                    {
+                        failed = true;
+                        error = current_exception();
+                    }
+                    readyCondition.notify_all();
+                    windowCondition.notify_all();
+                    return;
+                }
+
+                lock_guard<mutex> lock(stateMutex);
+                buffers[chunk].swap(buffer);
+                ready[chunk] = 1;
+                readyCondition.notify_all();
+            }
+        };
+
+        vector<thread> threads;
+        for (int i = 0; i < this->m_threadCount; ++i)
+        {
+            threads.push_back(thread(worker));
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step3
+        //调用线程按顺序等待下一块完成,将已完成的连续若干块一次写入,写入后释放缓冲区并移动窗口
+        while(true)
+        {
+            size_t first = 0, last = 0;
+            {
+                unique_lock<mutex> lock(stateMutex);
+                readyCondition.wait(lock, [&]{return failed || writtenCount >= chunkCount || ready[writtenCount];});
+                if(failed || writtenCount >= chunkCount)
+                {
+                    break;
+                }
+
+                first = writtenCount;
+                last = first;
+                while(last < chunkCount && ready[last] && last - first < (size_t)IOV_MAX)
+                {
+                    ++last;
+                }
+            }
+
+            //已完成的块不再被工作线程访问,可以在锁外写入
+            try
+            {
+                writeAll(fd, buffers.data() + first, last - first);
+            }
+            catch(...)
+            {
+                lock_guard<mutex> lock(stateMutex);
+                failed = true;
+                error = current_exception();
+                windowCondition.notify_all();
+                break;
+            }
+
+            lock_guard<mutex> lock(stateMutex);
+            for (size_t chunk = first; chunk < last; ++chunk)
+            {
+                string().swap(buffers[chunk]);
+            }
+            writtenCount = last;
+            windowCondition.notify_all();
+        }
+
+        for (size_t i = 0; i < threads.size(); ++i)
+        {
+            threads[i].join();
+        }
+        if(error)
+        {
+            rethrow_exception(error);
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void ChunkedWriter::writeAll(int fd, const string *buffers, size_t count)
+{
+    try
+    {
+        vector<struct iovec> iov;
+        iov.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            if(!buffers[i].empty())
+            {
+                struct iovec item;
+                item.iov_base = const_cast<char *>(buffers[i].data());
+                item.iov_len = buffers[i].size();
+                iov.push_back(item);
+            }
+        }
+
+        //部分写入时跳过已写入的部分继续写
+        size_t index = 0;
+        while(index < iov.size())
+        {
+            int iovCount = (int)std::min(iov.size() - index, (size_t)IOV_MAX);
+            ssize_t written = ::writev(fd, iov.data() + index, iovCount);
+            if(written < 0)
+            {
+                if(EINTR == errno)
+                {
+                    continue;
+                }
+                THROW_EXCEPTION("写入文件失败!");
+            }
+
+            size_t remain = (size_t)written;
+            while(index < iov.size() && remain >= iov[index].iov_len)
+            {
+                remain -= iov[index].iov_len;
+                ++index;
+            }
+            if(remain > 0)
+            {
+                iov[index].iov_base = static_cast<char *>(iov[index].iov_base) + remain;
+                iov[index].iov_len -= remain;
+            }
+        }
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,95 @@
+#ifndef CHUNKEDWRITER_HPP
+#define CHUNKEDWRITER_HPP
+
+#include <string>
+#include <functional>
+#include <cstddef>
+
+#include "customexception.hpp"
+
+namespace SSDK
+{
+    /**
+     *  @brief ChunkedWriter
+     *         并行分块导出: 将itemCount条数据按chunkSize条一块划分,
+     *         多个线程各自领取下一块,将该块格式化到独立的缓冲区中,
+     *         调用线程按块的顺序将已完成的连续若干块通过一次writev写入文件
+     *         格式化与写入同时进行,同一时刻最多有window个块的缓冲区未写入,内存占用与数据量无关
+     *         格式化函数只决定每一条数据的文本,与导出格式(xml,csv,json等)无关
+     *
+     *         使用方式:
+     *             ChunkedWriter writer(0);
+     *             writer.write(fd, cnt, [&](size_t begin, size_t end, std::string & buffer)
+     *             {
+     *                 for (size_t i = begin; i < end; ++i) { buffer += ...; }
+     *             });
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class ChunkedWriter
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //类型
+        //将[begin,end)范围内的数据格式化后追加到buffer(buffer初始为空),在工作线程中调用
+        using FormatFunction = std::function<void(size_t begin, size_t end, std::string & buffer)>;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //常量
+        static const size_t DEFAULT_CHUNK_SIZE = 4096;  //每块默认的数据条数
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        /*
+        *  @brief  ChunkedWriter
+        *  @param  threadCount:格式化的线程数,小于等于0时使用CPU核数
+        *          chunkSize:每块的数据条数
+        */
+        explicit ChunkedWriter(int threadCount = 0, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+        ~ChunkedWriter();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //访存函数
+        int threadCount() const {return this->m_threadCount;}
+        size_t chunkSize() const {return this->m_chunkSize;}
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        /*
+        *  @brief  write
+        *          并行格式化itemCount条数据,按顺序写入文件的当前位置
+        *          格式化函数抛出异常或写入失败时,停止所有线程后抛出异常(文件中可能已写入部分内容)
+        *  @param  fd:已打开的文件描述符
+        *          itemCount:数据的条数
+        *          format:格式化函数,不同的块在不同的线程中同时调用
+        *  @return N/A
+        */
+        void write(int fd, size_t itemCount, const FormatFunction & format) const;
+
+        /*
+        *  @brief  writeAll
+        *          通过writev将多段缓冲区依次写入文件,处理部分写入及EINTR
+        *  @param  fd:已打开的文件描述符
+        *          buffers:缓冲区
+        *          count:缓冲区的数量
+        *  @return N/A,写入失败时抛出异常
+        */
+        static void writeAll(int fd, const std::string * buffers, size_t count);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        int m_threadCount;          //格式化的线程数
+        size_t m_chunkSize;         //每块的数据条数
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace SSDK
+
+#endif // CHUNKEDWRITER_HPP
@@ -1,7 +1,184 @@
+#include <cmath>
+#include <cfloat>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <clocale>
+#include <cctype>
+
+#include <rapidjson/internal/dtoa.h>
+#include <rapidjson/internal/itoa.h>
+
 #include "formatconvertion.hpp"
 
 using namespace SSDK;
 
+const int FormatConvertion::MAX_NUMBER_LENGTH;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//浮点数格式化的内部函数
+namespace
+{
+    /*
+    *  @brief  writeDigits
+    *          按%g的规则将十进制有效数字写入缓冲区,末尾的0已去掉
+    *  @param  negative:是否为负数
+    *          digits,length:有效数字(第一位不为0)
+    *          exponent:第一位有效数字的十进制指数(即科学计数法中的指数)
+    *          precision:指数不小于precision或小于-4时使用科学计数法
+    *          buffer:输出缓冲区
+    *  @return 写入的字符数
+    */
+    int writeDigits(bool negative, const char * digits, int length, int exponent, int precision, char * buffer)
+    {
+        char * p = buffer;
+        if(negative)
+        {
+            *p++ = '-';
+        }
+
+        if(exponent < -4 || exponent >= precision)
+        {
+            //科学计数法: d.ddde+XX,指数至少两位
+            *p++ = digits[0];
+            if(length > 1)
+            {
+                *p++ = '.';
+                memcpy(p, digits + 1, length - 1);
+                p += length - 1;
+            }
+            *p++ = 'e';
+            *p++ = exponent < 0 ? '-' : '+';
+            int absExponent = exponent < 0 ? -exponent : exponent;
+            if(absExponent >= 100)
+            {
+                *p++ = (char)('0' + absExponent / 100);
+                absExponent %= 100;
+            }
+            *p++ = (char)('0' + absExponent / 10);
+            *p++ = (char)('0' + absExponent % 10);
+        }
+        else if(exponent >= 0)
+        {
+            //整数部分为exponent+1位,不足时补0
+            int integerLength = exponent + 1;
+            if(length <= integerLength)
+            {
+                memcpy(p, digits, length);
+                p += length;
+                memset(p, '0', integerLength - length);
+                p += integerLength - length;
+            }
+            else
+            {
+                memcpy(p, digits, integerLength);
+                p += integerLength;
+                *p++ = '.';
+                memcpy(p, digits + integerLength, length - integerLength);
+                p += length - integerLength;
+            }
+        }
+        else
+        {
+            //0.000ddd
+            *p++ = '0';
+            *p++ = '.';
+            memset(p, '0', -exponent - 1);
+            p += -exponent - 1;
+            memcpy(p, digits, length);
+            p += length;
+        }
+
+        return (int)(p - buffer);
+    }
+
+    /*
+    *  @brief  grisuShortest
+    *          生成正数value的十进制有效数字(value约等于digits*10^k),并判断是否为最短表示
+    *          收窄的舍入区间上与Grisu2相同,生成的数一定在原值的舍入区间内;
+    *          再按Grisu3的方法在放宽的区间(包含整个舍入区间)上生成一次,
+    *          两次最后一位的十进制位置(k)相同时,舍入区间内没有位数更少的数,结果即为最短
+    *  @param  value:正的有限数
+    *          digits,length:输出,有效数字(可能以0结尾)
+    *          k:输出,最后一位有效数字的十进制指数
+    *  @return true:结果为最短表示; false:不能确定,需要精确查找(随机位模式约0.2%,十进制小数约1%)
+    */
+    bool grisuShortest(double value, char * digits, int & length, int & k)
+    {
+        using namespace rapidjson::internal;
+
+        const DiyFp v(value);
+        DiyFp w_m, w_p;
+        v.NormalizedBoundaries(&w_m, &w_p);
+        int cachedK = 0;
+        const DiyFp c_mk = GetCachedPower(w_p.e, &cachedK);
+        const DiyFp W = v.Normalize() * c_mk;
+        const DiyFp Wp = w_p * c_mk;
+        const DiyFp Wm = w_m * c_mk;
+
+        //收窄的区间(上下各1个单位,即Grisu2)
+        k = cachedK;
+        DigitGen(W, DiyFp(Wp.f - 1, Wp.e), Wp.f - Wm.f - 2, digits, &length, &k);
+        if(UINT64_MAX == Wp.f)
+        {
+            return false;
+        }
+
+        //放宽的区间(上下各1个单位)
+        char unsafeDigits[FormatConvertion::MAX_NUMBER_LENGTH];
+        int unsafeLength = 0, unsafeK = cachedK;
+        DigitGen(W, DiyFp(Wp.f + 1, Wp.e), Wp.f - Wm.f + 2, unsafeDigits, &unsafeLength, &unsafeK);
+
+        return unsafeK == k;
+    }
+
+    /*
+    *  @brief  exactShortest
+    *          依次取1~maxLength位有效数字(按原值精确舍入,与printf("%.*e")相同),读回后与原值相同的第一个即为最短
+    *  @param  value:正的有限数
+    *          maxLength:最多查找的位数
+    *          digits,length,k:输出,有效数字及最后一位的十进制指数(与grisuShortest相同)
+    *  @return true:已找到; false:maxLength位以内没有可以还原原值的表示,输出不变
+    */
+    bool exactShortest(double value, int maxLength, char * digits, int & length, int & k)
+    {
+        char text[64];
+        char candidate[64];
+        for (int precision = 1; precision <= maxLength; ++precision)
+        {
+            //%e的小数点随locale变化,只取出其中的数字及指数
+            snprintf(text, sizeof(text), "%.*e", precision - 1, value);
+            const char * pExponent = strchr(text, 'e');
+            int count = 0;
+            for (const char * p = text; p < pExponent; ++p)
+            {
+                if(isdigit((unsigned char)*p))
+                {
+                    candidate[count++] = *p;
+                }
+            }
+            int lastExponent = atoi(pExponent + 1) - (count - 1);
+
+            //按"<有效数字>e<指数>"读回
+            int textLength = count;
+            candidate[textLength++] = 'e';
+            textLength += FormatConvertion::intToChars(lastExponent, candidate + textLength);
+            candidate[textLength] = '\0';
+            double parsed = 0;
+            if(FormatConvertion::charsToDouble(candidate, parsed) && parsed == value)
+            {
+                memcpy(digits, candidate, count);
+                length = count;
+                k = lastExponent;
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
 FormatConvertion::FormatConvertion()
 {
 
@@ -17,15 +194,178 @@ string FormatConvertion::intToString(int value)
 {
     try
     {
-        //定义一个字符串流对象
-        stringstream string;
-        //将整形数值赋值给字符串流
-        string <<value;
-        //将转换后的字符串作为返回值
-        return string.str();
+        //直接写入栈上的缓冲区,不再构造字符串流
+        char text[MAX_NUMBER_LENGTH];
+        return std::string(text, intToChars(value, text));
     }
     catch(const exception &ex)
     {
         THROW_EXCEPTION(ex.what());
     }
 }
+
+string FormatConvertion::timeToString(time_t time)
+{
+    try
+    {
+        //localtime_r不使用静态缓冲区,可以在多个线程中调用
+        tm localTime;
+        if(nullptr == localtime_r(&time, &localTime))
+        {
+            THROW_EXCEPTION("时间转换失败!");
+        }
+
+        return intToString(localTime.tm_year + 1900) +
+               "/" + intToString(localTime.tm_mon + 1) +
+               "/" + intToString(localTime.tm_mday) +
+               " " + intToString(localTime.tm_hour) +
+               ":" + intToString(localTime.tm_min) +
+               ":" + intToString(localTime.tm_sec);
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+int FormatConvertion::intToChars(int64_t value, char *buffer)
+{
+    return (int)(rapidjson::internal::i64toa(value, buffer) - buffer);
+}
+
+int FormatConvertion::doubleToChars(double value, char *buffer)
+{
+    if(!std::isfinite(value))
+    {
+        return snprintf(buffer, MAX_NUMBER_LENGTH, "%g", value);
+    }
+    if(0 == value)
+    {
+        return writeDigits(std::signbit(value), "0", 1, 0, 17, buffer);
+    }
+
+    //Grisu2生成的有效数字在原值的舍入区间内,读回后与原值相同
+    //不能确定为最短时,逐位查找更短的表示
+    char digits[MAX_NUMBER_LENGTH];
+    int length = 0, k = 0;
+    bool isShortest = grisuShortest(std::fabs(value), digits, length, k);
+    while(length > 1 && '0' == digits[length - 1])
+    {
+        --length;
+        ++k;
+    }
+    if(!isShortest && length > 1)
+    {
+        exactShortest(std::fabs(value), length - 1, digits, length, k);
+        while(length > 1 && '0' == digits[length - 1])
+        {
+            --length;
+            ++k;
+        }
+    }
+
+    return writeDigits(value < 0, digits, length, length + k - 1, 17, buffer);
+}
+
+int FormatConvertion::doubleToChars(double value, int precision, char *buffer)
+{
+    if(precision <= 0)
+    {
+        precision = 1;
+    }
+    //精度超过15位或为非规格化数(精度不足)时,最短表示与原值的差可能影响输出,交给snprintf
+    if(precision > 15 || !std::isfinite(value) || (0 != value && std::fabs(value) < DBL_MIN))
+    {
+        return snprintf(buffer, MAX_NUMBER_LENGTH, "%.*g", precision, value);
+    }
+    if(0 == value)
+    {
+        return writeDigits(std::signbit(value), "0", 1, 0, precision, buffer);
+    }
+
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //step1
+    //生成Grisu2的有效数字(最多17位,通常为最短),原值与其相差不超过半个ulp
+    char digits[MAX_NUMBER_LENGTH];
+    int length = 0, k = 0;
+    rapidjson::internal::Grisu2(std::fabs(value), digits, &length, &k);
+    int exponent = length + k - 1;
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //step2
+    //有效数字多于precision位时舍入到precision位
+    //舍掉的部分按17位有效数字对齐后,与进位边界(5000...)的差不超过100时,
+    //原值与最短表示可能位于边界两侧,交给snprintf按原值精确舍入
+    if(length > precision)
+    {
+        uint64_t tail = 0;
+        for (int i = precision; i < length; ++i)
+        {
+            tail = tail * 10 + (uint64_t)(digits[i] - '0');
+        }
+        for (int i = length; i < 17; ++i)
+        {
+            tail *= 10;
+        }
+        uint64_t half = 5;
+        for (int i = precision + 1; i < 17; ++i)
+        {
+            half *= 10;
+        }
+
+        uint64_t distance = tail > half ? tail - half : half - tail;
+        if(distance <= 100)
+        {
+            return snprintf(buffer, MAX_NUMBER_LENGTH, "%.*g", precision, value);
+        }
+
+        length = precision;
+        if(tail > half)
+        {
+            int i = length - 1;
+            while(i >= 0 && '9' == digits[i])
+            {
+                digits[i] = '0';
+                --i;
+            }
+            if(i >= 0)
+            {
+                ++digits[i];
+            }
+            else
+            {
+                //全部进位,如999.9995 -> 1000
+                digits[0] = '1';
+                length = 1;
+                ++exponent;
+            }
+        }
+    }
+    while(length > 1 && '0' == digits[length - 1])
+    {
+        --length;
+    }
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    return writeDigits(value < 0, digits, length, exponent, precision, buffer);
+}
+
+bool FormatConvertion::charsToDouble(const char *text, double &value)
+{
+    //C locale只创建一次,所有线程共用
+    static const locale_t cLocale = newlocale(LC_NUMERIC_MASK, "C", (locale_t)0);
+
+    char * pEnd = nullptr;
+    value = strtod_l(text, &pEnd, cLocale);
+    if(pEnd == text)
+    {
+        return false;
+    }
+    while(isspace((unsigned char)*pEnd))
+    {
+        ++pEnd;
+    }
+
+    return '\0' == *pEnd;
+}
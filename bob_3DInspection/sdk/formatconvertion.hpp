@@ -4,6 +4,8 @@
 #include<iostream>
 #include<string>
 #include<sstream>
+#include<cstdint>
+#include<ctime>
 
 #include "../sdk/customexception.hpp"
 
@@ -34,6 +36,12 @@ namespace SSDK
     /**
      *  @brief  FormatConvertion
      *          将整形(int)数字转为为字符串形(string)
+     *          将整数及浮点数直接写入调用者的缓冲区(不分配内存),供导出及终端显示使用:
+     *              doubleToChars(value,buffer): 可以精确还原的十进制表示(最短表示)
+     *              doubleToChars(value,precision,buffer): 与printf的%.<precision>g输出一致
+     *              intToChars(value,buffer): 整数
+     *          将字符串转换为浮点数(不受程序locale的影响),供导入使用:
+     *              charsToDouble(text,value)
      *  @author bob
      *  @version 1.00 2017-11-26 bob
      *                note:create it
@@ -57,6 +65,55 @@ namespace SSDK
         *  @return 将整形数字转换后的字符传返回
         */
         static std::string intToString(int value);
+
+        /*
+        *  @brief  timeToString
+        *          将时间转换为本地时间的字符串,格式为 年/月/日 时:分:秒 (如2026/10/17 9:05:30),用作检测程式的最后一次编辑时间
+        *  @param  time:时间,如time(NULL)
+        *  @return 时间字符串
+        */
+        static std::string timeToString(time_t time);
+
+        /*
+        *  @brief  intToChars
+        *          将整数写入缓冲区(不以'\0'结尾)
+        *  @param  value:整数
+        *          buffer:缓冲区,至少MAX_NUMBER_LENGTH个字节
+        *  @return 写入的字符数
+        */
+        static int intToChars(int64_t value, char * buffer);
+
+        /*
+        *  @brief  doubleToChars
+        *          将浮点数写入缓冲区(不以'\0'结尾)
+        *          不指定precision时输出最短的十进制表示(如1e23输出1e+23),strtod读回后与原值完全相同:
+        *              有效数字的位数不超过printf("%.<n>g")可以还原原值的最小n(最多17位);
+        *              由Grisu2生成并按Grisu3的方法验证,不能确定为最短时(随机位模式约0.2%,十进制小数约1%)用snprintf及strtod逐位查找
+        *              小数点位置的规则与%g相同(指数小于-4或不小于17时使用科学计数法,如1e-05,1.5e+17)
+        *          指定precision时输出与printf("%.<precision>g")完全相同,
+        *              如precision为6时与QString::number(value)及std::cout的默认格式相同
+        *              precision大于15,数值为nan/inf或非规格化数,或舍入位恰好落在进位边界附近时使用snprintf
+        *  @param  value:浮点数
+        *          precision:有效数字的位数(1~17)
+        *          buffer:缓冲区,至少MAX_NUMBER_LENGTH个字节
+        *  @return 写入的字符数
+        */
+        static int doubleToChars(double value, char * buffer);
+        static int doubleToChars(double value, int precision, char * buffer);
+
+        /*
+        *  @brief  charsToDouble
+        *          将字符串转换为浮点数,小数点固定为'.'(QCoreApplication会按系统设置locale,strtod的小数点随之变化)
+        *  @param  text:以'\0'结尾的字符串,前后可以有空白
+        *          value:转换的结果
+        *  @return 整个字符串是否为合法的数值
+        */
+        static bool charsToDouble(const char * text, double & value);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //常量
+        static const int MAX_NUMBER_LENGTH = 32;    //intToChars及doubleToChars需要的缓冲区大小
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     };
 }   //End of namespace SSDK
@@ -0,0 +1,65 @@
+#include <fstream>
+#include <vector>
+
+#include "hash.hpp"
+
+using namespace std;
+using namespace SSDK;
+
+const uint64_t Hash::FNV_OFFSET_BASIS;
+const uint64_t Hash::FNV_PRIME;
+
+uint64_t Hash::fnv1a(const void *pData, size_t size, uint64_t seed)
+{
+    const unsigned char * pByte = static_cast<const unsigned char *>(pData);
+    uint64_t hash = seed;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= pByte[i];
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+uint64_t Hash::fileHash(const string &path)
+{
+    try
+    {
+        ifstream file(path.c_str(), ios::in | ios::binary);
+        if(!file.is_open())
+        {
+            THROW_EXCEPTION("打开文件失败!!");
+        }
+
+        //每次读取64K,避免大文件一次性读入内存
+        vector<char> buffer(64 * 1024);
+        uint64_t hash = FNV_OFFSET_BASIS;
+        while (file)
+        {
+            file.read(buffer.data(), buffer.size());
+            hash = fnv1a(buffer.data(), (size_t)file.gcount(), hash);
+        }
+
+        return hash;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+string Hash::toHexString(uint64_t hash)
+{
+    static const char digits[] = "0123456789abcdef";
+
+    string str(16, '0');
+    for (int i = 15; i >= 0; --i)
+    {
+        str[i] = digits[hash & 0xF];
+        hash >>= 4;
+    }
+
+    return str;
+}
@@ -0,0 +1,60 @@
+#ifndef HASH_HPP
+#define HASH_HPP
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+#include "customexception.hpp"
+
+namespace SSDK
+{
+    /**
+     *  @brief Hash
+     *         计算内存数据及文件内容的64位哈希值(FNV-1a)
+     *         用于判断检测程式文件的内容是否发生变化,不用于加密
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class Hash
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //常量
+        static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;    //FNV-1a的初始值
+        static const uint64_t FNV_PRIME = 1099511628211ULL;                  //FNV-1a的乘数
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        /*
+        *  @brief  fnv1a
+        *          计算一段内存的哈希值,可以通过seed将多段数据串联计算
+        *  @param  pData:数据的首地址
+        *          size:数据的字节数
+        *          seed:初始值,默认为FNV_OFFSET_BASIS,串联时传入上一段的结果
+        *  @return 64位哈希值
+        */
+        static uint64_t fnv1a(const void * pData, size_t size, uint64_t seed = FNV_OFFSET_BASIS);
+
+        /*
+        *  @brief  fileHash
+        *          分块读取文件,计算整个文件内容的哈希值
+        *  @param  path:文件的路径
+        *  @return 64位哈希值,文件无法打开时抛出异常
+        */
+        static uint64_t fileHash(const std::string & path);
+
+        /*
+        *  @brief  toHexString
+        *          将哈希值转换为16位十六进制字符串(如文件名中使用)
+        *  @param  hash:哈希值
+        *  @return 十六进制字符串
+        */
+        static std::string toHexString(uint64_t hash);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace SSDK
+
+#endif // HASH_HPP
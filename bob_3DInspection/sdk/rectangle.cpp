@@ -9,6 +9,7 @@ Rectangle::Rectangle()
     this->m_yPos = 0;
     this->m_width = 0;
     this->m_height = 0;
+    this->m_angle = 0;
 }
 
 Rectangle::Rectangle(double xPos,
@@ -45,24 +45,24 @@ namespace SSDK
         //访存函数,给类的成员变量赋值
         //给成员变量X赋值,获取元件的X轴坐标
         void setX(double x){ this->m_xPos = x;}
-        double xPos(){ return this->m_xPos;}
+        double xPos() const { return this->m_xPos;}
 
         //给成员变量Y赋值,获取元件的Y轴坐标
         void setY(double y){ this->m_yPos = y;}
-        double yPos(){ return this->m_yPos;}
+        double yPos() const { return this->m_yPos;}
 
         //给成员变量width赋值,获取元件的宽度
         void setWidth(double width){this->m_width = width;}
-        double width(){ return this->m_width;}
+        double width() const { return this->m_width;}
 
         //给成员变量height赋值,获取元件的高度
         void setHeight(double height){this->m_height = height;}
-        double height(){ return this->m_height;}
+        double height() const { return this->m_height;}
 
         //2017.12.02 bob
         //给成员变量angle赋值,获取元件的角度
         void setAngle(double angle){this->m_angle = angle;}
-        double angle(){ return this->m_angle;}
+        double angle() const { return this->m_angle;}
         //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     private:
         //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,245 @@
+#include "rectanglekernelimpl.hpp"
+
+using namespace std;
+using namespace SSDK;
+using namespace SSDK::RectangleKernelImpl;
+
+namespace
+{
+    //unionBounds分块计算外接矩形时每块的矩形数量
+    const int BLOCK_SIZE = 64;
+
+    //检测CPU支持的最高指令集(只检测一次)
+    RectangleKernel::Isa detectIsa()
+    {
+#if defined(SSDK_HAVE_AVX2)
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2"))
+        {
+            return RectangleKernel::AVX2;
+        }
+#endif
+#if defined(__SSE2__)
+        return RectangleKernel::SSE2;
+#else
+        return RectangleKernel::SCALAR;
+#endif
+    }
+
+    //根据指令集选择实现,超过supportedIsa()的指令集降为supportedIsa()
+    template<class Kernel>
+    void dispatch(const Kernel & kernel, RectangleKernel::Isa isa)
+    {
+        isa = std::min(isa, RectangleKernel::supportedIsa());
+        switch (isa)
+        {
+#if defined(SSDK_HAVE_AVX2)
+        case RectangleKernel::AVX2:
+            runAvx2(kernel);
+            break;
+#endif
+#if defined(__SSE2__)
+        case RectangleKernel::SSE2:
+            runKernel<Sse2Ops>(kernel);
+            break;
+#endif
+        default:
+            runKernel<ScalarOps>(kernel);
+            break;
+        }
+    }
+}
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//单个矩形的运算
+void RectangleKernel::sinCos(double angle, double &cosValue, double &sinValue)
+{
+    //与批量运算使用同一算法,保证单个矩形与批量运算的结果一致
+    sinCosDeg<ScalarOps>(angle, cosValue, sinValue);
+}
+
+void RectangleKernel::bounds(const Rectangle &rectangle,
+                             double &minX, double &minY, double &maxX, double &maxY)
+{
+    double c = 0, s = 0;
+    sinCos(rectangle.angle(), c, s);
+
+    double halfX = 0.5 * (std::fabs(rectangle.width() * c) + std::fabs(rectangle.height() * s));
+    double halfY = 0.5 * (std::fabs(rectangle.width() * s) + std::fabs(rectangle.height() * c));
+
+    minX = rectangle.xPos() - halfX;
+    maxX = rectangle.xPos() + halfX;
+    minY = rectangle.yPos() - halfY;
+    maxY = rectangle.yPos() + halfY;
+}
+
+bool RectangleKernel::contains(const Rectangle &rectangle, double x, double y)
+{
+    double c = 0, s = 0;
+    sinCos(rectangle.angle(), c, s);
+
+    double dx = x - rectangle.xPos();
+    double dy = y - rectangle.yPos();
+
+    return std::fabs(dx * c + dy * s) <= 0.5 * rectangle.width() &&
+           std::fabs(dy * c - dx * s) <= 0.5 * rectangle.height();
+}
+
+bool RectangleKernel::overlaps(const Rectangle &a, const Rectangle &b)
+{
+    double ac = 0, as = 0, bc = 0, bs = 0;
+    sinCos(a.angle(), ac, as);
+    sinCos(b.angle(), bc, bs);
+
+    return satOverlap<ScalarOps>(a.xPos(), a.yPos(), 0.5 * a.width(), 0.5 * a.height(), ac, as,
+                                 b.xPos(), b.yPos(), 0.5 * b.width(), 0.5 * b.height(), bc, bs);
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//批量运算
+RectangleKernel::Isa RectangleKernel::compiledIsa()
+{
+#if defined(SSDK_HAVE_AVX2)
+    return AVX2;
+#elif defined(__SSE2__)
+    return SSE2;
+#else
+    return SCALAR;
+#endif
+}
+
+RectangleKernel::Isa RectangleKernel::supportedIsa()
+{
+    static const Isa isa = detectIsa();
+    return isa;
+}
+
+void RectangleKernel::corners(const RectangleArray &rects,
+                              double *cornerX, double *cornerY,
+                              Isa isa)
+{
+    CornersKernel kernel;
+    kernel.rects = rects;
+    kernel.cornerX = cornerX;
+    kernel.cornerY = cornerY;
+    dispatch(kernel, isa);
+}
+
+void RectangleKernel::bounds(const RectangleArray &rects,
+                             double *minX, double *minY, double *maxX, double *maxY,
+                             Isa isa)
+{
+    BoundsKernel kernel;
+    kernel.rects = rects;
+    kernel.minX = minX;
+    kernel.minY = minY;
+    kernel.maxX = maxX;
+    kernel.maxY = maxY;
+    dispatch(kernel, isa);
+}
+
+bool RectangleKernel::unionBounds(const RectangleArray &rects,
+                                  double &minX, double &minY, double &maxX, double &maxY,
+                                  Isa isa)
+{
+    if(rects.size <= 0)
+    {
+        return false;
+    }
+
+    //按块计算外接矩形,再合并
+    double blockMinX[BLOCK_SIZE], blockMinY[BLOCK_SIZE];
+    double blockMaxX[BLOCK_SIZE], blockMaxY[BLOCK_SIZE];
+
+    minX = minY = HUGE_VAL;
+    maxX = maxY = -HUGE_VAL;
+    for (int base = 0; base < rects.size; base += BLOCK_SIZE)
+    {
+        RectangleArray block;
+        block.xPos = rects.xPos + base;
+        block.yPos = rects.yPos + base;
+        block.width = rects.width + base;
+        block.height = rects.height + base;
+        block.angle = rects.angle + base;
+        block.size = std::min(BLOCK_SIZE, rects.size - base);
+
+        bounds(block, blockMinX, blockMinY, blockMaxX, blockMaxY, isa);
+        for (int i = 0; i < block.size; ++i)
+        {
+            minX = std::min(minX, blockMinX[i]);
+            minY = std::min(minY, blockMinY[i]);
+            maxX = std::max(maxX, blockMaxX[i]);
+            maxY = std::max(maxY, blockMaxY[i]);
+        }
+    }
+
+    return true;
+}
+
+void RectangleKernel::contains(const RectangleArray &rects,
+                               double x, double y,
+                               unsigned char *inside,
+                               Isa isa)
+{
+    ContainsKernel kernel;
+    kernel.rects = rects;
+    kernel.x = x;
+    kernel.y = y;
+    kernel.inside = inside;
+    dispatch(kernel, isa);
+}
+
+void RectangleKernel::overlaps(const RectangleArray &a,
+                               const RectangleArray &b,
+                               unsigned char *overlap,
+                               Isa isa)
+{
+    if(a.size != b.size)
+    {
+        THROW_EXCEPTION("矩形数组的数量不一致!");
+    }
+
+    PairOverlapKernel kernel;
+    kernel.rects = a;
+    kernel.others = b;
+    kernel.overlap = overlap;
+    dispatch(kernel, isa);
+}
+
+void RectangleKernel::overlaps(const Rectangle &rectangle,
+                               const RectangleArray &rects,
+                               unsigned char *overlap,
+                               Isa isa)
+{
+    OneOverlapKernel kernel;
+    kernel.rects = rects;
+    kernel.x = rectangle.xPos();
+    kernel.y = rectangle.yPos();
+    kernel.halfWidth = 0.5 * rectangle.width();
+    kernel.halfHeight = 0.5 * rectangle.height();
+    sinCos(rectangle.angle(), kernel.c, kernel.s);
+    kernel.overlap = overlap;
+    dispatch(kernel, isa);
+}
+
+void RectangleKernel::transform(const RectangleArray &rects,
+                                const AffineTransform &transform,
+                                double *xPos, double *yPos, double *angle,
+                                Isa isa)
+{
+    TransformKernel kernel;
+    kernel.rects = rects;
+    kernel.a = transform.a();
+    kernel.b = transform.b();
+    kernel.c = transform.c();
+    kernel.d = transform.d();
+    kernel.tx = transform.tx();
+    kernel.ty = transform.ty();
+    kernel.rotation = transform.rotation();
+    kernel.xPos = xPos;
+    kernel.yPos = yPos;
+    kernel.angle = angle;
+    dispatch(kernel, isa);
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,177 @@
+#ifndef RECTANGLEKERNEL_HPP
+#define RECTANGLEKERNEL_HPP
+
+#include "customexception.hpp"
+#include "rectangle.hpp"
+#include "affinetransform.hpp"
+
+namespace SSDK
+{
+    /**
+     *  @brief RectangleArray
+     *         以列式(每个属性一段连续数组)描述的一组旋转矩形,只引用外部内存,不持有数据
+     *         坐标约定与Rectangle相同: (xPos,yPos)为矩形中心,angle单位为度
+     */
+    struct RectangleArray
+    {
+        const double * xPos{nullptr};       //中心X坐标
+        const double * yPos{nullptr};       //中心Y坐标
+        const double * width{nullptr};      //宽
+        const double * height{nullptr};     //高
+        const double * angle{nullptr};      //角度
+        int size{0};                        //矩形的数量
+    };
+
+    /**
+     *  @brief RectangleKernel
+     *         旋转矩形的批量几何运算: 角点,外接矩形,点包含及两两重叠判断
+     *         对整段数组运算,使用AVX2(每次4个)或SSE2(每次2个)指令,尾部及其它平台使用标量代码
+     *         AVX2实现单独以-mavx2编译(rectanglekernel_avx2.cpp,见sdk/simd.pri),运行时CPU支持AVX2时才使用
+     *         每个函数都可以通过isa参数指定指令集(高于supportedIsa()时自动降级),便于与标量结果对比
+     *         各指令集的运算顺序相同且不使用FMA,因此SIMD与标量的结果逐位一致
+     *         正余弦也在向量寄存器中计算(按象限归约+多项式,误差约1ulp),不调用std::sin/std::cos
+     *         角度为90度的整数倍时结果为精确值,避免cos(90°)不为0造成的误差
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class RectangleKernel
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //枚举
+        //指令集
+        enum Isa
+        {
+            SCALAR = 0,
+            SSE2,
+            AVX2
+        };
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //单个矩形的运算
+        //计算角度(度)的正余弦,与批量运算的结果一致
+        static void sinCos(double angle, double & cosValue, double & sinValue);
+
+        /*
+        *  @brief  bounds
+        *          计算一个旋转矩形的外接矩形
+        *  @param  rectangle:旋转矩形
+        *          minX,minY,maxX,maxY:输出,外接矩形的边界
+        *  @return N/A
+        */
+        static void bounds(const Rectangle & rectangle,
+                           double & minX, double & minY, double & maxX, double & maxY);
+
+        //判断点(x,y)是否在旋转矩形内(包括边界)
+        static bool contains(const Rectangle & rectangle, double x, double y);
+
+        //判断两个旋转矩形是否重叠(分离轴定理,边界接触也算重叠)
+        static bool overlaps(const Rectangle & a, const Rectangle & b);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //批量运算
+        //程序中编译了实现的最高指令集(x86下编译了rectanglekernel_avx2.cpp时为AVX2)
+        static Isa compiledIsa();
+
+        //当前CPU上可以使用的最高指令集(不超过compiledIsa()),批量运算默认使用该指令集
+        static Isa supportedIsa();
+
+        /*
+        *  @brief  corners
+        *          计算每个矩形的4个角点
+        *          角点按平面方式存放: 第k个角点(k=0~3)的坐标为 cornerX[k*size+i], cornerY[k*size+i]
+        *          角点顺序为矩形局部坐标系下的(-w/2,-h/2),(w/2,-h/2),(w/2,h/2),(-w/2,h/2)
+        *  @param  rects:矩形数组
+        *          cornerX,cornerY:输出,各4*size个
+        *          isa:使用的指令集
+        *  @return N/A
+        */
+        static void corners(const RectangleArray & rects,
+                            double * cornerX, double * cornerY,
+                            Isa isa = supportedIsa());
+
+        /*
+        *  @brief  bounds
+        *          计算每个矩形的外接矩形
+        *  @param  rects:矩形数组
+        *          minX,minY,maxX,maxY:输出,各size个
+        *          isa:使用的指令集
+        *  @return N/A
+        */
+        static void bounds(const RectangleArray & rects,
+                           double * minX, double * minY, double * maxX, double * maxY,
+                           Isa isa = supportedIsa());
+
+        /*
+        *  @brief  unionBounds
+        *          计算所有矩形外接矩形的并集
+        *  @param  rects:矩形数组
+        *          minX,minY,maxX,maxY:输出,并集的边界
+        *  @return false:数组为空
+        */
+        static bool unionBounds(const RectangleArray & rects,
+                                double & minX, double & minY, double & maxX, double & maxY,
+                                Isa isa = supportedIsa());
+
+        /*
+        *  @brief  contains
+        *          判断点(x,y)是否在每个矩形内(包括边界)
+        *  @param  rects:矩形数组
+        *          x,y:点的坐标
+        *          inside:输出,size个,1为在矩形内,0为不在
+        *          isa:使用的指令集
+        *  @return N/A
+        */
+        static void contains(const RectangleArray & rects,
+                             double x, double y,
+                             unsigned char * inside,
+                             Isa isa = supportedIsa());
+
+        /*
+        *  @brief  overlaps
+        *          逐对判断a[i]与b[i]是否重叠,a和b的数量必须相同
+        *  @param  a,b:矩形数组
+        *          overlap:输出,size个,1为重叠,0为不重叠
+        *          isa:使用的指令集
+        *  @return N/A
+        */
+        static void overlaps(const RectangleArray & a,
+                             const RectangleArray & b,
+                             unsigned char * overlap,
+                             Isa isa = supportedIsa());
+
+        /*
+        *  @brief  overlaps
+        *          判断矩形rectangle与数组中每个矩形是否重叠
+        *  @param  rectangle:单个矩形
+        *          rects:矩形数组
+        *          overlap:输出,size个,1为重叠,0为不重叠
+        *          isa:使用的指令集
+        *  @return N/A
+        */
+        static void overlaps(const Rectangle & rectangle,
+                             const RectangleArray & rects,
+                             unsigned char * overlap,
+                             Isa isa = supportedIsa());
+
+        /*
+        *  @brief  transform
+        *          对每个矩形的中心做仿射变换,角度加上变换的旋转角度,宽和高不变
+        *  @param  rects:矩形数组
+        *          transform:仿射变换
+        *          xPos,yPos,angle:输出,变换后的中心坐标及角度,各size个
+        *          isa:使用的指令集
+        *  @return N/A
+        */
+        static void transform(const RectangleArray & rects,
+                              const AffineTransform & transform,
+                              double * xPos, double * yPos, double * angle,
+                              Isa isa = supportedIsa());
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace SSDK
+
+#endif // RECTANGLEKERNEL_HPP
@@ -0,0 +1,42 @@
+//RectangleKernel的AVX2实现
+//本文件单独以-mavx2编译(见sdk/simd.pri),只有RectangleKernel::supportedIsa()为AVX2时才会被调用
+#include "rectanglekernelimpl.hpp"
+
+#if !defined(__AVX2__)
+#error "rectanglekernel_avx2.cpp必须以-mavx2编译"
+#endif
+
+using namespace SSDK::RectangleKernelImpl;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//AVX2实现
+void SSDK::RectangleKernelImpl::runAvx2(const CornersKernel &kernel)
+{
+    runKernel<Avx2Ops>(kernel);
+}
+
+void SSDK::RectangleKernelImpl::runAvx2(const BoundsKernel &kernel)
+{
+    runKernel<Avx2Ops>(kernel);
+}
+
+void SSDK::RectangleKernelImpl::runAvx2(const ContainsKernel &kernel)
+{
+    runKernel<Avx2Ops>(kernel);
+}
+
+void SSDK::RectangleKernelImpl::runAvx2(const PairOverlapKernel &kernel)
+{
+    runKernel<Avx2Ops>(kernel);
+}
+
+void SSDK::RectangleKernelImpl::runAvx2(const OneOverlapKernel &kernel)
+{
+    runKernel<Avx2Ops>(kernel);
+}
+
+void SSDK::RectangleKernelImpl::runAvx2(const TransformKernel &kernel)
+{
+    runKernel<Avx2Ops>(kernel);
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
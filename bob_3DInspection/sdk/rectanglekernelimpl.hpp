@@ -0,0 +1,473 @@
+#ifndef RECTANGLEKERNELIMPL_HPP
+#define RECTANGLEKERNELIMPL_HPP
+
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "rectanglekernel.hpp"
+
+//RectangleKernel的内部实现,只由rectanglekernel.cpp及rectanglekernel_avx2.cpp包含
+//rectanglekernel_avx2.cpp单独以-mavx2编译,其它源文件只使用基础指令集(x86_64为SSE2),运行时根据CPU选择
+//各指令集的运算及算法都在匿名命名空间中,每个源文件各自实例化一份,
+//避免链接时将-mavx2编译出的标量代码用于不支持AVX2的CPU
+//两个源文件之间只通过下面的参数结构及runAvx2函数交互
+namespace SSDK
+{
+    namespace RectangleKernelImpl
+    {
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //各运算的参数
+        //角点
+        struct CornersKernel
+        {
+            RectangleArray rects;
+            double * cornerX;
+            double * cornerY;
+        };
+
+        //外接矩形
+        struct BoundsKernel
+        {
+            RectangleArray rects;
+            double * minX;
+            double * minY;
+            double * maxX;
+            double * maxY;
+        };
+
+        //点包含
+        struct ContainsKernel
+        {
+            RectangleArray rects;
+            double x;
+            double y;
+            unsigned char * inside;
+        };
+
+        //逐对重叠, rects为a
+        struct PairOverlapKernel
+        {
+            RectangleArray rects;
+            RectangleArray others;
+            unsigned char * overlap;
+        };
+
+        //一个矩形与数组中每个矩形的重叠
+        struct OneOverlapKernel
+        {
+            RectangleArray rects;
+            double x, y, halfWidth, halfHeight, c, s;
+            unsigned char * overlap;
+        };
+
+        //仿射变换
+        struct TransformKernel
+        {
+            RectangleArray rects;
+            double a, b, c, d, tx, ty, rotation;
+            double * xPos;
+            double * yPos;
+            double * angle;
+        };
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //AVX2实现,定义在rectanglekernel_avx2.cpp中,只有RectangleKernel::supportedIsa()为AVX2时才能调用
+        void runAvx2(const CornersKernel & kernel);
+        void runAvx2(const BoundsKernel & kernel);
+        void runAvx2(const ContainsKernel & kernel);
+        void runAvx2(const PairOverlapKernel & kernel);
+        void runAvx2(const OneOverlapKernel & kernel);
+        void runAvx2(const TransformKernel & kernel);
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        namespace
+        {
+            //角度转弧度的系数
+            const double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+
+            //1.5*2^52,double加上该数后,尾数的低位即为四舍五入后的整数(补码)
+            const double ROUND_MAGIC = 6755399441055744.0;
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //各指令集的基本运算,几何算法只依赖这些运算,因此同一份算法代码可以用于所有指令集
+            //Vec:一组double, Mask:一组比较结果, WIDTH:每组的数量
+            struct ScalarOps
+            {
+                typedef double Vec;
+                typedef bool Mask;
+                enum {WIDTH = 1};
+
+                static Vec load(const double * p){return *p;}
+                static void store(double * p, Vec v){*p = v;}
+                static Vec set1(double v){return v;}
+                static Vec add(Vec a, Vec b){return a + b;}
+                static Vec sub(Vec a, Vec b){return a - b;}
+                static Vec mul(Vec a, Vec b){return a * b;}
+                static Vec abs(Vec a){return std::fabs(a);}
+                static Mask le(Vec a, Vec b){return a <= b;}
+                static Mask andMask(Mask a, Mask b){return a && b;}
+                static void storeMask(unsigned char * p, Mask m){*p = m ? 1 : 0;}
+
+                //bits为x+ROUND_MAGIC,其低位为整数q
+                //q为奇数时取ifOdd,否则取ifEven
+                static Vec oddSelect(Vec bits, Vec ifOdd, Vec ifEven)
+                {
+                    return (toInt(bits) & 1) ? ifOdd : ifEven;
+                }
+                //(q+offset)的第1位为1时取反v的符号
+                static Vec flipSign(Vec v, Vec bits, int offset)
+                {
+                    return ((toInt(bits) + offset) & 2) ? -v : v;
+                }
+                static int64_t toInt(Vec bits)
+                {
+                    int64_t i = 0;
+                    std::memcpy(&i, &bits, sizeof(i));
+                    return i;
+                }
+            };
+
+#if defined(__SSE2__)
+            struct Sse2Ops
+            {
+                typedef __m128d Vec;
+                typedef __m128d Mask;
+                enum {WIDTH = 2};
+
+                static Vec load(const double * p){return _mm_loadu_pd(p);}
+                static void store(double * p, Vec v){_mm_storeu_pd(p, v);}
+                static Vec set1(double v){return _mm_set1_pd(v);}
+                static Vec add(Vec a, Vec b){return _mm_add_pd(a, b);}
+                static Vec sub(Vec a, Vec b){return _mm_sub_pd(a, b);}
+                static Vec mul(Vec a, Vec b){return _mm_mul_pd(a, b);}
+                static Vec abs(Vec a){return _mm_andnot_pd(_mm_set1_pd(-0.0), a);}
+                static Mask le(Vec a, Vec b){return _mm_cmple_pd(a, b);}
+                static Mask andMask(Mask a, Mask b){return _mm_and_pd(a, b);}
+                static void storeMask(unsigned char * p, Mask m)
+                {
+                    int bits = _mm_movemask_pd(m);
+                    p[0] = bits & 1;
+                    p[1] = (bits >> 1) & 1;
+                }
+                static Vec oddSelect(Vec bits, Vec ifOdd, Vec ifEven)
+                {
+                    __m128i one = _mm_set1_epi64x(1);
+                    __m128i mask = _mm_sub_epi64(_mm_setzero_si128(), _mm_and_si128(_mm_castpd_si128(bits), one));
+                    __m128d m = _mm_castsi128_pd(mask);
+                    return _mm_or_pd(_mm_and_pd(m, ifOdd), _mm_andnot_pd(m, ifEven));
+                }
+                static Vec flipSign(Vec v, Vec bits, int offset)
+                {
+                    __m128i q = _mm_add_epi64(_mm_castpd_si128(bits), _mm_set1_epi64x(offset));
+                    __m128i sign = _mm_and_si128(_mm_slli_epi64(q, 62), _mm_set1_epi64x(INT64_MIN));
+                    return _mm_xor_pd(v, _mm_castsi128_pd(sign));
+                }
+            };
+#endif
+
+#if defined(__AVX2__)
+            struct Avx2Ops
+            {
+                typedef __m256d Vec;
+                typedef __m256d Mask;
+                enum {WIDTH = 4};
+
+                static Vec load(const double * p){return _mm256_loadu_pd(p);}
+                static void store(double * p, Vec v){_mm256_storeu_pd(p, v);}
+                static Vec set1(double v){return _mm256_set1_pd(v);}
+                static Vec add(Vec a, Vec b){return _mm256_add_pd(a, b);}
+                static Vec sub(Vec a, Vec b){return _mm256_sub_pd(a, b);}
+                static Vec mul(Vec a, Vec b){return _mm256_mul_pd(a, b);}
+                static Vec abs(Vec a){return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a);}
+                static Mask le(Vec a, Vec b){return _mm256_cmp_pd(a, b, _CMP_LE_OQ);}
+                static Mask andMask(Mask a, Mask b){return _mm256_and_pd(a, b);}
+                static void storeMask(unsigned char * p, Mask m)
+                {
+                    int bits = _mm256_movemask_pd(m);
+                    p[0] = bits & 1;
+                    p[1] = (bits >> 1) & 1;
+                    p[2] = (bits >> 2) & 1;
+                    p[3] = (bits >> 3) & 1;
+                }
+                static Vec oddSelect(Vec bits, Vec ifOdd, Vec ifEven)
+                {
+                    //blendv只看符号位,将q的第0位移到符号位
+                    __m256d m = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(bits), 63));
+                    return _mm256_blendv_pd(ifEven, ifOdd, m);
+                }
+                static Vec flipSign(Vec v, Vec bits, int offset)
+                {
+                    __m256i q = _mm256_add_epi64(_mm256_castpd_si256(bits), _mm256_set1_epi64x(offset));
+                    __m256i sign = _mm256_and_si256(_mm256_slli_epi64(q, 62), _mm256_set1_epi64x(INT64_MIN));
+                    return _mm256_xor_pd(v, _mm256_castsi256_pd(sign));
+                }
+            };
+#endif
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //几何算法(与指令集无关)
+            //分离轴定理: 两个矩形在4条边的法线方向上的投影都重叠时,两矩形重叠
+            //hw,hh为半宽半高, c,s为角度的正余弦
+            template<class Ops>
+            typename Ops::Mask satOverlap(typename Ops::Vec ax, typename Ops::Vec ay,
+                                          typename Ops::Vec ahw, typename Ops::Vec ahh,
+                                          typename Ops::Vec ac, typename Ops::Vec as,
+                                          typename Ops::Vec bx, typename Ops::Vec by,
+                                          typename Ops::Vec bhw, typename Ops::Vec bhh,
+                                          typename Ops::Vec bc, typename Ops::Vec bs)
+            {
+                typedef typename Ops::Vec Vec;
+
+                Vec dx = Ops::sub(bx, ax);
+                Vec dy = Ops::sub(by, ay);
+                //两矩形夹角的正余弦
+                Vec cosAB = Ops::abs(Ops::add(Ops::mul(ac, bc), Ops::mul(as, bs)));
+                Vec sinAB = Ops::abs(Ops::sub(Ops::mul(as, bc), Ops::mul(ac, bs)));
+
+                //a的两条轴
+                Vec distA1 = Ops::abs(Ops::add(Ops::mul(dx, ac), Ops::mul(dy, as)));
+                Vec radA1 = Ops::add(ahw, Ops::add(Ops::mul(bhw, cosAB), Ops::mul(bhh, sinAB)));
+                Vec distA2 = Ops::abs(Ops::sub(Ops::mul(dy, ac), Ops::mul(dx, as)));
+                Vec radA2 = Ops::add(ahh, Ops::add(Ops::mul(bhw, sinAB), Ops::mul(bhh, cosAB)));
+
+                //b的两条轴
+                Vec distB1 = Ops::abs(Ops::add(Ops::mul(dx, bc), Ops::mul(dy, bs)));
+                Vec radB1 = Ops::add(bhw, Ops::add(Ops::mul(ahw, cosAB), Ops::mul(ahh, sinAB)));
+                Vec distB2 = Ops::abs(Ops::sub(Ops::mul(dy, bc), Ops::mul(dx, bs)));
+                Vec radB2 = Ops::add(bhh, Ops::add(Ops::mul(ahw, sinAB), Ops::mul(ahh, cosAB)));
+
+                return Ops::andMask(Ops::andMask(Ops::le(distA1, radA1), Ops::le(distA2, radA2)),
+                                    Ops::andMask(Ops::le(distB1, radB1), Ops::le(distB2, radB2)));
+            }
+
+            //计算角度(度)的正余弦
+            //先按90度取整得到象限q及余量r(|r|<=45度),再用多项式计算r的正余弦(Cephes的系数,误差约1ulp)
+            //最后根据象限交换正余弦并调整符号; 角度为90度的整数倍时r=0,结果是精确值
+            template<class Ops>
+            void sinCosDeg(typename Ops::Vec angle, typename Ops::Vec & c, typename Ops::Vec & s)
+            {
+                typedef typename Ops::Vec Vec;
+
+                const Vec magic = Ops::set1(ROUND_MAGIC);
+                Vec bits = Ops::add(Ops::mul(angle, Ops::set1(1.0 / 90.0)), magic);
+                Vec q = Ops::sub(bits, magic);
+                Vec r = Ops::mul(Ops::sub(angle, Ops::mul(q, Ops::set1(90.0))), Ops::set1(DEG_TO_RAD));
+                Vec z = Ops::mul(r, r);
+
+                Vec ps = Ops::set1(1.58962301576546568060E-10);
+                ps = Ops::add(Ops::mul(ps, z), Ops::set1(-2.50507477628578072866E-8));
+                ps = Ops::add(Ops::mul(ps, z), Ops::set1(2.75573136213857245213E-6));
+                ps = Ops::add(Ops::mul(ps, z), Ops::set1(-1.98412698295895385996E-4));
+                ps = Ops::add(Ops::mul(ps, z), Ops::set1(8.33333333332211858878E-3));
+                ps = Ops::add(Ops::mul(ps, z), Ops::set1(-1.66666666666666307295E-1));
+                Vec sinR = Ops::add(r, Ops::mul(Ops::mul(r, z), ps));
+
+                Vec pc = Ops::set1(-1.13585365213876817300E-11);
+                pc = Ops::add(Ops::mul(pc, z), Ops::set1(2.08757008419747316778E-9));
+                pc = Ops::add(Ops::mul(pc, z), Ops::set1(-2.75573141792967388112E-7));
+                pc = Ops::add(Ops::mul(pc, z), Ops::set1(2.48015872888517045348E-5));
+                pc = Ops::add(Ops::mul(pc, z), Ops::set1(-1.38888888888730564116E-3));
+                pc = Ops::add(Ops::mul(pc, z), Ops::set1(4.16666666666665929218E-2));
+                Vec cosR = Ops::add(Ops::sub(Ops::set1(1.0), Ops::mul(Ops::set1(0.5), z)),
+                                    Ops::mul(Ops::mul(z, z), pc));
+
+                //q=0:(cos r, sin r)  q=1:(-sin r, cos r)  q=2:(-cos r, -sin r)  q=3:(sin r, -cos r)
+                s = Ops::flipSign(Ops::oddSelect(bits, cosR, sinR), bits, 0);
+                c = Ops::flipSign(Ops::oddSelect(bits, sinR, cosR), bits, 1);
+            }
+
+            //角点
+            template<class Ops>
+            void run(const CornersKernel & kernel, int from, int to)
+            {
+                typedef typename Ops::Vec Vec;
+                const Vec half = Ops::set1(0.5);
+                const int n = kernel.rects.size;
+
+                for (int k = from; k < to; k += Ops::WIDTH)
+                {
+                    Vec x = Ops::load(kernel.rects.xPos + k);
+                    Vec y = Ops::load(kernel.rects.yPos + k);
+                    Vec hw = Ops::mul(half, Ops::load(kernel.rects.width + k));
+                    Vec hh = Ops::mul(half, Ops::load(kernel.rects.height + k));
+                    Vec vc, vs;
+                    sinCosDeg<Ops>(Ops::load(kernel.rects.angle + k), vc, vs);
+
+                    Vec a = Ops::mul(hw, vc);
+                    Vec b = Ops::mul(hh, vs);
+                    Vec d = Ops::mul(hw, vs);
+                    Vec e = Ops::mul(hh, vc);
+
+                    Ops::store(kernel.cornerX + k, Ops::add(Ops::sub(x, a), b));
+                    Ops::store(kernel.cornerY + k, Ops::sub(Ops::sub(y, d), e));
+                    Ops::store(kernel.cornerX + n + k, Ops::add(Ops::add(x, a), b));
+                    Ops::store(kernel.cornerY + n + k, Ops::sub(Ops::add(y, d), e));
+                    Ops::store(kernel.cornerX + 2 * n + k, Ops::sub(Ops::add(x, a), b));
+                    Ops::store(kernel.cornerY + 2 * n + k, Ops::add(Ops::add(y, d), e));
+                    Ops::store(kernel.cornerX + 3 * n + k, Ops::sub(Ops::sub(x, a), b));
+                    Ops::store(kernel.cornerY + 3 * n + k, Ops::add(Ops::sub(y, d), e));
+                }
+            }
+
+            //外接矩形
+            template<class Ops>
+            void run(const BoundsKernel & kernel, int from, int to)
+            {
+                typedef typename Ops::Vec Vec;
+                const Vec half = Ops::set1(0.5);
+
+                for (int k = from; k < to; k += Ops::WIDTH)
+                {
+                    Vec x = Ops::load(kernel.rects.xPos + k);
+                    Vec y = Ops::load(kernel.rects.yPos + k);
+                    Vec hw = Ops::mul(half, Ops::load(kernel.rects.width + k));
+                    Vec hh = Ops::mul(half, Ops::load(kernel.rects.height + k));
+                    Vec vc, vs;
+                    sinCosDeg<Ops>(Ops::load(kernel.rects.angle + k), vc, vs);
+                    vc = Ops::abs(vc);
+                    vs = Ops::abs(vs);
+
+                    //外接矩形半宽 = |hw*cos|+|hh*sin|, 半高 = |hw*sin|+|hh*cos|
+                    Vec halfX = Ops::add(Ops::mul(hw, vc), Ops::mul(hh, vs));
+                    Vec halfY = Ops::add(Ops::mul(hw, vs), Ops::mul(hh, vc));
+
+                    Ops::store(kernel.minX + k, Ops::sub(x, halfX));
+                    Ops::store(kernel.maxX + k, Ops::add(x, halfX));
+                    Ops::store(kernel.minY + k, Ops::sub(y, halfY));
+                    Ops::store(kernel.maxY + k, Ops::add(y, halfY));
+                }
+            }
+
+            //点包含
+            template<class Ops>
+            void run(const ContainsKernel & kernel, int from, int to)
+            {
+                typedef typename Ops::Vec Vec;
+                const Vec half = Ops::set1(0.5);
+                const Vec px = Ops::set1(kernel.x);
+                const Vec py = Ops::set1(kernel.y);
+
+                for (int k = from; k < to; k += Ops::WIDTH)
+                {
+                    Vec dx = Ops::sub(px, Ops::load(kernel.rects.xPos + k));
+                    Vec dy = Ops::sub(py, Ops::load(kernel.rects.yPos + k));
+                    Vec hw = Ops::mul(half, Ops::load(kernel.rects.width + k));
+                    Vec hh = Ops::mul(half, Ops::load(kernel.rects.height + k));
+                    Vec vc, vs;
+                    sinCosDeg<Ops>(Ops::load(kernel.rects.angle + k), vc, vs);
+
+                    //将点转换到矩形的局部坐标系
+                    Vec localX = Ops::abs(Ops::add(Ops::mul(dx, vc), Ops::mul(dy, vs)));
+                    Vec localY = Ops::abs(Ops::sub(Ops::mul(dy, vc), Ops::mul(dx, vs)));
+
+                    Ops::storeMask(kernel.inside + k,
+                                   Ops::andMask(Ops::le(localX, hw), Ops::le(localY, hh)));
+                }
+            }
+
+            //逐对重叠, rects为a
+            template<class Ops>
+            void run(const PairOverlapKernel & kernel, int from, int to)
+            {
+                typedef typename Ops::Vec Vec;
+                const Vec half = Ops::set1(0.5);
+
+                for (int k = from; k < to; k += Ops::WIDTH)
+                {
+                    Vec ac, as, bc, bs;
+                    sinCosDeg<Ops>(Ops::load(kernel.rects.angle + k), ac, as);
+                    sinCosDeg<Ops>(Ops::load(kernel.others.angle + k), bc, bs);
+
+                    typename Ops::Mask m = satOverlap<Ops>(Ops::load(kernel.rects.xPos + k),
+                                                           Ops::load(kernel.rects.yPos + k),
+                                                           Ops::mul(half, Ops::load(kernel.rects.width + k)),
+                                                           Ops::mul(half, Ops::load(kernel.rects.height + k)),
+                                                           ac,
+                                                           as,
+                                                           Ops::load(kernel.others.xPos + k),
+                                                           Ops::load(kernel.others.yPos + k),
+                                                           Ops::mul(half, Ops::load(kernel.others.width + k)),
+                                                           Ops::mul(half, Ops::load(kernel.others.height + k)),
+                                                           bc,
+                                                           bs);
+                    Ops::storeMask(kernel.overlap + k, m);
+                }
+            }
+
+            //一个矩形与数组中每个矩形的重叠
+            template<class Ops>
+            void run(const OneOverlapKernel & kernel, int from, int to)
+            {
+                typedef typename Ops::Vec Vec;
+                const Vec half = Ops::set1(0.5);
+                const Vec ax = Ops::set1(kernel.x);
+                const Vec ay = Ops::set1(kernel.y);
+                const Vec ahw = Ops::set1(kernel.halfWidth);
+                const Vec ahh = Ops::set1(kernel.halfHeight);
+                const Vec ac = Ops::set1(kernel.c);
+                const Vec as = Ops::set1(kernel.s);
+
+                for (int k = from; k < to; k += Ops::WIDTH)
+                {
+                    Vec bc, bs;
+                    sinCosDeg<Ops>(Ops::load(kernel.rects.angle + k), bc, bs);
+
+                    typename Ops::Mask m = satOverlap<Ops>(ax, ay, ahw, ahh, ac, as,
+                                                           Ops::load(kernel.rects.xPos + k),
+                                                           Ops::load(kernel.rects.yPos + k),
+                                                           Ops::mul(half, Ops::load(kernel.rects.width + k)),
+                                                           Ops::mul(half, Ops::load(kernel.rects.height + k)),
+                                                           bc,
+                                                           bs);
+                    Ops::storeMask(kernel.overlap + k, m);
+                }
+            }
+
+            //仿射变换
+            template<class Ops>
+            void run(const TransformKernel & kernel, int from, int to)
+            {
+                typedef typename Ops::Vec Vec;
+                const Vec va = Ops::set1(kernel.a);
+                const Vec vb = Ops::set1(kernel.b);
+                const Vec vc = Ops::set1(kernel.c);
+                const Vec vd = Ops::set1(kernel.d);
+                const Vec vtx = Ops::set1(kernel.tx);
+                const Vec vty = Ops::set1(kernel.ty);
+                const Vec vrot = Ops::set1(kernel.rotation);
+
+                for (int k = from; k < to; k += Ops::WIDTH)
+                {
+                    Vec x = Ops::load(kernel.rects.xPos + k);
+                    Vec y = Ops::load(kernel.rects.yPos + k);
+
+                    Ops::store(kernel.xPos + k, Ops::add(Ops::add(Ops::mul(va, x), Ops::mul(vb, y)), vtx));
+                    Ops::store(kernel.yPos + k, Ops::add(Ops::add(Ops::mul(vc, x), Ops::mul(vd, y)), vty));
+                    Ops::store(kernel.angle + k, Ops::add(Ops::load(kernel.rects.angle + k), vrot));
+                }
+            }
+
+            //整组部分用Ops处理,剩余不足一组的部分用标量处理
+            template<class Ops, class Kernel>
+            void runKernel(const Kernel & kernel)
+            {
+                int full = kernel.rects.size - kernel.rects.size % Ops::WIDTH;
+                run<Ops>(kernel, 0, full);
+                run<ScalarOps>(kernel, full, kernel.rects.size);
+            }
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        }
+    }   //End of namespace RectangleKernelImpl
+}   //End of namespace SSDK
+
+#endif // RECTANGLEKERNELIMPL_HPP
@@ -0,0 +1,19 @@
+#需要特定指令集的源文件
+#这些文件单独加指令集的编译选项,其余文件仍只使用基础指令集(x86_64为SSE2),运行时根据CPU选择实现
+#只在x86/x86_64的gcc/clang下编译,并定义SSDK_HAVE_AVX2
+AVX2_SOURCES += \
+    $$PWD/rectanglekernel_avx2.cpp
+
+unix {
+    contains(QT_ARCH, x86_64)|contains(QT_ARCH, i386) {
+        DEFINES += SSDK_HAVE_AVX2
+
+        avx2.name = avx2
+        avx2.input = AVX2_SOURCES
+        avx2.dependency_type = TYPE_C
+        avx2.variable_out = OBJECTS
+        avx2.output = ${QMAKE_VAR_OBJECTS_DIR}${QMAKE_FILE_IN_BASE}$${first(QMAKE_EXT_OBJ)}
+        avx2.commands = $${QMAKE_CXX} -c $(CXXFLAGS) -mavx2 $(INCPATH) ${QMAKE_FILE_IN} -o ${QMAKE_FILE_OUT}
+        QMAKE_EXTRA_COMPILERS += avx2
+    }
+}
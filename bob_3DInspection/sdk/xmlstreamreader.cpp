@@ -0,0 +1,562 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+#include "xmlstreamreader.hpp"
+
+using namespace std;
+using namespace SSDK;
+
+const size_t XmlStreamReader::BUFFER_SIZE;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//内部函数
+namespace
+{
+    inline bool isSpace(char c)
+    {
+        return ' ' == c || '\t' == c || '\n' == c || '\r' == c;
+    }
+
+    //将unicode码点按utf-8编码追加到value
+    void appendUtf8(unsigned long code, string & value)
+    {
+        if(code < 0x80)
+        {
+            value += (char)code;
+        }
+        else if(code < 0x800)
+        {
+            value += (char)(0xC0 | (code >> 6));
+            value += (char)(0x80 | (code & 0x3F));
+        }
+        else if(code < 0x10000)
+        {
+            value += (char)(0xE0 | (code >> 12));
+            value += (char)(0x80 | ((code >> 6) & 0x3F));
+            value += (char)(0x80 | (code & 0x3F));
+        }
+        else
+        {
+            value += (char)(0xF0 | (code >> 18));
+            value += (char)(0x80 | ((code >> 12) & 0x3F));
+            value += (char)(0x80 | ((code >> 6) & 0x3F));
+            value += (char)(0x80 | (code & 0x3F));
+        }
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//构造 & 析构函数
+XmlStreamReader::XmlStreamReader()
+    : m_fd(-1),
+      m_pos(0),
+      m_end(0),
+      m_eof(false),
+      m_lineNumber(1),
+      m_tokenType(NO_TOKEN),
+      m_depth(0),
+      m_pendingEnd(false),
+      m_attributeCount(0)
+{
+
+}
+
+XmlStreamReader::~XmlStreamReader()
+{
+    this->close();
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//访存函数
+const string *XmlStreamReader::attribute(const string &name) const
+{
+    for (int i = 0; i < this->m_attributeCount; ++i)
+    {
+        if(this->m_attributes[i].first == name)
+        {
+            return &this->m_attributes[i].second;
+        }
+    }
+
+    return nullptr;
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//成员函数
+void XmlStreamReader::open(const string &path)
+{
+    try
+    {
+        this->close();
+
+        this->m_fd = ::open(path.c_str(), O_RDONLY);
+        if(this->m_fd < 0)
+        {
+            THROW_EXCEPTION("打开文件失败:" + path);
+        }
+
+        this->m_buffer.resize(BUFFER_SIZE);
+        this->m_pos = 0;
+        this->m_end = 0;
+        this->m_eof = false;
+        this->m_lineNumber = 1;
+        this->m_tokenType = NO_TOKEN;
+        this->m_name.clear();
+        this->m_depth = 0;
+        this->m_pendingEnd = false;
+        this->m_elements.clear();
+        this->m_attributeCount = 0;
+
+        //跳过utf-8的BOM
+        if(this->ensure(3) && 0 == memcmp(this->m_buffer.data(), "\xEF\xBB\xBF", 3))
+        {
+            this->m_pos = 3;
+        }
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void XmlStreamReader::close()
+{
+    if(this->m_fd >= 0)
+    {
+        ::close(this->m_fd);
+        this->m_fd = -1;
+    }
+}
+
+XmlStreamReader::TOKEN_TYPE XmlStreamReader::readNext()
+{
+    try
+    {
+        if(!this->isOpened())
+        {
+            THROW_EXCEPTION("xml文件尚未打开!");
+        }
+        if(END_DOCUMENT == this->m_tokenType)
+        {
+            return END_DOCUMENT;
+        }
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //step1
+        //空元素在开始之后立即结束
+        if(this->m_pendingEnd)
+        {
+            this->m_pendingEnd = false;
+            this->m_depth = (int)this->m_elements.size();
+            this->m_elements.pop_back();
+            this->m_attributeCount = 0;
+            this->m_tokenType = END_ELEMENT;
+            return END_ELEMENT;
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        while(true)
+        {
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //step2
+            //跳过元素之间的文本,直到下一个'<'
+            while(true)
+            {
+                const char * pBegin = this->m_buffer.data() + this->m_pos;
+                const char * pLt = static_cast<const char *>(memchr(pBegin, '<', this->m_end - this->m_pos));
+                if(nullptr != pLt)
+                {
+                    this->consume(pLt - pBegin);
+                    break;
+                }
+                this->consume(this->m_end - this->m_pos);
+                if(!this->fill())
+                {
+                    if(!this->m_elements.empty())
+                    {
+                        this->throwError("文件不完整,元素" + this->m_elements.back() + "没有结束");
+                    }
+                    this->m_tokenType = END_DOCUMENT;
+                    return END_DOCUMENT;
+                }
+            }
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+            //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+            //step3
+            //按'<'之后的内容区分标签的类型
+            this->ensure(9);
+            const char * p = this->m_buffer.data() + this->m_pos;
+            const size_t available = this->m_end - this->m_pos;
+            auto startsWith = [&](const char * prefix)
+            {
+                size_t length = strlen(prefix);
+                return available >= length && 0 == memcmp(p, prefix, length);
+            };
+
+            if(startsWith("<?"))
+            {
+                this->consume(this->find("?>", 2) + 2);
+            }
+            else if(startsWith("<!--"))
+            {
+                this->consume(this->find("-->", 4) + 3);
+            }
+            else if(startsWith("<![CDATA["))
+            {
+                this->consume(this->find("]]>", 9) + 3);
+            }
+            else if(startsWith("<!"))
+            {
+                //DOCTYPE: 跳过内部子集[...]后的'>'
+                size_t bracket = this->find("[", 2);
+                size_t tagEnd = this->find(">", 2);
+                if(bracket < tagEnd)
+                {
+                    tagEnd = this->find(">", this->find("]", bracket));
+                }
+                this->consume(tagEnd + 1);
+            }
+            else if(startsWith("</"))
+            {
+                size_t tagEnd = this->find(">", 2);
+                const char * pBegin = this->m_buffer.data() + this->m_pos + 2;
+                const char * pEnd = this->m_buffer.data() + this->m_pos + tagEnd;
+                while(pEnd > pBegin && isSpace(pEnd[-1]))
+                {
+                    --pEnd;
+                }
+                this->m_name.assign(pBegin, pEnd);
+                if(this->m_elements.empty() || this->m_elements.back() != this->m_name)
+                {
+                    this->throwError("结束标签" + this->m_name + "与开始标签不匹配");
+                }
+                this->consume(tagEnd + 1);
+
+                this->m_depth = (int)this->m_elements.size();
+                this->m_elements.pop_back();
+                this->m_attributeCount = 0;
+                this->m_tokenType = END_ELEMENT;
+                return END_ELEMENT;
+            }
+            else
+            {
+                size_t tagEnd = this->findTagEnd();
+                const char * pBegin = this->m_buffer.data() + this->m_pos + 1;
+                const char * pEnd = this->m_buffer.data() + this->m_pos + tagEnd;
+                if(pEnd > pBegin && '/' == pEnd[-1])
+                {
+                    this->m_pendingEnd = true;
+                    --pEnd;
+                }
+                this->parseStartTag(pBegin, pEnd);
+                this->consume(tagEnd + 1);
+
+                this->m_elements.push_back(this->m_name);
+                this->m_depth = (int)this->m_elements.size();
+                this->m_tokenType = START_ELEMENT;
+                return START_ELEMENT;
+            }
+            //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        }
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void XmlStreamReader::skipCurrentElement()
+{
+    try
+    {
+        if(START_ELEMENT != this->m_tokenType)
+        {
+            return;
+        }
+
+        const int depth = this->m_depth;
+        while(!(END_ELEMENT == this->readNext() && this->m_depth == depth))
+        {
+            if(END_DOCUMENT == this->m_tokenType)
+            {
+                return;
+            }
+        }
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+bool XmlStreamReader::fill()
+{
+    if(this->m_eof)
+    {
+        return false;
+    }
+
+    //未处理的数据移到开头,仍然满时扩大缓冲区(单个标签超过缓冲区)
+    if(this->m_pos > 0)
+    {
+        memmove(this->m_buffer.data(), this->m_buffer.data() + this->m_pos, this->m_end - this->m_pos);
+        this->m_end -= this->m_pos;
+        this->m_pos = 0;
+    }
+    if(this->m_end == this->m_buffer.size())
+    {
+        this->m_buffer.resize(this->m_buffer.size() * 2);
+    }
+
+    while(true)
+    {
+        ssize_t readCnt = ::read(this->m_fd, this->m_buffer.data() + this->m_end, this->m_buffer.size() - this->m_end);
+        if(readCnt < 0)
+        {
+            if(EINTR == errno)
+            {
+                continue;
+            }
+            THROW_EXCEPTION("读取xml文件失败!");
+        }
+        if(0 == readCnt)
+        {
+            this->m_eof = true;
+            return false;
+        }
+        this->m_end += (size_t)readCnt;
+        return true;
+    }
+}
+
+bool XmlStreamReader::ensure(size_t count)
+{
+    while(this->m_end - this->m_pos < count)
+    {
+        if(!this->fill())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t XmlStreamReader::find(const char *pattern, size_t offset)
+{
+    const size_t length = strlen(pattern);
+    while(true)
+    {
+        const char * pBegin = this->m_buffer.data() + this->m_pos;
+        const size_t available = this->m_end - this->m_pos;
+        if(available >= offset + length)
+        {
+            const char * pFound = std::search(pBegin + offset, pBegin + available, pattern, pattern + length);
+            if(pFound != pBegin + available)
+            {
+                return pFound - pBegin;
+            }
+            //下次从可能跨越两次读取的位置开始查找
+            offset = available - length + 1;
+        }
+        if(!this->fill())
+        {
+            this->throwError(string("文件不完整,缺少") + pattern);
+        }
+    }
+}
+
+size_t XmlStreamReader::findTagEnd()
+{
+    size_t offset = 1;
+    char quote = 0;
+    while(true)
+    {
+        const char * pBegin = this->m_buffer.data() + this->m_pos;
+        const size_t available = this->m_end - this->m_pos;
+        for (; offset < available; ++offset)
+        {
+            const char c = pBegin[offset];
+            if(0 != quote)
+            {
+                if(c == quote)
+                {
+                    quote = 0;
+                }
+            }
+            else if('"' == c || '\'' == c)
+            {
+                quote = c;
+            }
+            else if('>' == c)
+            {
+                return offset;
+            }
+        }
+        if(!this->fill())
+        {
+            this->throwError("文件不完整,标签没有结束");
+        }
+    }
+}
+
+void XmlStreamReader::consume(size_t count)
+{
+    const char * pBegin = this->m_buffer.data() + this->m_pos;
+    this->m_lineNumber += (int)std::count(pBegin, pBegin + count, '\n');
+    this->m_pos += count;
+}
+
+void XmlStreamReader::parseStartTag(const char *begin, const char *end)
+{
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //step1
+    //元素名称到第一个空白为止
+    const char * p = begin;
+    while(p < end && !isSpace(*p))
+    {
+        ++p;
+    }
+    if(p == begin)
+    {
+        this->throwError("元素名称为空");
+    }
+    this->m_name.assign(begin, p);
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //step2
+    //依次读取 name="value" 形式的属性,属性的字符串重复使用
+    this->m_attributeCount = 0;
+    while(true)
+    {
+        while(p < end && isSpace(*p))
+        {
+            ++p;
+        }
+        if(p >= end)
+        {
+            break;
+        }
+
+        const char * pNameBegin = p;
+        while(p < end && '=' != *p && !isSpace(*p))
+        {
+            ++p;
+        }
+        const char * pNameEnd = p;
+        while(p < end && isSpace(*p))
+        {
+            ++p;
+        }
+        if(p >= end || '=' != *p)
+        {
+            this->throwError("元素" + this->m_name + "的属性格式错误");
+        }
+        ++p;
+        while(p < end && isSpace(*p))
+        {
+            ++p;
+        }
+        if(p >= end || ('"' != *p && '\'' != *p))
+        {
+            this->throwError("元素" + this->m_name + "的属性值没有引号");
+        }
+        const char quote = *p++;
+        const char * pValueBegin = p;
+        while(p < end && quote != *p)
+        {
+            ++p;
+        }
+        if(p >= end)
+        {
+            this->throwError("元素" + this->m_name + "的属性值没有结束");
+        }
+
+        if(this->m_attributeCount == (int)this->m_attributes.size())
+        {
+            this->m_attributes.resize(this->m_attributes.size() + 1);
+        }
+        pair<string, string> & attribute = this->m_attributes[this->m_attributeCount++];
+        attribute.first.assign(pNameBegin, pNameEnd);
+        this->decodeValue(pValueBegin, p, attribute.second);
+        ++p;
+    }
+    //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+}
+
+void XmlStreamReader::decodeValue(const char *begin, const char *end, string &value)
+{
+    value.clear();
+    const char * p = begin;
+    while(p < end)
+    {
+        const char * pAmp = static_cast<const char *>(memchr(p, '&', end - p));
+        if(nullptr == pAmp)
+        {
+            value.append(p, end);
+            break;
+        }
+        value.append(p, pAmp);
+
+        const char * pSemicolon = static_cast<const char *>(memchr(pAmp, ';', end - pAmp));
+        if(nullptr == pSemicolon)
+        {
+            this->throwError("属性值中的实体没有结束");
+        }
+
+        const string entity(pAmp + 1, pSemicolon);
+        if("lt" == entity)
+        {
+            value += '<';
+        }
+        else if("gt" == entity)
+        {
+            value += '>';
+        }
+        else if("amp" == entity)
+        {
+            value += '&';
+        }
+        else if("quot" == entity)
+        {
+            value += '"';
+        }
+        else if("apos" == entity)
+        {
+            value += '\'';
+        }
+        else if(entity.size() > 1 && '#' == entity[0])
+        {
+            const bool hex = ('x' == entity[1] || 'X' == entity[1]);
+            const char * pDigits = entity.c_str() + (hex ? 2 : 1);
+            char * pDigitsEnd = nullptr;
+            unsigned long code = strtoul(pDigits, &pDigitsEnd, hex ? 16 : 10);
+            if(pDigitsEnd == pDigits || '\0' != *pDigitsEnd || code > 0x10FFFF)
+            {
+                this->throwError("无效的字符引用&" + entity + ";");
+            }
+            appendUtf8(code, value);
+        }
+        else
+        {
+            this->throwError("未知的实体&" + entity + ";");
+        }
+        p = pSemicolon + 1;
+    }
+}
+
+void XmlStreamReader::throwError(const string &detail) const
+{
+    THROW_EXCEPTION("xml格式错误(第" + to_string(this->m_lineNumber) + "行):" + detail);
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,160 @@
+#ifndef XMLSTREAMREADER_HPP
+#define XMLSTREAMREADER_HPP
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+#include "customexception.hpp"
+
+namespace SSDK
+{
+    /**
+     *  @brief XmlStreamReader
+     *         流式(拉取式)读取xml文件,每次readNext返回下一个元素的开始或结束,不在内存中建立文档树
+     *         文件分块读入固定大小的缓冲区(单个标签超过缓冲区时才扩大),内存占用与文件大小无关
+     *         支持XmlStreamWriter及QDom输出的xml:
+     *             1.元素及属性(单引号或双引号),<name/>形式的空元素同样返回开始及结束
+     *             2.属性值中的预定义实体(&lt; &gt; &amp; &quot; &apos;)及字符引用(&#10; &#xa;)
+     *             3.跳过xml声明,处理指令,注释,DOCTYPE,CDATA及元素之间的文本
+     *         格式错误(标签不匹配,文件不完整等)时抛出异常,异常信息中包含行号
+     *
+     *         使用方式:
+     *             XmlStreamReader reader;
+     *             reader.open("test.xml");
+     *             while(XmlStreamReader::END_DOCUMENT != reader.readNext())
+     *             {
+     *                 if(XmlStreamReader::START_ELEMENT == reader.tokenType()) {reader.name(); reader.attribute("X");}
+     *             }
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class XmlStreamReader
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //类型 & 常量
+        enum TOKEN_TYPE
+        {
+            NO_TOKEN = 0,       //尚未读取
+            START_ELEMENT,      //元素开始,name()及属性有效
+            END_ELEMENT,        //元素结束,name()有效
+            END_DOCUMENT        //文件结束
+        };
+
+        static const size_t BUFFER_SIZE = 256 * 1024;   //缓冲区的初始大小(字节)
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        XmlStreamReader();
+
+        ~XmlStreamReader();
+
+        XmlStreamReader(const XmlStreamReader &) = delete;
+        XmlStreamReader & operator=(const XmlStreamReader &) = delete;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //访存函数
+        //当前的记号
+        TOKEN_TYPE tokenType() const {return this->m_tokenType;}
+
+        //当前元素的名称
+        const std::string & name() const {return this->m_name;}
+
+        //当前元素的层级(根元素为1),END_ELEMENT时为该元素的层级
+        int depth() const {return this->m_depth;}
+
+        //当前读取位置的行号(从1开始)
+        int lineNumber() const {return this->m_lineNumber;}
+
+        //当前元素(START_ELEMENT)的属性
+        int attributeCount() const {return this->m_attributeCount;}
+        const std::string & attributeName(int index) const {return this->m_attributes[index].first;}
+        const std::string & attributeValue(int index) const {return this->m_attributes[index].second;}
+
+        //名称为name的属性值(已解码),不存在时返回nullptr
+        const std::string * attribute(const std::string & name) const;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        /*
+        *  @brief  open
+        *          打开xml文件
+        *  @param  path:文件的路径
+        *  @return N/A,打开失败时抛出异常
+        */
+        void open(const std::string & path);
+
+        //关闭文件
+        void close();
+
+        //是否已打开
+        bool isOpened() const {return this->m_fd >= 0;}
+
+        /*
+        *  @brief  readNext
+        *          读取下一个元素的开始或结束
+        *  @param  N/A
+        *  @return 记号的类型,文件结束后一直返回END_DOCUMENT
+        */
+        TOKEN_TYPE readNext();
+
+        //跳过当前元素(START_ELEMENT)的所有子元素,读取到该元素的结束
+        void skipCurrentElement();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //读入更多数据(未处理的数据移到缓冲区开头,缓冲区已满时扩大),文件结束时返回false
+        bool fill();
+
+        //确保从当前位置起至少有count个字节,文件结束时返回false
+        bool ensure(size_t count);
+
+        //从当前位置的offset处查找pattern,返回相对当前位置的偏移,文件结束仍未找到时抛出异常
+        size_t find(const char * pattern, size_t offset);
+
+        //查找标签的结束'>'(忽略引号中的'>'),返回相对当前位置的偏移
+        size_t findTagEnd();
+
+        //跳过count个字节并统计其中的换行
+        void consume(size_t count);
+
+        //解析[begin,end)中的开始标签(不含'<'及'>')
+        void parseStartTag(const char * begin, const char * end);
+
+        //将属性值解码后写入value
+        void decodeValue(const char * begin, const char * end, std::string & value);
+
+        //抛出带行号的异常
+        void throwError(const std::string & detail) const;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        int m_fd;                               //文件描述符,未打开时为-1
+        std::vector<char> m_buffer;             //读取缓冲区
+        size_t m_pos;                           //当前位置
+        size_t m_end;                           //缓冲区中有效数据的结尾
+        bool m_eof;                             //文件已读完
+        int m_lineNumber;                       //当前行号
+
+        TOKEN_TYPE m_tokenType;                 //当前记号
+        std::string m_name;                     //当前元素的名称
+        int m_depth;                            //当前元素的层级
+        bool m_pendingEnd;                      //空元素(<name/>)在下一次readNext时返回结束
+        std::vector<std::string> m_elements;    //未结束的元素名称(栈)
+
+        std::vector<std::pair<std::string, std::string>> m_attributes;  //属性(重复使用,避免每个元素重新分配)
+        int m_attributeCount;                   //当前元素的属性数量
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace SSDK
+
+#endif // XMLSTREAMREADER_HPP
@@ -0,0 +1,328 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "xmlstreamwriter.hpp"
+#include "formatconvertion.hpp"
+
+using namespace std;
+using namespace SSDK;
+
+const size_t XmlStreamWriter::BUFFER_SIZE;
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//构造 & 析构函数
+XmlStreamWriter::XmlStreamWriter(int indent)
+    : m_fd(-1),
+      m_indent(indent),
+      m_baseDepth(0),
+      m_startTagOpen(false)
+{
+
+}
+
+XmlStreamWriter::~XmlStreamWriter()
+{
+    try
+    {
+        this->close();
+    }
+    catch(...)
+    {
+        //析构函数中不抛出异常
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//成员函数
+void XmlStreamWriter::open(const string &path)
+{
+    try
+    {
+        if(this->isOpened())
+        {
+            this->close();
+        }
+
+        this->m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(this->m_fd < 0)
+        {
+            THROW_EXCEPTION("打开文件失败:" + path);
+        }
+
+        this->m_buffer.clear();
+        this->m_buffer.reserve(BUFFER_SIZE + 4096);
+        this->m_elements.clear();
+        this->m_startTagOpen = false;
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void XmlStreamWriter::close()
+{
+    if(!this->isOpened())
+    {
+        return;
+    }
+
+    try
+    {
+        while(!this->m_elements.empty())
+        {
+            this->writeEndElement();
+        }
+        this->flush();
+    }
+    catch(const exception &ex)
+    {
+        ::close(this->m_fd);
+        this->m_fd = -1;
+        THROW_EXCEPTION(ex.what());
+    }
+
+    ::close(this->m_fd);
+    this->m_fd = -1;
+}
+
+void XmlStreamWriter::writeStartElement(const string &name)
+{
+    //父元素的开始标签在写入第一个子元素时结束
+    if(!this->m_elements.empty())
+    {
+        this->closeStartTag();
+    }
+
+    this->writeIndent(this->m_baseDepth + this->m_elements.size());
+    this->m_buffer += '<';
+    this->m_buffer += name;
+
+    this->m_elements.push_back(name);
+    this->m_startTagOpen = true;
+}
+
+void XmlStreamWriter::writeEndElement()
+{
+    try
+    {
+        if(this->m_elements.empty())
+        {
+            THROW_EXCEPTION("没有未结束的xml元素!");
+        }
+
+        if(this->m_startTagOpen)
+        {
+            //没有子元素
+            this->m_buffer += "/>";
+            this->m_startTagOpen = false;
+        }
+        else
+        {
+            this->writeIndent(this->m_baseDepth + this->m_elements.size() - 1);
+            this->m_buffer += "</";
+            this->m_buffer += this->m_elements.back();
+            this->m_buffer += '>';
+        }
+        if(this->m_indent >= 0)
+        {
+            this->m_buffer += '\n';
+        }
+
+        this->m_elements.pop_back();
+        this->flushIfFull();
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void XmlStreamWriter::writeAttribute(const string &name, const string &value)
+{
+    try
+    {
+        if(!this->m_startTagOpen)
+        {
+            THROW_EXCEPTION("xml属性必须在元素开始之后,子元素之前写入!");
+        }
+
+        this->m_buffer += ' ';
+        this->m_buffer += name;
+        this->m_buffer += "=\"";
+        this->appendEscaped(value);
+        this->m_buffer += '"';
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void XmlStreamWriter::writeAttribute(const string &name, double value, int precision)
+{
+    try
+    {
+        if(!this->m_startTagOpen)
+        {
+            THROW_EXCEPTION("xml属性必须在元素开始之后,子元素之前写入!");
+        }
+
+        char text[FormatConvertion::MAX_NUMBER_LENGTH];
+        int length = FormatConvertion::doubleToChars(value, precision, text);
+
+        this->m_buffer += ' ';
+        this->m_buffer += name;
+        this->m_buffer += "=\"";
+        this->m_buffer.append(text, length);
+        this->m_buffer += '"';
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void XmlStreamWriter::writeChunked(const ChunkedWriter &chunkedWriter,
+                                   size_t count,
+                                   const function<void (XmlStreamWriter &, size_t)> &writeItem)
+{
+    try
+    {
+        if(this->m_elements.empty())
+        {
+            THROW_EXCEPTION("分块写入的xml元素必须位于某个元素之下!");
+        }
+        if(0 == count)
+        {
+            return;
+        }
+
+        //结束父元素的开始标签,并将之前的内容写入文件,之后由chunkedWriter直接写入文件
+        this->closeStartTag();
+        this->flush();
+
+        const int indent = this->m_indent;
+        const size_t depth = this->m_baseDepth + this->m_elements.size();
+        chunkedWriter.write(this->m_fd, count, [&](size_t begin, size_t end, string & buffer)
+        {
+            //片段写入器直接在块的缓冲区中写入
+            XmlStreamWriter fragment(indent);
+            fragment.m_baseDepth = depth;
+            fragment.m_buffer.swap(buffer);
+            for (size_t i = begin; i < end; ++i)
+            {
+                writeItem(fragment, i);
+            }
+            if(!fragment.m_elements.empty())
+            {
+                THROW_EXCEPTION("分块写入的xml元素没有结束!");
+            }
+            fragment.m_buffer.swap(buffer);
+        });
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void XmlStreamWriter::flush()
+{
+    try
+    {
+        if(!this->isOpened())
+        {
+            THROW_EXCEPTION("xml文件尚未打开!");
+        }
+
+        const char * pData = this->m_buffer.data();
+        size_t remain = this->m_buffer.size();
+        while(remain > 0)
+        {
+            ssize_t written = ::write(this->m_fd, pData, remain);
+            if(written < 0)
+            {
+                if(EINTR == errno)
+                {
+                    continue;
+                }
+                THROW_EXCEPTION("写入xml文件失败!");
+            }
+            pData += written;
+            remain -= (size_t)written;
+        }
+        this->m_buffer.clear();
+    }
+    catch(const exception &ex)
+    {
+        THROW_EXCEPTION(ex.what());
+    }
+}
+
+void XmlStreamWriter::closeStartTag()
+{
+    if(this->m_startTagOpen)
+    {
+        this->m_buffer += '>';
+        if(this->m_indent >= 0)
+        {
+            this->m_buffer += '\n';
+        }
+        this->m_startTagOpen = false;
+    }
+}
+
+void XmlStreamWriter::writeIndent(size_t depth)
+{
+    if(this->m_indent > 0)
+    {
+        this->m_buffer.append(depth * (size_t)this->m_indent, ' ');
+    }
+}
+
+void XmlStreamWriter::appendEscaped(const string &value)
+{
+    for (size_t i = 0; i < value.size(); ++i)
+    {
+        const char c = value[i];
+        switch (c)
+        {
+        case '<':
+            this->m_buffer += "&lt;";
+            break;
+        case '"':
+            this->m_buffer += "&quot;";
+            break;
+        case '&':
+            this->m_buffer += "&amp;";
+            break;
+        case '>':
+            //与QDom一致,只转义"]]>"中的'>'
+            if(i >= 2 && ']' == value[i - 1] && ']' == value[i - 2])
+            {
+                this->m_buffer += "&gt;";
+            }
+            else
+            {
+                this->m_buffer += c;
+            }
+            break;
+        case '\n':
+            this->m_buffer += "&#xa;";
+            break;
+        case '\r':
+            this->m_buffer += "&#xd;";
+            break;
+        case '\t':
+            this->m_buffer += "&#x9;";
+            break;
+        default:
+            this->m_buffer += c;
+            break;
+        }
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
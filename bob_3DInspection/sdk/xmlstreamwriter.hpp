@@ -0,0 +1,148 @@
+#ifndef XMLSTREAMWRITER_HPP
+#define XMLSTREAMWRITER_HPP
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+#include "customexception.hpp"
+#include "chunkedwriter.hpp"
+
+namespace SSDK
+{
+    /**
+     *  @brief XmlStreamWriter
+     *         流式写入xml文件,元素及属性边生成边写入文件,不在内存中建立文档树
+     *         输出格式与QDomDocument::save(out,indent)一致:
+     *             1.没有xml声明,每个元素单独一行,子元素按层级缩进indent个空格
+     *             2.没有子元素的元素写为<name .../>
+     *             3.属性值按QDom的规则转义(& < " 及换行,回车,制表符)
+     *         写入的内容先放入固定大小的缓冲区,缓冲区满时写入文件,内存占用与文档大小无关
+     *         大量同级元素(如所有元件)可以通过writeChunked分块并行格式化后写入
+     *
+     *         使用方式:
+     *             XmlStreamWriter writer;
+     *             writer.open("test.xml");
+     *             writer.writeStartElement("Job");
+     *             writer.writeAttribute("版本号", "V2");
+     *             writer.writeEndElement();
+     *             writer.close();
+     *  @author bob
+     *  @version 1.00 2026-10-17 bob
+     *                note:create it
+     */
+    class XmlStreamWriter
+    {
+    public:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //常量
+        static const size_t BUFFER_SIZE = 256 * 1024;   //缓冲区的大小(字节),超过时写入文件
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //构造 & 析构函数
+        //indent:每一层缩进的空格数
+        explicit XmlStreamWriter(int indent = 4);
+
+        //未关闭时关闭文件(不抛出异常)
+        ~XmlStreamWriter();
+
+        XmlStreamWriter(const XmlStreamWriter &) = delete;
+        XmlStreamWriter & operator=(const XmlStreamWriter &) = delete;
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        /*
+        *  @brief  open
+        *          创建(或清空)xml文件
+        *  @param  path:文件的路径
+        *  @return N/A,打开失败时抛出异常
+        */
+        void open(const std::string & path);
+
+        /*
+        *  @brief  close
+        *          关闭所有未结束的元素,将缓冲区写入文件并关闭文件
+        *  @param  N/A
+        *  @return N/A,写入失败时抛出异常
+        */
+        void close();
+
+        //是否已打开
+        bool isOpened() const {return this->m_fd >= 0;}
+
+        //开始一个元素,之后可以写入该元素的属性,直到写入子元素或结束该元素
+        void writeStartElement(const std::string & name);
+
+        //结束最近开始的元素
+        void writeEndElement();
+
+        /*
+        *  @brief  writeAttribute
+        *          写入当前元素的属性,必须在writeStartElement之后,写入子元素之前调用
+        *          数值按printf的%.<precision>g格式化(FormatConvertion::doubleToChars):
+        *              precision为6时与QString::number(value)一致,
+        *              precision为16时与QDomElement::setAttribute(name,double)一致
+        *  @param  name:属性名
+        *          value:属性值(字符串按规则转义)
+        *          precision:数值的有效位数
+        *  @return N/A
+        */
+        void writeAttribute(const std::string & name, const std::string & value);
+        void writeAttribute(const std::string & name, double value, int precision = 6);
+
+        /*
+        *  @brief  writeChunked
+        *          在当前元素下写入count个子元素,由chunkedWriter分块并行格式化,按顺序写入文件
+        *          每一块使用一个独立的片段写入器(缩进层级与当前元素的子元素相同),
+        *          writeItem在片段写入器中写入第index个子元素(可以包含属性及更深的子元素,必须完整结束)
+        *  @param  chunkedWriter:并行分块导出的参数(线程数,每块的条数)
+        *          count:子元素的数量
+        *          writeItem:写入一个子元素的函数,在多个线程中同时调用
+        *  @return N/A
+        */
+        void writeChunked(const ChunkedWriter & chunkedWriter,
+                          size_t count,
+                          const std::function<void(XmlStreamWriter & fragment, size_t index)> & writeItem);
+
+        //将缓冲区的内容写入文件
+        void flush();
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+    private:
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员函数
+        //结束当前元素的开始标签(写入子元素之前)
+        void closeStartTag();
+
+        //写入缩进
+        void writeIndent(size_t depth);
+
+        //按属性值的规则转义后写入缓冲区
+        void appendEscaped(const std::string & value);
+
+        //缓冲区超过BUFFER_SIZE时写入文件(片段写入器没有文件,内容全部保留在缓冲区中)
+        void flushIfFull()
+        {
+            if(this->isOpened() && this->m_buffer.size() >= BUFFER_SIZE)
+            {
+                this->flush();
+            }
+        }
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+        //>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+        //成员变量
+        int m_fd;                               //文件描述符,未打开时为-1
+        int m_indent;                           //每一层缩进的空格数
+        size_t m_baseDepth;                     //最外层元素的缩进层级(片段写入器为父元素的层级+1)
+        std::string m_buffer;                   //写入缓冲区
+        std::vector<std::string> m_elements;    //未结束的元素名称(栈)
+        bool m_startTagOpen;                    //当前元素的开始标签尚未结束(可以继续写入属性)
+        //<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    };
+}   //End of namespace SSDK
+
+#endif // XMLSTREAMWRITER_HPP
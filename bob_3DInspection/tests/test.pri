@@ -0,0 +1,20 @@
+#所有单元测试共用的配置,被测源文件的路径相对于3DInspection.pro所在的目录(SRC_DIR)
+#CONFIG += testcase 使 make check 运行测试程序
+CONFIG += console c++11 testcase
+CONFIG -= app_bundle
+QT += core
+QT -= gui
+
+SRC_DIR = $$PWD/..
+
+INCLUDEPATH += $$SRC_DIR
+INCLUDEPATH += $$SRC_DIR/include
+INCLUDEPATH += $$PWD
+
+HEADERS += \
+    $$PWD/testcase.hpp
+
+unix::LIBS += -L$$SRC_DIR/lib/ -lsqlite3
+
+unix:LIBS += -L/usr/lib/x86_64-linux-gnu\
+-ldl -lpthread
@@ -0,0 +1,103 @@
+#ifndef TESTCASE_HPP
+#define TESTCASE_HPP
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <exception>
+
+//单元测试的检查宏
+//检查失败时输出文件名,行号及表达式,并继续执行;RUN_TEST捕获测试函数抛出的异常
+//main的最后返回Test::result(),有检查失败时返回1
+namespace Test
+{
+    //失败的检查数量
+    inline int & failureCount()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    inline void fail(const char * file, int line, const std::string & detail)
+    {
+        ++failureCount();
+        std::printf("FAIL %s:%d: %s\n", file, line, detail.c_str());
+    }
+
+    //按能精确还原的精度输出浮点数
+    inline std::string toString(double value)
+    {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.17g", value);
+        return text;
+    }
+
+    //输出结果并返回进程的退出码
+    inline int result()
+    {
+        if(0 == failureCount())
+        {
+            std::printf("All tests passed\n");
+            return 0;
+        }
+        std::printf("%d check(s) failed\n", failureCount());
+        return 1;
+    }
+}   //End of namespace Test
+
+#define CHECK(expr)\
+    do\
+    {\
+        if(!(expr))\
+        {\
+            Test::fail(__FILE__, __LINE__, #expr);\
+        }\
+    } while(0)
+
+#define CHECK_EQUAL(actual, expected)\
+    do\
+    {\
+        if(!((actual) == (expected)))\
+        {\
+            Test::fail(__FILE__, __LINE__, std::string(#actual " == " #expected));\
+        }\
+    } while(0)
+
+#define CHECK_NEAR(actual, expected, tolerance)\
+    do\
+    {\
+        double testActual = (actual), testExpected = (expected);\
+        if(!(std::fabs(testActual - testExpected) <= (tolerance)))\
+        {\
+            Test::fail(__FILE__, __LINE__, std::string(#actual " ~= " #expected ": ") +\
+                       Test::toString(testActual) + " vs " + Test::toString(testExpected));\
+        }\
+    } while(0)
+
+#define CHECK_THROWS(statement)\
+    do\
+    {\
+        bool testThrown = false;\
+        try {statement;} catch(const std::exception &) {testThrown = true;}\
+        if(!testThrown)\
+        {\
+            Test::fail(__FILE__, __LINE__, "no exception: " #statement);\
+        }\
+    } while(0)
+
+#define RUN_TEST(func)\
+    do\
+    {\
+        int testFailures = Test::failureCount();\
+        try\
+        {\
+            func();\
+        }\
+        catch(const std::exception & ex)\
+        {\
+            Test::fail(__FILE__, __LINE__, std::string(#func " threw: ") + ex.what());\
+        }\
+        std::printf("%s %s\n", testFailures == Test::failureCount() ? "PASS" : "FAIL", #func);\
+    } while(0)
+
+#endif // TESTCASE_HPP
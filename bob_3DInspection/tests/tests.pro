@@ -0,0 +1,21 @@
+#单元测试,每个子项目生成一个独立的可执行程序,全部通过时返回0
+#    qmake tests.pro && make && make check
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    tst_binaryjob \
+    tst_boardalignment \
+    tst_changetracker \
+    tst_formatconvertion \
+    tst_jobcache \
+    tst_jobmigrator \
+    tst_jobsnapshot \
+    tst_lazyjob \
+    tst_rectanglekernel \
+    tst_resultstore \
+    tst_xmlstream
+
+#需要SSDK,parquet-cpp及arrow库: qmake CONFIG+=parquet tests.pro
+parquet {
+    SUBDIRS += tst_parquetexporter
+}
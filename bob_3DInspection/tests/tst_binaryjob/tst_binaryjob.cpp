@@ -0,0 +1,154 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "testcase.hpp"
+#include "job/binaryjob.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK;
+
+namespace
+{
+    const char * BIN_PATH = "tst_binaryjob.bin";
+    const uint64_t SOURCE_HASH = 0x0123456789abcdefULL;
+
+    //检测程式数据:InspectionData -> Board -> MeasuredObjList
+    struct JobData
+    {
+        MeasuredObjList<MeasuredObj> list;
+        Board board;
+        InspectionData inspectionData;
+
+        JobData()
+        {
+            this->board.setMeasurdObjList(&this->list);
+            this->inspectionData.setBoard(&this->board);
+        }
+    };
+
+    void fillJob(JobData & job)
+    {
+        job.inspectionData.setVersion("V2");
+        job.inspectionData.setLastEditingTime("2026-10-17 12:00:00");
+        job.board.setName("board");
+        job.board.setOriginalX(0.5);
+        job.board.setOriginalY(0.25);
+        job.board.setSizeX(300);
+        job.board.setSizeY(200);
+
+        MeasuredObj * measuredObjArr = job.board.measuredObjPool().allocate(3);
+        for (int i = 0; i < 3; ++i)
+        {
+            measuredObjArr[i].setId(i + 1);
+            measuredObjArr[i].setName("ic" + to_string(i));
+            Rectangle rect(10.0 * i + 0.1, 5.0 * i + 0.2, 1.5, 0.75, 90.0 * i);
+            measuredObjArr[i].setRectangle(&rect);
+        }
+        job.list.append(measuredObjArr, measuredObjArr + 3);
+    }
+
+    vector<char> readFile(const char * path)
+    {
+        ifstream file(path, ios::binary);
+        return vector<char>((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    }
+
+    void writeFile(const char * path, const vector<char> & data)
+    {
+        ofstream file(path, ios::binary | ios::trunc);
+        file.write(data.data(), data.size());
+    }
+}
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//写入后以相同的源文件哈希值读取,内容一致
+void testRoundTrip()
+{
+    JobData source;
+    fillJob(source);
+    BinaryJob::write(BIN_PATH, &source.inspectionData, SOURCE_HASH);
+
+    BinaryJob binaryJob;
+    CHECK(binaryJob.open(BIN_PATH, SOURCE_HASH));
+    CHECK_EQUAL(binaryJob.header().sourceHash, SOURCE_HASH);
+
+    JobData loaded;
+    binaryJob.loadInto(&loaded.inspectionData);
+    CHECK_EQUAL(loaded.inspectionData.version(), string("V2"));
+    CHECK_EQUAL(loaded.inspectionData.lastEditingTime(), string("2026-10-17 12:00:00"));
+    CHECK_EQUAL(loaded.board.name(), string("board"));
+    CHECK_EQUAL(loaded.board.originalX(), 0.5);
+    CHECK_EQUAL(loaded.board.sizeY(), 200.0);
+    CHECK_EQUAL(loaded.list.size(), 3);
+
+    MeasuredObj * pExpected = source.list.pHead();
+    for (MeasuredObj * pObj = loaded.list.pHead(); nullptr != pObj && nullptr != pExpected;
+         pObj = pObj->pNextMeasuredObj(), pExpected = pExpected->pNextMeasuredObj())
+    {
+        CHECK_EQUAL(pObj->id(), pExpected->id());
+        CHECK_EQUAL(pObj->name(), pExpected->name());
+        CHECK_EQUAL(pObj->rectangle().xPos(), pExpected->rectangle().xPos());
+        CHECK_EQUAL(pObj->rectangle().yPos(), pExpected->rectangle().yPos());
+        CHECK_EQUAL(pObj->rectangle().angle(), pExpected->rectangle().angle());
+    }
+    binaryJob.close();
+    std::remove(BIN_PATH);
+}
+
+//源文件内容变化后(哈希值不同)不读取二进制文件,与文件的修改时间无关
+void testRejectsStaleSource()
+{
+    JobData source;
+    fillJob(source);
+    BinaryJob::write(BIN_PATH, &source.inspectionData, SOURCE_HASH);
+
+    //二进制文件在源文件修改之后才写入(修改时间更新)也不能使用
+    BinaryJob binaryJob;
+    CHECK(!binaryJob.open(BIN_PATH, SOURCE_HASH + 1));
+    CHECK(!binaryJob.isOpened());
+    CHECK(binaryJob.open(BIN_PATH, SOURCE_HASH));
+    binaryJob.close();
+    std::remove(BIN_PATH);
+}
+
+//文件不存在,不完整或格式版本不符时不读取
+void testRejectsInvalidFile()
+{
+    BinaryJob binaryJob;
+    std::remove(BIN_PATH);
+    CHECK(!binaryJob.open(BIN_PATH, SOURCE_HASH));
+
+    JobData source;
+    fillJob(source);
+    BinaryJob::write(BIN_PATH, &source.inspectionData, SOURCE_HASH);
+    vector<char> data = readFile(BIN_PATH);
+    CHECK(data.size() > sizeof(BinaryJobHeader));
+
+    //截断
+    vector<char> truncated(data.begin(), data.end() - 1);
+    writeFile(BIN_PATH, truncated);
+    CHECK(!binaryJob.open(BIN_PATH, SOURCE_HASH));
+
+    //旧的格式版本(文件头没有sourceHash)
+    vector<char> oldVersion = data;
+    reinterpret_cast<BinaryJobHeader *>(oldVersion.data())->version = 1;
+    writeFile(BIN_PATH, oldVersion);
+    CHECK(!binaryJob.open(BIN_PATH, SOURCE_HASH));
+
+    writeFile(BIN_PATH, data);
+    CHECK(binaryJob.open(BIN_PATH, SOURCE_HASH));
+    binaryJob.close();
+    std::remove(BIN_PATH);
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    RUN_TEST(testRoundTrip);
+    RUN_TEST(testRejectsStaleSource);
+    RUN_TEST(testRejectsInvalidFile);
+    return Test::result();
+}
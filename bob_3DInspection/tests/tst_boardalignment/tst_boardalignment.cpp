@@ -0,0 +1,178 @@
+#include <cmath>
+#include <random>
+
+#include "testcase.hpp"
+#include "job/boardalignment.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK;
+
+namespace
+{
+    //已知的变换:旋转0.35度,X/Y方向不同的缩放,少量剪切及平移
+    AffineTransform knownAffine()
+    {
+        const double radian = 0.35 * 3.14159265358979323846 / 180;
+        const double scaleX = 1.0002, scaleY = 0.9997, shear = 0.0004;
+        return AffineTransform(scaleX * std::cos(radian), -scaleY * std::sin(radian) + shear,
+                               scaleX * std::sin(radian), scaleY * std::cos(radian),
+                               1.25, -0.8);
+    }
+
+    //检测程式中四角的Mark点
+    const double NOMINAL[][2] = {{5, 5}, {245, 8}, {240, 195}, {10, 190}};
+
+    void checkTransform(const AffineTransform & actual, const AffineTransform & expected, double tolerance)
+    {
+        CHECK_NEAR(actual.a(), expected.a(), tolerance);
+        CHECK_NEAR(actual.b(), expected.b(), tolerance);
+        CHECK_NEAR(actual.c(), expected.c(), tolerance);
+        CHECK_NEAR(actual.d(), expected.d(), tolerance);
+        CHECK_NEAR(actual.tx(), expected.tx(), tolerance * 100);
+        CHECK_NEAR(actual.ty(), expected.ty(), tolerance * 100);
+    }
+}
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//3个及以上Mark点:精确恢复仿射变换,残差为0
+void testRecoversAffine()
+{
+    AffineTransform expected = knownAffine();
+    for (int cnt = 3; cnt <= 4; ++cnt)
+    {
+        BoardAlignment alignment;
+        for (int i = 0; i < cnt; ++i)
+        {
+            double x = 0, y = 0;
+            expected.map(NOMINAL[i][0], NOMINAL[i][1], x, y);
+            alignment.addFiducial(NOMINAL[i][0], NOMINAL[i][1], x, y);
+        }
+        alignment.solve();
+
+        CHECK_EQUAL(alignment.fiducialCount(), cnt);
+        checkTransform(alignment.transform(), expected, 1e-12);
+        CHECK(alignment.residual() < 1e-10);
+        CHECK_NEAR(alignment.transform().rotation(), 0.35, 0.05);
+    }
+}
+
+//Mark点有测量噪声时为最小二乘解,残差与噪声同一数量级
+void testLeastSquaresWithNoise()
+{
+    AffineTransform expected = knownAffine();
+    mt19937 engine(3);
+    normal_distribution<double> noise(0, 0.002);
+
+    BoardAlignment alignment;
+    for (int i = 0; i < 12; ++i)
+    {
+        double nominalX = 5 + 20 * i, nominalY = (0 == i % 2) ? 5 : 195;
+        double x = 0, y = 0;
+        expected.map(nominalX, nominalY, x, y);
+        alignment.addFiducial(nominalX, nominalY, x + noise(engine), y + noise(engine));
+    }
+    alignment.solve();
+
+    checkTransform(alignment.transform(), expected, 1e-4);
+    CHECK(alignment.residual() > 0);
+    CHECK(alignment.residual() < 0.005);
+}
+
+//1个Mark点为平移,2个Mark点为相似变换(旋转+等比缩放+平移)
+void testTranslationAndSimilarity()
+{
+    BoardAlignment translation;
+    translation.addFiducial(10, 20, 10.5, 19.25);
+    translation.solve();
+    checkTransform(translation.transform(), AffineTransform(1, 0, 0, 1, 0.5, -0.75), 1e-15);
+
+    const double radian = -0.2 * 3.14159265358979323846 / 180, scale = 1.0001;
+    AffineTransform similarity(scale * std::cos(radian), -scale * std::sin(radian),
+                               scale * std::sin(radian), scale * std::cos(radian),
+                               -0.3, 0.45);
+    BoardAlignment alignment;
+    for (int i = 0; i < 2; ++i)
+    {
+        double x = 0, y = 0;
+        similarity.map(NOMINAL[i * 2][0], NOMINAL[i * 2][1], x, y);
+        alignment.addFiducial(NOMINAL[i * 2][0], NOMINAL[i * 2][1], x, y);
+    }
+    alignment.solve();
+    checkTransform(alignment.transform(), similarity, 1e-12);
+    CHECK_NEAR(alignment.transform().rotation(), -0.2, 1e-9);
+}
+
+//没有Mark点,Mark点重合或共线时抛出异常
+void testDegenerateFiducials()
+{
+    BoardAlignment empty;
+    CHECK_THROWS(empty.solve());
+
+    BoardAlignment coincident;
+    coincident.addFiducial(10, 10, 11, 11);
+    coincident.addFiducial(10, 10, 11, 11);
+    CHECK_THROWS(coincident.solve());
+
+    BoardAlignment collinear;
+    collinear.addFiducial(0, 0, 1, 1);
+    collinear.addFiducial(10, 10, 11, 11);
+    collinear.addFiducial(20, 20, 21, 21);
+    CHECK_THROWS(collinear.solve());
+
+    //清空后恢复为单位变换
+    collinear.clearFiducials();
+    CHECK_EQUAL(collinear.fiducialCount(), 0);
+    checkTransform(collinear.transform(), AffineTransform(), 0);
+}
+
+//apply将变换作用于元件表的中心和角度,宽和高及元件表不变
+void testApplyToComponentTable()
+{
+    ComponentTable table;
+    mt19937 engine(5);
+    uniform_real_distribution<double> pos(0, 250), size(0.2, 5), angle(-180, 180);
+    for (int i = 0; i < 1003; ++i)
+    {
+        Rectangle rect(pos(engine), pos(engine), size(engine), size(engine), angle(engine));
+        table.append("c" + to_string(i), rect);
+    }
+
+    AffineTransform expected = knownAffine();
+    BoardAlignment alignment;
+    for (const auto & point : NOMINAL)
+    {
+        double x = 0, y = 0;
+        expected.map(point[0], point[1], x, y);
+        alignment.addFiducial(point[0], point[1], x, y);
+    }
+    alignment.solve();
+    alignment.apply(&table);
+
+    CHECK_EQUAL(alignment.size(), table.size());
+    RectangleArray rects = alignment.rectangles();
+    CHECK_EQUAL(rects.size, table.size());
+    double rotation = alignment.transform().rotation();
+    for (int i = 0; i < table.size(); ++i)
+    {
+        double x = 0, y = 0;
+        expected.map(table.xPos()[i], table.yPos()[i], x, y);
+        CHECK_NEAR(rects.xPos[i], x, 1e-9);
+        CHECK_NEAR(rects.yPos[i], y, 1e-9);
+        CHECK_NEAR(rects.angle[i], table.angle()[i] + rotation, 1e-12);
+        CHECK_EQUAL(rects.width[i], table.width()[i]);
+        CHECK_EQUAL(rects.height[i], table.height()[i]);
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    RUN_TEST(testRecoversAffine);
+    RUN_TEST(testLeastSquaresWithNoise);
+    RUN_TEST(testTranslationAndSimilarity);
+    RUN_TEST(testDegenerateFiducials);
+    RUN_TEST(testApplyToComponentTable);
+
+    return Test::result();
+}
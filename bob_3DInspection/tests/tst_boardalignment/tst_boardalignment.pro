@@ -0,0 +1,15 @@
+include(../test.pri)
+include($$SRC_DIR/sdk/simd.pri)
+
+TARGET = tst_boardalignment
+
+SOURCES += \
+    tst_boardalignment.cpp \
+    $$SRC_DIR/sdk/customexception.cpp \
+    $$SRC_DIR/sdk/formatconvertion.cpp \
+    $$SRC_DIR/sdk/rectangle.cpp \
+    $$SRC_DIR/sdk/affinetransform.cpp \
+    $$SRC_DIR/sdk/rectanglekernel.cpp \
+    $$SRC_DIR/job/measuredobj.cpp \
+    $$SRC_DIR/job/componenttable.cpp \
+    $$SRC_DIR/job/boardalignment.cpp
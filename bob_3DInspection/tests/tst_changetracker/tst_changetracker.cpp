@@ -0,0 +1,350 @@
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "testcase.hpp"
+#include "job/board.hpp"
+#include "sdk/DB/rowreader.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK;
+using namespace SSDK::DB;
+
+namespace
+{
+    const char * JOB_PATH = "tst_changetracker.job";
+
+    //检测程式中一个元件的数据
+    struct Row
+    {
+        string name;
+        double xPos, yPos, width, height, angle;
+    };
+
+    //建立只有Job表及MeasuredObjList表的检测程式(表结构与writeInspectionDataToJob一致),元件排成一行
+    void createJob(int objCnt)
+    {
+        std::remove(JOB_PATH);
+        SqliteDB sqlite;
+        sqlite.open(JOB_PATH);
+        sqlite.execute("CREATE TABLE Job(Version TEXT,LastEditingTime TEXT);");
+        sqlite.execute("INSERT INTO Job(Version,LastEditingTime) VALUES('V2','2026-10-01 08:00:00');");
+        sqlite.execute("CREATE TABLE MeasuredObjList(Id INTEGER PRIMARY KEY,Name TEXT,PosX REAL,PosY REAL,Width REAL,Height REAL,Angle REAL);");
+        sqlite.begin();
+        string sqlInsert = "INSERT INTO MeasuredObjList(Name,PosX,PosY,Width,Height,Angle) VALUES(?,?,?,?,?,?);";
+        sqlite.prepare(sqlInsert);
+        for (int i = 0; i < objCnt; ++i)
+        {
+            string name = "C" + to_string(i + 1);
+            sqlite.executeWithParms(name.data(), 10.0 * i + 5, 5.0, 4.0, 2.0, 0.0);
+        }
+        sqlite.commit();
+        sqlite.close();
+    }
+
+    //按ID读取检测程式中的所有元件
+    map<int64_t, Row> readJob()
+    {
+        SqliteDB sqlite;
+        sqlite.open(JOB_PATH);
+        RowReader<int64_t, string, double, double, double, double, double> reader(
+                    &sqlite, "select rowid,Name,PosX,PosY,Width,Height,Angle from MeasuredObjList");
+        map<int64_t, Row> rows;
+        int64_t id = 0;
+        Row row;
+        while (reader.next(id, row.name, row.xPos, row.yPos, row.width, row.height, row.angle))
+        {
+            rows[id] = row;
+        }
+        return rows;
+    }
+
+    //与readInspectionDataFromJob相同:从内存池一次性分配,按rowid设置ID后添加到链表,再生成元件表
+    void loadBoard(Board & board)
+    {
+        map<int64_t, Row> rows = readJob();
+        board.clearMeasuredObjs();
+        MeasuredObj * measuredObjArr = board.measuredObjPool().allocate((int)rows.size());
+        int i = 0;
+        for (map<int64_t, Row>::const_iterator it = rows.begin(); it != rows.end(); ++it, ++i)
+        {
+            measuredObjArr[i].setId(it->first);
+            measuredObjArr[i].setName(it->second.name);
+            Rectangle rect(it->second.xPos, it->second.yPos, it->second.width, it->second.height, it->second.angle);
+            measuredObjArr[i].setRectangle(&rect);
+        }
+        board.pMeasuredObjList()->append(measuredObjArr, measuredObjArr + rows.size());
+        board.buildComponentTable();
+    }
+
+    //查找名称为name的元件
+    MeasuredObj * findObj(Board & board, const string & name)
+    {
+        for (MeasuredObj * pObj = board.pMeasuredObjList()->pHead(); nullptr != pObj; pObj = pObj->pNextMeasuredObj())
+        {
+            if(pObj->name() == name)
+            {
+                return pObj;
+            }
+        }
+        return nullptr;
+    }
+
+    //元件表的内容与链表一致(顺序相同)
+    void checkTableMatchesList(Board & board)
+    {
+        const ComponentTable & table = board.componentTable();
+        CHECK_EQUAL(table.size(), board.pMeasuredObjList()->size());
+        CHECK_EQUAL(board.spatialIndex().size(), board.pMeasuredObjList()->size());
+
+        int i = 0;
+        for (MeasuredObj * pObj = board.pMeasuredObjList()->pHead(); nullptr != pObj && i < table.size(); pObj = pObj->pNextMeasuredObj(), ++i)
+        {
+            CHECK_EQUAL(table.name(i), pObj->name());
+            CHECK_EQUAL(table.xPos()[i], pObj->rectangle().xPos());
+            CHECK_EQUAL(table.yPos()[i], pObj->rectangle().yPos());
+            CHECK_EQUAL(table.width()[i], pObj->rectangle().width());
+            CHECK_EQUAL(table.height()[i], pObj->rectangle().height());
+            CHECK_EQUAL(table.angle()[i], pObj->rectangle().angle());
+        }
+    }
+
+    //点(x,y)处的元件名称
+    vector<string> namesAt(Board & board, double x, double y)
+    {
+        vector<int> indices;
+        board.spatialIndex().queryPoint(x, y, indices);
+        vector<string> names;
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            names.push_back(board.componentTable().name(indices[i]));
+        }
+        return names;
+    }
+}
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//修改记录的合并规则
+void testTrackerRecords()
+{
+    MeasuredObj saved1, saved2, added1, added2;
+    saved1.setId(1);
+    saved2.setId(2);
+
+    ChangeTracker tracker;
+    CHECK(!tracker.isDirty());
+    CHECK_THROWS(tracker.markAdded(&saved1));
+
+    tracker.markAdded(&added1);
+    tracker.markAdded(&added2);
+    tracker.markModified(&added1);      //新元件保存时写入最新数据,不记录修改
+    tracker.markModified(&saved1);
+    tracker.markModified(&saved1);
+    tracker.markModified(&saved2);
+    tracker.markDeleted(&added2);       //未保存的新元件直接移除
+    tracker.markDeleted(&saved2);       //已删除的元件不再更新
+
+    CHECK(tracker.isDirty());
+    CHECK_EQUAL(tracker.added().size(), 1u);
+    CHECK(tracker.added()[0] == &added1);
+    CHECK_EQUAL(tracker.modified().size(), 1u);
+    CHECK(tracker.modified().count(1) == 1);
+    CHECK_EQUAL(tracker.deleted().size(), 1u);
+    CHECK(tracker.deleted().count(2) == 1);
+
+    tracker.clear();
+    CHECK(!tracker.isDirty());
+}
+
+//编辑后元件表及空间索引在下一次访问时与链表同步
+void testEditInvalidatesComponentTable()
+{
+    createJob(20);
+    MeasuredObjList<MeasuredObj> list;
+    Board board;
+    board.setMeasurdObjList(&list);
+    loadBoard(board);
+    CHECK(!board.isComponentTableDirty());
+    CHECK_EQUAL(board.componentTable().size(), 20);
+
+    //添加
+    MeasuredObj * pNew = board.addMeasuredObj("NEW", Rectangle(500, 50, 4, 2, 0));
+    CHECK(board.isComponentTableDirty());
+    checkTableMatchesList(board);
+    CHECK(!board.isComponentTableDirty());
+    CHECK(namesAt(board, 500, 50) == vector<string>(1, "NEW"));
+
+    //修改:旧位置不再命中,新位置命中
+    board.updateMeasuredObj(pNew, Rectangle(500, 80, 4, 2, 90));
+    CHECK(board.isComponentTableDirty());
+    CHECK(namesAt(board, 500, 50).empty());
+    CHECK(namesAt(board, 500, 80) == vector<string>(1, "NEW"));
+    checkTableMatchesList(board);
+
+    //删除
+    MeasuredObj * pC3 = findObj(board, "C3");
+    CHECK(namesAt(board, 25, 5) == vector<string>(1, "C3"));
+    board.removeMeasuredObj(pC3);
+    CHECK(board.isComponentTableDirty());
+    CHECK(namesAt(board, 25, 5).empty());
+    checkTableMatchesList(board);
+    CHECK_EQUAL(board.componentTable().size(), 20);
+
+    //连续编辑只在访问时重新生成一次
+    board.updateMeasuredObj(findObj(board, "C1"), Rectangle(5, 30, 4, 2, 0));
+    board.updateMeasuredObj(findObj(board, "C2"), Rectangle(15, 30, 4, 2, 0));
+    CHECK(board.isComponentTableDirty());
+    checkTableMatchesList(board);
+
+    //重新加载后元件表有效,修改记录被清空
+    board.clearMeasuredObjs();
+    CHECK(!board.isComponentTableDirty());
+    CHECK(!board.changeTracker().isDirty());
+    CHECK_EQUAL(board.componentTable().size(), 0);
+}
+
+//编辑,保存,重新加载,比较
+void testSaveAndReload()
+{
+    createJob(100);
+    MeasuredObjList<MeasuredObj> list;
+    Board board;
+    board.setMeasurdObjList(&list);
+    loadBoard(board);
+
+    board.updateMeasuredObj(findObj(board, "C10"), Rectangle(1.25, 2.5, 3.75, 0.125, 45));
+    board.updateMeasuredObj(findObj(board, "C20"), Rectangle(-7, 8, 1, 1, -90));
+    board.updateMeasuredObj(findObj(board, "C30"), Rectangle(0.1, 0.2, 0.3, 0.4, 0.5));
+    board.removeMeasuredObj(findObj(board, "C30"));             //修改后删除
+    board.removeMeasuredObj(findObj(board, "C100"));            //删除最后一行,新元件可能复用其rowid
+    MeasuredObj * pA = board.addMeasuredObj("A", Rectangle(300, 10, 2, 2, 0));
+    MeasuredObj * pB = board.addMeasuredObj("B", Rectangle(310, 10, 2, 2, 0));
+    MeasuredObj * pC = board.addMeasuredObj("C", Rectangle(320, 10, 2, 2, 0));
+    board.updateMeasuredObj(pB, Rectangle(310, 20, 3, 3, 30));  //添加后修改
+    board.removeMeasuredObj(pC);                                //添加后删除
+
+    SqliteDB sqlite;
+    sqlite.open(JOB_PATH);
+    board.changeTracker().save(sqlite, "2026-10-17 12:00:00");
+    sqlite.close();
+
+    CHECK(!board.changeTracker().isDirty());
+    CHECK(0 != pA->id());
+    CHECK(0 != pB->id());
+    CHECK(pA->id() != pB->id());
+    CHECK_EQUAL(pC->id(), 0);
+
+    //保存后的检测程式与内存中的链表一致
+    map<int64_t, Row> rows = readJob();
+    CHECK_EQUAL((int)rows.size(), board.pMeasuredObjList()->size());
+    CHECK_EQUAL((int)rows.size(), 100);
+    for (MeasuredObj * pObj = board.pMeasuredObjList()->pHead(); nullptr != pObj; pObj = pObj->pNextMeasuredObj())
+    {
+        map<int64_t, Row>::const_iterator it = rows.find(pObj->id());
+        CHECK(it != rows.end());
+        if(it == rows.end())
+        {
+            continue;
+        }
+        CHECK_EQUAL(it->second.name, pObj->name());
+        CHECK_EQUAL(it->second.xPos, pObj->rectangle().xPos());
+        CHECK_EQUAL(it->second.yPos, pObj->rectangle().yPos());
+        CHECK_EQUAL(it->second.width, pObj->rectangle().width());
+        CHECK_EQUAL(it->second.height, pObj->rectangle().height());
+        CHECK_EQUAL(it->second.angle, pObj->rectangle().angle());
+    }
+
+    {
+        SqliteDB jobDb;
+        jobDb.open(JOB_PATH);
+        RowReader<string> reader(&jobDb, "select LastEditingTime from Job");
+        string lastEditingTime;
+        CHECK(reader.next(lastEditingTime));
+        CHECK_EQUAL(lastEditingTime, string("2026-10-17 12:00:00"));
+    }
+
+    //重新加载到另一块基板,元件表按ID比较
+    MeasuredObjList<MeasuredObj> reloadedList;
+    Board reloaded;
+    reloaded.setMeasurdObjList(&reloadedList);
+    loadBoard(reloaded);
+    CHECK_EQUAL(reloaded.componentTable().size(), board.componentTable().size());
+    CHECK(nullptr == findObj(reloaded, "C30"));
+    CHECK(nullptr == findObj(reloaded, "C100"));
+    CHECK(nullptr == findObj(reloaded, "C"));
+    MeasuredObj * pReloadedB = findObj(reloaded, "B");
+    CHECK(nullptr != pReloadedB);
+    if(nullptr != pReloadedB)
+    {
+        CHECK_EQUAL(pReloadedB->id(), pB->id());
+        CHECK_EQUAL(pReloadedB->rectangle().yPos(), 20.0);
+        CHECK_EQUAL(pReloadedB->rectangle().angle(), 30.0);
+    }
+    MeasuredObj * pReloadedC10 = findObj(reloaded, "C10");
+    CHECK(nullptr != pReloadedC10);
+    if(nullptr != pReloadedC10)
+    {
+        CHECK_EQUAL(pReloadedC10->rectangle().height(), 0.125);
+        CHECK_EQUAL(pReloadedC10->rectangle().angle(), 45.0);
+    }
+
+    //保存后再次编辑只写入新的修改
+    board.updateMeasuredObj(pA, Rectangle(300, 40, 2, 2, 0));
+    CHECK_EQUAL(board.changeTracker().modified().size(), 1u);
+    sqlite.open(JOB_PATH);
+    board.changeTracker().save(sqlite, "2026-10-17 12:05:00");
+    sqlite.close();
+    CHECK_EQUAL(readJob()[pA->id()].yPos, 40.0);
+    std::remove(JOB_PATH);
+}
+
+//保存失败时回滚:检测程式不变,修改记录保留,新元件的ID仍为0
+void testSaveRollsBackOnFailure()
+{
+    createJob(10);
+    MeasuredObjList<MeasuredObj> list;
+    Board board;
+    board.setMeasurdObjList(&list);
+    loadBoard(board);
+
+    board.updateMeasuredObj(findObj(board, "C1"), Rectangle(1, 1, 1, 1, 0));
+    board.removeMeasuredObj(findObj(board, "C2"));
+    MeasuredObj * pNew = board.addMeasuredObj("NEW", Rectangle(200, 5, 4, 2, 0));
+
+    SqliteDB sqlite;
+    sqlite.open(JOB_PATH, SQLITE_OPEN_READONLY);
+    CHECK_THROWS(board.changeTracker().save(sqlite, "2026-10-17 12:00:00"));
+    sqlite.close();
+
+    CHECK(board.changeTracker().isDirty());
+    CHECK_EQUAL(board.changeTracker().added().size(), 1u);
+    CHECK_EQUAL(board.changeTracker().deleted().size(), 1u);
+    CHECK_EQUAL(pNew->id(), 0);
+
+    map<int64_t, Row> rows = readJob();
+    CHECK_EQUAL(rows.size(), 10u);
+    CHECK_EQUAL(rows[1].xPos, 5.0);
+
+    //再次保存成功
+    sqlite.open(JOB_PATH);
+    board.changeTracker().save(sqlite, "2026-10-17 12:00:00");
+    sqlite.close();
+    rows = readJob();
+    CHECK_EQUAL(rows.size(), 10u);
+    CHECK_EQUAL(rows[1].xPos, 1.0);
+    CHECK(0 == rows.count(2));
+    CHECK(0 != pNew->id());
+    std::remove(JOB_PATH);
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    RUN_TEST(testTrackerRecords);
+    RUN_TEST(testEditInvalidatesComponentTable);
+    RUN_TEST(testSaveAndReload);
+    RUN_TEST(testSaveRollsBackOnFailure);
+    return Test::result();
+}
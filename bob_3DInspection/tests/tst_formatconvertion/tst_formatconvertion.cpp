@@ -0,0 +1,279 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "testcase.hpp"
+#include "sdk/formatconvertion.hpp"
+
+using namespace std;
+using namespace SSDK;
+
+namespace
+{
+    //每个检查最多输出的失败数,避免大量重复的输出
+    const int MAX_REPORTED = 10;
+
+    string shortest(double value)
+    {
+        char buffer[FormatConvertion::MAX_NUMBER_LENGTH];
+        return string(buffer, FormatConvertion::doubleToChars(value, buffer));
+    }
+
+    string withPrecision(double value, int precision)
+    {
+        char buffer[FormatConvertion::MAX_NUMBER_LENGTH];
+        return string(buffer, FormatConvertion::doubleToChars(value, precision, buffer));
+    }
+
+    string printfG(double value, int precision)
+    {
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+        return buffer;
+    }
+
+    bool sameBits(double a, double b)
+    {
+        uint64_t bitsA = 0, bitsB = 0;
+        std::memcpy(&bitsA, &a, sizeof(a));
+        std::memcpy(&bitsB, &b, sizeof(b));
+        return bitsA == bitsB;
+    }
+
+    double fromBits(uint64_t bits)
+    {
+        double value = 0;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    //有效数字的位数(不含符号,前导0,末尾的0及指数)
+    int significantDigits(const string & text)
+    {
+        string mantissa = text.substr(0, text.find('e'));
+        size_t first = mantissa.find_first_of("123456789");
+        size_t last = mantissa.find_last_of("123456789");
+        if(string::npos == first)
+        {
+            return 1;
+        }
+        int digits = 0;
+        for (size_t i = first; i <= last; ++i)
+        {
+            digits += (mantissa[i] >= '0' && mantissa[i] <= '9') ? 1 : 0;
+        }
+        return digits;
+    }
+
+    //printf可以精确还原原值的最少有效数字位数
+    int shortestPrecision(double value)
+    {
+        int precision = 1;
+        while(precision < 17 && !sameBits(std::strtod(printfG(value, precision).c_str(), nullptr), value))
+        {
+            ++precision;
+        }
+        return precision;
+    }
+
+    //边界值: 0,-0,非规格化数,规格化数的边界,inf/nan
+    vector<double> edgeValues()
+    {
+        const double inf = numeric_limits<double>::infinity();
+        vector<double> values = {
+            0.0, -0.0, 1.0, -1.0, 0.1, 0.5, 1.5, 2.5, 9.5, 0.125, 1e-5, 1e-4, 9.9999e-5,
+            1e15, 1e16, 1e17, 1e21, 1e22, 1e23, 123456789012345678.0,
+            numeric_limits<double>::denorm_min(), -numeric_limits<double>::denorm_min(),
+            fromBits(0x000fffffffffffffULL),        //最大的非规格化数
+            fromBits(0x0008000000000000ULL),
+            DBL_MIN, -DBL_MIN, DBL_MAX, -DBL_MAX, DBL_EPSILON, 1.0 + DBL_EPSILON,
+            inf, -inf, numeric_limits<double>::quiet_NaN(), -numeric_limits<double>::quiet_NaN(),
+            9007199254740992.0, 9007199254740993.0, 0.3, 2.0 / 3, 1.0 / 3, 299792458.0, 5e-324};
+        return values;
+    }
+
+    //任意位模式的数值(包括nan,inf及非规格化数)
+    vector<double> bitPatternValues(int count)
+    {
+        mt19937_64 engine(20261017);
+        vector<double> values;
+        values.reserve(count);
+        for (int i = 0; i < count; ++i)
+        {
+            values.push_back(fromBits(engine()));
+        }
+        return values;
+    }
+
+    //十进制小数,及舍入位落在进位边界上的数
+    vector<double> decimalValues(int count)
+    {
+        mt19937_64 engine(17);
+        uniform_int_distribution<int> digits(1, 17), exponent(-30, 30);
+        vector<double> values;
+        values.reserve(count * 2);
+        for (int i = 0; i < count; ++i)
+        {
+            //d位的十进制整数乘以10的幂,再加上半个单位,测试四舍五入的进位
+            int d = digits(engine);
+            uint64_t mantissa = engine() % (uint64_t)std::pow(10.0, d);
+            double decimal = (double)mantissa * std::pow(10.0, exponent(engine));
+            values.push_back(decimal);
+            values.push_back((mantissa + 0.5) * std::pow(10.0, exponent(engine)));
+        }
+        return values;
+    }
+
+    //检查precision为1~17时与printf("%.<precision>g")的输出一致
+    void checkMatchesPrintf(const vector<double> & values)
+    {
+        int reported = 0;
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            for (int precision = 1; precision <= 17; ++precision)
+            {
+                string actual = withPrecision(values[i], precision);
+                string expected = printfG(values[i], precision);
+                if(actual != expected && reported++ < MAX_REPORTED)
+                {
+                    Test::fail(__FILE__, __LINE__, "%.*g of " + Test::toString(values[i]) + " precision " +
+                               to_string(precision) + ": " + actual + " vs " + expected);
+                }
+            }
+        }
+    }
+
+    //检查最短表示经strtod及charsToDouble读回后与原值的位完全相同,
+    //且有效数字的位数不超过printf("%.<n>g")可以还原原值的最小n(包括靠近舍入区间边界的数值,如1e23)
+    void checkShortestRoundTrip(const vector<double> & values)
+    {
+        int reported = 0;
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            const double value = values[i];
+            const string text = shortest(value);
+            const double parsed = std::strtod(text.c_str(), nullptr);
+            bool ok = std::isnan(value) ? std::isnan(parsed) : sameBits(parsed, value);
+
+            double converted = 0;
+            ok = ok && FormatConvertion::charsToDouble(text.c_str(), converted) &&
+                 (std::isnan(value) ? std::isnan(converted) : sameBits(converted, value));
+
+            if(ok && std::isfinite(value) && 0 != value)
+            {
+                ok = significantDigits(text) <= shortestPrecision(value);
+            }
+
+            if(!ok && reported++ < MAX_REPORTED)
+            {
+                Test::fail(__FILE__, __LINE__, "shortest of " + Test::toString(value) + ": " + text);
+            }
+        }
+    }
+}
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//边界值: 0,-0,非规格化数,inf/nan
+void testDoubleEdgeCases()
+{
+    const double inf = numeric_limits<double>::infinity();
+    CHECK_EQUAL(shortest(0.0), string("0"));
+    CHECK_EQUAL(shortest(-0.0), string("-0"));
+    CHECK_EQUAL(shortest(1.0), string("1"));
+    CHECK_EQUAL(shortest(0.1), string("0.1"));
+    CHECK_EQUAL(shortest(1e-5), string("1e-05"));
+    CHECK_EQUAL(shortest(1.5e17), string("1.5e+17"));
+    CHECK_EQUAL(shortest(1e23), string("1e+23"));
+    CHECK_EQUAL(shortest(9007199254740993.0), string("9007199254740992"));
+    CHECK_EQUAL(shortest(numeric_limits<double>::denorm_min()), string("5e-324"));
+    CHECK_EQUAL(shortest(DBL_MAX), string("1.7976931348623157e+308"));
+    CHECK_EQUAL(shortest(DBL_MIN), string("2.2250738585072014e-308"));
+    CHECK_EQUAL(shortest(inf), printfG(inf, 17));
+    CHECK_EQUAL(shortest(-inf), printfG(-inf, 17));
+    CHECK(std::isnan(std::strtod(shortest(numeric_limits<double>::quiet_NaN()).c_str(), nullptr)));
+
+    vector<double> values = edgeValues();
+    checkMatchesPrintf(values);
+    checkShortestRoundTrip(values);
+}
+
+//随机数值: precision为1~17时与printf一致,最短表示可以精确还原且每个数值都是最短的
+//十进制小数常落在舍入区间边界附近,覆盖需要逐位查找的情况
+void testDoubleFuzz()
+{
+    vector<double> values = bitPatternValues(100000);
+    checkMatchesPrintf(values);
+    checkShortestRoundTrip(values);
+
+    values = decimalValues(100000);
+    checkMatchesPrintf(values);
+    checkShortestRoundTrip(values);
+}
+
+//整数: 与printf("%lld")一致,包括INT64_MIN及INT64_MAX
+void testIntToChars()
+{
+    vector<int64_t> values = {0, 1, -1, 9, 10, -10, 99, 100, INT32_MAX, INT32_MIN,
+                              INT64_MAX, INT64_MIN, INT64_MIN + 1, INT64_MAX - 1};
+    int64_t power = 1;
+    for (int i = 0; i < 18; ++i)
+    {
+        power *= 10;
+        values.push_back(power - 1);
+        values.push_back(power);
+        values.push_back(-power);
+        values.push_back(-power + 1);
+    }
+    mt19937_64 engine(23);
+    for (int i = 0; i < 100000; ++i)
+    {
+        values.push_back((int64_t)engine());
+        values.push_back((int64_t)(engine() >> (engine() % 64)));
+    }
+
+    int reported = 0;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        char buffer[FormatConvertion::MAX_NUMBER_LENGTH];
+        string actual(buffer, FormatConvertion::intToChars(values[i], buffer));
+        char expected[32];
+        std::snprintf(expected, sizeof(expected), "%lld", (long long)values[i]);
+        if(actual != expected && reported++ < MAX_REPORTED)
+        {
+            Test::fail(__FILE__, __LINE__, string("intToChars: ") + actual + " vs " + expected);
+        }
+    }
+}
+
+//时间: 本地时间的 年/月/日 时:分:秒,各字段不补零
+void testTimeToString()
+{
+    const time_t times[] = {0, 86399, 1792224330, time(NULL)};
+    for (size_t i = 0; i < sizeof(times) / sizeof(times[0]); ++i)
+    {
+        tm localTime;
+        localtime_r(&times[i], &localTime);
+        char expected[64];
+        std::snprintf(expected, sizeof(expected), "%d/%d/%d %d:%d:%d",
+                      localTime.tm_year + 1900, localTime.tm_mon + 1, localTime.tm_mday,
+                      localTime.tm_hour, localTime.tm_min, localTime.tm_sec);
+        CHECK_EQUAL(FormatConvertion::timeToString(times[i]), string(expected));
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    RUN_TEST(testDoubleEdgeCases);
+    RUN_TEST(testDoubleFuzz);
+    RUN_TEST(testIntToChars);
+    RUN_TEST(testTimeToString);
+    return Test::result();
+}
@@ -0,0 +1,8 @@
+include(../test.pri)
+
+TARGET = tst_formatconvertion
+
+SOURCES += \
+    tst_formatconvertion.cpp \
+    $$SRC_DIR/sdk/customexception.cpp \
+    $$SRC_DIR/sdk/formatconvertion.cpp
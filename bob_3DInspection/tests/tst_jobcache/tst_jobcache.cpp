@@ -0,0 +1,94 @@
+#include <cstdio>
+#include <string>
+#include <fstream>
+#include <memory>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "testcase.hpp"
+#include "job/jobcache.hpp"
+
+using namespace std;
+using namespace Job;
+
+namespace
+{
+    const char * CACHE_FOLDER = "tst_jobcache.cache";
+    const char * JOB_PATH = "tst_jobcache_missing.db";     //不存在的检测程式,invalidate不能读取它
+
+    shared_ptr<const CachedJob> makeCachedJob(uint64_t contentHash, const string & jobPath)
+    {
+        shared_ptr<CachedJob> pCachedJob = make_shared<CachedJob>();
+        pCachedJob->contentHash = contentHash;
+        pCachedJob->jobPath = jobPath;
+        return pCachedJob;
+    }
+
+    //在磁盘缓存中生成一个二进制检测程式文件
+    void writeBlob(JobCache & cache, uint64_t contentHash)
+    {
+        ofstream file(cache.blobPath(contentHash).c_str());
+        file << "blob";
+    }
+
+    bool exists(const string & path)
+    {
+        struct stat fileStat;
+        return 0 == ::stat(path.c_str(), &fileStat);
+    }
+}
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//按传入的哈希值删除内存及磁盘缓存,不读取检测程式文件
+void testInvalidateByKnownHash()
+{
+    JobCache cache;
+    cache.setDiskFolder(CACHE_FOLDER);
+    cache.insert(makeCachedJob(1, JOB_PATH));
+    cache.insert(makeCachedJob(2, JOB_PATH));
+    cache.insert(makeCachedJob(3, "other.db"));
+    writeBlob(cache, 1);
+    writeBlob(cache, 3);
+    CHECK_EQUAL(cache.memoryCount(), 3);
+
+    cache.invalidate(JOB_PATH, 1);
+    CHECK(!cache.find(1));
+    CHECK(!cache.find(2));
+    CHECK(cache.find(3));
+    CHECK(!exists(cache.blobPath(1)));
+    CHECK(exists(cache.blobPath(3)));
+
+    std::remove(cache.blobPath(3).c_str());
+}
+
+//哈希值未知时只删除内存中该路径的检测程式
+void testInvalidateWithUnknownHash()
+{
+    JobCache cache;
+    cache.setDiskFolder(CACHE_FOLDER);
+    cache.insert(makeCachedJob(4, JOB_PATH));
+    cache.insert(makeCachedJob(5, "other.db"));
+    writeBlob(cache, 5);
+
+    cache.invalidate(JOB_PATH, 0);
+    CHECK(!cache.find(4));
+    CHECK(cache.find(5));
+    CHECK(exists(cache.blobPath(5)));
+
+    //没有设置磁盘缓存时同样可用
+    JobCache memoryOnly;
+    memoryOnly.insert(makeCachedJob(6, JOB_PATH));
+    memoryOnly.invalidate(JOB_PATH, 6);
+    CHECK_EQUAL(memoryOnly.memoryCount(), 0);
+
+    std::remove(cache.blobPath(5).c_str());
+    ::rmdir(CACHE_FOLDER);
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    RUN_TEST(testInvalidateByKnownHash);
+    RUN_TEST(testInvalidateWithUnknownHash);
+    return Test::result();
+}
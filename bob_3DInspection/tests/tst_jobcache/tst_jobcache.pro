@@ -0,0 +1,29 @@
+include(../test.pri)
+include($$SRC_DIR/sdk/simd.pri)
+
+TARGET = tst_jobcache
+
+SOURCES += \
+    tst_jobcache.cpp \
+    $$SRC_DIR/sdk/customexception.cpp \
+    $$SRC_DIR/sdk/hash.cpp \
+    $$SRC_DIR/sdk/formatconvertion.cpp \
+    $$SRC_DIR/sdk/rectangle.cpp \
+    $$SRC_DIR/sdk/affinetransform.cpp \
+    $$SRC_DIR/sdk/rectanglekernel.cpp \
+    $$SRC_DIR/sdk/xmlstreamwriter.cpp \
+    $$SRC_DIR/sdk/chunkedwriter.cpp \
+    $$SRC_DIR/sdk/DB/blob.cpp \
+    $$SRC_DIR/sdk/DB/sqlitedb.cpp \
+    $$SRC_DIR/sdk/DB/statement.cpp \
+    $$SRC_DIR/job/measuredobj.cpp \
+    $$SRC_DIR/job/componenttable.cpp \
+    $$SRC_DIR/job/spatialindex.cpp \
+    $$SRC_DIR/job/changetracker.cpp \
+    $$SRC_DIR/job/board.cpp \
+    $$SRC_DIR/job/inspectiondata.cpp \
+    $$SRC_DIR/job/fovplan.cpp \
+    $$SRC_DIR/job/inspectionplan.cpp \
+    $$SRC_DIR/job/jobsnapshot.cpp \
+    $$SRC_DIR/job/jobstore.cpp \
+    $$SRC_DIR/job/jobcache.cpp
@@ -0,0 +1,181 @@
+#include <cstdio>
+#include <string>
+
+#include "testcase.hpp"
+#include "sdk/hash.hpp"
+#include "job/jobmigrator.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK;
+using namespace SSDK::DB;
+
+namespace
+{
+    const char * JOB_PATH = "tst_jobmigrator.db";
+
+    //生成一个V1版本的检测程式(检测对象没有Angle字段)
+    void createV1Job(int objCnt)
+    {
+        std::remove(JOB_PATH);
+        SqliteDB sqlite;
+        CHECK(sqlite.open(JOB_PATH));
+        CHECK(sqlite.execute("CREATE TABLE Job(Version TEXT, LastEditingTime TEXT);"));
+        CHECK(sqlite.execute("INSERT INTO Job VALUES('V1', '2017-12-01');"));
+        CHECK(sqlite.execute("CREATE TABLE MeasuredObjList(Name TEXT, PosX REAL, PosY REAL, Width REAL, Height REAL);"));
+        sqlite.begin();
+        for (int i = 0; i < objCnt; ++i)
+        {
+            sqlite.execute("INSERT INTO MeasuredObjList VALUES('obj', 1, 2, 3, 4);");
+        }
+        sqlite.commit();
+        sqlite.close();
+    }
+
+    string fileVersion()
+    {
+        SqliteDB sqlite;
+        sqlite.open(JOB_PATH, SQLITE_OPEN_READONLY);
+        string version = JobMigrator::readVersion(&sqlite);
+        sqlite.close();
+        return version;
+    }
+}
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//旧版本的检测程式就地升级,已是当前版本时不修改文件
+void testMigrateFileInPlace()
+{
+    createV1Job(10);
+    JobMigrator migrator;
+    CHECK_EQUAL(migrator.currentVersion(), string("V3"));
+
+    CHECK(migrator.migrateFile(JOB_PATH));
+    CHECK_EQUAL(fileVersion(), string("V3"));
+
+    SqliteDB sqlite;
+    sqlite.open(JOB_PATH, SQLITE_OPEN_READONLY);
+    int angleCnt = 0;
+    RowReader<int> reader(&sqlite, "select count(*) from MeasuredObjList where Angle=0");
+    CHECK(reader.next(angleCnt));
+    CHECK_EQUAL(angleCnt, 10);
+    sqlite.close();
+
+    CHECK(!migrator.migrateFile(JOB_PATH));
+    CHECK_EQUAL(fileVersion(), string("V3"));
+}
+
+//只读适配: 旧版本的检测程式在内存数据库中升级,文件内容(哈希值)不变
+void testOpenUpgradedKeepsFile()
+{
+    createV1Job(10);
+    const uint64_t hashBefore = Hash::fileHash(JOB_PATH);
+
+    JobMigrator migrator;
+    SqliteDB memoryDb;
+    CHECK_EQUAL(migrator.openUpgraded(JOB_PATH, memoryDb), string("V1"));
+    CHECK_EQUAL(JobMigrator::readVersion(&memoryDb), string("V3"));
+    int angleCnt = 0;
+    RowReader<int> reader(&memoryDb, "select count(*) from MeasuredObjList where Angle=0");
+    CHECK(reader.next(angleCnt));
+    CHECK_EQUAL(angleCnt, 10);
+
+    //内存中的修改不写回文件
+    CHECK(memoryDb.execute("DELETE FROM MeasuredObjList;"));
+    memoryDb.close();
+
+    CHECK_EQUAL(Hash::fileHash(JOB_PATH), hashBefore);
+    CHECK_EQUAL(fileVersion(), string("V1"));
+}
+
+//V2->V3添加Id INTEGER PRIMARY KEY列,保留原来的rowid(包括删除元件留下的空缺),VACUUM后ID不变
+void testIdColumnKeepsRowid()
+{
+    createV1Job(10);
+    {
+        SqliteDB sqlite;
+        sqlite.open(JOB_PATH);
+        CHECK(sqlite.execute("DELETE FROM MeasuredObjList WHERE rowid IN (2,5,10);"));
+        sqlite.close();
+    }
+
+    JobMigrator migrator;
+    CHECK(migrator.migrateFile(JOB_PATH));
+
+    SqliteDB sqlite;
+    sqlite.open(JOB_PATH);
+    int pkCnt = 0;
+    {
+        RowReader<int> pkReader(&sqlite, "select count(*) from pragma_table_info('MeasuredObjList') where name='Id' and pk=1");
+        CHECK(pkReader.next(pkCnt));
+    }
+    CHECK_EQUAL(pkCnt, 1);
+
+    CHECK(sqlite.execute("VACUUM;"));
+    const int64_t expectedIds[] = {1, 3, 4, 6, 7, 8, 9};
+    int idCnt = 0;
+    {
+        RowReader<int64_t, int64_t> idReader(&sqlite, "select Id,rowid from MeasuredObjList order by Id");
+        int64_t id = 0, rowid = 0;
+        while (idReader.next(id, rowid))
+        {
+            CHECK(idCnt < 7 && expectedIds[idCnt] == id);
+            CHECK_EQUAL(rowid, id);
+            ++idCnt;
+        }
+    }
+    CHECK_EQUAL(idCnt, 7);
+    sqlite.close();
+}
+
+//某一步失败时回滚该步,文件停留在上一个完整的版本
+void testFailedStepRollsBack()
+{
+    createV1Job(3);
+    JobMigrator migrator;
+    migrator.registerStep("V3", "V4", [](SqliteDB * sqlite)
+    {
+        //先修改表结构,再失败,修改必须被回滚
+        return sqlite->execute("ALTER TABLE MeasuredObjList ADD Extra REAL DEFAULT 0;") &&
+               sqlite->execute("SELECT * FROM NoSuchTable;");
+    });
+
+    CHECK_THROWS(migrator.migrateFile(JOB_PATH));
+    CHECK_EQUAL(fileVersion(), string("V3"));
+
+    SqliteDB sqlite;
+    sqlite.open(JOB_PATH, SQLITE_OPEN_READONLY);
+    int extraCnt = 0;
+    RowReader<int> reader(&sqlite, "select count(*) from pragma_table_info('MeasuredObjList') where name='Extra'");
+    CHECK(reader.next(extraCnt));
+    CHECK_EQUAL(extraCnt, 0);
+    sqlite.close();
+}
+
+//不支持的版本抛出异常,文件不修改
+void testRejectsUnknownVersion()
+{
+    createV1Job(1);
+    {
+        SqliteDB sqlite;
+        sqlite.open(JOB_PATH);
+        sqlite.execute("UPDATE Job SET Version='V0';");
+        sqlite.close();
+    }
+
+    JobMigrator migrator;
+    CHECK_THROWS(migrator.migrateFile(JOB_PATH));
+    CHECK_EQUAL(fileVersion(), string("V0"));
+    std::remove(JOB_PATH);
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    RUN_TEST(testMigrateFileInPlace);
+    RUN_TEST(testOpenUpgradedKeepsFile);
+    RUN_TEST(testIdColumnKeepsRowid);
+    RUN_TEST(testFailedStepRollsBack);
+    RUN_TEST(testRejectsUnknownVersion);
+    return Test::result();
+}
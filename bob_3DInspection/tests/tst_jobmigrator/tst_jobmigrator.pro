@@ -0,0 +1,13 @@
+include(../test.pri)
+
+TARGET = tst_jobmigrator
+
+SOURCES += \
+    tst_jobmigrator.cpp \
+    $$SRC_DIR/sdk/customexception.cpp \
+    $$SRC_DIR/sdk/hash.cpp \
+    $$SRC_DIR/sdk/DB/blob.cpp \
+    $$SRC_DIR/sdk/DB/sqlitedb.cpp \
+    $$SRC_DIR/sdk/DB/statement.cpp \
+    $$SRC_DIR/job/jobcatalog.cpp \
+    $$SRC_DIR/job/jobmigrator.cpp
@@ -0,0 +1,312 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "testcase.hpp"
+#include "job/jobstore.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK;
+
+namespace
+{
+    //检测程式数据,board的检测对象链表及inspectionData的board指向本结构中的成员
+    struct JobData
+    {
+        MeasuredObjList<MeasuredObj> list;
+        Board board;
+        InspectionData inspectionData;
+
+        JobData()
+        {
+            this->board.setMeasurdObjList(&this->list);
+            this->inspectionData.setBoard(&this->board);
+        }
+    };
+
+    //生成objCnt个元件(名称为C0,C1,...,X坐标等于序号)并生成元件表
+    void fillJob(JobData & job, int objCnt)
+    {
+        job.inspectionData.setVersion("V2");
+        job.inspectionData.setLastEditingTime("2026-10-17 12:00:00");
+        job.board.setName("board");
+
+        MeasuredObj * measuredObjArr = job.board.measuredObjPool().allocate(objCnt);
+        for (int i = 0; i < objCnt; ++i)
+        {
+            measuredObjArr[i].setId(i + 1);
+            measuredObjArr[i].setName("C" + to_string(i));
+            Rectangle rect(i, 1.0, 2.0, 1.0, 0.0);
+            measuredObjArr[i].setRectangle(&rect);
+        }
+        job.list.append(measuredObjArr, measuredObjArr + objCnt);
+        job.board.buildComponentTable();
+    }
+
+    //快照的内容与检测对象链表一致(顺序,名称及矩形),块的起始索引号连续
+    void checkMatchesList(const JobSnapshot & snapshot, JobData & job)
+    {
+        CHECK_EQUAL(snapshot.size(), job.list.size());
+        int index = 0;
+        for (MeasuredObj * pObj = job.list.pHead(); pObj != nullptr && index < snapshot.size(); pObj = pObj->pNextMeasuredObj(), ++index)
+        {
+            CHECK_EQUAL(snapshot.name(index), pObj->name());
+            CHECK_EQUAL(snapshot.rectangle(index).xPos(), pObj->rectangle().xPos());
+            CHECK_EQUAL(snapshot.rectangle(index).yPos(), pObj->rectangle().yPos());
+        }
+
+        int start = 0;
+        for (int i = 0; i < snapshot.chunkCount(); ++i)
+        {
+            CHECK_EQUAL(snapshot.chunkStart(i), start);
+            CHECK(snapshot.chunk(i).size() > 0);
+            start += snapshot.chunk(i).size();
+        }
+        CHECK_EQUAL(start, snapshot.size());
+    }
+}
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//编辑只复制被修改的块,其他块由新旧快照共享,旧快照不变
+void testEditorSharesChunks()
+{
+    JobData job;
+    fillJob(job, 3000);     //块: 1024,1024,952
+    shared_ptr<const JobSnapshot> base = JobSnapshot::create(&job.inspectionData);
+    CHECK_EQUAL(base->chunkCount(), 3);
+
+    //step1 修改第二块中的元件
+    JobSnapshotEditor setEditor(base);
+    setEditor.setComponent(1500, "S", Rectangle(-1, -1, 1, 1, 0));
+    setEditor.setComponent(1501, "T", Rectangle(-2, -2, 1, 1, 0));
+    shared_ptr<const JobSnapshot> setSnapshot = setEditor.commit();
+    CHECK_EQUAL(setSnapshot->revision(), base->revision() + 1);
+    CHECK(&setSnapshot->chunk(0) == &base->chunk(0));
+    CHECK(&setSnapshot->chunk(1) != &base->chunk(1));
+    CHECK(&setSnapshot->chunk(2) == &base->chunk(2));
+    CHECK_EQUAL(setSnapshot->name(1500), string("S"));
+    CHECK_EQUAL(setSnapshot->rectangle(1501).xPos(), -2.0);
+    CHECK_EQUAL(base->name(1500), string("C1500"));
+    CHECK_THROWS(setEditor.setComponent(0, "X", Rectangle()));
+
+    //step2 在末尾添加元件,只复制最后一块
+    JobSnapshotEditor appendEditor(base);
+    CHECK_EQUAL(appendEditor.appendComponent("A", Rectangle(9, 9, 1, 1, 0)), 3000);
+    shared_ptr<const JobSnapshot> appendSnapshot = appendEditor.commit();
+    CHECK_EQUAL(appendSnapshot->size(), 3001);
+    CHECK_EQUAL(appendSnapshot->chunkCount(), 3);
+    CHECK(&appendSnapshot->chunk(0) == &base->chunk(0));
+    CHECK(&appendSnapshot->chunk(1) == &base->chunk(1));
+    CHECK(&appendSnapshot->chunk(2) != &base->chunk(2));
+    CHECK_EQUAL(appendSnapshot->name(3000), string("A"));
+    CHECK_EQUAL(base->size(), 3000);
+
+    //step3 删除第一块中的元件,之后的块仍然共享,起始索引号减1
+    JobSnapshotEditor removeEditor(base);
+    removeEditor.removeComponent(10);
+    shared_ptr<const JobSnapshot> removeSnapshot = removeEditor.commit();
+    CHECK_EQUAL(removeSnapshot->size(), 2999);
+    CHECK(&removeSnapshot->chunk(0) != &base->chunk(0));
+    CHECK(&removeSnapshot->chunk(1) == &base->chunk(1));
+    CHECK(&removeSnapshot->chunk(2) == &base->chunk(2));
+    CHECK_EQUAL(removeSnapshot->chunkStart(1), 1023);
+    CHECK_EQUAL(removeSnapshot->name(10), string("C11"));
+    CHECK_EQUAL(removeSnapshot->name(1023), string("C1024"));
+    CHECK_EQUAL(removeSnapshot->name(2998), string("C2999"));
+    CHECK_EQUAL(base->name(10), string("C10"));
+    CHECK_THROWS(JobSnapshotEditor(base).removeComponent(3000));
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//删空的块被移除,最后一块未满时添加的元件放入该块
+void testRemoveWholeChunk()
+{
+    JobData job;
+    fillJob(job, 1030);     //块: 1024,6
+    shared_ptr<const JobSnapshot> base = JobSnapshot::create(&job.inspectionData);
+
+    JobSnapshotEditor editor(base);
+    for (int i = 0; i < 6; ++i)
+    {
+        editor.removeComponent(1024);
+    }
+    editor.removeComponent(0);
+    CHECK_EQUAL(editor.appendComponent("A", Rectangle(1, 1, 1, 1, 0)), 1023);
+    CHECK_EQUAL(editor.appendComponent("B", Rectangle(2, 2, 1, 1, 0)), 1024);
+    shared_ptr<const JobSnapshot> snapshot = editor.commit();
+
+    //step1 第二块删空后被移除,第一块删除一个元件后有空位,A放入第一块,B新建一块
+    CHECK_EQUAL(snapshot->size(), 1025);
+    CHECK_EQUAL(snapshot->chunkCount(), 2);
+    CHECK_EQUAL(snapshot->chunk(0).size(), 1024);
+    CHECK_EQUAL(snapshot->chunkStart(1), 1024);
+    CHECK_EQUAL(snapshot->name(0), string("C1"));
+    CHECK_EQUAL(snapshot->name(1022), string("C1023"));
+    CHECK_EQUAL(snapshot->name(1023), string("A"));
+    CHECK_EQUAL(snapshot->name(1024), string("B"));
+
+    //step2 删除所有元件后没有块
+    JobSnapshotEditor clearEditor(snapshot);
+    while(clearEditor.size() > 0)
+    {
+        clearEditor.removeComponent(clearEditor.size() / 2);
+    }
+    shared_ptr<const JobSnapshot> empty = clearEditor.commit();
+    CHECK_EQUAL(empty->size(), 0);
+    CHECK_EQUAL(empty->chunkCount(), 0);
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//board的编辑函数通过publishIf增量发布快照,快照与链表一致,未编辑的块共享
+void testBoardEditsPublish()
+{
+    JobData job;
+    fillJob(job, 2500);
+    JobStore store;
+    job.board.setJobStore(&store);
+
+    //step1 未发布快照时只修改链表
+    MeasuredObj * pFirst = job.list.pHead();
+    job.board.updateMeasuredObj(pFirst, Rectangle(0, 5, 2, 1, 0));
+    CHECK(!store.current());
+
+    //step2 添加,修改及删除元件后各发布一次
+    store.publish(JobSnapshot::create(&job.inspectionData));
+    shared_ptr<const JobSnapshot> loaded = store.current();
+    uint64_t sequence = store.sequence();
+
+    MeasuredObj * pNew = job.board.addMeasuredObj("NEW", Rectangle(7, 7, 1, 1, 0));
+    CHECK_EQUAL(store.sequence(), sequence + 1);
+    checkMatchesList(*store.current(), job);
+
+    job.board.updateMeasuredObj(pNew, Rectangle(8, 8, 1, 1, 0));
+    job.board.updateMeasuredObj(pFirst->pNextMeasuredObj(), Rectangle(1, 9, 2, 1, 0));
+    checkMatchesList(*store.current(), job);
+
+    job.board.removeMeasuredObj(pFirst);
+    shared_ptr<const JobSnapshot> edited = store.current();
+    CHECK_EQUAL(store.sequence(), sequence + 4);
+    CHECK_EQUAL(edited->revision(), loaded->revision() + 4);
+    checkMatchesList(*edited, job);
+    CHECK(&edited->chunk(1) == &loaded->chunk(1));
+    CHECK_EQUAL(loaded->size(), 2500);
+    CHECK_EQUAL(loaded->name(0), string("C0"));
+
+    //step3 当前快照不是由该board生成时抛出异常,链表不变
+    JobData other;
+    fillJob(other, 3);
+    store.publish(JobSnapshot::create(&other.inspectionData));
+    CHECK_THROWS(job.board.addMeasuredObj("BAD", Rectangle()));
+    CHECK_THROWS(job.board.removeMeasuredObj(pNew));
+    CHECK_EQUAL(job.list.size(), 2500);
+    CHECK(job.list.pTail() == pNew);
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//基于同一快照的两次编辑,后发布的publishIf失败,当前快照不变
+void testPublishIfConflict()
+{
+    JobData job;
+    fillJob(job, 10);
+    JobStore store;
+    store.publish(JobSnapshot::create(&job.inspectionData));
+    shared_ptr<const JobSnapshot> base = store.current();
+
+    JobSnapshotEditor first(base);
+    first.setComponent(0, "FIRST", Rectangle());
+    JobSnapshotEditor second(base);
+    second.setComponent(0, "SECOND", Rectangle());
+
+    shared_ptr<const JobSnapshot> firstSnapshot = first.commit();
+    uint64_t sequence = store.sequence();
+    CHECK(store.publishIf(base, firstSnapshot));
+    CHECK(!store.publishIf(base, second.commit()));
+    CHECK(store.current() == firstSnapshot);
+    CHECK_EQUAL(store.sequence(), sequence + 1);
+
+    //基于新的当前快照重新编辑后发布成功
+    JobSnapshotEditor retry(store.current());
+    retry.setComponent(0, "SECOND", Rectangle());
+    CHECK(store.publishIf(firstSnapshot, retry.commit()));
+    CHECK_EQUAL(store.current()->name(0), string("SECOND"));
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//编辑线程不断发布时,多个读者读取到的快照始终完整:
+//第n次编辑添加名为"E<n>"的元件,修订号为n的快照有初始数量+n个元件,且最后一个元件为"E<n>"
+void testConcurrentReaders()
+{
+    const int OBJ_CNT = 2000;
+    const int EDIT_CNT = 3000;
+    const int READER_CNT = 4;
+
+    JobData job;
+    fillJob(job, OBJ_CNT);
+    JobStore store;
+    job.board.setJobStore(&store);
+    store.publish(JobSnapshot::create(&job.inspectionData));
+
+    atomic<bool> done(false);
+    atomic<int> errorCnt(0);
+    vector<uint64_t> lastRevisions(READER_CNT, 0);
+    vector<thread> readers;
+    for (int r = 0; r < READER_CNT; ++r)
+    {
+        readers.push_back(thread([&, r]
+        {
+            JobSnapshotReader reader(&store);
+            uint64_t lastRevision = 0;
+            bool finished = false;
+            while(!finished)
+            {
+                //先读取结束标记,之后读取的快照一定是最终快照
+                finished = done.load();
+                const JobSnapshot & snapshot = reader.current();
+                uint64_t revision = snapshot.revision();
+                bool valid = revision >= lastRevision
+                        && snapshot.size() == OBJ_CNT + (int)revision
+                        && snapshot.name(snapshot.size() - 1) == (0 == revision ? "C" + to_string(OBJ_CNT - 1) : "E" + to_string(revision));
+                if(!valid)
+                {
+                    ++errorCnt;
+                }
+                lastRevision = revision;
+            }
+            lastRevisions[r] = lastRevision;
+        }));
+    }
+
+    for (int i = 1; i <= EDIT_CNT; ++i)
+    {
+        job.board.addMeasuredObj("E" + to_string(i), Rectangle(i, 2, 1, 1, 0));
+    }
+    done = true;
+    for (size_t r = 0; r < readers.size(); ++r)
+    {
+        readers[r].join();
+    }
+
+    CHECK_EQUAL(errorCnt.load(), 0);
+    for (int r = 0; r < READER_CNT; ++r)
+    {
+        CHECK_EQUAL(lastRevisions[r], (uint64_t)EDIT_CNT);
+    }
+    checkMatchesList(*store.current(), job);
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    RUN_TEST(testEditorSharesChunks);
+    RUN_TEST(testRemoveWholeChunk);
+    RUN_TEST(testBoardEditsPublish);
+    RUN_TEST(testPublishIfConflict);
+    RUN_TEST(testConcurrentReaders);
+    return Test::result();
+}
@@ -0,0 +1,203 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "testcase.hpp"
+#include "job/lazyjob.hpp"
+#include "sdk/rectanglekernel.hpp"
+#include "sdk/hash.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK;
+using namespace SSDK::DB;
+
+namespace
+{
+    const char * JOB_PATH = "tst_lazyjob.db";
+
+    //接收基本信息的检测程式数据:InspectionData -> Board -> MeasuredObjList
+    struct JobData
+    {
+        MeasuredObjList<MeasuredObj> list;
+        Board board;
+        InspectionData inspectionData;
+
+        JobData()
+        {
+            this->board.setMeasurdObjList(&this->list);
+            this->inspectionData.setBoard(&this->board);
+        }
+    };
+
+    double randomValue(double minValue, double maxValue)
+    {
+        return minValue + (maxValue - minValue) * (rand() / (double)RAND_MAX);
+    }
+
+    //生成当前版本的检测程式(没有位置索引),返回所有元件
+    vector<LazyComponent> createJob(int objCnt)
+    {
+        std::remove(JOB_PATH);
+        SqliteDB sqlite;
+        CHECK(sqlite.open(JOB_PATH));
+        CHECK(sqlite.execute("CREATE TABLE Job(Version TEXT,LastEditingTime TEXT);"));
+        CHECK(sqlite.execute("INSERT INTO Job VALUES('V2','2026-10-17');"));
+        CHECK(sqlite.execute("CREATE TABLE Board(Name TEXT,OriginalX REAL,OriginalY REAL,SizeX REAL,SizeY REAL);"));
+        CHECK(sqlite.execute("INSERT INTO Board VALUES('board',0,0,200,200);"));
+        CHECK(sqlite.execute("CREATE TABLE MeasuredObjList(Id INTEGER PRIMARY KEY,Name TEXT,PosX REAL,PosY REAL,Width REAL,Height REAL,Angle REAL);"));
+
+        vector<LazyComponent> components;
+        srand(20261017);
+        for (int i = 0; i < objCnt; ++i)
+        {
+            LazyComponent component;
+            component.id = i + 1;
+            component.xPos = randomValue(0, 200);
+            component.yPos = randomValue(0, 200);
+            component.width = randomValue(0.5, 3);
+            component.height = randomValue(0.5, 3);
+            component.angle = randomValue(0, 360);
+            components.push_back(component);
+        }
+        //中心在(50,50)的长条元件,跨越多个区域页
+        LazyComponent bar;
+        bar.id = objCnt + 1;
+        bar.xPos = 50;
+        bar.yPos = 50;
+        bar.width = 30;
+        bar.height = 1;
+        bar.angle = 0;
+        components.push_back(bar);
+
+        sqlite.begin();
+        for (size_t i = 0; i < components.size(); ++i)
+        {
+            const LazyComponent & c = components[i];
+            CHECK(sqlite.execute("INSERT INTO MeasuredObjList VALUES(?,'obj',?,?,?,?,?);",
+                                 c.id, c.xPos, c.yPos, c.width, c.height, c.angle));
+        }
+        sqlite.commit();
+        sqlite.close();
+
+        return components;
+    }
+
+    //外接矩形与区域相交的元件ID(逐个计算)
+    vector<int64_t> bruteForce(const vector<LazyComponent> & components,
+                               double minX, double minY, double maxX, double maxY)
+    {
+        vector<int64_t> ids;
+        for (size_t i = 0; i < components.size(); ++i)
+        {
+            const LazyComponent & c = components[i];
+            double boundMinX = 0, boundMinY = 0, boundMaxX = 0, boundMaxY = 0;
+            RectangleKernel::bounds(Rectangle(c.xPos, c.yPos, c.width, c.height, c.angle),
+                                    boundMinX, boundMinY, boundMaxX, boundMaxY);
+            if(!(boundMaxX < minX || boundMinX > maxX || boundMaxY < minY || boundMinY > maxY))
+            {
+                ids.push_back(c.id);
+            }
+        }
+        return ids;
+    }
+
+    vector<int64_t> idsOf(const vector<LazyComponent> & components)
+    {
+        vector<int64_t> ids;
+        for (size_t i = 0; i < components.size(); ++i)
+        {
+            ids.push_back(components[i].id);
+        }
+        return ids;
+    }
+}
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//中心在区域外但外接矩形与区域相交的元件也被查询到
+void testQueryFindsOverlappingComponents()
+{
+    vector<LazyComponent> components = createJob(0);
+    JobData jobData;
+    LazyJob job;
+    job.open(JOB_PATH, &jobData.inspectionData);
+
+    //长条元件的X范围为[35,65],中心(50,50)不在查询区域内
+    vector<LazyComponent> result;
+    job.queryRect(62, 45, 70, 55, result);
+    CHECK_EQUAL(result.size(), 1u);
+    job.queryRect(66, 45, 70, 55, result);
+    CHECK(result.empty());
+    job.queryRect(36, 50.4, 40, 60, result);
+    CHECK_EQUAL(result.size(), 1u);
+    job.queryRect(36, 50.6, 40, 60, result);
+    CHECK(result.empty());
+    job.close();
+}
+
+//任意区域的查询结果与逐个计算外接矩形的结果一致,prefetchRect之后查询不再读取数据库
+void testQueryMatchesBruteForce()
+{
+    vector<LazyComponent> components = createJob(5000);
+    JobData jobData;
+    LazyJobSetting setting;
+    setting.tileSize = 10;
+    setting.cachePageCount = 1024;
+    LazyJob job;
+    job.open(JOB_PATH, &jobData.inspectionData, setting);
+    CHECK_EQUAL(job.componentCount(), 5001);
+
+    vector<LazyComponent> result;
+    for (int i = 0; i < 100; ++i)
+    {
+        double x = randomValue(-10, 200), y = randomValue(-10, 200);
+        double w = randomValue(0, 40), h = randomValue(0, 40);
+
+        job.prefetchRect(x, y, x + w, y + h);
+        uint64_t missCount = job.missCount();
+        job.queryRect(x, y, x + w, y + h, result);
+        CHECK_EQUAL(job.missCount(), missCount);
+
+        vector<int64_t> expected = bruteForce(components, x, y, x + w, y + h);
+        vector<int64_t> actual = idsOf(result);
+        CHECK(expected == actual);
+    }
+    job.close();
+}
+
+//没有位置索引的检测程式在内存数据库中建立索引,文件内容(哈希值)不变,查询结果正确
+void testKeepsFileUnchanged()
+{
+    vector<LazyComponent> expected = createJob(10);
+    const uint64_t hashBefore = Hash::fileHash(JOB_PATH);
+    JobData jobData;
+    LazyJob job;
+    job.open(JOB_PATH, &jobData.inspectionData);
+    vector<LazyComponent> components;
+    job.queryRect(-10, -10, 210, 210, components);
+    CHECK_EQUAL(components.size(), expected.size());
+    job.close();
+
+    CHECK_EQUAL(Hash::fileHash(JOB_PATH), hashBefore);
+    SqliteDB sqlite;
+    sqlite.open(JOB_PATH, SQLITE_OPEN_READONLY);
+    int indexCount = 0;
+    {
+        RowReader<int> reader(&sqlite, "select count(*) from sqlite_master where type='index' and name=?");
+        CHECK(reader.bind(LazyJob::POSITION_INDEX_NAME));
+        CHECK(reader.next(indexCount));
+    }
+    CHECK_EQUAL(indexCount, 0);
+    sqlite.close();
+    std::remove(JOB_PATH);
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    RUN_TEST(testQueryFindsOverlappingComponents);
+    RUN_TEST(testQueryMatchesBruteForce);
+    RUN_TEST(testKeepsFileUnchanged);
+    return Test::result();
+}
@@ -0,0 +1,362 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <algorithm>
+
+#include "testcase.hpp"
+#include "job/inspectiondata.hpp"
+#include "job/parquetexporter.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK;
+using namespace SSDK::DB;
+
+namespace
+{
+    const char * PARQUET_PATH = "tst_parquetexporter.parquet";
+    const char * RESULT_DB_PATH = "tst_parquetexporter.db";
+
+    //检测程式数据:InspectionData -> Board -> MeasuredObjList
+    struct JobData
+    {
+        MeasuredObjList<MeasuredObj> list;
+        Board board;
+        InspectionData inspectionData;
+
+        JobData()
+        {
+            this->board.setMeasurdObjList(&this->list);
+            this->inspectionData.setBoard(&this->board);
+        }
+    };
+
+    //InspectionResult表的一行,按(BoardSerial,ComponentId,Timestamp)比较
+    struct ResultRow
+    {
+        string boardSerial;
+        int64_t componentId;
+        int64_t timestamp;
+        int status;
+        double height, area, volume, offsetX, offsetY;
+
+        bool operator<(const ResultRow & other) const
+        {
+            return std::tie(this->boardSerial, this->componentId, this->timestamp) <
+                   std::tie(other.boardSerial, other.componentId, other.timestamp);
+        }
+    };
+
+    bool fileExists(const string & path)
+    {
+        return ifstream(path).good();
+    }
+
+    /*
+    *  按RowGroup依次读取一列的所有值(不经过Parquet::readAllColumns,它只能读取一个RowGroup)
+    *  Reader为列的读取器类型(如parquet::Int64Reader),T为其值的类型
+    */
+    template<class Reader, class T>
+    vector<T> readColumn(parquet::ParquetFileReader & reader, int column)
+    {
+        vector<T> values;
+        for (int group = 0; group < reader.metadata()->num_row_groups(); ++group)
+        {
+            shared_ptr<parquet::ColumnReader> pColumn = reader.RowGroup(group)->Column(column);
+            Reader * pReader = static_cast<Reader *>(pColumn.get());
+            while(pReader->HasNext())
+            {
+                T value;
+                int64_t valueCnt = 0;
+                pReader->ReadBatch(1, nullptr, nullptr, &value, &valueCnt);
+                if(1 == valueCnt)
+                {
+                    values.push_back(value);
+                }
+            }
+        }
+        return values;
+    }
+
+    //字符串列,ByteArray只在下一次读取之前有效,读取后立即复制
+    vector<string> readStringColumn(parquet::ParquetFileReader & reader, int column)
+    {
+        vector<string> values;
+        for (int group = 0; group < reader.metadata()->num_row_groups(); ++group)
+        {
+            shared_ptr<parquet::ColumnReader> pColumn = reader.RowGroup(group)->Column(column);
+            parquet::ByteArrayReader * pReader = static_cast<parquet::ByteArrayReader *>(pColumn.get());
+            while(pReader->HasNext())
+            {
+                parquet::ByteArray value;
+                int64_t valueCnt = 0;
+                pReader->ReadBatch(1, nullptr, nullptr, &value, &valueCnt);
+                if(1 == valueCnt)
+                {
+                    values.push_back(string(reinterpret_cast<const char *>(value.ptr), value.len));
+                }
+            }
+        }
+        return values;
+    }
+
+    //检查Schema的列名,物理类型及逻辑类型
+    void checkColumn(parquet::ParquetFileReader & reader, int column, const string & name,
+                     parquet::Type::type type, parquet::LogicalType::type logicalType = parquet::LogicalType::NONE)
+    {
+        const parquet::ColumnDescriptor * pDescr = reader.metadata()->schema()->Column(column);
+        CHECK_EQUAL(pDescr->name(), name);
+        CHECK_EQUAL((int)pDescr->physical_type(), (int)type);
+        CHECK_EQUAL((int)pDescr->logical_type(), (int)logicalType);
+    }
+
+    //建立结果数据库(表结构与ResultStore一致),按打乱的顺序插入rows
+    void createResultDb(vector<ResultRow> rows)
+    {
+        std::remove(RESULT_DB_PATH);
+        std::reverse(rows.begin(), rows.end());
+        std::rotate(rows.begin(), rows.begin() + rows.size() / 3, rows.end());
+
+        SqliteDB sqlite;
+        sqlite.open(RESULT_DB_PATH);
+        sqlite.execute("CREATE TABLE InspectionResult("
+                       "BoardSerial TEXT,ComponentId INTEGER,Timestamp INTEGER,Status INTEGER,"
+                       "Height REAL,Area REAL,Volume REAL,OffsetX REAL,OffsetY REAL);");
+        sqlite.begin();
+        sqlite.prepare("INSERT INTO InspectionResult VALUES(?,?,?,?,?,?,?,?,?);");
+        for (const ResultRow & row : rows)
+        {
+            sqlite.executeWithParms(row.boardSerial.data(), row.componentId, row.timestamp, row.status,
+                                    row.height, row.area, row.volume, row.offsetX, row.offsetY);
+        }
+        sqlite.commit();
+        sqlite.close();
+    }
+
+    //读取exportResults导出的文件
+    vector<ResultRow> readResults(const char * path)
+    {
+        unique_ptr<parquet::ParquetFileReader> pReader = parquet::ParquetFileReader::OpenFile(path);
+        vector<string> serials = readStringColumn(*pReader, 0);
+        vector<int64_t> componentIds = readColumn<parquet::Int64Reader, int64_t>(*pReader, 1);
+        vector<int64_t> timestamps = readColumn<parquet::Int64Reader, int64_t>(*pReader, 2);
+        vector<int> statuses = readColumn<parquet::Int32Reader, int>(*pReader, 3);
+        vector<vector<double>> doubles;
+        for (int column = 4; column < 9; ++column)
+        {
+            doubles.push_back(readColumn<parquet::DoubleReader, double>(*pReader, column));
+        }
+
+        const size_t rowCnt = (size_t)pReader->metadata()->num_rows();
+        CHECK_EQUAL(serials.size(), rowCnt);
+        CHECK_EQUAL(timestamps.size(), rowCnt);
+        CHECK_EQUAL(doubles[4].size(), rowCnt);
+
+        vector<ResultRow> rows(std::min(rowCnt, doubles[4].size()));
+        for (size_t i = 0; i < rows.size(); ++i)
+        {
+            rows[i] = ResultRow{serials[i], componentIds[i], timestamps[i], statuses[i],
+                                doubles[0][i], doubles[1][i], doubles[2][i], doubles[3][i], doubles[4][i]};
+        }
+        return rows;
+    }
+
+    bool sameResults(const vector<ResultRow> & actual, const vector<ResultRow> & expected)
+    {
+        if(actual.size() != expected.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < actual.size(); ++i)
+        {
+            const ResultRow & a = actual[i];
+            const ResultRow & b = expected[i];
+            if(a.boardSerial != b.boardSerial || a.componentId != b.componentId || a.timestamp != b.timestamp ||
+               a.status != b.status || a.height != b.height || a.area != b.area || a.volume != b.volume ||
+               a.offsetX != b.offsetX || a.offsetY != b.offsetY)
+            {
+                Test::fail(__FILE__, __LINE__, "row " + to_string(i) + " differs");
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//两个头文件的异常宏同时可用:THROW_EXCEPTION抛出SSDK::CustomException,SSDK的宏抛出SSDK::Exception::CustomException
+void testExceptionMacros()
+{
+    bool isCustomException = false;
+    try
+    {
+        THROW_EXCEPTION("sdk");
+    }
+    catch(const SSDK::CustomException &)
+    {
+        isCustomException = true;
+    }
+    CHECK(isCustomException);
+
+    bool isSsdkException = false;
+    try
+    {
+        THROW_EXCEPTION_WITHOUT_OBJ("ssdk");
+    }
+    catch(const std::exception &ex)
+    {
+        isSsdkException = nullptr != dynamic_cast<const SSDK::Exception::CustomException *>(&ex);
+    }
+    CHECK(isSsdkException);
+}
+
+//导出的元件与元件表一致,超过rowGroupSize时分为多个RowGroup
+void testExportComponentsRoundTrip()
+{
+    JobData job;
+    job.board.setName("board");
+    const int objCnt = 2500;
+    MeasuredObj * measuredObjArr = job.board.measuredObjPool().allocate(objCnt);
+    for (int i = 0; i < objCnt; ++i)
+    {
+        measuredObjArr[i].setId(3 * i + 7);
+        measuredObjArr[i].setName(0 == i % 7 ? "元件" + to_string(i) : "c" + to_string(i));
+        Rectangle rect(0.1 * i, 200.0 - 0.05 * i, 1.5 + i % 3, 0.75, 90.0 * (i % 4));
+        measuredObjArr[i].setRectangle(&rect);
+    }
+    job.list.append(measuredObjArr, measuredObjArr + objCnt);
+
+    ParquetExportSetting setting;
+    setting.rowGroupSize = 1000;
+    ParquetExporter exporter(setting);
+    std::remove(PARQUET_PATH);
+    CHECK_EQUAL(exporter.exportComponents(&job.board, PARQUET_PATH), (size_t)objCnt);
+    CHECK(!fileExists(string(PARQUET_PATH) + ".tmp"));
+
+    unique_ptr<parquet::ParquetFileReader> pReader = parquet::ParquetFileReader::OpenFile(PARQUET_PATH);
+    CHECK_EQUAL(pReader->metadata()->num_rows(), (int64_t)objCnt);
+    CHECK_EQUAL(pReader->metadata()->num_row_groups(), 3);
+    CHECK_EQUAL(pReader->metadata()->num_columns(), 7);
+    checkColumn(*pReader, 0, "Id", parquet::Type::INT64);
+    checkColumn(*pReader, 1, "Name", parquet::Type::BYTE_ARRAY, parquet::LogicalType::UTF8);
+    checkColumn(*pReader, 2, "PosX", parquet::Type::DOUBLE);
+    checkColumn(*pReader, 6, "Angle", parquet::Type::DOUBLE);
+
+    vector<int64_t> ids = readColumn<parquet::Int64Reader, int64_t>(*pReader, 0);
+    vector<string> names = readStringColumn(*pReader, 1);
+    vector<vector<double>> doubles;
+    for (int column = 2; column < 7; ++column)
+    {
+        doubles.push_back(readColumn<parquet::DoubleReader, double>(*pReader, column));
+    }
+    CHECK_EQUAL(ids.size(), (size_t)objCnt);
+    CHECK_EQUAL(names.size(), (size_t)objCnt);
+    CHECK_EQUAL(doubles[4].size(), (size_t)objCnt);
+
+    MeasuredObj * pObj = job.list.pHead();
+    for (size_t i = 0; i < ids.size() && i < names.size() && i < doubles[4].size() && nullptr != pObj;
+         ++i, pObj = pObj->pNextMeasuredObj())
+    {
+        const Rectangle & rect = pObj->rectangle();
+        if(ids[i] != pObj->id() || names[i] != pObj->name() ||
+           doubles[0][i] != rect.xPos() || doubles[1][i] != rect.yPos() ||
+           doubles[2][i] != rect.width() || doubles[3][i] != rect.height() || doubles[4][i] != rect.angle())
+        {
+            Test::fail(__FILE__, __LINE__, "component " + to_string(i) + " differs");
+            break;
+        }
+    }
+    pReader->Close();
+    std::remove(PARQUET_PATH);
+}
+
+//导出的检测结果按(BoardSerial,ComponentId,Timestamp)排序,指定基板时只导出该基板
+void testExportResultsRoundTrip()
+{
+    vector<ResultRow> rows;
+    for (int board = 0; board < 3; ++board)
+    {
+        for (int i = 0; i < 900; ++i)
+        {
+            rows.push_back(ResultRow{"SN000" + to_string(board), i % 300 + 1, 1700000000000LL + i, i % 5,
+                                     0.01 * i, 0.5 * board, i * 1e-3, -0.25 * (i % 4), 1.0 / (i + 1)});
+        }
+    }
+    createResultDb(rows);
+    std::sort(rows.begin(), rows.end());
+
+    SqliteDB sqlite;
+    sqlite.open(RESULT_DB_PATH);
+    ParquetExportSetting setting;
+    setting.rowGroupSize = 1000;
+    ParquetExporter exporter(setting);
+
+    //所有基板
+    CHECK_EQUAL(exporter.exportResults(&sqlite, "", PARQUET_PATH), rows.size());
+    {
+        unique_ptr<parquet::ParquetFileReader> pReader = parquet::ParquetFileReader::OpenFile(PARQUET_PATH);
+        CHECK_EQUAL(pReader->metadata()->num_row_groups(), 3);
+        checkColumn(*pReader, 0, "BoardSerial", parquet::Type::BYTE_ARRAY, parquet::LogicalType::UTF8);
+        checkColumn(*pReader, 2, "Timestamp", parquet::Type::INT64, parquet::LogicalType::TIMESTAMP_MILLIS);
+        checkColumn(*pReader, 3, "Status", parquet::Type::INT32);
+        checkColumn(*pReader, 8, "OffsetY", parquet::Type::DOUBLE);
+    }
+    CHECK(sameResults(readResults(PARQUET_PATH), rows));
+
+    //一块基板(900行,一个RowGroup不满)
+    vector<ResultRow> boardRows;
+    std::copy_if(rows.begin(), rows.end(), std::back_inserter(boardRows),
+                 [](const ResultRow & row){return "SN0001" == row.boardSerial;});
+    CHECK_EQUAL(exporter.exportResults(&sqlite, "SN0001", PARQUET_PATH), boardRows.size());
+    CHECK(sameResults(readResults(PARQUET_PATH), boardRows));
+
+    //没有结果的基板导出空文件
+    CHECK_EQUAL(exporter.exportResults(&sqlite, "SN9999", PARQUET_PATH), (size_t)0);
+    CHECK(readResults(PARQUET_PATH).empty());
+
+    sqlite.close();
+    std::remove(PARQUET_PATH);
+    std::remove(RESULT_DB_PATH);
+}
+
+//导出失败时抛出异常,不留下临时文件,已有的目标文件不变
+void testExportFailure()
+{
+    JobData job;
+    MeasuredObj * measuredObjArr = job.board.measuredObjPool().allocate(1);
+    measuredObjArr[0].setId(1);
+    measuredObjArr[0].setName("c0");
+    Rectangle rect(1, 1, 1, 1, 0);
+    measuredObjArr[0].setRectangle(&rect);
+    job.list.append(measuredObjArr, measuredObjArr + 1);
+
+    ParquetExporter exporter;
+    CHECK_THROWS(exporter.exportComponents(&job.board, "no_such_dir/tst_parquetexporter.parquet"));
+    CHECK(!fileExists("no_such_dir/tst_parquetexporter.parquet.tmp"));
+
+    ParquetExportSetting lzo;
+    lzo.codec = parquet::Compression::LZO;
+    ParquetExporter lzoExporter(lzo);
+    {
+        ofstream existing(PARQUET_PATH);
+        existing << "old";
+    }
+    CHECK_THROWS(lzoExporter.exportComponents(&job.board, PARQUET_PATH));
+    CHECK(!fileExists(string(PARQUET_PATH) + ".tmp"));
+    string content;
+    ifstream(PARQUET_PATH) >> content;
+    CHECK_EQUAL(content, string("old"));
+    std::remove(PARQUET_PATH);
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    RUN_TEST(testExceptionMacros);
+    RUN_TEST(testExportComponentsRoundTrip);
+    RUN_TEST(testExportResultsRoundTrip);
+    RUN_TEST(testExportFailure);
+    return Test::result();
+}
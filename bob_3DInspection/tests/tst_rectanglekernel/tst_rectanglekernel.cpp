@@ -0,0 +1,357 @@
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <algorithm>
+#include <vector>
+
+#include "testcase.hpp"
+#include "sdk/rectanglekernel.hpp"
+
+using namespace std;
+using namespace SSDK;
+
+namespace
+{
+    const long double PI = 3.14159265358979323846264338327950288L;
+
+    //列式存储的一组矩形
+    struct Rects
+    {
+        vector<double> xPos, yPos, width, height, angle;
+
+        RectangleArray array() const
+        {
+            RectangleArray rects;
+            rects.xPos = this->xPos.data();
+            rects.yPos = this->yPos.data();
+            rects.width = this->width.data();
+            rects.height = this->height.data();
+            rects.angle = this->angle.data();
+            rects.size = (int)this->xPos.size();
+            return rects;
+        }
+
+        Rectangle at(int i) const
+        {
+            return Rectangle(this->xPos[i], this->yPos[i], this->width[i], this->height[i], this->angle[i]);
+        }
+    };
+
+    //随机生成cnt个矩形,角度包括任意值,90度的整数倍,45度及象限边界附近的值
+    Rects randomRects(int cnt, unsigned seed)
+    {
+        mt19937 engine(seed);
+        uniform_real_distribution<double> pos(-50, 50);
+        uniform_real_distribution<double> size(0.1, 20);
+        uniform_real_distribution<double> angle(-720, 720);
+        const double specialAngles[] = {0, 90, -90, 180, 270, 360, 45, -45, 44.999999999, 45.000000001, 135, -0.0};
+
+        Rects rects;
+        for (int i = 0; i < cnt; ++i)
+        {
+            rects.xPos.push_back(pos(engine));
+            rects.yPos.push_back(pos(engine));
+            rects.width.push_back(size(engine));
+            rects.height.push_back(size(engine));
+            rects.angle.push_back(0 == i % 3 ? specialAngles[(i / 3) % 12] : angle(engine));
+        }
+        return rects;
+    }
+
+    //两组double逐位相同
+    bool sameBits(const vector<double> & a, const vector<double> & b)
+    {
+        return a.size() == b.size() && 0 == std::memcmp(a.data(), b.data(), a.size() * sizeof(double));
+    }
+
+    //需要与标量结果对比的指令集(CPU不支持的跳过)
+    vector<RectangleKernel::Isa> simdIsas()
+    {
+        vector<RectangleKernel::Isa> isas;
+        for (RectangleKernel::Isa isa : {RectangleKernel::SSE2, RectangleKernel::AVX2})
+        {
+            if(isa <= RectangleKernel::supportedIsa())
+            {
+                isas.push_back(isa);
+            }
+        }
+        return isas;
+    }
+
+    //覆盖整组,尾部及空数组
+    const int SIZES[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 63, 64, 65, 1001};
+}
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//标量实现与long double的cosl/sinl及已知结果对比,误差不超过1ulp(double的角度转弧度本身有舍入误差,不能作为参考)
+void testSinCosMatchesStd()
+{
+    for (int i = -7200; i <= 7200; ++i)
+    {
+        double angle = i * 0.1 + 0.0123;
+        double c = 0, s = 0;
+        RectangleKernel::sinCos(angle, c, s);
+        long double radian = angle * PI / 180;
+        CHECK_NEAR(c, (double)cosl(radian), 2.3e-16);
+        CHECK_NEAR(s, (double)sinl(radian), 2.3e-16);
+    }
+
+    //90度的整数倍为精确值
+    const double expected[][3] = {{0, 1, 0}, {90, 0, 1}, {180, -1, 0}, {270, 0, -1}, {-90, 0, -1}, {450, 0, 1}};
+    for (const auto & item : expected)
+    {
+        double c = 0, s = 0;
+        RectangleKernel::sinCos(item[0], c, s);
+        CHECK_EQUAL(c, item[1]);
+        CHECK_EQUAL(s, item[2]);
+    }
+}
+
+void testScalarGeometry()
+{
+    //45度的正方形(菱形),外接矩形的半宽为边长/sqrt(2)
+    Rectangle diamond(10, 20, 2, 2, 45);
+    double minX = 0, minY = 0, maxX = 0, maxY = 0;
+    RectangleKernel::bounds(diamond, minX, minY, maxX, maxY);
+    CHECK_NEAR(maxX - minX, 2 * std::sqrt(2.0), 1e-12);
+    CHECK_NEAR(maxY - minY, 2 * std::sqrt(2.0), 1e-12);
+    CHECK_NEAR(minX, 10 - std::sqrt(2.0), 1e-12);
+
+    //菱形包含中心及顶点附近的点,不包含外接矩形的角
+    CHECK(RectangleKernel::contains(diamond, 10, 20));
+    CHECK(RectangleKernel::contains(diamond, 10 + 1.41, 20));
+    CHECK(!RectangleKernel::contains(diamond, 10 + 1.0, 20 + 1.0));
+
+    //旋转90度后宽高互换
+    Rectangle tall(0, 0, 10, 2, 90);
+    CHECK(RectangleKernel::contains(tall, 0, 4.9));
+    CHECK(!RectangleKernel::contains(tall, 4.9, 0));
+
+    //分离轴定理: 外接矩形重叠但矩形本身不重叠
+    Rectangle a(0, 0, 2, 2, 45);
+    Rectangle b(1.9, 1.9, 2, 2, 45);
+    CHECK(!RectangleKernel::overlaps(a, b));
+    CHECK(RectangleKernel::overlaps(a, Rectangle(1.4, 0, 2, 2, 45)));
+    CHECK(RectangleKernel::overlaps(Rectangle(0, 0, 2, 2, 0), Rectangle(2, 0, 2, 2, 0)));   //边界接触
+    CHECK(!RectangleKernel::overlaps(Rectangle(0, 0, 2, 2, 0), Rectangle(2.001, 0, 2, 2, 0)));
+}
+
+//批量运算的标量结果与单个矩形的运算一致
+void testBatchMatchesSingle()
+{
+    Rects rects = randomRects(257, 1);
+    RectangleArray array = rects.array();
+    const int n = array.size;
+
+    vector<double> minX(n), minY(n), maxX(n), maxY(n);
+    RectangleKernel::bounds(array, minX.data(), minY.data(), maxX.data(), maxY.data(), RectangleKernel::SCALAR);
+
+    vector<unsigned char> inside(n), overlap(n);
+    RectangleKernel::contains(array, 3.5, -2.5, inside.data(), RectangleKernel::SCALAR);
+    Rectangle probe(0, 0, 30, 10, 30);
+    RectangleKernel::overlaps(probe, array, overlap.data(), RectangleKernel::SCALAR);
+
+    for (int i = 0; i < n; ++i)
+    {
+        double x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+        RectangleKernel::bounds(rects.at(i), x0, y0, x1, y1);
+        CHECK_NEAR(minX[i], x0, 1e-12);
+        CHECK_NEAR(maxY[i], y1, 1e-12);
+        CHECK_EQUAL(inside[i] != 0, RectangleKernel::contains(rects.at(i), 3.5, -2.5));
+        CHECK_EQUAL(overlap[i] != 0, RectangleKernel::overlaps(probe, rects.at(i)));
+    }
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//SIMD实现与标量实现逐位一致
+void testCornersSimdMatchesScalar()
+{
+    for (RectangleKernel::Isa isa : simdIsas())
+    {
+        for (int size : SIZES)
+        {
+            Rects rects = randomRects(size, 100 + size);
+            vector<double> refX(4 * size), refY(4 * size), x(4 * size), y(4 * size);
+            RectangleKernel::corners(rects.array(), refX.data(), refY.data(), RectangleKernel::SCALAR);
+            RectangleKernel::corners(rects.array(), x.data(), y.data(), isa);
+            CHECK(sameBits(refX, x));
+            CHECK(sameBits(refY, y));
+        }
+    }
+}
+
+void testBoundsSimdMatchesScalar()
+{
+    for (RectangleKernel::Isa isa : simdIsas())
+    {
+        for (int size : SIZES)
+        {
+            Rects rects = randomRects(size, 200 + size);
+            vector<double> ref[4], out[4];
+            for (int k = 0; k < 4; ++k)
+            {
+                ref[k].resize(size);
+                out[k].resize(size);
+            }
+            RectangleKernel::bounds(rects.array(), ref[0].data(), ref[1].data(), ref[2].data(), ref[3].data(), RectangleKernel::SCALAR);
+            RectangleKernel::bounds(rects.array(), out[0].data(), out[1].data(), out[2].data(), out[3].data(), isa);
+            for (int k = 0; k < 4; ++k)
+            {
+                CHECK(sameBits(ref[k], out[k]));
+            }
+
+            double refBox[4] = {0}, box[4] = {0};
+            bool refValid = RectangleKernel::unionBounds(rects.array(), refBox[0], refBox[1], refBox[2], refBox[3], RectangleKernel::SCALAR);
+            bool valid = RectangleKernel::unionBounds(rects.array(), box[0], box[1], box[2], box[3], isa);
+            CHECK_EQUAL(valid, refValid);
+            CHECK_EQUAL(valid, size > 0);
+            if(valid)
+            {
+                CHECK(0 == std::memcmp(refBox, box, sizeof(box)));
+            }
+        }
+    }
+}
+
+void testContainsSimdMatchesScalar()
+{
+    mt19937 engine(7);
+    uniform_real_distribution<double> pos(-60, 60);
+    for (RectangleKernel::Isa isa : simdIsas())
+    {
+        for (int size : SIZES)
+        {
+            Rects rects = randomRects(size, 300 + size);
+            for (int trial = 0; trial < 20; ++trial)
+            {
+                //一半的点取矩形的中心,保证有命中
+                double x = 0 == trial % 2 || 0 == size ? pos(engine) : rects.xPos[trial % size];
+                double y = 0 == trial % 2 || 0 == size ? pos(engine) : rects.yPos[trial % size];
+                vector<unsigned char> ref(size), out(size);
+                RectangleKernel::contains(rects.array(), x, y, ref.data(), RectangleKernel::SCALAR);
+                RectangleKernel::contains(rects.array(), x, y, out.data(), isa);
+                CHECK(ref == out);
+            }
+        }
+    }
+}
+
+void testOverlapsSimdMatchesScalar()
+{
+    for (RectangleKernel::Isa isa : simdIsas())
+    {
+        for (int size : SIZES)
+        {
+            Rects a = randomRects(size, 400 + size);
+            Rects b = randomRects(size, 500 + size);
+            vector<unsigned char> ref(size), out(size);
+            RectangleKernel::overlaps(a.array(), b.array(), ref.data(), RectangleKernel::SCALAR);
+            RectangleKernel::overlaps(a.array(), b.array(), out.data(), isa);
+            CHECK(ref == out);
+
+            Rectangle probe(5, -5, 40, 25, 33);
+            RectangleKernel::overlaps(probe, a.array(), ref.data(), RectangleKernel::SCALAR);
+            RectangleKernel::overlaps(probe, a.array(), out.data(), isa);
+            CHECK(ref == out);
+        }
+    }
+
+    //数量不一致时抛出异常
+    Rects a = randomRects(4, 1), b = randomRects(5, 2);
+    vector<unsigned char> out(5);
+    CHECK_THROWS(RectangleKernel::overlaps(a.array(), b.array(), out.data()));
+}
+
+void testTransformSimdMatchesScalar()
+{
+    AffineTransform transform(std::cos(0.01), -std::sin(0.01), std::sin(0.01), std::cos(0.01), 1.25, -0.75);
+    for (RectangleKernel::Isa isa : simdIsas())
+    {
+        for (int size : SIZES)
+        {
+            Rects rects = randomRects(size, 600 + size);
+            vector<double> ref[3], out[3];
+            for (int k = 0; k < 3; ++k)
+            {
+                ref[k].resize(size);
+                out[k].resize(size);
+            }
+            RectangleKernel::transform(rects.array(), transform, ref[0].data(), ref[1].data(), ref[2].data(), RectangleKernel::SCALAR);
+            RectangleKernel::transform(rects.array(), transform, out[0].data(), out[1].data(), out[2].data(), isa);
+            for (int k = 0; k < 3; ++k)
+            {
+                CHECK(sameBits(ref[k], out[k]));
+            }
+        }
+    }
+}
+
+//边界接触的矩形及边界上的点,比较时必须包含等号
+void testTouchingSimdMatchesScalar()
+{
+    const int size = 37;
+    Rects a, b;
+    for (int i = 0; i < size; ++i)
+    {
+        //b与a在X方向恰好接触,角度为90度的整数倍时正余弦是精确值
+        a.xPos.push_back(4.0 * i);
+        a.yPos.push_back(1.0);
+        a.width.push_back(2.0);
+        a.height.push_back(2.0);
+        a.angle.push_back(90.0 * (i % 4));
+        b.xPos.push_back(4.0 * i + 2.0);
+        b.yPos.push_back(1.0);
+        b.width.push_back(2.0);
+        b.height.push_back(2.0);
+        b.angle.push_back(90.0 * ((i + 1) % 4));
+    }
+
+    vector<RectangleKernel::Isa> isas = simdIsas();
+    isas.insert(isas.begin(), RectangleKernel::SCALAR);
+    for (RectangleKernel::Isa isa : isas)
+    {
+        vector<unsigned char> overlap(size), inside(size);
+        RectangleKernel::overlaps(a.array(), b.array(), overlap.data(), isa);
+        CHECK(vector<unsigned char>(size, 1) == overlap);
+
+        //(1,0)在第0个矩形的右边界上
+        RectangleKernel::contains(a.array(), 1.0, 0.0, inside.data(), isa);
+        CHECK_EQUAL(inside[0], 1);
+        CHECK_EQUAL(std::count(inside.begin(), inside.end(), 1), 1);
+    }
+}
+
+//指定的指令集超过CPU支持时降级,结果不变
+void testIsaFallback()
+{
+    CHECK(RectangleKernel::supportedIsa() <= RectangleKernel::compiledIsa());
+
+    Rects rects = randomRects(33, 9);
+    vector<double> refX(4 * 33), refY(4 * 33), x(4 * 33), y(4 * 33);
+    RectangleKernel::corners(rects.array(), refX.data(), refY.data(), RectangleKernel::supportedIsa());
+    RectangleKernel::corners(rects.array(), x.data(), y.data(), RectangleKernel::AVX2);
+    CHECK(sameBits(refX, x));
+    CHECK(sameBits(refY, y));
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    const char * isaNames[] = {"SCALAR", "SSE2", "AVX2"};
+    printf("compiled isa: %s, supported isa: %s\n",
+           isaNames[RectangleKernel::compiledIsa()], isaNames[RectangleKernel::supportedIsa()]);
+
+    RUN_TEST(testSinCosMatchesStd);
+    RUN_TEST(testScalarGeometry);
+    RUN_TEST(testBatchMatchesSingle);
+    RUN_TEST(testCornersSimdMatchesScalar);
+    RUN_TEST(testBoundsSimdMatchesScalar);
+    RUN_TEST(testContainsSimdMatchesScalar);
+    RUN_TEST(testOverlapsSimdMatchesScalar);
+    RUN_TEST(testTransformSimdMatchesScalar);
+    RUN_TEST(testTouchingSimdMatchesScalar);
+    RUN_TEST(testIsaFallback);
+
+    return Test::result();
+}
@@ -0,0 +1,295 @@
+#include <cstdio>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "testcase.hpp"
+#include "job/resultstore.hpp"
+
+using namespace std;
+using namespace Job;
+using namespace SSDK::DB;
+
+namespace
+{
+    const char * DB_PATH = "tst_resultstore.db";
+
+    void removeDb()
+    {
+        std::remove(DB_PATH);
+        std::remove((string(DB_PATH) + "-wal").c_str());
+        std::remove((string(DB_PATH) + "-shm").c_str());
+    }
+
+    InspectionResult makeResult(int64_t componentId)
+    {
+        InspectionResult result;
+        ResultStore::setBoardSerial(result, "SN0001");
+        result.componentId = componentId;
+        result.timestamp = ResultStore::currentTimestamp();
+        result.status = 0;
+        result.height = 0.1;
+        result.area = 0.2;
+        result.volume = 0.3;
+        result.offsetX = 0.4;
+        result.offsetY = 0.5;
+        return result;
+    }
+
+    //数据库中的结果数量
+    int rowCount(SqliteConnectionPool & pool)
+    {
+        SqliteConnectionPool::WriteGuard writer = pool.writer();
+        string sql = "SELECT COUNT(*) FROM InspectionResult";
+        writer->prepare(sql);
+        return writer->executeScalar<int>(sql);
+    }
+
+    //结果表被删除时提交失败(再构造一个ResultStore会重新建表)
+    void dropResultTable(SqliteConnectionPool & pool)
+    {
+        SqliteConnectionPool::WriteGuard writer = pool.writer();
+        writer->execute("DROP TABLE InspectionResult;");
+    }
+}
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//未start及stop之后push/tryPush返回false,不计入pushed;运行期间放入的结果全部写入
+void testPushRequiresRunning()
+{
+    removeDb();
+    SqliteConnectionPool pool(DB_PATH);
+    ResultStoreSetting setting;
+    setting.queueCapacity = 4;
+    ResultStore store(&pool, setting);
+
+    //未start:队列满了也不等待
+    for (int i = 0; i < 10; ++i)
+    {
+        CHECK(!store.push(makeResult(i)));
+    }
+    CHECK(!store.tryPush(makeResult(0)));
+
+    store.start();
+    for (int i = 0; i < 100; ++i)
+    {
+        CHECK(store.push(makeResult(i)));
+    }
+    store.flush();
+    CHECK_EQUAL(store.metrics().written, 100u);
+
+    store.stop();
+    CHECK(!store.push(makeResult(0)));
+    CHECK(!store.tryPush(makeResult(0)));
+
+    ResultStoreMetrics metrics = store.metrics();
+    CHECK_EQUAL(metrics.pushed, 100u);
+    CHECK_EQUAL(metrics.written, 100u);
+    CHECK_EQUAL(metrics.rejected, 13u);
+    CHECK_EQUAL(rowCount(pool), 100);
+}
+
+//写线程阻塞时队列满,push最多等待pushTimeoutMs后返回false;写线程恢复后已放入的结果全部写入
+void testPushTimesOutWhenFull()
+{
+    removeDb();
+    SqliteConnectionPool pool(DB_PATH);
+    ResultStoreSetting setting;
+    setting.queueCapacity = 4;
+    setting.groupSize = 2;
+    setting.pushTimeoutMs = 50;
+    ResultStore store(&pool, setting);
+    store.start();
+
+    int accepted = 0;
+    bool timedOut = false;
+    {
+        //持有写连接,写线程在提交第一组时等待
+        SqliteConnectionPool::WriteGuard writer = pool.writer();
+        for (int i = 0; i < 100 && !timedOut; ++i)
+        {
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            if(store.push(makeResult(i)))
+            {
+                ++accepted;
+                continue;
+            }
+            timedOut = true;
+            double waitedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            CHECK(waitedMs >= 45);
+            CHECK(waitedMs < 1000);
+        }
+    }
+    CHECK(timedOut);
+    CHECK(accepted > 0);
+
+    store.flush();
+    ResultStoreMetrics metrics = store.metrics();
+    CHECK_EQUAL(metrics.pushed, (uint64_t)accepted);
+    CHECK_EQUAL(metrics.written, (uint64_t)accepted);
+    CHECK_EQUAL(metrics.rejected, 1u);
+    CHECK(metrics.queueFullCount >= 1);
+    store.stop();
+    CHECK_EQUAL(rowCount(pool), accepted);
+}
+
+//提交失败的一组结果被保留并重试,数据库恢复后写入
+void testRetriesFailedGroup()
+{
+    removeDb();
+    SqliteConnectionPool pool(DB_PATH);
+    ResultStoreSetting setting;
+    setting.maxRetries = 1000;
+    setting.retryIntervalMs = 5;
+    ResultStore store(&pool, setting);
+    store.start();
+
+    dropResultTable(pool);
+    for (int i = 0; i < 3; ++i)
+    {
+        CHECK(store.push(makeResult(i)));
+    }
+
+    //等到至少重试一次后再恢复结果表
+    for (int i = 0; i < 2000 && 0 == store.metrics().retries; ++i)
+    {
+        std::this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    CHECK(store.metrics().retries >= 1);
+    ResultStore recreate(&pool);
+
+    store.flush();
+    ResultStoreMetrics metrics = store.metrics();
+    CHECK_EQUAL(metrics.written, 3u);
+    CHECK_EQUAL(metrics.failed, 0u);
+    CHECK(store.takeUnwritten().empty());
+    store.stop();
+    CHECK_EQUAL(rowCount(pool), 3);
+}
+
+//重试maxRetries次仍失败的结果移入未写入的结果,取出后可以重新放入
+void testKeepsUnwrittenAfterRetries()
+{
+    removeDb();
+    SqliteConnectionPool pool(DB_PATH);
+    ResultStoreSetting setting;
+    setting.maxRetries = 2;
+    setting.retryIntervalMs = 1;
+    ResultStore store(&pool, setting);
+    store.start();
+
+    dropResultTable(pool);
+    for (int i = 0; i < 5; ++i)
+    {
+        CHECK(store.push(makeResult(i)));
+    }
+    store.flush();
+
+    ResultStoreMetrics metrics = store.metrics();
+    CHECK_EQUAL(metrics.written, 0u);
+    CHECK_EQUAL(metrics.failed, 5u);
+    CHECK_EQUAL(metrics.retries, 2u);
+
+    vector<InspectionResult> unwritten = store.takeUnwritten();
+    CHECK_EQUAL(unwritten.size(), 5u);
+    CHECK(store.takeUnwritten().empty());
+    for (size_t i = 0; i < unwritten.size(); ++i)
+    {
+        CHECK_EQUAL(unwritten[i].componentId, (int64_t)i);
+    }
+
+    ResultStore recreate(&pool);
+    for (size_t i = 0; i < unwritten.size(); ++i)
+    {
+        CHECK(store.push(unwritten[i]));
+    }
+    store.flush();
+    CHECK_EQUAL(store.metrics().written, 5u);
+    store.stop();
+    CHECK_EQUAL(rowCount(pool), 5);
+}
+
+//多个线程push时stop:每个被接受的结果都写入,stop之后的push都被拒绝
+void testStopWhilePushing()
+{
+    removeDb();
+    SqliteConnectionPool pool(DB_PATH);
+    ResultStoreSetting setting;
+    setting.queueCapacity = 256;
+    setting.groupSize = 64;
+    ResultStore store(&pool, setting);
+    store.start();
+
+    const int threadCnt = 4;
+    vector<int> accepted(threadCnt, 0);
+    vector<thread> threads;
+    for (int t = 0; t < threadCnt; ++t)
+    {
+        threads.push_back(thread([&store, &accepted, t]()
+        {
+            for (int i = 0; i < 1000000; ++i)
+            {
+                if(!store.push(makeResult(t * 1000000 + i)))
+                {
+                    break;
+                }
+                ++accepted[t];
+            }
+        }));
+    }
+    std::this_thread::sleep_for(chrono::milliseconds(50));
+    store.stop();
+    for (size_t t = 0; t < threads.size(); ++t)
+    {
+        threads[t].join();
+    }
+
+    uint64_t total = 0;
+    for (int t = 0; t < threadCnt; ++t)
+    {
+        total += accepted[t];
+    }
+    ResultStoreMetrics metrics = store.metrics();
+    CHECK(total > 0);
+    CHECK_EQUAL(metrics.pushed, total);
+    CHECK_EQUAL(metrics.written, total);
+    CHECK_EQUAL(metrics.rejected, (uint64_t)threadCnt);
+    CHECK_EQUAL((uint64_t)rowCount(pool), total);
+}
+
+//空闲时写线程在条件变量上等待,push唤醒后按groupIntervalMs提交
+void testIdleWriterWakesOnPush()
+{
+    removeDb();
+    SqliteConnectionPool pool(DB_PATH);
+    ResultStoreSetting setting;
+    setting.groupIntervalMs = 20;
+    ResultStore store(&pool, setting);
+    store.start();
+
+    std::this_thread::sleep_for(chrono::milliseconds(50));
+    CHECK_EQUAL(store.metrics().groups, 0u);
+
+    CHECK(store.push(makeResult(1)));
+    for (int i = 0; i < 2000 && 0 == store.metrics().written; ++i)
+    {
+        std::this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    CHECK_EQUAL(store.metrics().written, 1u);
+    CHECK_EQUAL(store.metrics().groups, 1u);
+    store.stop();
+    removeDb();
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    RUN_TEST(testPushRequiresRunning);
+    RUN_TEST(testPushTimesOutWhenFull);
+    RUN_TEST(testRetriesFailedGroup);
+    RUN_TEST(testKeepsUnwrittenAfterRetries);
+    RUN_TEST(testStopWhilePushing);
+    RUN_TEST(testIdleWriterWakesOnPush);
+    return Test::result();
+}
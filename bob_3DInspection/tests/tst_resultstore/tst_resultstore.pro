@@ -0,0 +1,12 @@
+include(../test.pri)
+
+TARGET = tst_resultstore
+
+SOURCES += \
+    tst_resultstore.cpp \
+    $$SRC_DIR/sdk/customexception.cpp \
+    $$SRC_DIR/sdk/DB/blob.cpp \
+    $$SRC_DIR/sdk/DB/sqlitedb.cpp \
+    $$SRC_DIR/sdk/DB/statement.cpp \
+    $$SRC_DIR/sdk/DB/sqliteconnectionpool.cpp \
+    $$SRC_DIR/job/resultstore.cpp
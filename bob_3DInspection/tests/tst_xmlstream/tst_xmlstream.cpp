@@ -0,0 +1,273 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "testcase.hpp"
+#include "sdk/xmlstreamwriter.hpp"
+#include "sdk/xmlstreamreader.hpp"
+#include "sdk/formatconvertion.hpp"
+#include "sdk/DB/rowreader.hpp"
+#include "job/xmljobimporter.hpp"
+
+using namespace std;
+using namespace SSDK;
+using namespace SSDK::DB;
+using namespace Job;
+
+namespace
+{
+    const char * XML_PATH = "tst_xmlstream.xml";
+    const char * JOB_PATH = "tst_xmlstream.db";
+
+    //检测程式数据:InspectionData -> Board -> MeasuredObjList
+    struct JobData
+    {
+        MeasuredObjList<MeasuredObj> list;
+        Board board;
+        InspectionData inspectionData;
+
+        JobData()
+        {
+            this->board.setMeasurdObjList(&this->list);
+            this->inspectionData.setBoard(&this->board);
+        }
+    };
+
+    //读取下一个记号并检查类型及元素名称
+    void expectToken(XmlStreamReader & reader, XmlStreamReader::TOKEN_TYPE type, const string & name)
+    {
+        CHECK_EQUAL(reader.readNext(), type);
+        CHECK_EQUAL(reader.name(), name);
+    }
+
+    string attributeOf(const XmlStreamReader & reader, const string & name)
+    {
+        const string * pValue = reader.attribute(name);
+        CHECK(nullptr != pValue);
+        return nullptr != pValue ? *pValue : string();
+    }
+}
+
+//>>>----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//需要转义的字符,中文属性名及数值写入后读回与原值相同
+void testAttributesRoundTrip()
+{
+    const string special = "a&b<c>d\"e'f\ng\rh\ti &amp; 检测";
+    const double numbers[] = {0.1, -1234.5678, 1e-7, 123456789.123, 5e-324};
+    {
+        XmlStreamWriter writer;
+        writer.open(XML_PATH);
+        writer.writeStartElement("Job");
+        writer.writeAttribute("版本号", "V2");
+        writer.writeAttribute("special", special);
+        writer.writeAttribute("empty", "");
+        for (size_t i = 0; i < sizeof(numbers) / sizeof(numbers[0]); ++i)
+        {
+            writer.writeAttribute("n" + to_string(i), numbers[i], 17);
+            writer.writeAttribute("g" + to_string(i), numbers[i]);
+        }
+        writer.close();
+    }
+
+    XmlStreamReader reader;
+    reader.open(XML_PATH);
+    expectToken(reader, XmlStreamReader::START_ELEMENT, "Job");
+    CHECK_EQUAL(reader.depth(), 1);
+    CHECK_EQUAL(attributeOf(reader, "版本号"), string("V2"));
+    CHECK_EQUAL(attributeOf(reader, "special"), special);
+    CHECK_EQUAL(attributeOf(reader, "empty"), string());
+    CHECK(nullptr == reader.attribute("missing"));
+    for (size_t i = 0; i < sizeof(numbers) / sizeof(numbers[0]); ++i)
+    {
+        double value = 0;
+        CHECK(FormatConvertion::charsToDouble(attributeOf(reader, "n" + to_string(i)).c_str(), value));
+        CHECK_EQUAL(value, numbers[i]);
+
+        char expected[64];
+        std::snprintf(expected, sizeof(expected), "%.6g", numbers[i]);
+        CHECK_EQUAL(attributeOf(reader, "g" + to_string(i)), string(expected));
+    }
+    expectToken(reader, XmlStreamReader::END_ELEMENT, "Job");
+    CHECK_EQUAL(reader.readNext(), XmlStreamReader::END_DOCUMENT);
+    reader.close();
+    std::remove(XML_PATH);
+}
+
+//嵌套元素,空元素及skipCurrentElement,close关闭所有未结束的元素
+void testNestedElements()
+{
+    {
+        XmlStreamWriter writer;
+        writer.open(XML_PATH);
+        writer.writeStartElement("Job");
+        writer.writeStartElement("Board");
+        writer.writeAttribute("Name", "b");
+        writer.writeStartElement("Skipped");
+        writer.writeStartElement("Deep");
+        writer.writeEndElement();
+        writer.writeEndElement();
+        writer.writeStartElement("Empty");
+        writer.writeEndElement();
+        writer.close();
+    }
+
+    XmlStreamReader reader;
+    reader.open(XML_PATH);
+    expectToken(reader, XmlStreamReader::START_ELEMENT, "Job");
+    expectToken(reader, XmlStreamReader::START_ELEMENT, "Board");
+    CHECK_EQUAL(reader.depth(), 2);
+    CHECK_EQUAL(attributeOf(reader, "Name"), string("b"));
+    expectToken(reader, XmlStreamReader::START_ELEMENT, "Skipped");
+    reader.skipCurrentElement();
+    CHECK_EQUAL(reader.tokenType(), XmlStreamReader::END_ELEMENT);
+    CHECK_EQUAL(reader.name(), string("Skipped"));
+    expectToken(reader, XmlStreamReader::START_ELEMENT, "Empty");
+    CHECK_EQUAL(reader.attributeCount(), 0);
+    expectToken(reader, XmlStreamReader::END_ELEMENT, "Empty");
+    expectToken(reader, XmlStreamReader::END_ELEMENT, "Board");
+    expectToken(reader, XmlStreamReader::END_ELEMENT, "Job");
+    CHECK_EQUAL(reader.readNext(), XmlStreamReader::END_DOCUMENT);
+    reader.close();
+    std::remove(XML_PATH);
+}
+
+//writeChunked并行写入的大量子元素(超过读写缓冲区的大小)按顺序读回
+void testChunkedRoundTrip()
+{
+    const size_t count = 60000;
+    {
+        XmlStreamWriter writer;
+        writer.open(XML_PATH);
+        writer.writeStartElement("List");
+        writer.writeChunked(ChunkedWriter(4, 1000), count, [](XmlStreamWriter & fragment, size_t index)
+        {
+            fragment.writeStartElement("Item");
+            fragment.writeAttribute("Index", to_string(index));
+            fragment.writeAttribute("Value", index * 0.25, 17);
+            if(0 == index % 1000)
+            {
+                fragment.writeStartElement("Child");
+                fragment.writeEndElement();
+            }
+            fragment.writeEndElement();
+        });
+        writer.writeEndElement();
+        writer.close();
+    }
+
+    XmlStreamReader reader;
+    reader.open(XML_PATH);
+    expectToken(reader, XmlStreamReader::START_ELEMENT, "List");
+    size_t index = 0;
+    int failures = 0;
+    while(XmlStreamReader::START_ELEMENT == reader.readNext())
+    {
+        double value = 0;
+        bool ok = "Item" == reader.name() && 2 == reader.depth() &&
+                  to_string(index) == attributeOf(reader, "Index") &&
+                  FormatConvertion::charsToDouble(attributeOf(reader, "Value").c_str(), value) &&
+                  value == index * 0.25;
+        if(!ok && failures++ < 10)
+        {
+            CHECK(ok);
+        }
+        reader.skipCurrentElement();
+        ++index;
+    }
+    CHECK_EQUAL(index, count);
+    CHECK_EQUAL(reader.name(), string("List"));
+    CHECK_EQUAL(reader.readNext(), XmlStreamReader::END_DOCUMENT);
+    reader.close();
+    std::remove(XML_PATH);
+}
+
+//writeInspectionDataToXml导出的xml经XmlJobImporter导入,检测程式及内存中的检测对象与导出前一致
+void testJobRoundTrip()
+{
+    JobData source;
+    source.inspectionData.setVersion("V2");
+    source.inspectionData.setLastEditingTime("2026-10-17 12:00:00");
+    source.board.setName("board");
+    source.board.setOriginalX(0.5);
+    source.board.setOriginalY(0.25);
+    source.board.setSizeX(300);
+    source.board.setSizeY(200);
+    const int objCnt = 5000;
+    MeasuredObj * measuredObjArr = source.board.measuredObjPool().allocate(objCnt);
+    for (int i = 0; i < objCnt; ++i)
+    {
+        measuredObjArr[i].setId(i + 1);
+        measuredObjArr[i].setName("c" + to_string(i));
+        Rectangle rect(0.5 * (i % 500), 0.25 * (i / 500), 1.5, 0.75, 90.0 * (i % 4));
+        measuredObjArr[i].setRectangle(&rect);
+    }
+    source.list.append(measuredObjArr, measuredObjArr + objCnt);
+    source.inspectionData.writeInspectionDataToXml(XML_PATH);
+
+    //只生成检测程式文件
+    XmlJobImporter importer(1000);
+    CHECK_EQUAL(importer.importJob(XML_PATH, JOB_PATH), (size_t)objCnt);
+    {
+        SqliteDB sqlite;
+        sqlite.open(JOB_PATH, SQLITE_OPEN_READONLY);
+        RowReader<int64_t, string, double, double, double, double, double> reader(
+                    &sqlite, "select Id,Name,PosX,PosY,Width,Height,Angle from MeasuredObjList order by Id");
+        int64_t id = 0;
+        string name;
+        double x = 0, y = 0, width = 0, height = 0, angle = 0;
+        int i = 0;
+        int failures = 0;
+        while(reader.next(id, name, x, y, width, height, angle))
+        {
+            bool ok = id == i + 1 && name == "c" + to_string(i) &&
+                      x == 0.5 * (i % 500) && y == 0.25 * (i / 500) &&
+                      width == 1.5 && height == 0.75 && angle == 90.0 * (i % 4);
+            if(!ok && failures++ < 10)
+            {
+                CHECK(ok);
+            }
+            ++i;
+        }
+        CHECK_EQUAL(i, objCnt);
+
+        string boardName;
+        double originalX = 0, sizeY = 0;
+        RowReader<string, double, double> boardReader(&sqlite, "select Name,OriginalX,SizeY from Board");
+        CHECK(boardReader.next(boardName, originalX, sizeY));
+        CHECK_EQUAL(boardName, string("board"));
+        CHECK_EQUAL(originalX, 0.5);
+        CHECK_EQUAL(sizeY, 200.0);
+        sqlite.close();
+    }
+
+    //同时读入内存
+    JobData loaded;
+    CHECK_EQUAL(importer.importJob(XML_PATH, JOB_PATH, &loaded.inspectionData), (size_t)objCnt);
+    CHECK_EQUAL(loaded.list.size(), objCnt);
+    CHECK_EQUAL(loaded.board.name(), string("board"));
+    MeasuredObj * pExpected = source.list.pHead();
+    for (MeasuredObj * pObj = loaded.list.pHead(); nullptr != pObj && nullptr != pExpected;
+         pObj = pObj->pNextMeasuredObj(), pExpected = pExpected->pNextMeasuredObj())
+    {
+        if(pObj->id() != pExpected->id() || pObj->name() != pExpected->name() ||
+           pObj->rectangle().xPos() != pExpected->rectangle().xPos() ||
+           pObj->rectangle().angle() != pExpected->rectangle().angle())
+        {
+            CHECK_EQUAL(pObj->id(), pExpected->id());
+            break;
+        }
+    }
+
+    std::remove(XML_PATH);
+    std::remove(JOB_PATH);
+}
+//<<<----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main()
+{
+    RUN_TEST(testAttributesRoundTrip);
+    RUN_TEST(testNestedElements);
+    RUN_TEST(testChunkedRoundTrip);
+    RUN_TEST(testJobRoundTrip);
+    return Test::result();
+}